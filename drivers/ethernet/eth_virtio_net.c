@@ -0,0 +1,986 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* VIRTIO network device driver. Each RX/TX virtqueue pair is used
+ * independently, network buffers of received frames are given to the device
+ * as they are, and sent packets are handed over without being copied.
+ */
+
+#define DT_DRV_COMPAT virtio_device1
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(eth_virtio_net, CONFIG_ETHERNET_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/virtio.h>
+#include <zephyr/drivers/virtio/virtqueue.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/byteorder.h>
+#include <ethernet/eth_stats.h>
+
+#include "eth.h"
+
+/* Feature bits, see 5.1.3 of the VIRTIO specification */
+#define VIRTIO_NET_F_CSUM      0
+#define VIRTIO_NET_F_MAC       5
+#define VIRTIO_NET_F_HOST_TSO4 11
+#define VIRTIO_NET_F_HOST_TSO6 12
+#define VIRTIO_NET_F_MRG_RXBUF 15
+#define VIRTIO_NET_F_STATUS    16
+#define VIRTIO_NET_F_CTRL_VQ   17
+#define VIRTIO_NET_F_MQ        22
+
+#define VIRTIO_NET_S_LINK_UP BIT(0)
+
+#define VIRTIO_NET_HDR_F_NEEDS_CSUM 1
+#define VIRTIO_NET_HDR_GSO_TCPV4    1
+#define VIRTIO_NET_HDR_GSO_TCPV6    4
+
+#define VIRTIO_NET_CTRL_MQ                 4
+#define VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET    0
+#define VIRTIO_NET_OK                      0
+
+#define VIRTIO_NET_CTRL_QUEUE_SIZE 4
+#define VIRTIO_NET_CTRL_TIMEOUT    K_MSEC(100)
+#define VIRTIO_NET_TX_TIMEOUT      K_MSEC(100)
+#define VIRTIO_NET_REFILL_RETRY    K_MSEC(10)
+
+/* Bytes of a sent frame looked at to find the offloaded headers */
+#define VIRTIO_NET_TX_HDRS_MAX 192
+
+#define VIRTIO_NET_TCP_CSUM_OFFSET 16
+#define VIRTIO_NET_UDP_CSUM_OFFSET 6
+
+#define VIRTIO_NET_IPV4_IHL_MASK 0x0f
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_ETH_VIRTIO_NET_QUEUE_SIZE),
+	     "Virtqueue size must be a power of two");
+
+struct virtio_net_hdr {
+	uint8_t flags;
+	uint8_t gso_type;
+	uint16_t hdr_len;
+	uint16_t gso_size;
+	uint16_t csum_start;
+	uint16_t csum_offset;
+	uint16_t num_buffers;
+} __packed;
+
+struct virtio_net_config {
+	uint8_t mac[6];
+	uint16_t status;
+	uint16_t max_virtqueue_pairs;
+	uint16_t mtu;
+} __packed;
+
+struct virtio_net_ctrl_hdr {
+	uint8_t class;
+	uint8_t cmd;
+} __packed;
+
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+#define VIRTIO_NET_RX_BUF_SIZE CONFIG_NET_BUF_DATA_SIZE
+#else
+#define VIRTIO_NET_RX_BUF_SIZE (sizeof(struct virtio_net_hdr) + NET_ETH_MAX_FRAME_SIZE)
+#endif
+
+/* Buffers needed for the largest frame when they are not merged */
+#define VIRTIO_NET_RX_CHAIN_MAX                                                                    \
+	DIV_ROUND_UP(sizeof(struct virtio_net_hdr) + NET_ETH_MAX_FRAME_SIZE, VIRTIO_NET_RX_BUF_SIZE)
+
+#define VIRTIO_NET_RX_BUFS MAX(CONFIG_ETH_VIRTIO_NET_RX_BUFS, VIRTIO_NET_RX_CHAIN_MAX)
+
+BUILD_ASSERT(VIRTIO_NET_RX_BUF_SIZE > sizeof(struct virtio_net_hdr),
+	     "Network buffers too small for the VIRTIO header");
+
+struct eth_virtio_net_config {
+	const struct device *vdev;
+};
+
+struct eth_virtio_net_rx_slot {
+	sys_snode_t node;
+	struct eth_virtio_net_rxq *rxq;
+	struct net_buf *buf;
+	uint32_t len;
+	uint16_t nbufs;
+};
+
+struct eth_virtio_net_rxq {
+	const struct device *dev;
+	struct virtq *vq;
+	struct k_spinlock lock;
+	struct eth_virtio_net_rx_slot slots[VIRTIO_NET_RX_BUFS];
+	struct eth_virtio_net_rx_slot *free_slots[VIRTIO_NET_RX_BUFS];
+	struct virtq_buf bufs[VIRTIO_NET_RX_CHAIN_MAX];
+	/* Slots filled by the device, waiting for rx_work */
+	sys_slist_t done;
+	struct k_work rx_work;
+	uint16_t nfree;
+	uint16_t posted;
+	uint16_t idx;
+	/* Frame being assembled from merged buffers */
+	struct net_pkt *pkt;
+	uint16_t bufs_left;
+};
+
+struct eth_virtio_net_tx_slot {
+	struct eth_virtio_net_txq *txq;
+	struct net_pkt *pkt;
+	struct virtio_net_hdr hdr;
+};
+
+struct eth_virtio_net_txq {
+	struct virtq *vq;
+	struct k_mutex lock;
+	struct k_spinlock slot_lock;
+	struct k_sem done;
+	struct eth_virtio_net_tx_slot slots[CONFIG_ETH_VIRTIO_NET_TX_PKTS];
+	struct eth_virtio_net_tx_slot *free_slots[CONFIG_ETH_VIRTIO_NET_TX_PKTS];
+	struct virtq_buf bufs[CONFIG_ETH_VIRTIO_NET_TX_MAX_FRAGS + 1];
+	uint16_t nfree;
+	uint16_t idx;
+};
+
+struct eth_virtio_net_data {
+	const struct device *dev;
+	struct net_if *iface;
+	uint8_t mac[6];
+	uint16_t pairs;
+	uint16_t ctrl_idx;
+	bool has_ctrl;
+	bool has_status;
+	bool mrg_rxbuf;
+	enum ethernet_hw_caps caps;
+	struct eth_virtio_net_rxq rxq[CONFIG_ETH_VIRTIO_NET_MAX_QUEUE_PAIRS];
+	struct eth_virtio_net_txq txq[CONFIG_ETH_VIRTIO_NET_MAX_QUEUE_PAIRS];
+	struct k_work_delayable refill_work;
+	struct k_sem ctrl_done;
+	struct virtio_net_ctrl_hdr ctrl_hdr;
+	uint16_t ctrl_pairs;
+	uint8_t ctrl_ack;
+#if defined(CONFIG_NET_STATISTICS_ETHERNET)
+	struct net_stats_eth stats;
+#endif
+};
+
+static uint16_t eth_virtio_net_enum_queues_cb(uint16_t q_index, uint16_t q_size_max, void *opaque)
+{
+	struct eth_virtio_net_data *data = opaque;
+
+	/* Both sizes are powers of two */
+	if (q_index < data->pairs * 2) {
+		return MIN(q_size_max, CONFIG_ETH_VIRTIO_NET_QUEUE_SIZE);
+	}
+
+	if (data->has_ctrl && q_index == data->ctrl_idx) {
+		return MIN(q_size_max, VIRTIO_NET_CTRL_QUEUE_SIZE);
+	}
+
+	return 0;
+}
+
+static void eth_virtio_net_rx_refill(struct eth_virtio_net_data *data,
+				     struct eth_virtio_net_rxq *rxq);
+
+static void eth_virtio_net_rx_deliver(struct eth_virtio_net_data *data, struct net_pkt *pkt)
+{
+	net_pkt_trim_buffer(pkt);
+
+	if (net_recv_data(data->iface, pkt) < 0) {
+		net_pkt_unref(pkt);
+		eth_stats_update_errors_rx(data->iface);
+	}
+}
+
+/* Set the length of the buffers the device wrote len bytes into */
+static void eth_virtio_net_rx_set_len(struct net_buf *buf, uint32_t len)
+{
+	for (; buf != NULL; buf = buf->frags) {
+		size_t frag_len = MIN(len, net_buf_tailroom(buf));
+
+		net_buf_add(buf, frag_len);
+		len -= frag_len;
+	}
+}
+
+static void eth_virtio_net_rx_merged(struct eth_virtio_net_data *data,
+				     struct eth_virtio_net_rxq *rxq, struct net_buf *buf,
+				     uint32_t len)
+{
+	if (rxq->bufs_left == 0U) {
+		struct virtio_net_hdr *hdr = (struct virtio_net_hdr *)buf->data;
+
+		if (len < sizeof(*hdr) || hdr->num_buffers == 0U) {
+			goto drop;
+		}
+
+		rxq->bufs_left = sys_le16_to_cpu(hdr->num_buffers);
+		rxq->pkt = net_pkt_rx_alloc_on_iface(data->iface, K_NO_WAIT);
+		if (rxq->pkt == NULL) {
+			eth_stats_update_errors_rx(data->iface);
+		}
+
+		eth_virtio_net_rx_set_len(buf, len);
+		net_buf_pull(buf, sizeof(*hdr));
+	} else {
+		eth_virtio_net_rx_set_len(buf, len);
+	}
+
+	rxq->bufs_left--;
+
+	/* The rest of a frame without a packet is dropped */
+	if (rxq->pkt == NULL) {
+		net_buf_unref(buf);
+		return;
+	}
+
+	net_pkt_frag_add(rxq->pkt, buf);
+
+	if (rxq->bufs_left == 0U) {
+		struct net_pkt *pkt = rxq->pkt;
+
+		rxq->pkt = NULL;
+		eth_virtio_net_rx_deliver(data, pkt);
+	}
+
+	return;
+
+drop:
+	net_buf_unref(buf);
+	eth_stats_update_errors_rx(data->iface);
+}
+
+static void eth_virtio_net_rx_chain(struct eth_virtio_net_data *data, struct net_buf *buf,
+				    uint32_t len)
+{
+	struct net_pkt *pkt;
+
+	if (len <= sizeof(struct virtio_net_hdr)) {
+		goto drop;
+	}
+
+	pkt = net_pkt_rx_alloc_on_iface(data->iface, K_NO_WAIT);
+	if (pkt == NULL) {
+		goto drop;
+	}
+
+	eth_virtio_net_rx_set_len(buf, len);
+	net_buf_pull(buf, sizeof(struct virtio_net_hdr));
+	net_pkt_frag_add(pkt, buf);
+
+	eth_virtio_net_rx_deliver(data, pkt);
+	return;
+
+drop:
+	net_buf_unref(buf);
+	eth_stats_update_errors_rx(data->iface);
+}
+
+/* Called from the interrupt handler of the VIRTIO transport, the frame is
+ * handed to the network stack from rx_work.
+ */
+static void eth_virtio_net_rx_done(void *opaque, uint32_t len)
+{
+	struct eth_virtio_net_rx_slot *slot = opaque;
+	struct eth_virtio_net_rxq *rxq = slot->rxq;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&rxq->lock);
+	slot->len = len;
+	sys_slist_append(&rxq->done, &slot->node);
+	k_spin_unlock(&rxq->lock, key);
+
+	k_work_submit(&rxq->rx_work);
+}
+
+static void eth_virtio_net_rx_work(struct k_work *work)
+{
+	struct eth_virtio_net_rxq *rxq = CONTAINER_OF(work, struct eth_virtio_net_rxq, rx_work);
+	struct eth_virtio_net_data *data = rxq->dev->data;
+
+	while (true) {
+		struct eth_virtio_net_rx_slot *slot;
+		struct net_buf *buf;
+		k_spinlock_key_t key;
+		sys_snode_t *node;
+		uint32_t len;
+
+		key = k_spin_lock(&rxq->lock);
+
+		node = sys_slist_get(&rxq->done);
+		if (node == NULL) {
+			k_spin_unlock(&rxq->lock, key);
+			break;
+		}
+
+		slot = CONTAINER_OF(node, struct eth_virtio_net_rx_slot, node);
+		buf = slot->buf;
+		len = slot->len;
+		slot->buf = NULL;
+		rxq->posted -= slot->nbufs;
+		rxq->free_slots[rxq->nfree++] = slot;
+		k_spin_unlock(&rxq->lock, key);
+
+		if (data->mrg_rxbuf) {
+			eth_virtio_net_rx_merged(data, rxq, buf, len);
+		} else {
+			eth_virtio_net_rx_chain(data, buf, len);
+		}
+	}
+
+	eth_virtio_net_rx_refill(data, rxq);
+}
+
+/* Give one buffer, or a chain of them for a whole frame, to the device */
+static int eth_virtio_net_rx_post(struct eth_virtio_net_data *data,
+				  struct eth_virtio_net_rxq *rxq)
+{
+	uint16_t nbufs = data->mrg_rxbuf ? 1U : VIRTIO_NET_RX_CHAIN_MAX;
+	struct eth_virtio_net_rx_slot *slot;
+	struct net_buf *head = NULL;
+	int ret;
+
+	if (rxq->nfree == 0U || rxq->posted + nbufs > VIRTIO_NET_RX_BUFS) {
+		return -ENOSPC;
+	}
+
+	for (uint16_t i = 0; i < nbufs; i++) {
+		struct net_buf *buf;
+
+		buf = net_pkt_get_reserve_rx_data(VIRTIO_NET_RX_BUF_SIZE, K_NO_WAIT);
+		if (buf == NULL) {
+			if (head != NULL) {
+				net_buf_unref(head);
+			}
+
+			return -ENOMEM;
+		}
+
+		rxq->bufs[i].addr = buf->data;
+		rxq->bufs[i].len = net_buf_tailroom(buf);
+
+		if (head == NULL) {
+			head = buf;
+		} else {
+			net_buf_frag_add(head, buf);
+		}
+	}
+
+	slot = rxq->free_slots[--rxq->nfree];
+
+	ret = virtq_add_buffer_chain(rxq->vq, rxq->bufs, nbufs, 0, eth_virtio_net_rx_done, slot,
+				     K_NO_WAIT);
+	if (ret < 0) {
+		rxq->free_slots[rxq->nfree++] = slot;
+		net_buf_unref(head);
+		return ret;
+	}
+
+	slot->buf = head;
+	slot->nbufs = nbufs;
+	rxq->posted += nbufs;
+
+	return 0;
+}
+
+static void eth_virtio_net_rx_refill(struct eth_virtio_net_data *data,
+				     struct eth_virtio_net_rxq *rxq)
+{
+	const struct eth_virtio_net_config *cfg = data->dev->config;
+	bool posted = false;
+	k_spinlock_key_t key;
+	int ret;
+
+	key = k_spin_lock(&rxq->lock);
+
+	do {
+		ret = eth_virtio_net_rx_post(data, rxq);
+		if (ret == 0) {
+			posted = true;
+		}
+	} while (ret == 0);
+
+	k_spin_unlock(&rxq->lock, key);
+
+	/* Try again later when the buffer pool has run dry */
+	if (ret == -ENOMEM) {
+		k_work_schedule(&data->refill_work, VIRTIO_NET_REFILL_RETRY);
+	}
+
+	if (posted) {
+		virtio_notify_virtqueue(cfg->vdev, rxq->idx);
+	}
+}
+
+static void eth_virtio_net_refill_work(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct eth_virtio_net_data *data =
+		CONTAINER_OF(dwork, struct eth_virtio_net_data, refill_work);
+
+	for (uint16_t i = 0; i < data->pairs; i++) {
+		eth_virtio_net_rx_refill(data, &data->rxq[i]);
+	}
+}
+
+/* Called from the interrupt handler of the VIRTIO transport */
+static void eth_virtio_net_tx_done(void *opaque, uint32_t len)
+{
+	struct eth_virtio_net_tx_slot *slot = opaque;
+	struct eth_virtio_net_txq *txq = slot->txq;
+	struct net_pkt *pkt = slot->pkt;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(len);
+
+	key = k_spin_lock(&txq->slot_lock);
+	slot->pkt = NULL;
+	txq->free_slots[txq->nfree++] = slot;
+	k_spin_unlock(&txq->slot_lock, key);
+
+	net_pkt_unref(pkt);
+	k_sem_give(&txq->done);
+}
+
+static uint32_t eth_virtio_net_csum_add(uint32_t sum, const uint8_t *data, size_t len)
+{
+	for (; len > 1; len -= 2, data += 2) {
+		sum += sys_get_be16(data);
+	}
+
+	if (len > 0) {
+		sum += (uint32_t)data[0] << 8;
+	}
+
+	return sum;
+}
+
+static uint16_t eth_virtio_net_csum_fold(uint32_t sum)
+{
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+static int eth_virtio_net_put_be16(struct net_pkt *pkt, size_t offset, uint16_t value)
+{
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ret = net_pkt_skip(pkt, offset);
+	if (ret == 0) {
+		ret = net_pkt_write_be16(pkt, value);
+	}
+
+	net_pkt_set_overwrite(pkt, false);
+	net_pkt_cursor_init(pkt);
+
+	return ret;
+}
+
+/* Finish the IPv4 header and describe the checksum and segmentation work
+ * left to the device in the VIRTIO header.
+ */
+static int eth_virtio_net_tx_offload(struct eth_virtio_net_data *data, struct net_pkt *pkt,
+				     struct virtio_net_hdr *hdr)
+{
+	uint8_t hdrs[VIRTIO_NET_TX_HDRS_MAX];
+	size_t len = MIN(net_pkt_get_len(pkt), sizeof(hdrs));
+	size_t l2_len = sizeof(struct net_eth_hdr);
+	uint16_t csum_start;
+	uint16_t l4_len;
+	uint16_t type;
+	uint32_t sum;
+	size_t l3_len;
+	uint8_t proto;
+	bool is_ipv4;
+
+	if (!(data->caps & ETHERNET_HW_TX_CHKSUM_OFFLOAD)) {
+		return 0;
+	}
+
+	net_pkt_cursor_init(pkt);
+	if (len < l2_len || net_pkt_read(pkt, hdrs, len) < 0) {
+		return -EINVAL;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	type = sys_get_be16(&hdrs[offsetof(struct net_eth_hdr, type)]);
+	if (type == NET_ETH_PTYPE_VLAN) {
+		l2_len = sizeof(struct net_eth_vlan_hdr);
+		if (len < l2_len) {
+			return -EINVAL;
+		}
+
+		type = sys_get_be16(&hdrs[offsetof(struct net_eth_vlan_hdr, type)]);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && type == NET_ETH_PTYPE_IP) {
+		struct net_ipv4_hdr *ip = (struct net_ipv4_hdr *)&hdrs[l2_len];
+		int ret;
+
+		l3_len = (ip->vhl & VIRTIO_NET_IPV4_IHL_MASK) * 4U;
+		if (len < l2_len + l3_len || l3_len < NET_IPV4H_LEN) {
+			return -EINVAL;
+		}
+
+		/* The header checksum is always left to the driver */
+		ip->chksum = 0U;
+		sum = eth_virtio_net_csum_add(0, (uint8_t *)ip, l3_len);
+		ret = eth_virtio_net_put_be16(pkt, l2_len + offsetof(struct net_ipv4_hdr, chksum),
+					      ~eth_virtio_net_csum_fold(sum));
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (sys_get_be16(ip->offset) &
+		    (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) {
+			return 0;
+		}
+
+		is_ipv4 = true;
+		proto = ip->proto;
+		l4_len = ntohs(ip->len) - l3_len;
+		sum = eth_virtio_net_csum_add(0, ip->src, 2 * NET_IPV4_ADDR_SIZE);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && type == NET_ETH_PTYPE_IPV6) {
+		struct net_ipv6_hdr *ip = (struct net_ipv6_hdr *)&hdrs[l2_len];
+
+		l3_len = NET_IPV6H_LEN;
+		if (len < l2_len + l3_len) {
+			return -EINVAL;
+		}
+
+		proto = ip->nexthdr;
+		while (proto == NET_IPV6_NEXTHDR_HBHO || proto == NET_IPV6_NEXTHDR_DESTO ||
+		       proto == NET_IPV6_NEXTHDR_ROUTING) {
+			if (len < l2_len + l3_len + 2) {
+				return -EINVAL;
+			}
+
+			proto = hdrs[l2_len + l3_len];
+			l3_len += (hdrs[l2_len + l3_len + 1] + 1U) * 8U;
+		}
+
+		if (proto == NET_IPV6_NEXTHDR_FRAG) {
+			return 0;
+		}
+
+		is_ipv4 = false;
+		l4_len = ntohs(ip->len) + NET_IPV6H_LEN - l3_len;
+		sum = eth_virtio_net_csum_add(0, ip->src, 2 * NET_IPV6_ADDR_SIZE);
+	} else {
+		return 0;
+	}
+
+	if (net_pkt_is_chksum_done(pkt) || (proto != IPPROTO_TCP && proto != IPPROTO_UDP)) {
+		return 0;
+	}
+
+	csum_start = l2_len + l3_len;
+	if (len < csum_start + (proto == IPPROTO_TCP ? NET_TCPH_LEN : NET_UDPH_LEN)) {
+		return -EINVAL;
+	}
+
+	/* The device adds the data to the pseudo header sum found in the field */
+	sum += proto + l4_len;
+	hdr->flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+	hdr->csum_start = sys_cpu_to_le16(csum_start);
+	hdr->csum_offset = sys_cpu_to_le16(proto == IPPROTO_TCP ? VIRTIO_NET_TCP_CSUM_OFFSET
+								: VIRTIO_NET_UDP_CSUM_OFFSET);
+
+	if (proto == IPPROTO_TCP && net_pkt_gso_size(pkt) != 0U) {
+		uint8_t tcp_len = (hdrs[csum_start + 12] >> 4) * 4U;
+
+		if (!(data->caps & ETHERNET_HW_TCP_SEG_OFFLOAD)) {
+			return -ENOTSUP;
+		}
+
+		hdr->gso_type = is_ipv4 ? VIRTIO_NET_HDR_GSO_TCPV4 : VIRTIO_NET_HDR_GSO_TCPV6;
+		hdr->hdr_len = sys_cpu_to_le16(csum_start + tcp_len);
+		hdr->gso_size = sys_cpu_to_le16(net_pkt_gso_size(pkt));
+	}
+
+	return eth_virtio_net_put_be16(pkt, csum_start + sys_le16_to_cpu(hdr->csum_offset),
+				       eth_virtio_net_csum_fold(sum));
+}
+
+static struct eth_virtio_net_tx_slot *eth_virtio_net_tx_slot_get(struct eth_virtio_net_txq *txq)
+{
+	struct eth_virtio_net_tx_slot *slot = NULL;
+	k_spinlock_key_t key;
+
+	do {
+		key = k_spin_lock(&txq->slot_lock);
+		if (txq->nfree > 0U) {
+			slot = txq->free_slots[--txq->nfree];
+		}
+		k_spin_unlock(&txq->slot_lock, key);
+	} while (slot == NULL && k_sem_take(&txq->done, VIRTIO_NET_TX_TIMEOUT) == 0);
+
+	return slot;
+}
+
+static void eth_virtio_net_tx_slot_put(struct eth_virtio_net_txq *txq,
+				       struct eth_virtio_net_tx_slot *slot)
+{
+	k_spinlock_key_t key = k_spin_lock(&txq->slot_lock);
+
+	txq->free_slots[txq->nfree++] = slot;
+	k_spin_unlock(&txq->slot_lock, key);
+}
+
+static int eth_virtio_net_send(const struct device *dev, struct net_pkt *pkt)
+{
+	const struct eth_virtio_net_config *cfg = dev->config;
+	struct eth_virtio_net_data *data = dev->data;
+	struct eth_virtio_net_txq *txq;
+	struct eth_virtio_net_tx_slot *slot;
+	uint16_t nbufs = 1U;
+	int ret;
+
+	/* Every TX traffic class thread gets a queue of its own when possible */
+	txq = &data->txq[net_tx_priority2tc(net_pkt_priority(pkt)) % data->pairs];
+
+	k_mutex_lock(&txq->lock, K_FOREVER);
+
+	slot = eth_virtio_net_tx_slot_get(txq);
+	if (slot == NULL) {
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	memset(&slot->hdr, 0, sizeof(slot->hdr));
+
+	ret = eth_virtio_net_tx_offload(data, pkt, &slot->hdr);
+	if (ret < 0) {
+		goto free_slot;
+	}
+
+	txq->bufs[0].addr = &slot->hdr;
+	txq->bufs[0].len = sizeof(slot->hdr);
+
+	for (struct net_buf *frag = pkt->frags; frag != NULL; frag = frag->frags) {
+		if (frag->len == 0U) {
+			continue;
+		}
+
+		if (nbufs == ARRAY_SIZE(txq->bufs) || nbufs == txq->vq->num) {
+			LOG_DBG("pkt %p has too many fragments", pkt);
+			ret = -EMSGSIZE;
+			goto free_slot;
+		}
+
+		txq->bufs[nbufs].addr = frag->data;
+		txq->bufs[nbufs].len = frag->len;
+		nbufs++;
+	}
+
+	/* The buffers stay with the device until it is done with them */
+	slot->pkt = net_pkt_ref(pkt);
+
+	while ((ret = virtq_add_buffer_chain(txq->vq, txq->bufs, nbufs, nbufs,
+					     eth_virtio_net_tx_done, slot, K_NO_WAIT)) == -EBUSY) {
+		if (k_sem_take(&txq->done, VIRTIO_NET_TX_TIMEOUT) != 0) {
+			break;
+		}
+	}
+
+	if (ret < 0) {
+		net_pkt_unref(pkt);
+		slot->pkt = NULL;
+		goto free_slot;
+	}
+
+	virtio_notify_virtqueue(cfg->vdev, txq->idx);
+	goto out;
+
+free_slot:
+	eth_virtio_net_tx_slot_put(txq, slot);
+out:
+	k_mutex_unlock(&txq->lock);
+
+	if (ret < 0) {
+		LOG_DBG("Cannot send pkt %p (%d)", pkt, ret);
+		eth_stats_update_errors_tx(data->iface);
+	}
+
+	return ret;
+}
+
+static enum ethernet_hw_caps eth_virtio_net_get_capabilities(const struct device *dev)
+{
+	struct eth_virtio_net_data *data = dev->data;
+
+	return data->caps;
+}
+
+static int eth_virtio_net_get_config(const struct device *dev, enum ethernet_config_type type,
+				     struct ethernet_config *config)
+{
+	struct eth_virtio_net_data *data = dev->data;
+
+	switch (type) {
+	case ETHERNET_CONFIG_TYPE_TX_CHECKSUM_SUPPORT:
+		if (!(data->caps & ETHERNET_HW_TX_CHKSUM_OFFLOAD)) {
+			return -ENOTSUP;
+		}
+
+		config->chksum_support = ETHERNET_CHECKSUM_SUPPORT_IPV4_HEADER |
+					 ETHERNET_CHECKSUM_SUPPORT_IPV6_HEADER |
+					 ETHERNET_CHECKSUM_SUPPORT_TCP |
+					 ETHERNET_CHECKSUM_SUPPORT_UDP;
+		return 0;
+	default:
+		return -ENOTSUP;
+	}
+}
+
+#if defined(CONFIG_NET_STATISTICS_ETHERNET)
+static struct net_stats_eth *eth_virtio_net_get_stats(const struct device *dev)
+{
+	struct eth_virtio_net_data *data = dev->data;
+
+	return &data->stats;
+}
+#endif
+
+static void eth_virtio_net_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	const struct eth_virtio_net_config *cfg = dev->config;
+	struct eth_virtio_net_data *data = dev->data;
+	volatile struct virtio_net_config *net_cfg;
+	bool first = (data->iface == NULL);
+
+	if (first) {
+		data->iface = iface;
+	}
+
+	ethernet_init(iface);
+
+	net_if_set_link_addr(iface, data->mac, sizeof(data->mac), NET_LINK_ETHERNET);
+
+	if (!first) {
+		return;
+	}
+
+	net_cfg = virtio_get_device_specific_config(cfg->vdev);
+	if (data->has_status && !(sys_le16_to_cpu(net_cfg->status) & VIRTIO_NET_S_LINK_UP)) {
+		net_eth_carrier_off(iface);
+	}
+
+	for (uint16_t i = 0; i < data->pairs; i++) {
+		eth_virtio_net_rx_refill(data, &data->rxq[i]);
+	}
+}
+
+static void eth_virtio_net_ctrl_done(void *opaque, uint32_t len)
+{
+	struct eth_virtio_net_data *data = opaque;
+
+	ARG_UNUSED(len);
+
+	k_sem_give(&data->ctrl_done);
+}
+
+static int eth_virtio_net_set_queue_pairs(const struct device *dev, uint16_t pairs)
+{
+	const struct eth_virtio_net_config *cfg = dev->config;
+	struct eth_virtio_net_data *data = dev->data;
+	struct virtq_buf bufs[] = {
+		{.addr = &data->ctrl_hdr, .len = sizeof(data->ctrl_hdr)},
+		{.addr = &data->ctrl_pairs, .len = sizeof(data->ctrl_pairs)},
+		{.addr = &data->ctrl_ack, .len = sizeof(data->ctrl_ack)},
+	};
+	int ret;
+
+	data->ctrl_hdr.class = VIRTIO_NET_CTRL_MQ;
+	data->ctrl_hdr.cmd = VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET;
+	data->ctrl_pairs = sys_cpu_to_le16(pairs);
+	data->ctrl_ack = ~VIRTIO_NET_OK;
+
+	ret = virtq_add_buffer_chain(virtio_get_virtqueue(cfg->vdev, data->ctrl_idx), bufs,
+				     ARRAY_SIZE(bufs), ARRAY_SIZE(bufs) - 1,
+				     eth_virtio_net_ctrl_done, data, K_NO_WAIT);
+	if (ret < 0) {
+		return ret;
+	}
+
+	virtio_notify_virtqueue(cfg->vdev, data->ctrl_idx);
+
+	if (k_sem_take(&data->ctrl_done, VIRTIO_NET_CTRL_TIMEOUT) != 0) {
+		return -ETIMEDOUT;
+	}
+
+	return data->ctrl_ack == VIRTIO_NET_OK ? 0 : -EIO;
+}
+
+static bool eth_virtio_net_negotiate(const struct device *vdev, int bit)
+{
+	if (!virtio_read_device_feature_bit(vdev, bit)) {
+		return false;
+	}
+
+	return virtio_write_driver_feature_bit(vdev, bit, true) == 0;
+}
+
+static void eth_virtio_net_queues_init(struct eth_virtio_net_data *data)
+{
+	const struct eth_virtio_net_config *cfg = data->dev->config;
+
+	for (uint16_t i = 0; i < data->pairs; i++) {
+		struct eth_virtio_net_rxq *rxq = &data->rxq[i];
+		struct eth_virtio_net_txq *txq = &data->txq[i];
+
+		rxq->dev = data->dev;
+		rxq->idx = i * 2U;
+		rxq->vq = virtio_get_virtqueue(cfg->vdev, rxq->idx);
+
+		for (uint16_t j = 0; j < ARRAY_SIZE(rxq->slots); j++) {
+			rxq->slots[j].rxq = rxq;
+			rxq->free_slots[j] = &rxq->slots[j];
+		}
+
+		rxq->nfree = ARRAY_SIZE(rxq->slots);
+		sys_slist_init(&rxq->done);
+		k_work_init(&rxq->rx_work, eth_virtio_net_rx_work);
+
+		txq->idx = i * 2U + 1U;
+		txq->vq = virtio_get_virtqueue(cfg->vdev, txq->idx);
+		k_mutex_init(&txq->lock);
+		k_sem_init(&txq->done, 0, K_SEM_MAX_LIMIT);
+
+		for (uint16_t j = 0; j < ARRAY_SIZE(txq->slots); j++) {
+			txq->slots[j].txq = txq;
+			txq->free_slots[j] = &txq->slots[j];
+		}
+
+		txq->nfree = ARRAY_SIZE(txq->slots);
+	}
+}
+
+static int eth_virtio_net_init(const struct device *dev)
+{
+	const struct eth_virtio_net_config *cfg = dev->config;
+	struct eth_virtio_net_data *data = dev->data;
+	volatile struct virtio_net_config *net_cfg;
+	uint16_t max_pairs = 1U;
+	bool csum;
+	bool tso;
+	int ret;
+
+	if (!device_is_ready(cfg->vdev)) {
+		LOG_ERR("VIRTIO device not ready");
+		return -ENODEV;
+	}
+
+	data->dev = dev;
+	net_cfg = virtio_get_device_specific_config(cfg->vdev);
+
+	/* Segmentation offload requires checksum offload, and the stack
+	 * cannot tell IPv4 and IPv6 apart when asking for it.
+	 */
+	csum = eth_virtio_net_negotiate(cfg->vdev, VIRTIO_NET_F_CSUM);
+	tso = false;
+	if (csum) {
+		tso = eth_virtio_net_negotiate(cfg->vdev, VIRTIO_NET_F_HOST_TSO4);
+		tso = eth_virtio_net_negotiate(cfg->vdev, VIRTIO_NET_F_HOST_TSO6) && tso;
+	}
+	data->mrg_rxbuf = eth_virtio_net_negotiate(cfg->vdev, VIRTIO_NET_F_MRG_RXBUF);
+
+	if (eth_virtio_net_negotiate(cfg->vdev, VIRTIO_NET_F_MAC)) {
+		for (int i = 0; i < sizeof(data->mac); i++) {
+			data->mac[i] = net_cfg->mac[i];
+		}
+	} else {
+		gen_random_mac(data->mac, 0x52, 0x54, 0x00);
+	}
+
+	data->has_status = eth_virtio_net_negotiate(cfg->vdev, VIRTIO_NET_F_STATUS);
+
+	if (CONFIG_ETH_VIRTIO_NET_MAX_QUEUE_PAIRS > 1 &&
+	    virtio_read_device_feature_bit(cfg->vdev, VIRTIO_NET_F_MQ) &&
+	    eth_virtio_net_negotiate(cfg->vdev, VIRTIO_NET_F_CTRL_VQ) &&
+	    eth_virtio_net_negotiate(cfg->vdev, VIRTIO_NET_F_MQ)) {
+		max_pairs = sys_le16_to_cpu(net_cfg->max_virtqueue_pairs);
+		data->has_ctrl = true;
+		data->ctrl_idx = max_pairs * 2U;
+	}
+
+	ret = virtio_commit_feature_bits(cfg->vdev);
+	if (ret < 0) {
+		LOG_ERR("Feature negotiation failed (%d)", ret);
+		return ret;
+	}
+
+	data->pairs = CLAMP(max_pairs, 1U, CONFIG_ETH_VIRTIO_NET_MAX_QUEUE_PAIRS);
+
+	ret = virtio_init_virtqueues(cfg->vdev, data->has_ctrl ? max_pairs * 2U + 1U : 2U,
+				     eth_virtio_net_enum_queues_cb, data);
+	if (ret < 0) {
+		LOG_ERR("Virtqueue initialization failed (%d)", ret);
+		return ret;
+	}
+
+	eth_virtio_net_queues_init(data);
+	k_work_init_delayable(&data->refill_work, eth_virtio_net_refill_work);
+	k_sem_init(&data->ctrl_done, 0, 1);
+
+	virtio_finalize_init(cfg->vdev);
+
+	/* The device only uses the first pair until told otherwise */
+	if (data->pairs > 1U) {
+		ret = eth_virtio_net_set_queue_pairs(dev, data->pairs);
+		if (ret < 0) {
+			LOG_WRN("Cannot enable %u queue pairs (%d)", data->pairs, ret);
+			data->pairs = 1U;
+		}
+	}
+
+	data->caps = ETHERNET_LINK_10BASE | ETHERNET_LINK_100BASE | ETHERNET_LINK_1000BASE;
+	if (csum) {
+		data->caps |= ETHERNET_HW_TX_CHKSUM_OFFLOAD;
+	}
+
+	if (tso) {
+		data->caps |= ETHERNET_HW_TCP_SEG_OFFLOAD;
+	}
+
+	LOG_INF("%u queue pairs, %s RX buffers, caps 0x%x", data->pairs,
+		data->mrg_rxbuf ? "merged" : "chained", data->caps);
+
+	return 0;
+}
+
+static const struct ethernet_api eth_virtio_net_api = {
+	.iface_api.init = eth_virtio_net_iface_init,
+	.get_capabilities = eth_virtio_net_get_capabilities,
+	.get_config = eth_virtio_net_get_config,
+	.send = eth_virtio_net_send,
+#if defined(CONFIG_NET_STATISTICS_ETHERNET)
+	.get_stats = eth_virtio_net_get_stats,
+#endif
+};
+
+#define ETH_VIRTIO_NET_INIT(inst)                                                                  \
+	static const struct eth_virtio_net_config eth_virtio_net_config_##inst = {                \
+		.vdev = DEVICE_DT_GET(DT_PARENT(DT_DRV_INST(inst))),                               \
+	};                                                                                         \
+	static struct eth_virtio_net_data eth_virtio_net_data_##inst;                              \
+	ETH_NET_DEVICE_DT_INST_DEFINE(inst, eth_virtio_net_init, NULL,                             \
+				      &eth_virtio_net_data_##inst, &eth_virtio_net_config_##inst,  \
+				      CONFIG_ETH_INIT_PRIORITY, &eth_virtio_net_api, NET_ETH_MTU);
+
+DT_INST_FOREACH_STATUS_OKAY(ETH_VIRTIO_NET_INIT)
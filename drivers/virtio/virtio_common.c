@@ -17,7 +17,14 @@ void virtio_isr(const struct device *dev, uint8_t isr_status, uint16_t virtqueue
 	if (isr_status & VIRTIO_QUEUE_INTERRUPT) {
 		for (int i = 0; i < virtqueue_count; i++) {
 			struct virtq *vq = virtio_get_virtqueue(dev, i);
-			uint16_t used_idx = sys_le16_to_cpu(vq->used->idx);
+			uint16_t used_idx;
+
+			/* Not set up by the driver */
+			if (vq->num == 0) {
+				continue;
+			}
+
+			used_idx = sys_le16_to_cpu(vq->used->idx);
 
 			while (vq->last_used_idx != used_idx) {
 				uint16_t idx = vq->last_used_idx % vq->num;
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <zephyr/device.h>
 #include <zephyr/kernel/mm.h>
 #include <zephyr/logging/log.h>
@@ -220,6 +221,14 @@ static int virtio_mmio_set_virtqueues(const struct device *dev, uint16_t queue_c
 		const uint16_t queue_size =
 			cb(i, virtio_mmio_read32(dev, VIRTIO_MMIO_QUEUE_SIZE_MAX), opaque);
 
+		/* Queues the driver does not use are left disabled */
+		if (queue_size == 0) {
+			memset(&data->virtqueues[i], 0, sizeof(struct virtq));
+			created_queues++;
+			activated_queues++;
+			continue;
+		}
+
 		ret = virtq_create(&data->virtqueues[i], queue_size);
 		if (ret != 0) {
 			goto fail;
@@ -237,11 +246,16 @@ static int virtio_mmio_set_virtqueues(const struct device *dev, uint16_t queue_c
 
 fail:
 	for (int j = 0; j < activated_queues; j++) {
+		if (data->virtqueues[j].num == 0) {
+			continue;
+		}
 		virtio_mmio_write32(dev, VIRTIO_MMIO_QUEUE_SEL, j);
 		virtio_mmio_write32(dev, VIRTIO_MMIO_QUEUE_READY, 0);
 	}
 	for (int j = 0; j < created_queues; j++) {
-		virtq_free(&data->virtqueues[j]);
+		if (data->virtqueues[j].num != 0) {
+			virtq_free(&data->virtqueues[j]);
+		}
 	}
 	k_free(data->virtqueues);
 	data->virtqueue_count = 0;
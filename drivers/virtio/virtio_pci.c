@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/pcie/pcie.h>
 #include <zephyr/kernel/mm.h>
@@ -281,6 +282,14 @@ static int virtio_pci_init_virtqueues(
 
 		uint16_t queue_size = cb(i, sys_le16_to_cpu(data->common_cfg->queue_size), opaque);
 
+		/* Queues the driver does not use are left disabled */
+		if (queue_size == 0) {
+			memset(&data->virtqueues[i], 0, sizeof(struct virtq));
+			created_queues++;
+			activated_queues++;
+			continue;
+		}
+
 		ret = virtq_create(&data->virtqueues[i], queue_size);
 		if (ret != 0) {
 			goto fail;
@@ -298,12 +307,17 @@ static int virtio_pci_init_virtqueues(
 
 fail:
 	for (int j = 0; j < activated_queues; j++) {
+		if (data->virtqueues[j].num == 0) {
+			continue;
+		}
 		data->common_cfg->queue_select = sys_cpu_to_le16(j);
 		barrier_dmem_fence_full();
 		data->common_cfg->queue_enable = sys_cpu_to_le16(0);
 	}
 	for (int j = 0; j < created_queues; j++) {
-		virtq_free(&data->virtqueues[j]);
+		if (data->virtqueues[j].num != 0) {
+			virtq_free(&data->virtqueues[j]);
+		}
 	}
 	k_free(data->virtqueues);
 	data->virtqueue_count = 0;
@@ -26,7 +26,8 @@ extern "C" {
  * @param queue_idx index of currently inspected queue
  * @param max_queue_size maximum permitted size of currently inspected queue
  * @param opaque pointer to user provided data
- * @return the size of currently inspected virtqueue we want to set
+ * @return the size of currently inspected virtqueue we want to set, or 0 to
+ *         leave the queue disabled
  */
 typedef uint16_t (*virtio_enumerate_queues)(
 	uint16_t queue_idx, uint16_t max_queue_size, void *opaque
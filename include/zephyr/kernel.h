@@ -87,6 +87,8 @@ struct k_mem_domain;
 struct k_mem_partition;
 struct k_futex;
 struct k_event;
+struct k_sched_latency_stats;
+struct k_lock_stats;
 
 enum execution_context_types {
 	K_ISR = 0,
@@ -3050,6 +3052,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_pool;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
 
@@ -3084,6 +3087,14 @@ struct k_mutex {
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	struct k_obj_core obj_core;
 #endif
+
+#ifdef CONFIG_LOCK_STATS
+	/* Statistics of the place the mutex was first locked from, and the
+	 * time (in cycles) when it was
+	 */
+	struct z_lock_stats_entry *stats_entry;
+	uint32_t stats_time;
+#endif
 };
 
 /**
@@ -3635,6 +3646,59 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+/** @brief Statically define a work queue pool.
+ *
+ * This defines a pool of @p n_workers work queue threads along with
+ * their stacks.  The pool must be started with k_work_q_pool_start()
+ * before work can be submitted to it.
+ *
+ * @param name name of the @ref k_work_q_pool object.
+ * @param n_workers number of worker threads.
+ * @param size size of each worker thread stack area, in bytes.
+ */
+#define K_WORK_Q_POOL_DEFINE(name, n_workers, size)				\
+	static struct k_work_q _k_work_q_pool_workers_##name[n_workers];	\
+	static K_KERNEL_STACK_ARRAY_DEFINE(_k_work_q_pool_stacks_##name,	\
+					   n_workers, size);			\
+	struct k_work_q_pool name = {						\
+		.workers = _k_work_q_pool_workers_##name,			\
+		.stacks = _k_work_q_pool_stacks_##name[0],			\
+		.stack_len = sizeof(_k_work_q_pool_stacks_##name[0]),		\
+		.stack_size = K_KERNEL_STACK_SIZEOF(_k_work_q_pool_stacks_##name[0]), \
+		.num_workers = (n_workers),					\
+	}
+
+/** @brief Start the threads of a work queue pool.
+ *
+ * Once started, work items are submitted to the pool by passing
+ * k_work_q_pool_queue() wherever a work queue is expected.  Submission,
+ * flush, cancellation, draining, plugging and delayable work keep their
+ * single queue semantics, in particular a work item is never run by two
+ * workers at the same time.  Items are however not run in submission
+ * order, and separate items may run concurrently.
+ *
+ * k_work_queue_stop() stops all the worker threads of a pool.
+ * k_work_queue_thread_get() returns NULL for a pool.
+ *
+ * @param pool pointer to a pool defined with K_WORK_Q_POOL_DEFINE().
+ *
+ * @param prio initial priority of the worker threads.
+ *
+ * @param cfg optional additional configuration parameters, applied to
+ * every worker thread.  Pass @c NULL if not required, to use the defaults
+ * documented in k_work_queue_config.
+ */
+void k_work_q_pool_start(struct k_work_q_pool *pool, int prio,
+			 const struct k_work_queue_config *cfg);
+
+/** @brief Access the work queue of a work queue pool.
+ *
+ * @param pool pointer to the pool.
+ *
+ * @return the queue to submit work items to.
+ */
+static inline struct k_work_q *k_work_q_pool_queue(struct k_work_q_pool *pool);
+
 /** @brief Run work queue using calling thread
  *
  * This will run the work queue forever unless stopped by @ref k_work_queue_stop.
@@ -4029,6 +4093,8 @@ enum {
 	/* Static work queue flags */
 	K_WORK_QUEUE_NO_YIELD_BIT = 8,
 	K_WORK_QUEUE_NO_YIELD = BIT(K_WORK_QUEUE_NO_YIELD_BIT),
+	K_WORK_QUEUE_POOL_BIT = 9,
+	K_WORK_QUEUE_POOL = BIT(K_WORK_QUEUE_POOL_BIT),
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -4229,6 +4295,15 @@ struct k_work_queue_config {
 	 * an error will be logged if CONFIG_LOG is enabled.
 	 */
 	uint32_t work_timeout_ms;
+
+	/** Control whether the threads of a work queue pool are pinned
+	 * one per CPU.
+	 *
+	 * Only used by k_work_q_pool_start(), and only when
+	 * CONFIG_SCHED_CPU_MASK is enabled.  Work submitted from a CPU
+	 * is then preferably queued to the thread pinned to that CPU.
+	 */
+	bool pin_workers;
 };
 
 /** @brief A structure used to hold work until it can be processed. */
@@ -4262,6 +4337,45 @@ struct k_work_q {
 	struct k_work *work;
 	k_timeout_t work_timeout;
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
+
+#if defined(CONFIG_WORKQUEUE_POOL)
+	/* Pool this queue is a worker of, if any. */
+	struct k_work_q_pool *pool;
+
+	/* Work item being run by the worker of a pool. */
+	struct k_work *running;
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+};
+
+/** @brief A work queue served by several threads.
+ *
+ * Work items are submitted to @c queue with the regular work queue API.
+ * Each worker thread has its own list of pending items and steals from
+ * the other workers when it runs out of work.
+ */
+struct k_work_q_pool {
+	/* The queue work items are submitted to.  It has no thread of
+	 * its own.
+	 */
+	struct k_work_q queue;
+
+	/* All the following fields are set up by K_WORK_Q_POOL_DEFINE(). */
+
+	/* One queue per worker thread, holding the items queued to it. */
+	struct k_work_q *workers;
+
+	/* Worker thread stacks, stack_len bytes apart. */
+	k_thread_stack_t *stacks;
+	size_t stack_len;
+	size_t stack_size;
+
+	uint8_t num_workers;
+
+	/* Worker the next submission is queued to, unless one is idle. */
+	uint8_t next_worker;
+
+	/* Whether worker i is pinned to CPU i. */
+	bool pinned;
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4300,6 +4414,11 @@ static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue)
 	return queue->thread_id;
 }
 
+static inline struct k_work_q *k_work_q_pool_queue(struct k_work_q_pool *pool)
+{
+	return &pool->queue;
+}
+
 /** @} */
 
 struct k_work_user;
@@ -4662,6 +4781,19 @@ struct k_msgq {
 	/** Message queue */
 	uint8_t flags;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	/** Per-slot sequence numbers of a lock-free queue */
+	atomic_t *seq;
+	/** Position of the next message to be written */
+	atomic_t put_pos;
+	/** Position of the next message to be read */
+	atomic_t get_pos;
+	/** Messages published and not claimed by a reader yet */
+	atomic_t published;
+	/** Threads (and pollers) that must be woken up on progress */
+	atomic_t waiters;
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_msgq)
 
 #ifdef CONFIG_OBJ_CORE_MSGQ
@@ -4688,12 +4820,42 @@ struct k_msgq {
 	.flags = 0, \
 	}
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+#define Z_MSGQ_LOCKFREE_INITIALIZER(obj, q_buffer, q_seq, q_msg_size, q_max_msgs) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.lock = {}, \
+	.msg_size = q_msg_size, \
+	.max_msgs = q_max_msgs, \
+	.buffer_start = q_buffer, \
+	.buffer_end = q_buffer + (q_max_msgs * q_msg_size), \
+	.read_ptr = q_buffer, \
+	.write_ptr = q_buffer, \
+	.used_msgs = 0, \
+	Z_POLL_EVENT_OBJ_INIT(obj) \
+	.flags = K_MSGQ_FLAG_LOCKFREE, \
+	.seq = q_seq, \
+	}
+
+/*
+ * Number of messages in a lock-free queue, may be stale under contention.
+ * Slots claimed by a writer count once published only, and the count may
+ * transiently drop below zero when a reader claims a message before its
+ * writer accounts it.
+ */
+static inline uint32_t z_msgq_lockfree_used(struct k_msgq *msgq)
+{
+	return CLAMP(atomic_get(&msgq->published), 0, (atomic_val_t)msgq->max_msgs);
+}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_LOCKFREE	BIT(1)
 
 /**
  * @brief Message Queue Attributes
@@ -4750,6 +4912,57 @@ struct k_msgq_attrs {
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs);
 
+/**
+ * @brief Statically define and initialize a lock-free message queue.
+ *
+ * Same as K_MSGQ_DEFINE(), except that the message queue is backed by a
+ * bounded multi-producer multi-consumer ring with a sequence number per
+ * slot. Putting and getting messages do not take the message queue's lock
+ * unless the queue is empty or full and the caller has to wait, or another
+ * thread is waiting on the queue and has to be woken up.
+ *
+ * Messages can only be added to the back of a lock-free message queue,
+ * k_msgq_put_front() fails with -ENOTSUP. A put that is still copying its
+ * message delays the messages queued after it: readers see the queue as
+ * empty until the copy is complete.
+ *
+ * @param q_name Name of the message queue.
+ * @param q_msg_size Message size (in bytes).
+ * @param q_max_msgs Maximum number of messages that can be queued (power of 2).
+ * @param q_align Alignment of the message queue's ring buffer (power of 2).
+ */
+#define K_MSGQ_LOCKFREE_DEFINE(q_name, q_msg_size, q_max_msgs, q_align)	\
+	BUILD_ASSERT(IS_ENABLED(CONFIG_MSGQ_LOCKFREE),			\
+		     "CONFIG_MSGQ_LOCKFREE is required");			\
+	BUILD_ASSERT(IS_POWER_OF_TWO(q_max_msgs),				\
+		     "lock-free message queue length must be a power of 2");	\
+	static char __noinit __aligned(q_align)				\
+		_k_fifo_buf_##q_name[(q_max_msgs) * (q_msg_size)];	\
+	static atomic_t _k_msgq_seq_##q_name[(q_max_msgs)];		\
+	STRUCT_SECTION_ITERABLE(k_msgq, q_name) =			\
+	       Z_MSGQ_LOCKFREE_INITIALIZER(q_name, _k_fifo_buf_##q_name,	\
+					   _k_msgq_seq_##q_name,	\
+					   (q_msg_size), (q_max_msgs))
+
+/**
+ * @brief Initialize a lock-free message queue.
+ *
+ * This routine initializes a message queue object operating in lock-free
+ * mode, prior to its first use. See K_MSGQ_LOCKFREE_DEFINE() for the
+ * behavior of such a queue.
+ *
+ * @param msgq Address of the message queue.
+ * @param buffer Pointer to ring buffer that holds queued messages.
+ * @param seq Array of @a max_msgs sequence numbers, owned by the queue.
+ * @param msg_size Message size (in bytes).
+ * @param max_msgs Maximum number of messages that can be queued (power of 2).
+ *
+ * @retval 0 Message queue initialized.
+ * @retval -EINVAL @a max_msgs is not a power of 2.
+ */
+int k_msgq_lockfree_init(struct k_msgq *msgq, char *buffer, atomic_t *seq,
+			 size_t msg_size, uint32_t max_msgs);
+
 /**
  * @brief Initialize a message queue.
  *
@@ -4830,6 +5043,7 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -ENOTSUP Message queue is a lock-free message queue.
  */
 __syscall int k_msgq_put_front(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
@@ -4926,6 +5140,11 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if ((msgq->flags & K_MSGQ_FLAG_LOCKFREE) != 0U) {
+		return msgq->max_msgs - z_msgq_lockfree_used(msgq);
+	}
+#endif /* CONFIG_MSGQ_LOCKFREE */
 	return msgq->max_msgs - msgq->used_msgs;
 }
 
@@ -4942,6 +5161,11 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if ((msgq->flags & K_MSGQ_FLAG_LOCKFREE) != 0U) {
+		return z_msgq_lockfree_used(msgq);
+	}
+#endif /* CONFIG_MSGQ_LOCKFREE */
 	return msgq->used_msgs;
 }
 
@@ -5448,6 +5672,15 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+/* Per-CPU stack of free blocks, linked through the blocks themselves */
+struct k_mem_slab_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -5455,6 +5688,12 @@ struct k_mem_slab {
 	char *free_list;
 	struct k_mem_slab_info info;
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+	struct k_mem_slab_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+	/* Number of allocations bypassing the per-CPU caches */
+	atomic_t cache_bypass;
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
@@ -5472,6 +5711,24 @@ struct k_mem_slab {
 	.info = {_slab_num_blocks, _slab_block_size, 0}               \
 	}
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+/* Blocks sitting in the per-CPU caches are accounted as used in
+ * slab->info.num_used, as far as the shared free list is concerned.
+ */
+static inline uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+	uint32_t cached = 0U;
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		cached += *(volatile uint32_t *)&slab->cache[i].count;
+	}
+
+	return cached;
+}
+
+/* Number of blocks handed out to users, takes slab->lock */
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab);
+#endif /* CONFIG_MEM_SLAB_CACHE */
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -5662,7 +5919,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CACHE
+	return z_mem_slab_num_used_get(slab);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5697,7 +5958,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -6352,6 +6613,96 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Poll Set
+ *
+ * A set of poll events that stay registered on their objects between
+ * waits. See k_poll_set_init().
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * A poll set is a persistent alternative to k_poll() for event loops that
+ * wait on the same objects over and over. Events are registered once with
+ * k_poll_set_add(), and the kernel queues them on the set's ready list as
+ * their objects are signaled, so that the cost of k_poll_set_wait() depends
+ * on the number of ready events rather than on the number of events in the
+ * set.
+ *
+ * Events in a set are level-triggered: an event returned by
+ * k_poll_set_wait() is returned again by the next wait for as long as its
+ * condition holds, e.g. until the semaphore is taken or the FIFO emptied.
+ *
+ * Poll sets can only be used from supervisor threads.
+ *
+ * @param set The poll set to initialize.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event must have been initialized with k_poll_event_init() or one of
+ * the K_POLL_EVENT_*INITIALIZER() macros, and must not be in use by
+ * k_poll() or another poll set. It stays registered on its object until
+ * it is removed with k_poll_set_remove().
+ *
+ * @param set The poll set.
+ * @param event The event to add.
+ *
+ * @retval 0 Event added.
+ * @retval -EBUSY The event is already in use.
+ */
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * Once this returns, the event is no longer referenced by the kernel and
+ * may be freed or reused.
+ *
+ * @param set The poll set.
+ * @param event The event to remove.
+ *
+ * @retval 0 Event removed.
+ * @retval -EINVAL The event is not in this poll set.
+ */
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * Store pointers to up to @a num_events ready events of the set in
+ * @a events, waiting up to @a timeout for one to become ready. The state
+ * field of each returned event holds its K_POLL_STATE_xxx values. As with
+ * k_poll(), an object being ready is not given to the caller.
+ *
+ * An event cancelled e.g. with k_queue_cancel_wait() is returned once with
+ * K_POLL_STATE_CANCELLED set in its state.
+ *
+ * @param set The poll set.
+ * @param events Array receiving the ready events.
+ * @param num_events Size of the @a events array, must be positive.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @a events, or -EAGAIN if the waiting
+ *         period timed out.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int num_events, k_timeout_t timeout);
+
 /** @} */
 
 /**
@@ -6621,6 +6972,63 @@ void k_sys_runtime_stats_enable(void);
  */
 void k_sys_runtime_stats_disable(void);
 
+/**
+ * @brief Get the scheduling latencies of a priority level
+ *
+ * Requires CONFIG_SCHED_LATENCY_STATS. The latencies are measured from the
+ * time a thread of the priority level is made ready, by a thread or by an
+ * ISR, until it is switched in.
+ *
+ * @param prio Priority level.
+ * @param stats Pointer to struct to copy the histograms into.
+ * @return -EINVAL if null pointer or invalid priority, otherwise 0
+ */
+int k_sched_latency_stats_get(int prio, struct k_sched_latency_stats *stats);
+
+/**
+ * @brief Reset the scheduling latencies of all priority levels
+ *
+ * Requires CONFIG_SCHED_LATENCY_STATS.
+ */
+void k_sched_latency_stats_reset(void);
+
+/**
+ * @brief Get an entry of the lock statistics
+ *
+ * Requires CONFIG_LOCK_STATS. There is one entry for each spinlock or mutex
+ * and call site pair, in a table of CONFIG_LOCK_STATS_ENTRIES entries. The
+ * entry is copied without stopping the CPUs taking the lock, so its fields
+ * may be slightly inconsistent with each other.
+ *
+ * @param index Index of the entry in the table.
+ * @param stats Pointer to struct to copy the entry into, its lock member is
+ *              NULL if the entry is unused.
+ * @return -EINVAL if null pointer, -ENOENT if @p index is past the end of
+ *         the table, otherwise 0
+ */
+int k_lock_stats_get(size_t index, struct k_lock_stats *stats);
+
+/**
+ * @brief Get the number of lock acquisitions not recorded
+ *
+ * Requires CONFIG_LOCK_STATS. Acquisitions are not recorded when their lock
+ * and call site pair does not fit in the table anymore.
+ *
+ * @return Number of acquisitions dropped since the last reset.
+ */
+uint32_t k_lock_stats_dropped(void);
+
+/**
+ * @brief Reset the lock statistics
+ *
+ * Requires CONFIG_LOCK_STATS. The hold times of the locks being held are
+ * not recorded. The entries are not locked against the CPUs updating them,
+ * so an acquisition or release accounted on another CPU during the reset
+ * may be added to the entry of another lock claiming the same slot. Reset
+ * the statistics while the locks of interest are idle for exact counts.
+ */
+void k_lock_stats_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,6 +51,8 @@
 #define K_OBJ_TYPE_MUTEX_ID      K_OBJ_TYPE_ID_GEN("MUTX")
 /** Pipe object type */
 #define K_OBJ_TYPE_PIPE_ID       K_OBJ_TYPE_ID_GEN("PIPE")
+/** Scheduling latency object type */
+#define K_OBJ_TYPE_SCHED_LATENCY_ID K_OBJ_TYPE_ID_GEN("SLAT")
 /** Semaphore object type */
 #define K_OBJ_TYPE_SEM_ID        K_OBJ_TYPE_ID_GEN("SEM4")
 /** Stack object type */
@@ -30,4 +30,60 @@ struct k_cycle_stats {
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) || defined(__DOXYGEN__)
+/**
+ * Log2 histogram of scheduling latencies, in cycles.
+ *
+ * Bucket 0 counts the latencies of 0 cycles, and bucket i the latencies
+ * from 2^(i-1) to 2^i - 1 cycles. The last bucket also counts all the
+ * longer latencies.
+ */
+struct k_sched_latency_histogram {
+	uint64_t  sum;          /**< sum of the latencies in cycles */
+	uint32_t  count;        /**< number of latencies */
+	uint32_t  max;          /**< longest latency in cycles */
+	/** number of latencies of each bucket */
+	uint32_t  buckets[CONFIG_SCHED_LATENCY_STATS_BUCKETS];
+};
+
+/**
+ * Scheduling latencies of the threads of a priority level.
+ */
+struct k_sched_latency_stats {
+	int       prio;         /**< priority level */
+	/** from a thread making the thread ready until it runs */
+	struct k_sched_latency_histogram  wakeup;
+	/** from an ISR making the thread ready until it runs */
+	struct k_sched_latency_histogram  isr;
+};
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
+#if defined(CONFIG_LOCK_STATS) || defined(__DOXYGEN__)
+/** Kind of lock of a lock statistics entry. */
+enum k_lock_stats_type {
+	K_LOCK_STATS_SPINLOCK,  /**< struct k_spinlock */
+	K_LOCK_STATS_MUTEX,     /**< struct k_mutex */
+};
+
+/**
+ * Statistics of a lock taken from one call site.
+ *
+ * An acquisition is contended when the lock was held by another CPU, for
+ * a spinlock, or by another thread, for a mutex. The hold time of a
+ * recursively locked mutex runs from its first lock to its last unlock.
+ */
+struct k_lock_stats {
+	const void *lock;       /**< lock, NULL for an unused entry */
+	/** address right after the call taking the lock */
+	uintptr_t site;
+	enum k_lock_stats_type  type;  /**< kind of lock */
+	uint32_t  acquisitions; /**< \# of times the lock was taken */
+	uint32_t  contended;    /**< \# of acquisitions that had to wait */
+	uint32_t  wait_max;     /**< longest wait in cycles */
+	uint32_t  hold_max;     /**< longest hold in cycles */
+	uint64_t  wait_total;   /**< total wait in cycles */
+	uint64_t  hold_total;   /**< total hold in cycles */
+};
+#endif /* CONFIG_LOCK_STATS */
+
 #endif /* ZEPHYR_INCLUDE_KERNEL_STATS_H_ */
@@ -116,6 +116,11 @@ struct _thread_base {
 	/* CPU index on which thread was last run */
 	uint8_t cpu;
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+	/* CPU index whose run queue holds the thread */
+	uint8_t runq_cpu;
+#endif /* CONFIG_SCHED_WORK_STEALING */
+
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
@@ -147,6 +152,15 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif /* CONFIG_SCHED_THREAD_USAGE */
+
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	/* Cycle count when made ready */
+	uint32_t ready_cycles;
+	/* Made ready and not run since */
+	bool ready_pending;
+	/* Made ready by an ISR */
+	bool ready_in_isr;
+#endif /* CONFIG_SCHED_LATENCY_STATS */
 };
 
 typedef struct _thread_base _thread_base_t;
@@ -157,7 +157,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
 	struct _ready_q ready_q;
 #endif
 
@@ -178,6 +178,11 @@ struct _cpu {
 	uint8_t swap_ok;
 #endif
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+	/* Number of threads taken from the run queue of another CPU */
+	uint32_t steals;
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	/*
 	 * [usage0] is used as a timestamp to mark the beginning of an
@@ -213,7 +218,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_PER_CPU_RUNQ
 	struct _ready_q ready_q;
 #endif
 
@@ -305,6 +310,10 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* CPU whose queue the timeout was last armed on */
+	uint8_t cpu;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
@@ -202,6 +202,12 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** TCP segmentation offload supported, the packets are split in
+	 *  segments of net_pkt_gso_size() payload bytes. Requires
+	 *  ETHERNET_HW_TX_CHKSUM_OFFLOAD.
+	 */
+	ETHERNET_HW_TCP_SEG_OFFLOAD	= BIT(21),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -67,6 +67,8 @@ struct http_resource_desc {
 
 struct http_service_runtime_data {
 	int num_clients;
+	/* Root of the resource lookup trie, 0 if the resources are scanned */
+	uint16_t res_trie;
 };
 
 struct http_service_desc;
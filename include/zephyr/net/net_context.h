@@ -1255,6 +1255,31 @@ int net_context_send(struct net_context *context,
 		     k_timeout_t timeout,
 		     void *user_data);
 
+/**
+ * @brief Send a buffer chain to a peer without copying it.
+ *
+ * @details This function works like net_context_send() but links the
+ * buffers to the outgoing packets instead of copying the data. The context
+ * takes its own references to the buffers, the caller keeps its reference
+ * to the chain. A TCP context queues no more than its send window permits,
+ * so fewer bytes than the chain holds may be sent. Only UDP and TCP
+ * contexts that have their destination set are supported.
+ * Available if @kconfig{CONFIG_NET_SOCKETS_ZEROCOPY} is enabled.
+ *
+ * @param context The network context to use.
+ * @param frags The buffer chain to send
+ * @param cb Caller-supplied callback function.
+ * @param timeout Timeout for the send attempt.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *frags,
+			 net_context_send_cb_t cb,
+			 k_timeout_t timeout,
+			 void *user_data);
+
 /**
  * @brief Send data to a peer specified by address.
  *
@@ -175,6 +175,15 @@ static inline int net_send_data(struct net_pkt *pkt)
 #define NET_TC_COUNT 0
 #endif /* CONFIG_NET_TC_TX_COUNT && CONFIG_NET_TC_RX_COUNT */
 
+/* The best effort traffic class can be spread over several RX queues, the
+ * extra ones are numbered after the traffic classes.
+ */
+#if defined(CONFIG_NET_TC_RX_RSS_QUEUES) && CONFIG_NET_TC_RX_RSS_QUEUES > 1 && NET_TC_RX_COUNT > 0
+#define NET_TC_RX_QUEUE_COUNT (NET_TC_RX_COUNT + CONFIG_NET_TC_RX_RSS_QUEUES - 1)
+#else
+#define NET_TC_RX_QUEUE_COUNT NET_TC_RX_COUNT
+#endif
+
 /**
  * @brief Registration information for a given L3 handler. Note that
  *        the layer number (L3) just refers to something that is on top
@@ -632,7 +632,8 @@ struct net_traffic_class {
 	struct k_fifo fifo;
 
 #if NET_TC_COUNT > 1 || defined(CONFIG_NET_TC_TX_SKIP_FOR_HIGH_PRIO) \
-	|| defined(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO)
+	|| defined(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO) \
+	|| (defined(CONFIG_NET_TC_RX_RSS_QUEUES) && CONFIG_NET_TC_RX_RSS_QUEUES > 1)
 	/** Semaphore for tracking the available slots in the fifo */
 	struct k_sem fifo_slot;
 #endif
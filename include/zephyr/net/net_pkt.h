@@ -360,6 +360,16 @@ struct net_pkt {
 	uint8_t ipv4_pmtu : 1;
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_TCP_GRO)
+	/* Coalesced TCP segments, their checksums are already verified */
+	uint8_t tcp_gro : 1;
+#endif /* CONFIG_NET_TCP_GRO */
+
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Payload size of the TCP segments this packet is to be split in */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 	/* @endcond */
 };
 
@@ -1047,6 +1057,56 @@ static inline void net_pkt_set_ip_reassembled(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IP_FRAGMENT */
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else /* CONFIG_NET_TCP_GSO */
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+#if defined(CONFIG_NET_TCP_GRO)
+static inline bool net_pkt_is_tcp_gro(struct net_pkt *pkt)
+{
+	return !!(pkt->tcp_gro);
+}
+
+static inline void net_pkt_set_tcp_gro(struct net_pkt *pkt, bool is_gro)
+{
+	pkt->tcp_gro = is_gro;
+}
+#else /* CONFIG_NET_TCP_GRO */
+static inline bool net_pkt_is_tcp_gro(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+
+static inline void net_pkt_set_tcp_gro(struct net_pkt *pkt, bool is_gro)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(is_gro);
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 static inline uint8_t net_pkt_priority(struct net_pkt *pkt)
 {
 	return pkt->priority;
@@ -2361,6 +2421,24 @@ struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt,
  */
 int net_pkt_read(struct net_pkt *pkt, void *data, size_t length);
 
+/**
+ * @brief Read some data from a net_pkt and checksum it in the same pass
+ *
+ * @details Works like net_pkt_read(), and adds the data to the Internet
+ *          checksum in sum while it is being copied. The sum is the
+ *          ones' complement sum in host byte order, not yet complemented.
+ *          The data is summed as if it started at an even offset, so all
+ *          but the last of consecutive calls should use an even length.
+ *
+ * @param pkt    The network packet from where to read some data
+ * @param data   The destination buffer where to copy the data
+ * @param length The amount of data to copy
+ * @param sum    The checksum to add the data to
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_read_chksum(struct net_pkt *pkt, void *data, size_t length, uint16_t *sum);
+
 /**
  * @brief Read a byte (uint8_t) from a net_pkt
  *
@@ -2435,6 +2513,24 @@ int net_pkt_read_be32(struct net_pkt *pkt, uint32_t *data);
  */
 int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length);
 
+/**
+ * @brief Write data into a net_pkt and checksum it in the same pass
+ *
+ * @details Works like net_pkt_write(), and adds the data to the Internet
+ *          checksum in sum while it is being copied. The sum is the
+ *          ones' complement sum in host byte order, not yet complemented.
+ *          The data is summed as if it started at an even offset, so all
+ *          but the last of consecutive calls should use an even length.
+ *
+ * @param pkt    The network packet where to write
+ * @param data   Data to be written
+ * @param length Length of the data to be written
+ * @param sum    The checksum to add the data to
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length, uint16_t *sum);
+
 /**
  * @brief Write a byte (uint8_t) data to a net_pkt
  *
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROMETHEUS_SCHED_LATENCY_H_
+#define ZEPHYR_INCLUDE_PROMETHEUS_SCHED_LATENCY_H_
+
+/**
+ * @file
+ *
+ * @brief Prometheus export of the scheduling latencies.
+ *
+ * @addtogroup prometheus
+ * @{
+ */
+
+#include <zephyr/net/prometheus/collector.h>
+
+/**
+ * @brief Collector of the scheduling latency histograms
+ *
+ * Available with CONFIG_PROMETHEUS_SCHED_LATENCY. It holds two histograms per
+ * priority level, in seconds, named
+ * @c k_sched_wakeup_latency_seconds_prio_<prio> and
+ * @c k_sched_isr_latency_seconds_prio_<prio>, where a negative priority is
+ * written @c neg<n>. The levels without samples are skipped when scraping.
+ *
+ * Example usage:
+ * @code{.c}
+ *
+ * ret = prometheus_format_exposition(&prometheus_sched_latency, buffer, sizeof(buffer));
+ *
+ * @endcode
+ */
+extern struct prometheus_collector prometheus_sched_latency;
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_PROMETHEUS_SCHED_LATENCY_H_ */
@@ -77,6 +77,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: block only until the first message has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -511,6 +513,24 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * Sends up to @p vlen messages with a single call, as if zsock_sendmsg()
+ * was called for each of them in turn, but looking up the socket and
+ * taking its lock only once. The number of bytes sent for each message is
+ * stored in its @c msg_len field.
+ * See Linux manual page sendmmsg(2) for a description of the interface.
+ * This function is also exposed as `sendmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @return Number of messages sent, or -1 with errno set if none could be
+ *         sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -537,6 +557,28 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * Receives up to @p vlen messages with a single call, as if zsock_recvmsg()
+ * was called for each of them in turn, but looking up the socket and
+ * taking its lock only once. The number of bytes received for each message
+ * is stored in its @c msg_len field. With ZSOCK_MSG_WAITFORONE set in
+ * @p flags, only the first message is waited for. As on Linux, the
+ * @p timeout is checked only after each received message, once it has
+ * expired only the messages already queued are still returned.
+ * See Linux manual page recvmmsg(2) for a description of the interface.
+ * This function is also exposed as `recvmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @return Number of messages received, or -1 with errno set if none could
+ *         be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags,
+			     const struct timespec *timeout);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -553,6 +595,63 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_buf;
+
+/**
+ * @brief Receive data from a socket without copying it
+ *
+ * @details
+ * Hands over the next received datagram, or for a stream socket the data of
+ * the next received segment, as a chain of the network buffers it was
+ * received in. The caller owns the chain and must release it with
+ * zsock_buf_release() once done, until then the buffers are not available
+ * for receiving other data. Blocking and the ZSOCK_MSG_DONTWAIT flag work
+ * as with zsock_recv(). The function can only be called from supervisor
+ * threads.
+ * Available if @kconfig{CONFIG_NET_SOCKETS_ZEROCOPY} is enabled.
+ *
+ * @param sock Socket to receive from.
+ * @param frags Set to the received buffer chain, or NULL when 0 is returned.
+ * @param flags ZSOCK_MSG_DONTWAIT or 0.
+ *
+ * @return Number of bytes in the chain, 0 at the end of a stream, or -1
+ *         with errno set on error.
+ */
+ssize_t zsock_recv_buf(int sock, struct net_buf **frags, int flags);
+
+/**
+ * @brief Send data on a connected socket without copying it
+ *
+ * @details
+ * Takes the data of the buffer chain into the socket as it is, instead of
+ * copying it into newly allocated buffers. The socket takes its own
+ * references to the buffers and releases them once the data has been sent,
+ * or acknowledged for a stream socket, so the caller always keeps its
+ * reference to the chain and releases it when done. The sent data must not
+ * be modified anymore. As with zsock_send(), a stream socket may send fewer
+ * bytes than the chain holds when its send window is full, the caller can
+ * then pull the sent bytes from the chain and send the rest. Buffers with
+ * external data, see net_buf_alloc_with_data(), can be used to send data
+ * from flash or other memory without copying it at all. Blocking and the
+ * ZSOCK_MSG_DONTWAIT flag work as with zsock_send(). The function can only
+ * be called from supervisor threads.
+ * Available if @kconfig{CONFIG_NET_SOCKETS_ZEROCOPY} is enabled.
+ *
+ * @param sock Connected UDP or TCP socket to send on.
+ * @param frags Buffer chain with the data to send.
+ * @param flags ZSOCK_MSG_DONTWAIT or 0.
+ *
+ * @return Number of bytes sent, or -1 with errno set on error.
+ */
+ssize_t zsock_send_buf(int sock, struct net_buf *frags, int flags);
+
+/**
+ * @brief Release a buffer chain received with zsock_recv_buf()
+ *
+ * @param frags Buffer chain to release, can be NULL.
+ */
+void zsock_buf_release(struct net_buf *frags);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -959,6 +1058,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm name (string) */
+#define TCP_CONGESTION 5
 
 /** @} */
 
@@ -1239,6 +1340,10 @@ struct socket_op_vtable {
 			   socklen_t *addrlen);
 	int (*getsockname)(void *obj, struct sockaddr *addr,
 			   socklen_t *addrlen);
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	ssize_t (*recv_buf)(void *obj, struct net_buf **frags, int flags);
+	ssize_t (*send_buf)(void *obj, struct net_buf *frags, int flags);
+#endif
 };
 
 /** @endcond */
@@ -35,6 +35,8 @@ struct z_spinlock_key {
 	int key;
 };
 
+struct z_lock_stats_entry;
+
 /**
  * @brief Kernel Spin Lock
  *
@@ -78,6 +80,14 @@ struct k_spinlock {
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_LOCK_STATS
+	/* Statistics of the place the lock was taken from, NULL if not
+	 * tracked, and the time (in cycles) when it was taken
+	 */
+	struct z_lock_stats_entry *stats_entry;
+	uint32_t stats_time;
+#endif /* CONFIG_LOCK_STATS */
+
 #if defined(CONFIG_CPP) && !defined(CONFIG_SMP) && \
 	!defined(CONFIG_SPIN_VALIDATE)
 	/* If CONFIG_SMP and CONFIG_SPIN_VALIDATE are both not defined
@@ -116,6 +126,12 @@ bool z_spin_lock_mem_coherent(struct k_spinlock *l);
 
 #endif /* CONFIG_SPIN_VALIDATE */
 
+bool z_lock_stats_now(uint32_t *now);
+#ifdef CONFIG_LOCK_STATS
+void z_spin_lock_stats_acquired(struct k_spinlock *l, uint32_t start, bool contended);
+void z_spin_unlock_stats(struct k_spinlock *l);
+#endif /* CONFIG_LOCK_STATS */
+
 /**
  * @brief Spinlock key type
  *
@@ -151,6 +167,42 @@ static ALWAYS_INLINE void z_spinlock_validate_post(struct k_spinlock *l)
 #endif /* CONFIG_SPIN_VALIDATE */
 }
 
+static ALWAYS_INLINE bool z_spinlock_stats_pre(uint32_t *start)
+{
+#ifdef CONFIG_LOCK_STATS
+	return z_lock_stats_now(start);
+#else
+	*start = 0U;
+	return false;
+#endif /* CONFIG_LOCK_STATS */
+}
+
+/* Always inlined, so that the statistics are accounted to the caller of
+ * k_spin_lock(), found from the return address of the call below. A lock
+ * not tracked keeps the NULL entry left by its last release.
+ */
+static ALWAYS_INLINE void z_spinlock_stats_post(struct k_spinlock *l, bool tracked,
+						uint32_t start, bool contended)
+{
+	ARG_UNUSED(l);
+	ARG_UNUSED(tracked);
+	ARG_UNUSED(start);
+	ARG_UNUSED(contended);
+#ifdef CONFIG_LOCK_STATS
+	if (tracked) {
+		z_spin_lock_stats_acquired(l, start, contended);
+	}
+#endif /* CONFIG_LOCK_STATS */
+}
+
+static ALWAYS_INLINE void z_spinlock_stats_release(struct k_spinlock *l)
+{
+	ARG_UNUSED(l);
+#ifdef CONFIG_LOCK_STATS
+	z_spin_unlock_stats(l);
+#endif /* CONFIG_LOCK_STATS */
+}
+
 /**
  * @brief Lock a spinlock
  *
@@ -194,6 +246,11 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	k.key = arch_irq_lock();
 
 	z_spinlock_validate_pre(l);
+
+	uint32_t start;
+	bool tracked = z_spinlock_stats_pre(&start);
+	bool contended = false;
+
 #ifdef CONFIG_SMP
 #ifdef CONFIG_TICKET_SPINLOCKS
 	/*
@@ -203,15 +260,18 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	atomic_val_t ticket = atomic_inc(&l->tail);
 	/* Spin until our ticket is served */
 	while (atomic_get(&l->owner) != ticket) {
+		contended = true;
 		arch_spin_relax();
 	}
 #else
 	while (!atomic_cas(&l->locked, 0, 1)) {
+		contended = true;
 		arch_spin_relax();
 	}
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
+	z_spinlock_stats_post(l, tracked, start, contended);
 
 	return k;
 }
@@ -235,6 +295,10 @@ static ALWAYS_INLINE int k_spin_trylock(struct k_spinlock *l, k_spinlock_key_t *
 	int key = arch_irq_lock();
 
 	z_spinlock_validate_pre(l);
+
+	uint32_t start;
+	bool tracked = z_spinlock_stats_pre(&start);
+
 #ifdef CONFIG_SMP
 #ifdef CONFIG_TICKET_SPINLOCKS
 	/*
@@ -267,6 +331,7 @@ static ALWAYS_INLINE int k_spin_trylock(struct k_spinlock *l, k_spinlock_key_t *
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
+	z_spinlock_stats_post(l, tracked, start, false);
 
 	k->key = key;
 
@@ -315,6 +380,7 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 		 l, delta, CONFIG_SPIN_LOCK_TIME_LIMIT);
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
+	z_spinlock_stats_release(l);
 
 #ifdef CONFIG_SMP
 #ifdef CONFIG_TICKET_SPINLOCKS
@@ -365,6 +431,7 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 #ifdef CONFIG_SPIN_VALIDATE
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
+	z_spinlock_stats_release(l);
 #ifdef CONFIG_SMP
 #ifdef CONFIG_TICKET_SPINLOCKS
 	(void)atomic_inc(&l->owner);
@@ -33,11 +33,13 @@ extern "C" {
  * free by user pointer and not an opaque block handle.
  *
  * Good fragmentation resistance.  Freed blocks are always immediately
- * merged with adjacent free blocks.  Allocations are attempted from a
- * sample of the smallest bucket that might fit, falling back rapidly
- * to the smallest block guaranteed to fit.  Split memory remaining in
- * the chunk is always returned immediately to the heap for other
- * allocation.
+ * merged with adjacent free blocks (with CONFIG_SYS_HEAP_SIZE_CLASSES,
+ * small blocks that have no free neighbor are instead kept for reuse
+ * by allocations of the same size, until a neighbor is freed).
+ * Allocations are attempted from a sample of the smallest bucket that
+ * might fit, falling back rapidly to the smallest block guaranteed to
+ * fit.  Split memory remaining in the chunk is always returned
+ * immediately to the heap for other allocation.
  *
  * Excellent performance with firmly bounded runtime.  All operations
  * are constant time (though there is a search of the smallest bucket
@@ -54,10 +56,21 @@ extern "C" {
  * put the two values somewhere else, though it would make
  * SYS_HEAP_DEFINE a little hairy to write.
  */
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* One list of cached free chunks per chunk size, in 8 byte units, up to
+ * CONFIG_SYS_HEAP_SIZE_CLASS_MAX bytes plus the chunk header.
+ */
+#define Z_HEAP_SIZE_CLASS_COUNT ((CONFIG_SYS_HEAP_SIZE_CLASS_MAX + 15U) / 8U + 1U)
+#endif
+
 struct sys_heap {
 	struct z_heap *heap;
 	void *init_mem;
 	size_t init_bytes;
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Kept out of the heap memory so as not to reduce its capacity */
+	uint32_t size_classes[Z_HEAP_SIZE_CLASS_COUNT];
+#endif
 };
 
 struct z_heap_stress_result {
@@ -23,8 +23,9 @@ void flag_ipi(uint32_t ipi_mask);
 void signal_pending_ipi(void);
 atomic_val_t ipi_mask_create(struct k_thread *thread);
 #else
-#define flag_ipi(ipi_mask) do { } while (false)
+#define flag_ipi(ipi_mask) ARG_UNUSED(ipi_mask)
 #define signal_pending_ipi() do { } while (false)
+#define ipi_mask_create(thread) ((atomic_val_t)0)
 #endif /* CONFIG_SMP */
 
 
@@ -220,6 +220,26 @@ void z_mem_manage_boot_finish(void);
 
 bool z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state);
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+/* Called by k_poll(), with its lock held, before it checks a message queue
+ * for data
+ */
+void z_msgq_poll_register(struct k_msgq *msgq);
+
+/* Called by z_msgq_poll_done(), with the k_poll() lock held, once no event
+ * is registered on a message queue anymore
+ */
+void z_msgq_poll_unregister(struct k_msgq *msgq);
+
+/* Called by a lock-free message queue after notifying its poll events */
+void z_msgq_poll_done(struct k_msgq *msgq);
+#else
+static inline void z_msgq_poll_register(struct k_msgq *msgq)
+{
+	ARG_UNUSED(msgq);
+}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 #ifdef CONFIG_PM
 
 /* When the kernel is about to go idle, it calls this function to notify the
@@ -304,6 +324,42 @@ void k_thread_abort_cleanup(struct k_thread *thread);
 void k_thread_abort_cleanup_check_reuse(struct k_thread *thread);
 #endif /* CONFIG_THREAD_ABORT_NEED_CLEANUP */
 
+#ifdef CONFIG_LOCK_STATS
+/**
+ * Account a mutex being locked by the current thread, not recursively, if
+ * z_lock_stats_now() returned true when it was requested.
+ *
+ * @param mutex Mutex locked.
+ * @param site Return address of the call to k_mutex_lock().
+ * @param start Time in cycles when k_mutex_lock() was called, from
+ *              z_lock_stats_now().
+ * @param contended True if another thread held the mutex then.
+ */
+void z_mutex_stats_acquired(struct k_mutex *mutex, uintptr_t site, uint32_t start,
+			    bool contended);
+
+/**
+ * Account a mutex being unlocked by the current thread, not recursively.
+ *
+ * @param mutex Mutex unlocked.
+ */
+void z_mutex_stats_release(struct k_mutex *mutex);
+#else
+static inline void z_mutex_stats_acquired(struct k_mutex *mutex, uintptr_t site,
+					  uint32_t start, bool contended)
+{
+	ARG_UNUSED(mutex);
+	ARG_UNUSED(site);
+	ARG_UNUSED(start);
+	ARG_UNUSED(contended);
+}
+
+static inline void z_mutex_stats_release(struct k_mutex *mutex)
+{
+	ARG_UNUSED(mutex);
+}
+#endif /* CONFIG_LOCK_STATS */
+
 #ifdef __cplusplus
 }
 #endif
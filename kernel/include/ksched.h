@@ -227,11 +227,39 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data);
  */
 void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 
+#ifdef CONFIG_EVENTS
+/**
+ * Wakes a list of threads
+ *
+ * Batched version of z_sched_wake_thread() for the threads linked through
+ * their next_event_link field, starting with head.  All of them are made
+ * ready under a single hold of the scheduler lock, with one update of the
+ * next thread to run and one set of IPIs.
+ *
+ * @param head First thread of the list, may be NULL.
+ */
+void z_sched_wake_event_threads(struct k_thread *head);
+#endif /* CONFIG_EVENTS */
+
+/**
+ * Wake up all threads pending on the provided wait queue at once
+ *
+ * Unlike calling z_sched_wake() until the queue is empty, every thread is
+ * unpended and made ready under a single hold of the scheduler lock.  The
+ * next thread to run is only computed once and the IPIs needed by all the
+ * woken threads are flagged together.
+ *
+ * @param wait_q Wait queue to wake up all threads from
+ * @param swap_retval Swap return value for the woken threads
+ * @param swap_data Data return value to supplement swap_retval. May be NULL.
+ * @return Number of threads woken up
+ */
+int z_ready_threads(_wait_q_t *wait_q, int swap_retval, void *swap_data);
+
 /**
  * Wake up all threads pending on the provided wait queue
  *
- * Convenience function to invoke z_sched_wake() on all threads in the queue
- * until there are no more to wake up.
+ * Convenience wrapper around z_ready_threads().
  *
  * @param wait_q Wait queue to wake up the highest prio thread
  * @param swap_retval Swap return value for woken thread
@@ -242,14 +270,8 @@ void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 static inline bool z_sched_wake_all(_wait_q_t *wait_q, int swap_retval,
 				    void *swap_data)
 {
-	bool woken = false;
-
-	while (z_sched_wake(wait_q, swap_retval, swap_data)) {
-		woken = true;
-	}
-
 	/* True if we woke at least one thread up */
-	return woken;
+	return z_ready_threads(wait_q, swap_retval, swap_data) != 0;
 }
 
 /**
@@ -337,4 +359,32 @@ static inline void z_sched_usage_switch(struct k_thread *thread)
 #endif /* CONFIG_SCHED_THREAD_USAGE */
 }
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+/**
+ * @brief Account the scheduling latency of a thread being switched in
+ *
+ * Called with the scheduler spinlock held, or with local interrupts masked
+ * on uniprocessor systems.
+ */
+void z_sched_latency_switched_in(struct k_thread *thread);
+
+/** @brief Start the scheduling latency of a thread being made ready */
+static inline void z_sched_latency_ready(struct k_thread *thread)
+{
+	thread->base.ready_cycles = k_cycle_get_32();
+	thread->base.ready_pending = true;
+	thread->base.ready_in_isr = k_is_in_isr();
+}
+#else
+static inline void z_sched_latency_switched_in(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+
+static inline void z_sched_latency_ready(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
 #endif /* ZEPHYR_KERNEL_INCLUDE_KSCHED_H_ */
@@ -120,6 +120,9 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 
 	new_thread = z_swap_next_thread();
 
+	/* Also when the thread was made ready again before it switched out */
+	z_sched_latency_switched_in(new_thread);
+
 	if (new_thread != old_thread) {
 		z_sched_usage_switch(new_thread);
 
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/check.h>
+#include <zephyr/llext/symbol.h>
+#include <kernel_internal.h>
+#include <string.h>
+
+#define ENTRIES CONFIG_LOCK_STATS_ENTRIES
+
+/* Bound of the linear probing, to keep the locking time short on a full table */
+#define PROBE_MAX 32
+
+struct z_lock_stats_entry {
+	/* Lock of the entry, claimed with a compare and swap */
+	atomic_ptr_t lock;
+	struct k_lock_stats stats;
+};
+
+/*
+ * The statistics of a lock and call site pair are only updated with the lock
+ * held: by the CPU holding a spinlock, or by the thread owning a mutex. Only
+ * the claim of a free entry has to be atomic, against the other locks hashed
+ * to the same entries.
+ */
+static struct z_lock_stats_entry entries[ENTRIES];
+static atomic_t dropped;
+
+/*
+ * Set while a CPU accounts a spinlock. Reading the cycle counter may take
+ * the spinlock of the timer driver, whose acquisitions are then not tracked
+ * instead of recursing.
+ */
+static bool busy[CONFIG_MP_MAX_NUM_CPUS];
+
+/*
+ * Set once the system timer is initialized. Spinlocks are taken earlier in
+ * the boot, when reading the cycle counter may fault, as on HPET whose
+ * registers are not mapped yet.
+ */
+static bool ready;
+
+static uint32_t entry_hash(const void *lock, uintptr_t site)
+{
+	uint32_t hash = (uint32_t)((uintptr_t)lock ^ (site << 4)) * 2654435761U;
+
+	return hash ^ (hash >> 16);
+}
+
+static struct z_lock_stats_entry *entry_get(void *lock, uintptr_t site,
+					    enum k_lock_stats_type type)
+{
+	uint32_t hash = entry_hash(lock, site);
+
+	for (uint32_t i = 0; i < MIN(PROBE_MAX, ENTRIES); i++) {
+		struct z_lock_stats_entry *entry = &entries[(hash + i) % ENTRIES];
+		void *owner = atomic_ptr_get(&entry->lock);
+
+		if (owner == NULL) {
+			if (!atomic_ptr_cas(&entry->lock, NULL, lock)) {
+				/* Claimed meanwhile for another lock */
+				continue;
+			}
+
+			entry->stats = (struct k_lock_stats){
+				.lock = lock,
+				.site = site,
+				.type = type,
+			};
+
+			return entry;
+		}
+
+		if (owner == lock && entry->stats.site == site) {
+			return entry;
+		}
+	}
+
+	(void)atomic_inc(&dropped);
+
+	return NULL;
+}
+
+static void entry_acquired(struct z_lock_stats_entry *entry, uint32_t wait, bool contended)
+{
+	struct k_lock_stats *stats = &entry->stats;
+
+	stats->acquisitions++;
+	if (contended) {
+		stats->contended++;
+	}
+	stats->wait_total += wait;
+	stats->wait_max = MAX(stats->wait_max, wait);
+}
+
+static void entry_released(struct z_lock_stats_entry *entry, void *lock, uint32_t hold)
+{
+	struct k_lock_stats *stats = &entry->stats;
+
+	if (atomic_ptr_get(&entry->lock) != lock) {
+		/* Reset while the lock was held */
+		return;
+	}
+
+	stats->hold_total += hold;
+	stats->hold_max = MAX(stats->hold_max, hold);
+}
+
+/* Time when a lock is requested, false if the acquisition is not tracked */
+bool z_lock_stats_now(uint32_t *now)
+{
+	unsigned int key;
+	bool *cpu_busy;
+	bool tracked = false;
+
+	*now = 0U;
+
+	if (!ready) {
+		return false;
+	}
+
+	/* Not migrated to another CPU, when called by k_mutex_lock() */
+	key = arch_irq_lock();
+
+	cpu_busy = &busy[_current_cpu->id];
+	if (!*cpu_busy) {
+		*cpu_busy = true;
+		*now = k_cycle_get_32();
+		*cpu_busy = false;
+		tracked = true;
+	}
+
+	arch_irq_unlock(key);
+
+	return tracked;
+}
+EXPORT_SYMBOL(z_lock_stats_now);
+
+/* Called from k_spin_lock() inlined in its caller, so that the return
+ * address is the call site.
+ */
+void z_spin_lock_stats_acquired(struct k_spinlock *l, uint32_t start, bool contended)
+{
+	uintptr_t site = (uintptr_t)__builtin_return_address(0);
+	bool *cpu_busy = &busy[_current_cpu->id];
+	uint32_t now;
+
+	l->stats_entry = NULL;
+
+	if (*cpu_busy) {
+		return;
+	}
+
+	*cpu_busy = true;
+	now = k_cycle_get_32();
+	l->stats_entry = entry_get(l, site, K_LOCK_STATS_SPINLOCK);
+	if (l->stats_entry != NULL) {
+		entry_acquired(l->stats_entry, now - start, contended);
+	}
+	l->stats_time = now;
+	*cpu_busy = false;
+}
+EXPORT_SYMBOL(z_spin_lock_stats_acquired);
+
+void z_spin_unlock_stats(struct k_spinlock *l)
+{
+	struct z_lock_stats_entry *entry = l->stats_entry;
+	bool *cpu_busy;
+	uint32_t hold;
+
+	if (entry == NULL) {
+		return;
+	}
+
+	l->stats_entry = NULL;
+
+	cpu_busy = &busy[_current_cpu->id];
+	*cpu_busy = true;
+	hold = k_cycle_get_32() - l->stats_time;
+	*cpu_busy = false;
+
+	entry_released(entry, l, hold);
+}
+EXPORT_SYMBOL(z_spin_unlock_stats);
+
+void z_mutex_stats_acquired(struct k_mutex *mutex, uintptr_t site, uint32_t start,
+			    bool contended)
+{
+	uint32_t now = k_cycle_get_32();
+
+	mutex->stats_entry = entry_get(mutex, site, K_LOCK_STATS_MUTEX);
+	if (mutex->stats_entry != NULL) {
+		entry_acquired(mutex->stats_entry, now - start, contended);
+	}
+	mutex->stats_time = now;
+}
+
+void z_mutex_stats_release(struct k_mutex *mutex)
+{
+	struct z_lock_stats_entry *entry = mutex->stats_entry;
+
+	if (entry == NULL) {
+		return;
+	}
+
+	mutex->stats_entry = NULL;
+	entry_released(entry, mutex, k_cycle_get_32() - mutex->stats_time);
+}
+
+int k_lock_stats_get(size_t index, struct k_lock_stats *stats)
+{
+	CHECKIF(stats == NULL) {
+		return -EINVAL;
+	}
+
+	if (index >= ENTRIES) {
+		return -ENOENT;
+	}
+
+	if (atomic_ptr_get(&entries[index].lock) == NULL) {
+		memset(stats, 0, sizeof(*stats));
+	} else {
+		*stats = entries[index].stats;
+	}
+
+	return 0;
+}
+
+uint32_t k_lock_stats_dropped(void)
+{
+	return (uint32_t)atomic_get(&dropped);
+}
+
+void k_lock_stats_reset(void)
+{
+	/* The counters are cleared when an entry is claimed again */
+	for (size_t i = 0; i < ENTRIES; i++) {
+		(void)atomic_ptr_clear(&entries[i].lock);
+	}
+
+	(void)atomic_clear(&dropped);
+}
+
+static int lock_stats_init(void)
+{
+	ready = true;
+
+	return 0;
+}
+
+/* The system timer is initialized at PRE_KERNEL_2, or early in POST_KERNEL */
+SYS_INIT(lock_stats_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
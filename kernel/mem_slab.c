@@ -18,6 +18,33 @@
 #include <ksched.h>
 #include <wait_q.h>
 
+/* Number of blocks handed out to users, the caller holds slab->lock */
+static inline uint32_t slab_num_used(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_CACHE
+	/* Cache counts drop and grow under their own lock only, so a block
+	 * moving between two caches while they are summed may be seen twice.
+	 */
+	uint32_t cached = z_mem_slab_num_cached(slab);
+
+	return (cached < slab->info.num_used) ? (slab->info.num_used - cached) : 0U;
+#else
+	return slab->info.num_used;
+#endif /* CONFIG_MEM_SLAB_CACHE */
+}
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t used = slab_num_used(slab);
+
+	k_spin_unlock(&slab->lock, key);
+
+	return used;
+}
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 static struct k_obj_type obj_type_mem_slab;
 
@@ -33,6 +60,7 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+	((struct k_mem_slab_info *)stats)->num_used = slab_num_used(slab);
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -48,9 +76,9 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	ptr->free_bytes = (slab->info.num_blocks - slab_num_used(slab)) *
 			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->allocated_bytes = slab_num_used(slab) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -183,6 +211,10 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+#ifdef CONFIG_MEM_SLAB_CACHE
+	memset(slab->cache, 0, sizeof(slab->cache));
+	atomic_clear(&slab->cache_bypass);
+#endif /* CONFIG_MEM_SLAB_CACHE */
 
 	rc = create_free_list(slab);
 	if (rc < 0) {
@@ -219,7 +251,150 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 	       ((offset % slab->info.block_size) == 0);
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+#ifdef CONFIG_MEM_SLAB_CACHE
+#define CACHE_BATCH CONFIG_MEM_SLAB_CACHE_BATCH
+
+/* Lock order is cache->lock, then slab->lock. The cache of the current
+ * CPU is only locked by another CPU to reclaim its blocks, so migrating
+ * after picking it is harmless: the lock is then merely shared.
+ */
+static inline struct k_mem_slab_cache *cache_get(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_SMP
+	return &slab->cache[arch_curr_cpu()->id];
+#else
+	return &slab->cache[0];
+#endif /* CONFIG_SMP */
+}
+
+/* Detach up to @a max blocks from the head of @a list, returns the count */
+static uint32_t blocks_take(char **list, char **head, uint32_t max)
+{
+	char *tail = *list;
+	uint32_t n = 1U;
+
+	if (tail == NULL) {
+		*head = NULL;
+		return 0U;
+	}
+
+	while ((n < max) && (*(char **)tail != NULL)) {
+		tail = *(char **)tail;
+		n++;
+	}
+
+	*head = *list;
+	*list = *(char **)tail;
+	*(char **)tail = NULL;
+
+	return n;
+}
+
+/* Prepend the @a n blocks of the NULL-terminated @a head to @a list */
+static void blocks_put(char **list, char *head, uint32_t n)
+{
+	char *tail = head;
+
+	while (--n > 0U) {
+		tail = *(char **)tail;
+	}
+
+	*(char **)tail = *list;
+	*list = head;
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct k_mem_slab_cache *cache = cache_get(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	/* Do not hoard blocks while another allocation is starving */
+	if ((cache->count == 0U) && (atomic_get(&slab->cache_bypass) == 0)) {
+		k_spinlock_key_t slab_key = k_spin_lock(&slab->lock);
+		uint32_t n = blocks_take(&slab->free_list, &cache->free_list,
+					 CACHE_BATCH);
+
+		/* Cached blocks count as used for the shared free list */
+		slab->info.num_used += n;
+		cache->count = n;
+		k_spin_unlock(&slab->lock, slab_key);
+	}
+
+	if (cache->count == 0U) {
+		k_spin_unlock(&cache->lock, key);
+		return false;
+	}
+
+	*mem = cache->free_list;
+	cache->free_list = *(char **)(cache->free_list);
+	cache->count--;
+	__ASSERT((cache->free_list == NULL && cache->count == 0U) ||
+		 slab_ptr_is_good(slab, cache->free_list),
+		 "slab corruption detected");
+
+	k_spin_unlock(&cache->lock, key);
+
+	return true;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	struct k_mem_slab_cache *cache = cache_get(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	/* An allocation is starving (maybe pending): give the block to it */
+	if (atomic_get(&slab->cache_bypass) != 0) {
+		k_spin_unlock(&cache->lock, key);
+		return false;
+	}
+
+	*(char **)mem = cache->free_list;
+	cache->free_list = mem;
+	cache->count++;
+
+	if (cache->count >= 2U * CACHE_BATCH) {
+		k_spinlock_key_t slab_key = k_spin_lock(&slab->lock);
+		char *head;
+		uint32_t n = blocks_take(&cache->free_list, &head, CACHE_BATCH);
+
+		blocks_put(&slab->free_list, head, n);
+		slab->info.num_used -= n;
+		cache->count -= n;
+		k_spin_unlock(&slab->lock, slab_key);
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return true;
+}
+
+/* Return the blocks of every CPU cache to the shared free list. Once
+ * cache_bypass is raised, the caches are neither refilled nor fed by
+ * frees, so they stay empty until the starving allocation is done.
+ */
+static void cache_reclaim(struct k_mem_slab *slab)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct k_mem_slab_cache *cache = &slab->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		if (cache->count != 0U) {
+			k_spinlock_key_t slab_key = k_spin_lock(&slab->lock);
+
+			blocks_put(&slab->free_list, cache->free_list, cache->count);
+			slab->info.num_used -= cache->count;
+			cache->free_list = NULL;
+			cache->count = 0U;
+			k_spin_unlock(&slab->lock, slab_key);
+		}
+
+		k_spin_unlock(&cache->lock, key);
+	}
+}
+
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
+static int slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
@@ -268,6 +443,28 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 	return result;
 }
 
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+#ifdef CONFIG_MEM_SLAB_CACHE
+	int result;
+
+	if (cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+
+	atomic_inc(&slab->cache_bypass);
+	cache_reclaim(slab);
+	result = slab_alloc(slab, mem, timeout);
+	atomic_dec(&slab->cache_bypass);
+
+	return result;
+#else
+	return slab_alloc(slab, mem, timeout);
+#endif /* CONFIG_MEM_SLAB_CACHE */
+}
+
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 {
 	if (!slab_ptr_is_good(slab, mem)) {
@@ -276,6 +473,14 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		return;
 	}
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
@@ -308,8 +513,8 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	stats->allocated_bytes = slab_num_used(slab) * slab->info.block_size;
+	stats->free_bytes = (slab->info.num_blocks - slab_num_used(slab)) *
 			    slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
@@ -40,6 +40,300 @@ static inline bool handle_poll_events(struct k_msgq *msgq)
 #endif /* CONFIG_POLL */
 }
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+/*
+ * Lock-free message queues are bounded MPMC rings (Vyukov): every slot has
+ * a sequence number telling whether it may be written for a given put
+ * position or read for a given get position. Producers and consumers claim
+ * positions with a CAS and publish the slot by advancing its sequence
+ * number, the queue lock is only taken to pend and to wake up threads.
+ *
+ * A thread about to pend increments msgq->waiters under the lock and then
+ * retries its operation once more. Every successful operation reads
+ * msgq->waiters after publishing its slot, so either the retry succeeds or
+ * the other side sees the waiter and wakes up the wait queue. Woken threads
+ * just retry, which is why the whole wait queue is woken at once: readers
+ * and writers may transiently share it.
+ */
+
+/* Set while a queue is polled, keeps it on the notification path */
+#define LF_WAITERS_POLLED BIT(30)
+
+static inline bool is_lockfree(struct k_msgq *msgq)
+{
+	return (msgq->flags & K_MSGQ_FLAG_LOCKFREE) != 0U;
+}
+
+static inline atomic_val_t lf_pos_add(atomic_val_t pos, unsigned long n)
+{
+	return (atomic_val_t)((unsigned long)pos + n);
+}
+
+static inline atomic_val_t lf_diff(atomic_val_t a, atomic_val_t b)
+{
+	return (atomic_val_t)((unsigned long)a - (unsigned long)b);
+}
+
+static inline uint32_t lf_idx(struct k_msgq *msgq, atomic_val_t pos)
+{
+	return (uint32_t)pos & (msgq->max_msgs - 1U);
+}
+
+static inline char *lf_slot(struct k_msgq *msgq, uint32_t idx)
+{
+	return msgq->buffer_start + (idx * msgq->msg_size);
+}
+
+/*
+ * Sequence numbers are stored relative to their slot index so that a zeroed
+ * array describes an empty ring, which is what K_MSGQ_LOCKFREE_DEFINE() gets.
+ */
+static inline atomic_val_t lf_seq_get(struct k_msgq *msgq, uint32_t idx)
+{
+	return lf_pos_add(atomic_get(&msgq->seq[idx]), idx);
+}
+
+static inline void lf_seq_set(struct k_msgq *msgq, uint32_t idx, atomic_val_t seq)
+{
+	(void)atomic_set(&msgq->seq[idx], lf_diff(seq, idx));
+}
+
+static bool lf_put(struct k_msgq *msgq, const void *data)
+{
+	atomic_val_t pos = atomic_get(&msgq->put_pos);
+	atomic_val_t dif;
+	uint32_t idx;
+
+	for (;;) {
+		idx = lf_idx(msgq, pos);
+		dif = lf_diff(lf_seq_get(msgq, idx), pos);
+		if (dif == 0) {
+			if (atomic_cas(&msgq->put_pos, pos, lf_pos_add(pos, 1))) {
+				break;
+			}
+		} else if (dif < 0) {
+			/* slot still holds a message from the previous lap */
+			return false;
+		} else {
+			/* another producer claimed this position */
+		}
+		pos = atomic_get(&msgq->put_pos);
+	}
+
+	(void)memcpy(lf_slot(msgq, idx), data, msgq->msg_size);
+	lf_seq_set(msgq, idx, lf_pos_add(pos, 1));
+	(void)atomic_inc(&msgq->published);
+
+	return true;
+}
+
+static bool lf_get(struct k_msgq *msgq, void *data)
+{
+	atomic_val_t pos = atomic_get(&msgq->get_pos);
+	atomic_val_t dif;
+	uint32_t idx;
+
+	for (;;) {
+		idx = lf_idx(msgq, pos);
+		dif = lf_diff(lf_seq_get(msgq, idx), lf_pos_add(pos, 1));
+		if (dif == 0) {
+			if (atomic_cas(&msgq->get_pos, pos, lf_pos_add(pos, 1))) {
+				(void)atomic_dec(&msgq->published);
+				break;
+			}
+		} else if (dif < 0) {
+			/* slot not written yet, queue is empty */
+			return false;
+		} else {
+			/* another consumer claimed this position */
+		}
+		pos = atomic_get(&msgq->get_pos);
+	}
+
+	if (data != NULL) {
+		(void)memcpy(data, lf_slot(msgq, idx), msgq->msg_size);
+	}
+	lf_seq_set(msgq, idx, lf_pos_add(pos, msgq->max_msgs));
+
+	return true;
+}
+
+static int lf_peek(struct k_msgq *msgq, void *data, uint32_t offset)
+{
+	atomic_val_t pos;
+	atomic_val_t seq;
+	atomic_val_t dif;
+	uint32_t idx;
+
+	if (offset >= msgq->max_msgs) {
+		return -ENOMSG;
+	}
+
+	for (;;) {
+		pos = lf_pos_add(atomic_get(&msgq->get_pos), offset);
+		idx = lf_idx(msgq, pos);
+		seq = lf_seq_get(msgq, idx);
+		dif = lf_diff(seq, lf_pos_add(pos, 1));
+		if (dif < 0) {
+			return -ENOMSG;
+		}
+		if (dif > 0) {
+			/* message was read meanwhile, look again */
+			continue;
+		}
+
+		(void)memcpy(data, lf_slot(msgq, idx), msgq->msg_size);
+
+		/* the slot cannot have been rewritten without its sequence moving */
+		if (lf_seq_get(msgq, idx) == seq) {
+			return 0;
+		}
+	}
+}
+
+static void lf_wake_waiters(struct k_msgq *msgq, bool data_available)
+{
+	k_spinlock_key_t key;
+	bool resched;
+
+	if (atomic_get(&msgq->waiters) == 0) {
+		return;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	resched = z_sched_wake_all(&msgq->wait_q, 0, NULL);
+	if (data_available && handle_poll_events(msgq)) {
+		resched = true;
+	}
+
+#ifdef CONFIG_POLL
+	if ((atomic_get(&msgq->waiters) & LF_WAITERS_POLLED) != 0) {
+		z_msgq_poll_done(msgq);
+	}
+#endif /* CONFIG_POLL */
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+/* Put (or get) a message, pending on the wait queue until it succeeds */
+static int lf_transfer(struct k_msgq *msgq, void *data, k_timeout_t timeout, bool put)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	bool done;
+	int result = -ENOMSG;
+
+	done = put ? lf_put(msgq, data) : lf_get(msgq, data);
+	while (!done) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return result;
+		}
+
+		key = k_spin_lock(&msgq->lock);
+
+		atomic_inc(&msgq->waiters);
+		done = put ? lf_put(msgq, data) : lf_get(msgq, data);
+		if (done) {
+			atomic_dec(&msgq->waiters);
+			k_spin_unlock(&msgq->lock, key);
+			break;
+		}
+
+		if (put) {
+			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+		} else {
+			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+		}
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		atomic_dec(&msgq->waiters);
+		if (result != 0) {
+			return result;
+		}
+
+		/* woken up because the queue moved, retry with what is left */
+		timeout = sys_timepoint_timeout(end);
+		result = -EAGAIN;
+		done = put ? lf_put(msgq, data) : lf_get(msgq, data);
+	}
+
+	lf_wake_waiters(msgq, put);
+
+	return 0;
+}
+
+int k_msgq_lockfree_init(struct k_msgq *msgq, char *buffer, atomic_t *seq,
+			 size_t msg_size, uint32_t max_msgs)
+{
+	CHECKIF(!IS_POWER_OF_TWO(max_msgs)) {
+		return -EINVAL;
+	}
+
+	k_msgq_init(msgq, buffer, msg_size, max_msgs);
+
+	(void)memset(seq, 0, max_msgs * sizeof(*seq));
+	msgq->seq = seq;
+	msgq->flags = K_MSGQ_FLAG_LOCKFREE;
+
+	return 0;
+}
+
+void z_msgq_poll_register(struct k_msgq *msgq)
+{
+	/*
+	 * A poller is not a pending thread and cannot retry on its own, so
+	 * while a queue is polled every put takes the notification path.
+	 */
+	if (is_lockfree(msgq)) {
+		(void)atomic_or(&msgq->waiters, LF_WAITERS_POLLED);
+	}
+}
+
+void z_msgq_poll_unregister(struct k_msgq *msgq)
+{
+	(void)atomic_and(&msgq->waiters, ~LF_WAITERS_POLLED);
+}
+#else
+static inline bool is_lockfree(struct k_msgq *msgq)
+{
+	ARG_UNUSED(msgq);
+
+	return false;
+}
+
+static inline bool lf_get(struct k_msgq *msgq, void *data)
+{
+	ARG_UNUSED(msgq);
+	ARG_UNUSED(data);
+
+	return false;
+}
+
+static inline int lf_peek(struct k_msgq *msgq, void *data, uint32_t offset)
+{
+	ARG_UNUSED(msgq);
+	ARG_UNUSED(data);
+	ARG_UNUSED(offset);
+
+	return -ENOTSUP;
+}
+
+static inline int lf_transfer(struct k_msgq *msgq, void *data, k_timeout_t timeout, bool put)
+{
+	ARG_UNUSED(msgq);
+	ARG_UNUSED(data);
+	ARG_UNUSED(timeout);
+	ARG_UNUSED(put);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -51,6 +345,13 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->write_ptr = buffer;
 	msgq->used_msgs = 0;
 	msgq->flags = 0;
+#ifdef CONFIG_MSGQ_LOCKFREE
+	msgq->seq = NULL;
+	msgq->put_pos = ATOMIC_INIT(0);
+	msgq->get_pos = ATOMIC_INIT(0);
+	msgq->published = ATOMIC_INIT(0);
+	msgq->waiters = ATOMIC_INIT(0);
+#endif /* CONFIG_MSGQ_LOCKFREE */
 	z_waitq_init(&msgq->wait_q);
 	msgq->lock = (struct k_spinlock) {};
 #ifdef CONFIG_POLL
@@ -134,6 +435,21 @@ static inline int put_msg_in_queue(struct k_msgq *msgq, const void *data,
 	int result;
 	bool resched = false;
 
+	if (is_lockfree(msgq)) {
+		if (put_at_back) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+			result = lf_transfer(msgq, (void *)data, timeout, true);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+		} else {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_front, msgq, timeout);
+			/* only the back of a lock-free ring can be claimed */
+			result = -ENOTSUP;
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_front, msgq, timeout, result);
+		}
+
+		return result;
+	}
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (put_at_back) {
@@ -259,7 +575,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_impl_k_msgq_num_used_get(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -282,6 +598,14 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	int result;
 	bool resched = false;
 
+	if (is_lockfree(msgq)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+		result = lf_transfer(msgq, data, timeout, false);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+		return result;
+	}
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
@@ -359,6 +683,13 @@ int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 	k_spinlock_key_t key;
 	int result;
 
+	if (is_lockfree(msgq)) {
+		result = lf_peek(msgq, data, 0);
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+		return result;
+	}
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > 0U) {
@@ -396,6 +727,13 @@ int z_impl_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
 	uint32_t byte_offset;
 	char *start_addr;
 
+	if (is_lockfree(msgq)) {
+		result = lf_peek(msgq, data, idx);
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+		return result;
+	}
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > idx) {
@@ -453,6 +791,12 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 		resched = true;
 	}
 
+	if (is_lockfree(msgq)) {
+		/* discard whatever is published, racing puts may still land */
+		while (lf_get(msgq, NULL)) {
+		}
+	}
+
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
 
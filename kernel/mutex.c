@@ -107,6 +107,10 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	int new_prio;
 	k_spinlock_key_t key;
 	bool resched = false;
+	/* Where and when the mutex is requested, for the lock statistics */
+	uintptr_t site = (uintptr_t)__builtin_return_address(0);
+	uint32_t start = 0U;
+	bool tracked = IS_ENABLED(CONFIG_LOCK_STATS) && z_lock_stats_now(&start);
 
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
@@ -129,6 +133,10 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 		k_spin_unlock(&lock, key);
 
+		if (tracked && (mutex->lock_count == 1U)) {
+			z_mutex_stats_acquired(mutex, site, start, false);
+		}
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 
 		return 0;
@@ -161,6 +169,9 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		got_mutex ? 'y' : 'n');
 
 	if (got_mutex == 0) {
+		if (tracked) {
+			z_mutex_stats_acquired(mutex, site, start, true);
+		}
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 		return 0;
 	}
@@ -249,6 +260,8 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		goto k_mutex_unlock_return;
 	}
 
+	z_mutex_stats_release(mutex);
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	adjust_owner_prio(mutex, mutex->owner_orig_prio);
@@ -35,10 +35,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -82,7 +83,7 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 		}
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
-		if (event->msgq->used_msgs > 0) {
+		if (z_impl_k_msgq_num_used_get(event->msgq) > 0) {
 			*state = K_POLL_STATE_MSGQ_DATA_AVAILABLE;
 			return true;
 		}
@@ -112,21 +113,32 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+static inline bool is_set_poller(struct z_poller *poller)
+{
+	return poller->mode == MODE_SET;
+}
+
+/*
+ * Events of poll sets have no thread to order them by and are queued
+ * behind those of all polling threads.
+ */
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
 	struct k_poll_event *pending;
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
+	if ((pending == NULL) || is_set_poller(poller) ||
+		(!is_set_poller(pending->poller) &&
+		 z_sched_prio_cmp(poller_thread(pending->poller),
 							   poller_thread(poller)) > 0)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
+		if (is_set_poller(pending->poller) ||
+		    z_sched_prio_cmp(poller_thread(poller),
 					poller_thread(pending->poller)) > 0) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
@@ -242,6 +254,10 @@ static inline int register_events(struct k_poll_event *events,
 		uint32_t state;
 
 		key = k_spin_lock(&lock);
+		if (events[ii].type == K_POLL_TYPE_MSGQ_DATA_AVAILABLE) {
+			/* must precede the check, see z_msgq_poll_register() */
+			z_msgq_poll_register(events[ii].msgq);
+		}
 		if (is_condition_met(&events[ii], &state)) {
 			set_event_ready(&events[ii], state);
 			poller->is_polling = false;
@@ -441,6 +457,11 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	int retcode = 0;
 
 	if (poller != NULL) {
+		if (poller->mode == MODE_SET) {
+			/* The event stays in the set, only queue it as ready */
+			return signal_set(event, state);
+		}
+
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
@@ -476,6 +497,18 @@ bool z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 	return (poll_event != NULL);
 }
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+void z_msgq_poll_done(struct k_msgq *msgq)
+{
+	/* Events are registered under the lock, after z_msgq_poll_register() */
+	K_SPINLOCK(&lock) {
+		if (sys_dlist_is_empty(&msgq->poll_events)) {
+			z_msgq_poll_unregister(msgq);
+		}
+	}
+}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 void z_impl_k_poll_signal_init(struct k_poll_signal *sig)
 {
 	sys_dlist_init(&sig->poll_events);
@@ -566,6 +599,183 @@ static inline void z_vrfy_k_poll_signal_reset(struct k_poll_signal *sig)
 
 #endif /* CONFIG_USERSPACE */
 
+/* must be called with interrupts locked */
+static void set_event_queue_ready(struct k_poll_set *set,
+				  struct k_poll_event *event)
+{
+	sys_dlist_append(&set->ready, &event->_node);
+	(void)z_sched_wake(&set->wait_q, 0, NULL);
+}
+
+/* must be called with interrupts locked */
+static int signal_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller,
+					      struct k_poll_set, poller);
+
+	event->state |= state;
+	set_event_queue_ready(set, event);
+
+	return 0;
+}
+
+/* must be called with interrupts locked */
+static void set_event_arm(struct k_poll_set *set, struct k_poll_event *event)
+{
+	uint32_t state;
+
+	if (is_condition_met(event, &state)) {
+		event->poller = &set->poller;
+		event->state |= state;
+		set_event_queue_ready(set, event);
+	} else {
+		register_event(event, &set->poller);
+	}
+}
+
+/*
+ * Move up to num_events ready events to the caller, must be called with
+ * interrupts locked. Only events on the ready list are looked at: those
+ * whose condition no longer holds are registered back on their object,
+ * and those still ready go back to the tail of the ready list so that the
+ * next wait reports them again.
+ */
+static int set_collect(struct k_poll_set *set, struct k_poll_event **events,
+		       int num_events)
+{
+	struct k_poll_event *event;
+	sys_dlist_t reported;
+	int count = 0;
+
+	sys_dlist_init(&reported);
+
+	while (count < num_events) {
+		uint32_t cancelled;
+		uint32_t state = K_POLL_STATE_NOT_READY;
+		bool ready;
+
+		event = (struct k_poll_event *)sys_dlist_get(&set->ready);
+		if (event == NULL) {
+			break;
+		}
+
+		cancelled = event->state & K_POLL_STATE_CANCELLED;
+		ready = is_condition_met(event, &state);
+		event->state = state | cancelled;
+
+		if (ready || (cancelled != 0U)) {
+			events[count] = event;
+			count++;
+		}
+
+		/* A cancellation is only reported once */
+		if (ready && (cancelled == 0U)) {
+			sys_dlist_append(&reported, &event->_node);
+		} else {
+			register_event(event, &set->poller);
+		}
+	}
+
+	while ((event = (struct k_poll_event *)sys_dlist_get(&reported)) != NULL) {
+		sys_dlist_append(&set->ready, &event->_node);
+	}
+
+	return count;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	z_waitq_init(&set->wait_q);
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key;
+
+	__ASSERT(set != NULL, "NULL set\n");
+	__ASSERT(event != NULL, "NULL event\n");
+
+	key = k_spin_lock(&lock);
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	if (event->type == K_POLL_TYPE_MSGQ_DATA_AVAILABLE) {
+		/* must precede the check, see z_msgq_poll_register() */
+		z_msgq_poll_register(event->msgq);
+	}
+
+	event->state = K_POLL_STATE_NOT_READY;
+	set_event_arm(set, event);
+
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	/* Unlinks it from either its object or the ready list */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int num_events, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int count;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(events != NULL, "NULL events\n");
+	__ASSERT(num_events > 0, "<=0 events\n");
+
+	key = k_spin_lock(&lock);
+
+	for (;;) {
+		count = set_collect(set, events, num_events);
+		if (count > 0) {
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			count = -EAGAIN;
+			break;
+		}
+
+		/* Woken with 0 when an event of the set is signaled */
+		if (z_pend_curr(&lock, key, &set->wait_q, timeout) != 0) {
+			return -EAGAIN;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+		key = k_spin_lock(&lock);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return count;
+}
+
 static void triggered_work_handler(struct k_work *work)
 {
 	struct k_work_poll *twork =
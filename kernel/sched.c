@@ -47,7 +47,9 @@ BUILD_ASSERT(CONFIG_NUM_COOP_PRIORITIES >= CONFIG_NUM_METAIRQ_PRIORITIES,
 
 static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_WORK_STEALING)
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY)
 	int cpu, m = thread->base.cpu_mask;
 
 	/* Edge case: it's legal per the API to "make runnable" a
@@ -67,17 +69,75 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+}
+
+#ifdef CONFIG_SCHED_WORK_STEALING
+/* Picks the run queue a thread gets added to: the one of the CPU it last
+ * ran on when it may still run there, else the one of the current CPU
+ * or of the first CPU its mask allows.  Other CPUs steal it from there
+ * when needed, see runq_steal().
+ */
+static ALWAYS_INLINE uint8_t runq_home_cpu(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t m = thread->base.cpu_mask;
+
+	if ((m & BIT(thread->base.cpu)) != 0U) {
+		return thread->base.cpu;
+	}
+
+	if ((m & BIT(_current_cpu->id)) != 0U) {
+		return _current_cpu->id;
+	}
+
+	/* See thread_runq() for threads with all CPUs masked off */
+	return (m == 0U) ? 0U : u32_count_trailing_zeros(m);
+#else
+	return thread->base.cpu;
+#endif /* CONFIG_SCHED_CPU_MASK */
+}
+
+/* Returns the best thread this CPU may run among best, the best one of
+ * its own run queue, and those of the other CPUs.  Threads of other
+ * queues are only taken when of strictly higher priority, so priority
+ * order holds across CPUs while ties stay on the CPU they were queued on.
+ */
+static struct k_thread *runq_steal(struct k_thread *best)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int id = _current_cpu->id;
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct k_thread *thread;
+
+		if (i == id) {
+			continue;
+		}
+
+		thread = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+		if ((thread != NULL) &&
+		    ((best == NULL) || (z_sched_prio_cmp(thread, best) > 0))) {
+			best = thread;
+		}
+	}
+
+	return best;
 }
+#endif /* CONFIG_SCHED_WORK_STEALING */
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+	thread->base.runq_cpu = runq_home_cpu(thread);
+#endif /* CONFIG_SCHED_WORK_STEALING */
+
 	_priq_run_add(thread_runq(thread), thread);
 }
 
@@ -95,7 +155,13 @@ static ALWAYS_INLINE void runq_yield(void)
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
-	return _priq_run_best(curr_cpu_runq());
+	struct k_thread *thread = _priq_run_best(curr_cpu_runq());
+
+#ifdef CONFIG_SCHED_WORK_STEALING
+	thread = runq_steal(thread);
+#endif /* CONFIG_SCHED_WORK_STEALING */
+
+	return thread;
 }
 
 /* _current is never in the run queue until context switch on
@@ -244,6 +310,11 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 
 	/* Take the new _current out of the queue */
 	if (z_is_thread_queued(thread)) {
+#ifdef CONFIG_SCHED_WORK_STEALING
+		if (thread->base.runq_cpu != _current_cpu->id) {
+			_current_cpu->steals++;
+		}
+#endif /* CONFIG_SCHED_WORK_STEALING */
 		dequeue_thread(thread);
 	}
 
@@ -335,7 +406,10 @@ static struct _cpu *thread_active_elsewhere(struct k_thread *thread)
 	return NULL;
 }
 
-static void ready_thread(struct k_thread *thread)
+/* Returns true if the thread was added to the run queue, in which case
+ * the caller is responsible for updating the cache and flagging IPIs.
+ */
+static bool queue_ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
 	__ASSERT_NO_MSG(arch_mem_coherent(thread));
@@ -347,7 +421,17 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+		z_sched_latency_ready(thread);
 		queue_thread(thread);
+		return true;
+	}
+
+	return false;
+}
+
+static void ready_thread(struct k_thread *thread)
+{
+	if (queue_ready_thread(thread)) {
 		update_cache(0);
 
 		flag_ipi(ipi_mask_create(thread));
@@ -578,33 +662,69 @@ void z_unpend_thread_no_timeout(struct k_thread *thread)
 	}
 }
 
-void z_sched_wake_thread(struct k_thread *thread, bool is_timeout)
+/* Returns true if the thread was added to the run queue, see
+ * queue_ready_thread().
+ */
+static bool wake_thread(struct k_thread *thread, bool is_timeout)
 {
-	K_SPINLOCK(&_sched_spinlock) {
-		bool killed = (thread->base.thread_state &
-				(_THREAD_DEAD | _THREAD_ABORTING));
+	bool killed = (thread->base.thread_state &
+			(_THREAD_DEAD | _THREAD_ABORTING));
 
 #ifdef CONFIG_EVENTS
-		bool do_nothing = thread->no_wake_on_timeout && is_timeout;
+	bool do_nothing = thread->no_wake_on_timeout && is_timeout;
 
-		thread->no_wake_on_timeout = false;
+	thread->no_wake_on_timeout = false;
 
-		if (do_nothing) {
-			continue;
-		}
+	if (do_nothing) {
+		return false;
+	}
 #endif /* CONFIG_EVENTS */
 
-		if (!killed) {
-			/* The thread is not being killed */
-			if (thread->base.pended_on != NULL) {
-				unpend_thread_no_timeout(thread);
-			}
-			z_mark_thread_as_not_sleeping(thread);
-			ready_thread(thread);
+	if (killed) {
+		return false;
+	}
+
+	/* The thread is not being killed */
+	if (thread->base.pended_on != NULL) {
+		unpend_thread_no_timeout(thread);
+	}
+	z_mark_thread_as_not_sleeping(thread);
+
+	return queue_ready_thread(thread);
+}
+
+void z_sched_wake_thread(struct k_thread *thread, bool is_timeout)
+{
+	K_SPINLOCK(&_sched_spinlock) {
+		if (wake_thread(thread, is_timeout)) {
+			update_cache(0);
+			flag_ipi(ipi_mask_create(thread));
 		}
 	}
+}
+
+#ifdef CONFIG_EVENTS
+void z_sched_wake_event_threads(struct k_thread *head)
+{
+	atomic_val_t ipi_mask = 0;
+	bool queued = false;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		for (struct k_thread *thread = head; thread != NULL;
+		     thread = thread->next_event_link) {
+			if (wake_thread(thread, false)) {
+				ipi_mask |= ipi_mask_create(thread);
+				queued = true;
+			}
+		}
 
+		if (queued) {
+			update_cache(0);
+			flag_ipi(ipi_mask);
+		}
+	}
 }
+#endif /* CONFIG_EVENTS */
 
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 /* Timeout handler for *_thread_timeout() APIs */
@@ -876,6 +996,7 @@ void *z_get_next_switch_handle(void *interrupted)
 		new_thread = next_up();
 
 		z_sched_usage_switch(new_thread);
+		z_sched_latency_switched_in(new_thread);
 
 		if (old_thread != new_thread) {
 			uint8_t  cpu_id;
@@ -929,6 +1050,7 @@ void *z_get_next_switch_handle(void *interrupted)
 	return ret;
 #else
 	z_sched_usage_switch(_kernel.ready_q.cache);
+	z_sched_latency_switched_in(_kernel.ready_q.cache);
 	_current->switch_handle = interrupted;
 	set_current(_kernel.ready_q.cache);
 	return _current->switch_handle;
@@ -938,16 +1060,8 @@ void *z_get_next_switch_handle(void *interrupted)
 
 int z_unpend_all(_wait_q_t *wait_q)
 {
-	int need_sched = 0;
-	struct k_thread *thread;
-
-	for (thread = z_waitq_head(wait_q); thread != NULL; thread = z_waitq_head(wait_q)) {
-		z_unpend_thread(thread);
-		z_ready_thread(thread);
-		need_sched = 1;
-	}
-
-	return need_sched;
+	/* -EAGAIN is what z_swap() returns when nobody set a value */
+	return (z_ready_threads(wait_q, -EAGAIN, NULL) != 0) ? 1 : 0;
 }
 
 void init_ready_q(struct _ready_q *ready_q)
@@ -957,13 +1071,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -1475,6 +1589,40 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data)
 	return ret;
 }
 
+int z_ready_threads(_wait_q_t *wait_q, int swap_retval, void *swap_data)
+{
+	struct k_thread *thread;
+	atomic_val_t ipi_mask = 0;
+	bool queued = false;
+	int woken = 0;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		for (thread = _priq_wait_best(&wait_q->waitq); thread != NULL;
+		     thread = _priq_wait_best(&wait_q->waitq)) {
+			z_thread_return_value_set_with_data(thread,
+							    swap_retval,
+							    swap_data);
+			unpend_thread_no_timeout(thread);
+			z_abort_thread_timeout(thread);
+			woken++;
+
+			if ((thread_active_elsewhere(thread) == NULL) &&
+			    queue_ready_thread(thread)) {
+				ipi_mask |= ipi_mask_create(thread);
+				queued = true;
+			}
+		}
+
+		/* One cache update and one set of IPIs for the whole batch */
+		if (queued) {
+			update_cache(0);
+			flag_ipi(ipi_mask);
+		}
+	}
+
+	return woken;
+}
+
 int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
 		 _wait_q_t *wait_q, k_timeout_t timeout, void **data)
 {
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
+#include <ksched.h>
+#include <string.h>
+
+#define NUM_LEVELS  (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO + 1)
+#define NUM_BUCKETS CONFIG_SCHED_LATENCY_STATS_BUCKETS
+
+struct sched_latency_level {
+#ifdef CONFIG_OBJ_CORE_STATS_SCHED_LATENCY
+	struct k_obj_core obj_core;
+#endif /* CONFIG_OBJ_CORE_STATS_SCHED_LATENCY */
+	struct k_sched_latency_stats stats;
+};
+
+/*
+ * The histograms are updated with the scheduler spinlock held, which is
+ * also taken to read them. On uniprocessor systems without USE_SWITCH, they
+ * are updated with interrupts masked, which the spinlock does as well.
+ */
+static struct sched_latency_level levels[NUM_LEVELS];
+
+static void histogram_add(struct k_sched_latency_histogram *histogram, uint32_t cycles)
+{
+	uint32_t bucket = (cycles == 0U) ? 0U : 32U - u32_count_leading_zeros(cycles);
+
+	histogram->buckets[MIN(bucket, NUM_BUCKETS - 1)]++;
+	histogram->sum += cycles;
+	histogram->count++;
+	histogram->max = MAX(histogram->max, cycles);
+}
+
+void z_sched_latency_switched_in(struct k_thread *thread)
+{
+	struct k_sched_latency_stats *stats;
+	int prio = thread->base.prio;
+
+	if (!thread->base.ready_pending) {
+		/* Preempted or yielding, or already accounted */
+		return;
+	}
+
+	thread->base.ready_pending = false;
+
+	if (prio < K_HIGHEST_THREAD_PRIO || prio > K_LOWEST_THREAD_PRIO) {
+		return;
+	}
+
+	stats = &levels[prio - K_HIGHEST_THREAD_PRIO].stats;
+	histogram_add(thread->base.ready_in_isr ? &stats->isr : &stats->wakeup,
+		      k_cycle_get_32() - thread->base.ready_cycles);
+}
+
+int k_sched_latency_stats_get(int prio, struct k_sched_latency_stats *stats)
+{
+	CHECKIF(stats == NULL || prio < K_HIGHEST_THREAD_PRIO || prio > K_LOWEST_THREAD_PRIO) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		*stats = levels[prio - K_HIGHEST_THREAD_PRIO].stats;
+	}
+
+	return 0;
+}
+
+static void level_reset(struct sched_latency_level *level)
+{
+	memset(&level->stats.wakeup, 0, sizeof(level->stats.wakeup));
+	memset(&level->stats.isr, 0, sizeof(level->stats.isr));
+}
+
+void k_sched_latency_stats_reset(void)
+{
+	K_SPINLOCK(&_sched_spinlock) {
+		for (int i = 0; i < NUM_LEVELS; i++) {
+			level_reset(&levels[i]);
+		}
+	}
+}
+
+#ifdef CONFIG_OBJ_CORE_STATS_SCHED_LATENCY
+static struct k_obj_type obj_type_sched_latency;
+
+static int sched_latency_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	K_SPINLOCK(&_sched_spinlock) {
+		memcpy(stats, obj_core->stats, sizeof(struct k_sched_latency_stats));
+	}
+
+	return 0;
+}
+
+static int sched_latency_stats_reset(struct k_obj_core *obj_core)
+{
+	K_SPINLOCK(&_sched_spinlock) {
+		level_reset(CONTAINER_OF(obj_core, struct sched_latency_level, obj_core));
+	}
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc sched_latency_stats_desc = {
+	.raw_size = sizeof(struct k_sched_latency_stats),
+	.query_size = sizeof(struct k_sched_latency_stats),
+	.raw   = sched_latency_stats_raw,
+	.query = sched_latency_stats_raw,
+	.reset = sched_latency_stats_reset,
+	.disable = NULL,
+	.enable  = NULL,
+};
+#endif /* CONFIG_OBJ_CORE_STATS_SCHED_LATENCY */
+
+static int init_sched_latency(void)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_SCHED_LATENCY
+	z_obj_type_init(&obj_type_sched_latency, K_OBJ_TYPE_SCHED_LATENCY_ID,
+			offsetof(struct sched_latency_level, obj_core));
+	k_obj_type_stats_init(&obj_type_sched_latency, &sched_latency_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_SCHED_LATENCY */
+
+	for (int i = 0; i < NUM_LEVELS; i++) {
+		levels[i].stats.prio = K_HIGHEST_THREAD_PRIO + i;
+
+#ifdef CONFIG_OBJ_CORE_STATS_SCHED_LATENCY
+		k_obj_core_init_and_link(K_OBJ_CORE(&levels[i]), &obj_type_sched_latency);
+		k_obj_core_stats_register(K_OBJ_CORE(&levels[i]), &levels[i].stats,
+					  sizeof(levels[i].stats));
+#endif /* CONFIG_OBJ_CORE_STATS_SCHED_LATENCY */
+	}
+
+	return 0;
+}
+
+SYS_INIT(init_sched_latency, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
@@ -920,6 +920,10 @@ void z_thread_mark_switched_in(void)
 	z_sched_usage_start(_current);
 #endif /* CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) && !defined(CONFIG_USE_SWITCH)
+	z_sched_latency_switched_in(_current);
+#endif /* CONFIG_SCHED_LATENCY_STATS && !CONFIG_USE_SWITCH */
+
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
 #endif /* CONFIG_TRACING */
@@ -12,21 +12,83 @@
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
 
-static uint64_t curr_tick;
+#define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
+		  ? K_TICKS_FOREVER : INT_MAX)
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+#define WHEEL_LEVELS	 CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SLOT_BITS	 6
+#define WHEEL_SLOTS	 BIT(WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK	 (WHEEL_SLOTS - 1U)
+#define WHEEL_SHIFT(lvl) ((lvl) * WHEEL_SLOT_BITS)
+#define WHEEL_SPAN(lvl)	 BIT64(WHEEL_SHIFT(lvl))
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+struct timeout_q {
+	/*
+	 * The timeout code shall take no locks other than those of the
+	 * timeout queues (and tick_lock), nor shall it call any other
+	 * subsystem while holding them.
+	 */
+	struct k_spinlock lock;
+
+	uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+	/* Ticks left to process in the currently-executing sys_clock_announce() */
+	int announce_remaining;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* Value of announced_ticks the queue has been asked to catch up with */
+	uint64_t announced;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	sys_dlist_t wheel_slots[WHEEL_LEVELS][WHEEL_SLOTS];
+	uint64_t wheel_map[WHEEL_LEVELS];
+	sys_dlist_t wheel_overflow;
+
+	/* Timeouts of the tick being processed by sys_clock_announce() */
+	sys_dlist_t wheel_expired;
+
+	/* Earliest tick at which the wheel needs processing */
+	uint64_t wheel_next;
+#else
+	sys_dlist_t list;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+};
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+#define TIMEOUT_Q_INIT(i, _)							\
+	[i] = {									\
+		.wheel_overflow = SYS_DLIST_STATIC_INIT(&timeout_qs[i].wheel_overflow), \
+		.wheel_expired = SYS_DLIST_STATIC_INIT(&timeout_qs[i].wheel_expired), \
+		.wheel_next = UINT64_MAX,					\
+	}
+#else
+#define TIMEOUT_Q_INIT(i, _)							\
+	[i] = {									\
+		.list = SYS_DLIST_STATIC_INIT(&timeout_qs[i].list),		\
+	}
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
 /*
- * The timeout code shall take no locks other than its own (timeout_lock), nor
- * shall it call any other subsystem while holding this lock.
+ * Every CPU owns a timeout queue.  Timeouts are armed on the queue of
+ * the CPU arming them and expire from the timer interrupt of that CPU,
+ * which catches its queue up with the ticks announced by all CPUs.
  */
-static struct k_spinlock timeout_lock;
+#define NUM_TIMEOUT_QS CONFIG_MP_MAX_NUM_CPUS
 
-#define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
-		  ? K_TICKS_FOREVER : INT_MAX)
+/* Ticks announced by the timer driver on any CPU */
+static uint64_t announced_ticks;
+static struct k_spinlock tick_lock;
+#else
+#define NUM_TIMEOUT_QS 1
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
-/* Ticks left to process in the currently-executing sys_clock_announce() */
-static int announce_remaining;
+static struct timeout_q timeout_qs[NUM_TIMEOUT_QS] = {
+	LISTIFY(NUM_TIMEOUT_QS, TIMEOUT_Q_INIT, (,))
+};
 
 #if defined(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME)
 unsigned int z_clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
@@ -40,30 +102,116 @@ static inline unsigned int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
-static struct _timeout *first(void)
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* must be locked */
+static bool is_local_q(struct timeout_q *q)
 {
-	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
+	return q == &timeout_qs[arch_curr_cpu()->id];
+}
 
-	return (t == NULL) ? NULL : CONTAINER_OF(t, struct _timeout, node);
+/* Locks the timeout queue of the current CPU */
+static struct timeout_q *local_q_lock(k_spinlock_key_t *key)
+{
+	struct timeout_q *q;
+
+	for (;;) {
+		q = &timeout_qs[arch_curr_cpu()->id];
+		*key = k_spin_lock(&q->lock);
+
+		/* Migrated before the spinlock masked interrupts? */
+		if (is_local_q(q)) {
+			return q;
+		}
+		k_spin_unlock(&q->lock, *key);
+	}
 }
 
-static struct _timeout *next(struct _timeout *t)
+/* Locks the timeout queue the timeout was last armed on.  The owner of a
+ * timeout only changes with the lock of its previous owner held, so it
+ * can't change once checked here under that lock.
+ */
+static struct timeout_q *owner_q_lock(const struct _timeout *to, k_spinlock_key_t *key)
 {
-	sys_dnode_t *n = sys_dlist_peek_next(&timeout_list, &t->node);
+	struct timeout_q *q;
 
-	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
+	for (;;) {
+		q = &timeout_qs[to->cpu];
+		*key = k_spin_lock(&q->lock);
+
+		/* Re-armed on another CPU while we were spinning? */
+		if (q == &timeout_qs[to->cpu]) {
+			return q;
+		}
+		k_spin_unlock(&q->lock, *key);
+	}
 }
 
-static void remove_timeout(struct _timeout *t)
+/* Locks the timeout queue of the current CPU and makes it the owner of
+ * the timeout, which must not be armed.
+ */
+static struct timeout_q *local_q_claim(struct _timeout *to, k_spinlock_key_t *key)
 {
-	if (next(t) != NULL) {
-		next(t)->dticks += t->dticks;
+	struct timeout_q *q;
+
+	for (;;) {
+		q = owner_q_lock(to, key);
+		if (is_local_q(q)) {
+			return q;
+		}
+		to->cpu = arch_curr_cpu()->id;
+		k_spin_unlock(&q->lock, *key);
 	}
+}
 
-	sys_dlist_remove(&t->node);
+/* must be locked, returns the ticks announced but not yet processed by q */
+static int32_t lag(struct timeout_q *q)
+{
+	uint64_t now = 0U;
+
+	K_SPINLOCK(&tick_lock) {
+		now = announced_ticks;
+	}
+
+	return (int32_t)MIN(now - q->curr_tick, (uint64_t)INT_MAX);
+}
+#else
+static inline struct timeout_q *local_q_lock(k_spinlock_key_t *key)
+{
+	*key = k_spin_lock(&timeout_qs[0].lock);
+
+	return &timeout_qs[0];
+}
+
+static inline struct timeout_q *owner_q_lock(const struct _timeout *to, k_spinlock_key_t *key)
+{
+	ARG_UNUSED(to);
+
+	return local_q_lock(key);
+}
+
+static inline struct timeout_q *local_q_claim(struct _timeout *to, k_spinlock_key_t *key)
+{
+	ARG_UNUSED(to);
+
+	return local_q_lock(key);
+}
+
+static inline bool is_local_q(struct timeout_q *q)
+{
+	ARG_UNUSED(q);
+
+	return true;
+}
+
+static inline int32_t lag(struct timeout_q *q)
+{
+	ARG_UNUSED(q);
+
+	return 0;
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
-static int32_t elapsed(void)
+static int32_t elapsed(struct timeout_q *q)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
 	 * scheduled relatively to the currently firing timeout's original tick
@@ -81,109 +229,360 @@ static int32_t elapsed(void)
 	 * will be non-zero while sys_clock_announce() is executing and zero
 	 * otherwise.
 	 */
-	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+	return q->announce_remaining == 0 ? lag(q) + sys_clock_elapsed() : 0U;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/*
+ * Hierarchical timing wheel.  Level n has 64 slots each spanning 64^n
+ * ticks, so that level n holds the timeouts expiring between 64^n and
+ * 64^(n+1) ticks from the wheel base (the next tick to be processed,
+ * i.e. curr_tick + 1).  In this mode _timeout.dticks holds the absolute
+ * tick at which the timeout expires instead of a delta to its
+ * predecessor.
+ *
+ * A slot at level n > 0 is cascaded, i.e. its timeouts re-hashed into
+ * the lower levels, when the wheel base reaches the first tick of the
+ * range it covers, so every level 0 slot only ever holds timeouts
+ * expiring on the same tick.  Timeouts beyond the range of the top level
+ * live on an unsorted overflow list which is re-hashed whenever the top
+ * level wraps around.
+ *
+ * wheel_map tracks the non-empty slots of each level.  The slot list
+ * heads are only initialized when their bit gets set, which avoids
+ * needing an init hook before the first timeout is added.
+ */
+
+static inline uint64_t wheel_align_up(uint64_t tick, int lvl)
+{
+	return (tick + WHEEL_SPAN(lvl) - 1U) & ~(WHEEL_SPAN(lvl) - 1U);
 }
 
-static int32_t next_timeout(int32_t ticks_elapsed)
+static inline bool wheel_is_slot(struct timeout_q *q, const sys_dnode_t *node)
 {
-	struct _timeout *to = first();
-	int32_t ret;
+	return (node >= &q->wheel_slots[0][0]) &&
+	       (node <= &q->wheel_slots[WHEEL_LEVELS - 1][WHEEL_SLOT_MASK]);
+}
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
-		ret = MAX_WAIT;
+/* Hashes a timeout into the wheel relative to base, returning the tick
+ * at which the wheel must next look at it: its expiry for level 0, the
+ * time its slot is cascaded otherwise.
+ */
+static uint64_t wheel_add(struct timeout_q *q, struct _timeout *to, uint64_t base, bool prepend)
+{
+	uint64_t expires = (uint64_t)to->dticks;
+	uint64_t delta = expires - base;
+	sys_dlist_t *list = &q->wheel_overflow;
+	uint64_t tick = wheel_align_up(base, WHEEL_LEVELS);
+
+	for (int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		if (delta < WHEEL_SPAN(lvl + 1)) {
+			unsigned int slot = (expires >> WHEEL_SHIFT(lvl)) & WHEEL_SLOT_MASK;
+
+			list = &q->wheel_slots[lvl][slot];
+			if ((q->wheel_map[lvl] & BIT64(slot)) == 0U) {
+				sys_dlist_init(list);
+				q->wheel_map[lvl] |= BIT64(slot);
+			}
+			tick = expires & ~(WHEEL_SPAN(lvl) - 1U);
+			break;
+		}
+	}
+
+	if (prepend) {
+		sys_dlist_prepend(list, &to->node);
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		sys_dlist_append(list, &to->node);
 	}
 
-	return ret;
+	return tick;
 }
 
-k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
+static uint64_t wheel_next_event(struct timeout_q *q, uint64_t base)
 {
-	k_ticks_t ticks = 0;
+	uint64_t ret = UINT64_MAX;
 
-	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
-		return 0;
+	for (int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		uint64_t map = q->wheel_map[lvl];
+		uint64_t start;
+		unsigned int first;
+
+		if (map == 0U) {
+			continue;
+		}
+
+		/* Slots are visited in time order starting with the first one
+		 * whose range begins at or after base.
+		 */
+		start = wheel_align_up(base, lvl) >> WHEEL_SHIFT(lvl);
+		first = start & WHEEL_SLOT_MASK;
+		if (first != 0U) {
+			map = (map >> first) | (map << (WHEEL_SLOTS - first));
+		}
+		start += u64_count_trailing_zeros(map);
+		ret = MIN(ret, start << WHEEL_SHIFT(lvl));
 	}
 
-#ifdef CONFIG_KERNEL_COHERENCE
-	__ASSERT_NO_MSG(arch_mem_coherent(to));
-#endif /* CONFIG_KERNEL_COHERENCE */
+	if (!sys_dlist_is_empty(&q->wheel_overflow)) {
+		ret = MIN(ret, wheel_align_up(base, WHEEL_LEVELS));
+	}
 
-	__ASSERT(!sys_dnode_is_linked(&to->node), "");
-	to->fn = fn;
+	return ret;
+}
 
-	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
-		int32_t ticks_elapsed;
-		bool has_elapsed = false;
+/* Re-hashes every timeout of list relative to base.  The list is walked
+ * backwards and its entries prepended to their new slots: they were all
+ * armed before any timeout already sitting in a lower level slot with
+ * the same expiry, so this keeps same-tick timeouts in the order they
+ * were armed.
+ */
+static void wheel_rehash(struct timeout_q *q, sys_dlist_t *list, uint64_t base)
+{
+	sys_dlist_t pending;
+	sys_dnode_t *node;
 
-		if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
-			ticks_elapsed = elapsed();
-			has_elapsed = true;
-			to->dticks = timeout.ticks + 1 + ticks_elapsed;
-			ticks = curr_tick + to->dticks;
-		} else {
-			k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+	sys_dlist_init(&pending);
+	while ((node = sys_dlist_get(list)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	while ((node = sys_dlist_peek_tail(&pending)) != NULL) {
+		sys_dlist_remove(node);
+		(void)wheel_add(q, CONTAINER_OF(node, struct _timeout, node), base, true);
+	}
+}
 
-			to->dticks = MAX(1, dticks);
-			ticks = timeout.ticks;
+/* Cascades the slots whose range starts at tick */
+static void wheel_cascade(struct timeout_q *q, uint64_t tick)
+{
+	for (int lvl = 1; lvl < WHEEL_LEVELS; lvl++) {
+		unsigned int slot = (tick >> WHEEL_SHIFT(lvl)) & WHEEL_SLOT_MASK;
+
+		if ((tick & (WHEEL_SPAN(lvl) - 1U)) != 0U) {
+			return;
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
+		if ((q->wheel_map[lvl] & BIT64(slot)) != 0U) {
+			q->wheel_map[lvl] &= ~BIT64(slot);
+			wheel_rehash(q, &q->wheel_slots[lvl][slot], tick);
 		}
+	}
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
+	if ((tick & (WHEEL_SPAN(WHEEL_LEVELS) - 1U)) == 0U) {
+		wheel_rehash(q, &q->wheel_overflow, tick);
+	}
+}
+
+/* must be locked */
+static bool insert_timeout(struct timeout_q *q, struct _timeout *to)
+{
+	uint64_t tick;
+
+	to->dticks = q->curr_tick + MAX(1, to->dticks);
+	tick = wheel_add(q, to, q->curr_tick + 1, false);
+	if (tick < q->wheel_next) {
+		q->wheel_next = tick;
+		return true;
+	}
+
+	return false;
+}
+
+/* must be locked, returns true if the next expiry moved */
+static bool remove_timeout(struct timeout_q *q, struct _timeout *t)
+{
+	sys_dnode_t *n = t->node.next;
+	uint64_t prev_next = q->wheel_next;
+
+	sys_dlist_remove(&t->node);
+
+	if (wheel_is_slot(q, n) && sys_dlist_is_empty(n)) {
+		size_t idx = n - &q->wheel_slots[0][0];
+
+		q->wheel_map[idx / WHEEL_SLOTS] &= ~BIT64(idx % WHEEL_SLOTS);
+	} else if ((n != &q->wheel_overflow) || !sys_dlist_is_empty(n)) {
+		return false;
+	}
+
+	q->wheel_next = wheel_next_event(q, q->curr_tick + 1);
+
+	return q->wheel_next != prev_next;
+}
+
+static int32_t next_timeout(struct timeout_q *q, int32_t ticks_elapsed)
+{
+	uint64_t next = q->wheel_next;
+	int32_t ret;
+
+	if ((next == UINT64_MAX) ||
+	    ((int64_t)(next - q->curr_tick - ticks_elapsed) > (int64_t)INT_MAX)) {
+		ret = MAX_WAIT;
+	} else {
+		ret = MAX(0, (int64_t)(next - q->curr_tick) - ticks_elapsed);
+	}
+
+	return ret;
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_q *q, const struct _timeout *timeout)
+{
+	return timeout->dticks - q->curr_tick;
+}
+
+/* must be locked, returns the next timeout due within announce_remaining
+ * and the number of ticks until it fires in dt.
+ */
+static struct _timeout *expired_timeout(struct timeout_q *q, int *dt)
+{
+	*dt = 0;
+
+	while (sys_dlist_is_empty(&q->wheel_expired)) {
+		uint64_t tick = wheel_next_event(q, q->curr_tick + 1);
+		unsigned int slot = tick & WHEEL_SLOT_MASK;
+		sys_dnode_t *node;
+
+		if ((tick == UINT64_MAX) ||
+		    ((tick - q->curr_tick) > (uint64_t)q->announce_remaining)) {
+			return NULL;
 		}
 
-		if (to == first() && announce_remaining == 0) {
-			if (!has_elapsed) {
-				/* In case of absolute timeout that is first to expire
-				 * elapsed need to be read from the system clock.
-				 */
-				ticks_elapsed = elapsed();
+		wheel_cascade(q, tick);
+
+		if ((q->wheel_map[0] & BIT64(slot)) != 0U) {
+			q->wheel_map[0] &= ~BIT64(slot);
+			while ((node = sys_dlist_get(&q->wheel_slots[0][slot])) != NULL) {
+				sys_dlist_append(&q->wheel_expired, node);
 			}
-			sys_clock_set_timeout(next_timeout(ticks_elapsed), false);
+			*dt = (int)(tick - q->curr_tick);
+		} else {
+			/* Nothing but a cascade, just move time forward */
+			q->announce_remaining -= (int)(tick - q->curr_tick);
+			q->curr_tick = tick;
 		}
 	}
 
-	return ticks;
+	return CONTAINER_OF(sys_dlist_peek_head(&q->wheel_expired), struct _timeout, node);
 }
 
-int z_abort_timeout(struct _timeout *to)
+/* must be locked */
+static void announce_done(struct timeout_q *q)
 {
-	int ret = -EINVAL;
+	q->wheel_next = wheel_next_event(q, q->curr_tick + q->announce_remaining + 1);
+}
 
-	K_SPINLOCK(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
-			bool is_first = (to == first());
+#ifdef CONFIG_ZTEST
+/* must be locked, moves the wheel to a new current tick preserving the
+ * ticks left on every armed timeout.
+ */
+static void wheel_set_tick(struct timeout_q *q, uint64_t tick)
+{
+	sys_dlist_t pending;
+	sys_dnode_t *node;
+
+	/* Oldest entries first, see wheel_rehash() */
+	sys_dlist_init(&pending);
+	while ((node = sys_dlist_get(&q->wheel_overflow)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
 
-			remove_timeout(to);
-			to->dticks = TIMEOUT_DTICKS_ABORTED;
-			ret = 0;
-			if (is_first) {
-				sys_clock_set_timeout(next_timeout(elapsed()), false);
+	for (int lvl = WHEEL_LEVELS - 1; lvl >= 0; lvl--) {
+		for (unsigned int slot = 0; slot < WHEEL_SLOTS; slot++) {
+			if ((q->wheel_map[lvl] & BIT64(slot)) == 0U) {
+				continue;
 			}
+			while ((node = sys_dlist_get(&q->wheel_slots[lvl][slot])) != NULL) {
+				sys_dlist_append(&pending, node);
+			}
+		}
+		q->wheel_map[lvl] = 0U;
+	}
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+		t->dticks = t->dticks - q->curr_tick + tick;
+		(void)wheel_add(q, t, tick + 1, false);
+	}
+
+	q->curr_tick = tick;
+	q->wheel_next = wheel_next_event(q, q->curr_tick + 1);
+}
+#endif /* CONFIG_ZTEST */
+
+#else
+
+static struct _timeout *first(struct timeout_q *q)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&q->list);
+
+	return (t == NULL) ? NULL : CONTAINER_OF(t, struct _timeout, node);
+}
+
+static struct _timeout *next(struct timeout_q *q, struct _timeout *t)
+{
+	sys_dnode_t *n = sys_dlist_peek_next(&q->list, &t->node);
+
+	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+/* must be locked, returns true if the timeout was the first to expire */
+static bool insert_timeout(struct timeout_q *q, struct _timeout *to)
+{
+	struct _timeout *t;
+
+	for (t = first(q); t != NULL; t = next(q, t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
 		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&q->list, &to->node);
+	}
+
+	return to == first(q);
+}
+
+/* must be locked, returns true if the timeout was the first to expire */
+static bool remove_timeout(struct timeout_q *q, struct _timeout *t)
+{
+	bool is_first = (t == first(q));
+
+	if (next(q, t) != NULL) {
+		next(q, t)->dticks += t->dticks;
+	}
+
+	sys_dlist_remove(&t->node);
+
+	return is_first;
+}
+
+static int32_t next_timeout(struct timeout_q *q, int32_t ticks_elapsed)
+{
+	struct _timeout *to = first(q);
+	int32_t ret;
+
+	if ((to == NULL) ||
+	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+		ret = MAX_WAIT;
+	} else {
+		ret = MAX(0, to->dticks - ticks_elapsed);
 	}
 
 	return ret;
 }
 
 /* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
+static k_ticks_t timeout_rem(struct timeout_q *q, const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+	for (struct _timeout *t = first(q); t != NULL; t = next(q, t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
@@ -193,46 +592,174 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 	return ticks;
 }
 
-k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+/* must be locked, returns the next timeout due within announce_remaining
+ * and the number of ticks until it fires in dt.
+ */
+static struct _timeout *expired_timeout(struct timeout_q *q, int *dt)
+{
+	struct _timeout *t = first(q);
+
+	if ((t != NULL) && (t->dticks <= q->announce_remaining)) {
+		*dt = t->dticks;
+		return t;
+	}
+
+	return NULL;
+}
+
+/* must be locked */
+static void announce_done(struct timeout_q *q)
+{
+	struct _timeout *t = first(q);
+
+	if (t != NULL) {
+		t->dticks -= q->announce_remaining;
+	}
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
 {
 	k_ticks_t ticks = 0;
+	k_spinlock_key_t key;
+	struct timeout_q *q;
+	int32_t ticks_elapsed;
+	bool has_elapsed = false;
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return 0;
+	}
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif /* CONFIG_KERNEL_COHERENCE */
+
+	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	to->fn = fn;
+
+	q = local_q_claim(to, &key);
+
+	if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
+		ticks_elapsed = elapsed(q);
+		has_elapsed = true;
+		to->dticks = timeout.ticks + 1 + ticks_elapsed;
+		ticks = q->curr_tick + to->dticks;
+	} else {
+		k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - q->curr_tick;
+
+		to->dticks = MAX(1, dticks);
+		ticks = timeout.ticks;
+	}
+
+	if (insert_timeout(q, to) && (q->announce_remaining == 0)) {
+		if (!has_elapsed) {
+			/* In case of absolute timeout that is first to expire
+			 * elapsed need to be read from the system clock.
+			 */
+			ticks_elapsed = elapsed(q);
+		}
+		sys_clock_set_timeout(next_timeout(q, ticks_elapsed), false);
+	}
+
+	k_spin_unlock(&q->lock, key);
+
+	return ticks;
+}
+
+int z_abort_timeout(struct _timeout *to)
+{
+	int ret = -EINVAL;
+	k_spinlock_key_t key;
+	struct timeout_q *q = owner_q_lock(to, &key);
+
+	if (sys_dnode_is_linked(&to->node)) {
+		bool is_first = remove_timeout(q, to);
+
+		to->dticks = TIMEOUT_DTICKS_ABORTED;
+		ret = 0;
 
-	K_SPINLOCK(&timeout_lock) {
-		if (!z_is_inactive_timeout(timeout)) {
-			ticks = timeout_rem(timeout) - elapsed();
+		/* Only the owning CPU can program its timer, a timeout
+		 * cancelled from another CPU leaves it armed for one
+		 * spurious interrupt after which it gets reprogrammed.
+		 */
+		if (is_first && is_local_q(q)) {
+			sys_clock_set_timeout(next_timeout(q, elapsed(q)), false);
 		}
 	}
 
+	k_spin_unlock(&q->lock, key);
+
+	return ret;
+}
+
+k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+	k_spinlock_key_t key;
+	struct timeout_q *q = owner_q_lock(timeout, &key);
+
+	if (!z_is_inactive_timeout(timeout)) {
+		ticks = timeout_rem(q, timeout) - elapsed(q);
+	}
+
+	k_spin_unlock(&q->lock, key);
+
 	return ticks;
 }
 
 k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
+	k_spinlock_key_t key;
+	struct timeout_q *q = owner_q_lock(timeout, &key);
 
-	K_SPINLOCK(&timeout_lock) {
-		ticks = curr_tick;
-		if (!z_is_inactive_timeout(timeout)) {
-			ticks += timeout_rem(timeout);
-		}
+	ticks = q->curr_tick;
+	if (!z_is_inactive_timeout(timeout)) {
+		ticks += timeout_rem(q, timeout);
 	}
 
+	k_spin_unlock(&q->lock, key);
+
 	return ticks;
 }
 
 int32_t z_get_next_timeout_expiry(void)
 {
-	int32_t ret = (int32_t) K_TICKS_FOREVER;
+	int32_t ret;
+	k_spinlock_key_t key;
+	struct timeout_q *q = local_q_lock(&key);
+
+	ret = next_timeout(q, elapsed(q));
+
+	k_spin_unlock(&q->lock, key);
 
-	K_SPINLOCK(&timeout_lock) {
-		ret = next_timeout(elapsed());
-	}
 	return ret;
 }
 
 void sys_clock_announce(int32_t ticks)
 {
-	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	k_spinlock_key_t key;
+	struct timeout_q *q;
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	uint64_t now = 0U;
+
+	K_SPINLOCK(&tick_lock) {
+		announced_ticks += ticks;
+		now = announced_ticks;
+	}
+
+	q = local_q_lock(&key);
+
+	/* Catch up with the ticks announced by all CPUs since this queue
+	 * was last processed, not just with those of this interrupt.
+	 */
+	ticks = (int32_t)MIN(now - q->announced, (uint64_t)INT_MAX);
+	q->announced += ticks;
+#else
+	q = local_q_lock(&key);
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
 	/* We release the lock around the callbacks below, so on SMP
 	 * systems someone might be already running the loop.  Don't
@@ -240,41 +767,36 @@ void sys_clock_announce(int32_t ticks)
 	 * timeouts and confuse apps), just increment the tick count
 	 * and return.
 	 */
-	if (IS_ENABLED(CONFIG_SMP) && (announce_remaining != 0)) {
-		announce_remaining += ticks;
-		k_spin_unlock(&timeout_lock, key);
+	if (IS_ENABLED(CONFIG_SMP) && (q->announce_remaining != 0)) {
+		q->announce_remaining += ticks;
+		k_spin_unlock(&q->lock, key);
 		return;
 	}
 
-	announce_remaining = ticks;
+	q->announce_remaining = ticks;
 
 	struct _timeout *t;
+	int dt;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
-
-		curr_tick += dt;
+	for (t = expired_timeout(q, &dt); t != NULL; t = expired_timeout(q, &dt)) {
+		q->curr_tick += dt;
 		t->dticks = 0;
-		remove_timeout(t);
+		(void)remove_timeout(q, t);
 
-		k_spin_unlock(&timeout_lock, key);
+		k_spin_unlock(&q->lock, key);
 		t->fn(t);
-		key = k_spin_lock(&timeout_lock);
-		announce_remaining -= dt;
+		key = k_spin_lock(&q->lock);
+		q->announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
+	announce_done(q);
 
-	curr_tick += announce_remaining;
-	announce_remaining = 0;
+	q->curr_tick += q->announce_remaining;
+	q->announce_remaining = 0;
 
-	sys_clock_set_timeout(next_timeout(0), false);
+	sys_clock_set_timeout(next_timeout(q, lag(q)), false);
 
-	k_spin_unlock(&timeout_lock, key);
+	k_spin_unlock(&q->lock, key);
 
 #ifdef CONFIG_TIMESLICING
 	z_time_slice();
@@ -283,11 +805,14 @@ void sys_clock_announce(int32_t ticks)
 
 int64_t sys_clock_tick_get(void)
 {
-	uint64_t t = 0U;
+	uint64_t t;
+	k_spinlock_key_t key;
+	struct timeout_q *q = local_q_lock(&key);
+
+	t = q->curr_tick + elapsed(q);
+
+	k_spin_unlock(&q->lock, key);
 
-	K_SPINLOCK(&timeout_lock) {
-		t = curr_tick + elapsed();
-	}
 	return t;
 }
 
@@ -296,7 +821,7 @@ uint32_t sys_clock_tick_get_32(void)
 #ifdef CONFIG_TICKLESS_KERNEL
 	return (uint32_t)sys_clock_tick_get();
 #else
-	return (uint32_t)curr_tick;
+	return (uint32_t)timeout_qs[0].curr_tick;
 #endif /* CONFIG_TICKLESS_KERNEL */
 }
 
@@ -353,7 +878,26 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
-	curr_tick = tick;
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	K_SPINLOCK(&tick_lock) {
+		announced_ticks = tick;
+	}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+	for (int i = 0; i < NUM_TIMEOUT_QS; i++) {
+		struct timeout_q *q = &timeout_qs[i];
+
+		K_SPINLOCK(&q->lock) {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+			wheel_set_tick(q, tick);
+#else
+			q->curr_tick = tick;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+			q->announced = tick;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+		}
+	}
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
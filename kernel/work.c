@@ -176,6 +176,265 @@ int k_work_busy_get(const struct k_work *work)
 	return ret;
 }
 
+#if defined(CONFIG_WORKQUEUE_POOL)
+/* Get the pool a queue is the submission queue of.
+ *
+ * @param queue a work queue, possibly null.
+ *
+ * @return the pool, or null if @p queue is not the queue of a pool.
+ */
+static inline struct k_work_q_pool *queue_pool(struct k_work_q *queue)
+{
+	if ((queue == NULL) || !flag_test(&queue->flags, K_WORK_QUEUE_POOL_BIT)) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(queue, struct k_work_q_pool, queue);
+}
+
+/* Find the worker of a pool that runs a work item.
+ *
+ * Invoked with work lock held.
+ */
+static struct k_work_q *pool_runner_locked(struct k_work_q_pool *pool,
+					   const struct k_work *work)
+{
+	for (uint8_t i = 0; i < pool->num_workers; i++) {
+		if (pool->workers[i].running == work) {
+			return &pool->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the worker of a pool that a work item is queued to.
+ *
+ * Invoked with work lock held.
+ */
+static struct k_work_q *pool_holder_locked(struct k_work_q_pool *pool,
+					   struct k_work *work)
+{
+	sys_snode_t *prev;
+
+	for (uint8_t i = 0; i < pool->num_workers; i++) {
+		if (sys_slist_find(&pool->workers[i].pending, &work->node, &prev)) {
+			return &pool->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Check whether the current thread is a worker of a pool. */
+static struct k_work_q *pool_current_worker(struct k_work_q_pool *pool)
+{
+	if (k_is_in_isr()) {
+		return NULL;
+	}
+
+	for (uint8_t i = 0; i < pool->num_workers; i++) {
+		if (pool->workers[i].thread_id == _current) {
+			return &pool->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Select the worker a work item submitted to a pool is queued to.
+ *
+ * A running item is queued to the worker running it so that it cannot
+ * be reentered, and chained submissions stay on the submitting worker.
+ * Otherwise the worker pinned to the current CPU is used, or an idle
+ * worker, falling back to round-robin.
+ *
+ * Invoked with work lock held.
+ */
+static struct k_work_q *pool_select_locked(struct k_work_q_pool *pool,
+					   struct k_work *work)
+{
+	struct k_work_q *worker = NULL;
+	uint8_t n = pool->num_workers;
+	uint8_t i;
+
+	if (flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		worker = pool_runner_locked(pool, work);
+	}
+
+	if (worker == NULL) {
+		worker = pool_current_worker(pool);
+	}
+
+#if defined(CONFIG_SCHED_CPU_MASK)
+	if ((worker == NULL) && pool->pinned && (_current_cpu->id < n)) {
+		worker = &pool->workers[_current_cpu->id];
+	}
+#endif /* defined(CONFIG_SCHED_CPU_MASK) */
+
+	if (worker != NULL) {
+		return worker;
+	}
+
+	for (i = 0; i < n; i++) {
+		worker = &pool->workers[(pool->next_worker + i) % n];
+		if (!flag_test(&worker->flags, K_WORK_QUEUE_BUSY_BIT)
+		    && sys_slist_is_empty(&worker->pending)) {
+			break;
+		}
+	}
+
+	if (i == n) {
+		i = 0;
+		worker = &pool->workers[pool->next_worker % n];
+	}
+
+	pool->next_worker = (pool->next_worker + i + 1U) % n;
+
+	return worker;
+}
+
+/* Wake a worker that got new work, or else any idle worker of its pool
+ * so that it can steal the work.
+ *
+ * Invoked with work lock held.
+ */
+static bool pool_notify_locked(struct k_work_q_pool *pool,
+			       struct k_work_q *worker)
+{
+	if (z_sched_wake(&worker->notifyq, 0, NULL)) {
+		return true;
+	}
+
+	for (uint8_t i = 0; i < pool->num_workers; i++) {
+		if (z_sched_wake(&pool->workers[i].notifyq, 0, NULL)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Check whether the first item pending on a worker may be stolen.
+ *
+ * Flushers must run on the worker of the item they follow, after it, and
+ * items that are running stay on the worker running them.  Neither these
+ * nor an item followed by a flusher can be stolen.
+ */
+static bool pool_stealable(sys_snode_t *node)
+{
+	struct k_work *work = CONTAINER_OF(node, struct k_work, node);
+	sys_snode_t *next = sys_slist_peek_next(node);
+
+	if ((work->handler == handle_flush)
+	    || flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		return false;
+	}
+
+	return (next == NULL)
+		|| (CONTAINER_OF(next, struct k_work, node)->handler != handle_flush);
+}
+
+/* Take the oldest stealable item pending on another worker of a pool.
+ *
+ * Invoked with work lock held.
+ */
+static sys_snode_t *pool_steal_locked(struct k_work_q *thief)
+{
+	struct k_work_q_pool *pool = thief->pool;
+	uint8_t n = pool->num_workers;
+	uint8_t self = thief - pool->workers;
+
+	for (uint8_t i = 1; i < n; i++) {
+		struct k_work_q *victim = &pool->workers[(self + i) % n];
+		sys_snode_t *node = sys_slist_peek_head(&victim->pending);
+
+		if ((node != NULL) && pool_stealable(node)) {
+			return sys_slist_get(&victim->pending);
+		}
+	}
+
+	return NULL;
+}
+
+/* Check whether no worker of a pool is busy or has pending work.
+ *
+ * Invoked with work lock held.
+ */
+static bool pool_idle_locked(struct k_work_q_pool *pool)
+{
+	for (uint8_t i = 0; i < pool->num_workers; i++) {
+		struct k_work_q *worker = &pool->workers[i];
+
+		if (flag_test(&worker->flags, K_WORK_QUEUE_BUSY_BIT)
+		    || !sys_slist_is_empty(&worker->pending)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+#else
+static inline struct k_work_q_pool *queue_pool(struct k_work_q *queue)
+{
+	ARG_UNUSED(queue);
+
+	return NULL;
+}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+
+/* Check whether the current thread animates a queue (or one of the
+ * workers of a pool).
+ */
+static inline bool queue_thread_is_current(struct k_work_q *queue)
+{
+	if (k_is_in_isr()) {
+		return false;
+	}
+
+#if defined(CONFIG_WORKQUEUE_POOL)
+	struct k_work_q_pool *pool = queue_pool(queue);
+
+	if (pool != NULL) {
+		return pool_current_worker(pool) != NULL;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+
+	return _current == queue->thread_id;
+}
+
+/* Get the queue whose flags control a queue: the pool of a pool worker,
+ * the queue itself otherwise.
+ */
+static inline struct k_work_q *queue_control(struct k_work_q *queue)
+{
+#if defined(CONFIG_WORKQUEUE_POOL)
+	if (queue->pool != NULL) {
+		return &queue->pool->queue;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+
+	return queue;
+}
+
+/* Check whether a queue has neither pending nor running work.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool queue_idle_locked(struct k_work_q *queue)
+{
+#if defined(CONFIG_WORKQUEUE_POOL)
+	struct k_work_q_pool *pool = queue_pool(queue);
+
+	if (pool != NULL) {
+		return pool_idle_locked(pool);
+	}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+
+	return !flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT)
+		&& sys_slist_is_empty(&queue->pending);
+}
+
 /* Add a flusher work item to the queue.
  *
  * Invoked with work lock held.
@@ -212,6 +471,14 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
+#if defined(CONFIG_WORKQUEUE_POOL)
+		struct k_work_q_pool *pool = queue_pool(queue);
+
+		if (pool != NULL) {
+			queue = pool_holder_locked(pool, work);
+			__ASSERT_NO_MSG(queue != NULL);
+		}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
 		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
 	}
 }
@@ -231,6 +498,21 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 {
 	bool rv = false;
 
+#if defined(CONFIG_WORKQUEUE_POOL)
+	struct k_work_q_pool *pool = queue_pool(queue);
+
+	if (pool != NULL) {
+		/* Queue state changed, every worker has to look at it */
+		for (uint8_t i = 0; i < pool->num_workers; i++) {
+			if (z_sched_wake(&pool->workers[i].notifyq, 0, NULL)) {
+				rv = true;
+			}
+		}
+
+		return rv;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+
 	if (queue != NULL) {
 		rv = z_sched_wake(&queue->notifyq, 0, NULL);
 	}
@@ -265,7 +547,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret;
-	bool chained = (_current == queue->thread_id) && !k_is_in_isr();
+	bool chained = queue_thread_is_current(queue);
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -282,6 +564,15 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 		ret = -EBUSY;
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
+#if defined(CONFIG_WORKQUEUE_POOL)
+	} else if (queue_pool(queue) != NULL) {
+		struct k_work_q_pool *pool = queue_pool(queue);
+		struct k_work_q *worker = pool_select_locked(pool, work);
+
+		sys_slist_append(&worker->pending, &work->node);
+		ret = 1;
+		(void)pool_notify_locked(pool, worker);
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
 	} else {
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
@@ -448,6 +739,18 @@ static bool work_flush_locked(struct k_work *work,
 
 		__ASSERT_NO_MSG(queue != NULL);
 
+#if defined(CONFIG_WORKQUEUE_POOL)
+		struct k_work_q_pool *pool = queue_pool(queue);
+
+		/* Flush on the worker that holds or runs the item */
+		if (pool != NULL) {
+			queue = flag_test(&work->flags, K_WORK_QUEUED_BIT)
+				? pool_holder_locked(pool, work)
+				: pool_runner_locked(pool, work);
+			__ASSERT_NO_MSG(queue != NULL);
+		}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+
 		queue_flusher_locked(queue, work, flusher);
 		notify_queue_locked(queue);
 	}
@@ -659,6 +962,9 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
 
+	/* Drain and stop requests of a pool worker are made on the pool */
+	struct k_work_q *ctl = queue_control(queue);
+
 	while (true) {
 		sys_snode_t *node;
 		struct k_work *work = NULL;
@@ -668,6 +974,11 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 
 		/* Check for and prepare any new work. */
 		node = sys_slist_get(&queue->pending);
+#if defined(CONFIG_WORKQUEUE_POOL)
+		if ((node == NULL) && (queue->pool != NULL)) {
+			node = pool_steal_locked(queue);
+		}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
@@ -690,8 +1001,11 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
-					       K_WORK_QUEUE_DRAIN_BIT)) {
+#if defined(CONFIG_WORKQUEUE_POOL)
+			queue->running = work;
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+		} else if (flag_test(&ctl->flags, K_WORK_QUEUE_DRAIN_BIT)
+			   && queue_idle_locked(ctl)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
 			 * immediate reschedule; released threads get their
@@ -701,9 +1015,11 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * here doesn't mean that the queue will allow new
 			 * submissions.
 			 */
-			(void)z_sched_wake_all(&queue->drainq, 1, NULL);
-		} else if (flag_test(&queue->flags, K_WORK_QUEUE_STOP_BIT)) {
+			flag_clear(&ctl->flags, K_WORK_QUEUE_DRAIN_BIT);
+			(void)z_sched_wake_all(&ctl->drainq, 1, NULL);
+		} else if (flag_test(&ctl->flags, K_WORK_QUEUE_STOP_BIT)) {
 			/* User has requested that the queue stop. Clear the status flags and exit.
+			 * The flags of a pool are cleared once all its workers exited.
 			 */
 			flags_set(&queue->flags, 0);
 			k_spin_unlock(&lock, key);
@@ -748,6 +1064,9 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
 
 		flag_clear(&work->flags, K_WORK_RUNNING_BIT);
+#if defined(CONFIG_WORKQUEUE_POOL)
+		queue->running = NULL;
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
 		if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
 			finalize_flush_locked(work);
 		}
@@ -805,24 +1124,27 @@ void k_work_queue_run(struct k_work_q *queue, const struct k_work_queue_config *
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
 	queue->thread_id = _current;
+#if defined(CONFIG_WORKQUEUE_POOL)
+	queue->pool = NULL;
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
 	flags_set(&queue->flags, flags);
 	work_queue_main(queue, NULL, NULL);
 }
 
-void k_work_queue_start(struct k_work_q *queue,
-			k_thread_stack_t *stack,
-			size_t stack_size,
-			int prio,
-			const struct k_work_queue_config *cfg)
+/* Set up a work queue and create its thread, without starting it.
+ *
+ * @param queue the queue to set up.
+ * @param stack, stack_size, prio thread parameters.
+ * @param cfg optional additional configuration parameters.
+ */
+static void work_queue_create(struct k_work_q *queue,
+			      k_thread_stack_t *stack,
+			      size_t stack_size,
+			      int prio,
+			      const struct k_work_queue_config *cfg)
 {
-	__ASSERT_NO_MSG(queue);
-	__ASSERT_NO_MSG(stack);
-	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
-
 	uint32_t flags = K_WORK_QUEUE_STARTED;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
-
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
@@ -857,12 +1179,80 @@ void k_work_queue_start(struct k_work_q *queue,
 	}
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
 
-	k_thread_start(&queue->thread);
 	queue->thread_id = &queue->thread;
+}
+
+void k_work_queue_start(struct k_work_q *queue,
+			k_thread_stack_t *stack,
+			size_t stack_size,
+			int prio,
+			const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(stack);
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+#if defined(CONFIG_WORKQUEUE_POOL)
+	queue->pool = NULL;
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+	work_queue_create(queue, stack, stack_size, prio, cfg);
+	k_thread_start(&queue->thread);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#if defined(CONFIG_WORKQUEUE_POOL)
+void k_work_q_pool_start(struct k_work_q_pool *pool, int prio,
+			 const struct k_work_queue_config *cfg)
+{
+	struct k_work_q *queue;
+
+	__ASSERT_NO_MSG(pool);
+	__ASSERT_NO_MSG(pool->num_workers > 0U);
+
+	queue = &pool->queue;
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	/* The pool queue only holds the queue state, items are kept by
+	 * the workers.
+	 */
+	sys_slist_init(&queue->pending);
+	z_waitq_init(&queue->notifyq);
+	z_waitq_init(&queue->drainq);
+	queue->thread_id = NULL;
+	queue->pool = NULL;
+	pool->next_worker = 0U;
+	pool->pinned = IS_ENABLED(CONFIG_SCHED_CPU_MASK) && (cfg != NULL) && cfg->pin_workers;
+
+	for (uint8_t i = 0; i < pool->num_workers; i++) {
+		struct k_work_q *worker = &pool->workers[i];
+
+		work_queue_create(worker, pool->stacks + (i * pool->stack_len),
+				  pool->stack_size, prio, cfg);
+		worker->pool = pool;
+		worker->running = NULL;
+
+#if defined(CONFIG_SCHED_CPU_MASK)
+		if (pool->pinned) {
+			(void)k_thread_cpu_pin(&worker->thread, i % arch_num_cpus());
+		}
+#endif /* defined(CONFIG_SCHED_CPU_MASK) */
+	}
+
+	flags_set(&queue->flags, K_WORK_QUEUE_STARTED | K_WORK_QUEUE_POOL);
+
+	for (uint8_t i = 0; i < pool->num_workers; i++) {
+		k_thread_start(&pool->workers[i].thread);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
+}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -874,10 +1264,9 @@ int k_work_queue_drain(struct k_work_q *queue,
 	int ret = 0;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	if (((flags_get(&queue->flags)
-	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
+	if (flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT)
 	    || plug
-	    || !sys_slist_is_empty(&queue->pending)) {
+	    || !queue_idle_locked(queue)) {
 		flag_set(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 		if (plug) {
 			flag_set(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
@@ -938,6 +1327,33 @@ int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout)
 	notify_queue_locked(queue);
 	k_spin_unlock(&lock, key);
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_work_queue, stop, queue, timeout);
+#if defined(CONFIG_WORKQUEUE_POOL)
+	struct k_work_q_pool *pool = queue_pool(queue);
+
+	if (pool != NULL) {
+		k_timepoint_t end = sys_timepoint_calc(timeout);
+
+		for (uint8_t i = 0; i < pool->num_workers; i++) {
+			if (k_thread_join(pool->workers[i].thread_id,
+					  sys_timepoint_timeout(end))) {
+				key = k_spin_lock(&lock);
+				flag_clear(&queue->flags, K_WORK_QUEUE_STOP_BIT);
+				k_spin_unlock(&lock, key);
+				SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, stop, queue, timeout,
+							       -ETIMEDOUT);
+				return -ETIMEDOUT;
+			}
+		}
+
+		/* Workers are gone, the pool can be started again */
+		key = k_spin_lock(&lock);
+		flags_set(&queue->flags, K_WORK_QUEUE_POOL);
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, stop, queue, timeout, 0);
+		return 0;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
 	if (k_thread_join(queue->thread_id, timeout)) {
 		key = k_spin_lock(&lock);
 		flag_clear(&queue->flags, K_WORK_QUEUE_STOP_BIT);
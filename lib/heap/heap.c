@@ -148,6 +148,134 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* Chunks in the size class lists stay marked used, so that they never
+ * get merged with a neighbor, carry the cached flag and are linked
+ * through FREE_PREV and FREE_NEXT (0 terminated). Only chunks whose
+ * neighbors are both allocated are cached, and a cached chunk is taken
+ * back out of its list as soon as one of its neighbors is freed, so that
+ * caching never gets in the way of coalescing free space.
+ */
+static bool size_class_free(struct sys_heap *heap, chunkid_t c)
+{
+	struct z_heap *h = heap->heap;
+	chunksz_t sz = chunk_size(h, c);
+	chunkid_t lc = left_chunk(h, c), rc = right_chunk(h, c);
+	chunkid_t next;
+
+	if ((sz >= Z_HEAP_SIZE_CLASS_COUNT) ||
+	    !chunk_used(h, lc) || chunk_cached(h, lc) ||
+	    !chunk_used(h, rc) || chunk_cached(h, rc)) {
+		return false;
+	}
+
+	next = heap->size_classes[sz];
+	set_chunk_cached(h, c, true);
+	set_prev_free_chunk(h, c, 0);
+	set_next_free_chunk(h, c, next);
+	if (next != 0U) {
+		set_prev_free_chunk(h, next, c);
+	}
+	heap->size_classes[sz] = c;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes += chunksz_to_bytes(h, sz);
+#endif
+
+	return true;
+}
+
+static void size_class_remove(struct sys_heap *heap, chunkid_t c)
+{
+	struct z_heap *h = heap->heap;
+	chunksz_t sz = chunk_size(h, c);
+	chunkid_t prev = prev_free_chunk(h, c), next = next_free_chunk(h, c);
+
+	CHECK(chunk_used(h, c) && chunk_cached(h, c));
+
+	if (prev == 0U) {
+		heap->size_classes[sz] = next;
+	} else {
+		set_next_free_chunk(h, prev, next);
+	}
+	if (next != 0U) {
+		set_prev_free_chunk(h, next, prev);
+	}
+	set_chunk_cached(h, c, false);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes -= chunksz_to_bytes(h, sz);
+#endif
+}
+
+static chunkid_t size_class_alloc(struct sys_heap *heap, chunksz_t sz)
+{
+	chunkid_t c;
+
+	if (sz >= Z_HEAP_SIZE_CLASS_COUNT) {
+		return 0;
+	}
+
+	c = heap->size_classes[sz];
+	if (c != 0U) {
+		CHECK(chunk_size(heap->heap, c) == sz);
+		size_class_remove(heap, c);
+	}
+
+	return c;
+}
+
+/* Return @a c to the heap free lists if it is cached, called before one
+ * of its neighbors is freed or shrunk so that they can be merged.
+ */
+static void size_class_uncache(struct sys_heap *heap, chunkid_t c)
+{
+	struct z_heap *h = heap->heap;
+
+	if (chunk_cached(h, c)) {
+		size_class_remove(heap, c);
+		set_chunk_used(h, c, false);
+		free_list_add(h, c);
+	}
+}
+
+/* Merge every chunk of the size class lists back into the heap */
+static bool size_class_flush(struct sys_heap *heap)
+{
+	bool flushed = false;
+	chunkid_t c;
+
+	for (chunksz_t sz = 0; sz < Z_HEAP_SIZE_CLASS_COUNT; sz++) {
+		while ((c = size_class_alloc(heap, sz)) != 0U) {
+			set_chunk_used(heap->heap, c, false);
+			free_chunk(heap->heap, c);
+			flushed = true;
+		}
+	}
+
+	return flushed;
+}
+#else
+static inline bool size_class_free(struct sys_heap *heap, chunkid_t c)
+{
+	return false;
+}
+
+static inline chunkid_t size_class_alloc(struct sys_heap *heap, chunksz_t sz)
+{
+	return 0;
+}
+
+static inline void size_class_uncache(struct sys_heap *heap, chunkid_t c)
+{
+}
+
+static inline bool size_class_flush(struct sys_heap *heap)
+{
+	return false;
+}
+#endif /* CONFIG_SYS_HEAP_SIZE_CLASSES */
+
 /*
  * Return the closest chunk ID corresponding to given memory pointer.
  * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
@@ -174,6 +302,8 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 	 */
 	__ASSERT(chunk_used(h, c),
 		 "unexpected heap state (double-free?) for memory at %p", mem);
+	/* Chunks in the size class lists are marked used as well */
+	__ASSERT(!chunk_cached(h, c), "double free of cached memory at %p", mem);
 
 	/*
 	 * It is easy to catch many common memory overflow cases with
@@ -184,7 +314,6 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
@@ -194,6 +323,13 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 				  chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+	if (size_class_free(heap, c)) {
+		return;
+	}
+	size_class_uncache(heap, left_chunk(h, c));
+	size_class_uncache(heap, right_chunk(h, c));
+
+	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
@@ -270,19 +406,26 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes, 0);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c = size_class_alloc(heap, chunk_sz);
 
 	if (c == 0U) {
-		return NULL;
-	}
+		c = alloc_chunk(h, chunk_sz);
+		/* Last resort: merge the cached small chunks back and retry */
+		if ((c == 0U) && size_class_flush(heap)) {
+			c = alloc_chunk(h, chunk_sz);
+		}
+		if (c == 0U) {
+			return NULL;
+		}
 
-	/* Split off remainder if any */
-	if (chunk_size(h, c) > chunk_sz) {
-		split_chunks(h, c, c + chunk_sz);
-		free_list_add(h, c + chunk_sz);
-	}
+		/* Split off remainder if any */
+		if (chunk_size(h, c) > chunk_sz) {
+			split_chunks(h, c, c + chunk_sz);
+			free_list_add(h, c + chunk_sz);
+		}
 
-	set_chunk_used(h, c, true);
+		set_chunk_used(h, c, true);
+	}
 
 	mem = chunk_mem(h, c);
 
@@ -343,6 +486,9 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	chunksz_t padded_sz = bytes_to_chunksz(h, bytes, align - gap);
 	chunkid_t c0 = alloc_chunk(h, padded_sz);
 
+	if ((c0 == 0) && size_class_flush(heap)) {
+		c0 = alloc_chunk(h, padded_sz);
+	}
 	if (c0 == 0) {
 		return NULL;
 	}
@@ -409,6 +555,7 @@ static bool inplace_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
 			(chunk_size(h, c) - chunks_need) * CHUNK_UNIT;
 #endif
 
+		size_class_uncache(heap, right_chunk(h, c));
 		split_chunks(h, c, c + chunks_need);
 		set_chunk_used(h, c, true);
 		free_chunk(h, c + chunks_need);
@@ -557,6 +704,12 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->max_allocated_bytes = 0;
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	for (int i = 0; i < Z_HEAP_SIZE_CLASS_COUNT; i++) {
+		heap->size_classes[i] = 0;
+	}
+#endif
+
 #if CONFIG_SYS_HEAP_ARRAY_SIZE
 	sys_heap_array_save(heap);
 #endif
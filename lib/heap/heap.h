@@ -40,6 +40,10 @@
  *   FREE_PREV: Chunk ID of the previous node in a free list.
  *   FREE_NEXT: Chunk ID of the next node in a free list.
  *
+ * With CONFIG_SYS_HEAP_SIZE_CLASSES, the top bit of LEFT_SIZE, which a
+ * chunk size never reaches, flags a used chunk that is parked in a size
+ * class list rather than handed out.
+ *
  * The free lists are circular lists, one for each power-of-two size
  * category.  The free list pointers exist only for free chunks,
  * obviously.  This memory is part of the user's buffer when
@@ -196,9 +200,20 @@ static inline void set_next_free_chunk(struct z_heap *h, chunkid_t c,
 	chunk_set(h, c, FREE_NEXT, next);
 }
 
+static inline chunksz_t left_size_cached_bit(struct z_heap *h)
+{
+	return big_heap(h) ? BIT(31) : BIT(15);
+}
+
 static inline chunkid_t left_chunk(struct z_heap *h, chunkid_t c)
 {
-	return c - chunk_field(h, c, LEFT_SIZE);
+	chunksz_t lsz = chunk_field(h, c, LEFT_SIZE);
+
+	if (IS_ENABLED(CONFIG_SYS_HEAP_SIZE_CLASSES)) {
+		lsz &= ~left_size_cached_bit(h);
+	}
+
+	return c - lsz;
 }
 
 static inline chunkid_t right_chunk(struct z_heap *h, chunkid_t c)
@@ -206,12 +221,29 @@ static inline chunkid_t right_chunk(struct z_heap *h, chunkid_t c)
 	return c + chunk_size(h, c);
 }
 
+/*
+ * Note: this clears the cached flag, a cached chunk is taken out of its
+ * size class list before its left neighbor may change size.
+ */
 static inline void set_left_chunk_size(struct z_heap *h, chunkid_t c,
 				       chunksz_t size)
 {
 	chunk_set(h, c, LEFT_SIZE, size);
 }
 
+static inline bool chunk_cached(struct z_heap *h, chunkid_t c)
+{
+	return IS_ENABLED(CONFIG_SYS_HEAP_SIZE_CLASSES) &&
+	       ((chunk_field(h, c, LEFT_SIZE) & left_size_cached_bit(h)) != 0U);
+}
+
+static inline void set_chunk_cached(struct z_heap *h, chunkid_t c, bool cached)
+{
+	chunksz_t lsz = chunk_field(h, c, LEFT_SIZE) & ~left_size_cached_bit(h);
+
+	chunk_set(h, c, LEFT_SIZE, cached ? (lsz | left_size_cached_bit(h)) : lsz);
+}
+
 static inline bool solo_free_header(struct z_heap *h, chunkid_t c)
 {
 	return big_heap(h) && (chunk_size(h, c) == 1U);
@@ -264,16 +296,18 @@ static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 	return 31 - __builtin_clz(usable_sz);
 }
 
-static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
+static inline void get_alloc_info(struct sys_heap *heap, size_t *alloc_bytes,
 			   size_t *free_bytes)
 {
+	struct z_heap *h = heap->heap;
 	chunkid_t c;
 
 	*alloc_bytes = 0;
 	*free_bytes = 0;
 
 	for (c = right_chunk(h, 0); c < h->end_chunk; c = right_chunk(h, c)) {
-		if (chunk_used(h, c)) {
+		/* Chunks in the size class lists are marked used but are free */
+		if (chunk_used(h, c) && !chunk_cached(h, c)) {
 			*alloc_bytes += chunksz_to_bytes(h, chunk_size(h, c));
 		} else if (!solo_free_header(h, c)) {
 			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
@@ -35,6 +35,14 @@ static bool valid_chunk(struct z_heap *h, chunkid_t c)
 	VALIDATE(in_bounds(h, c));
 	VALIDATE(right_chunk(h, left_chunk(h, c)) == c);
 	VALIDATE(left_chunk(h, right_chunk(h, c)) == c);
+	if (chunk_cached(h, c)) {
+		/* A cached chunk never stands in the way of a merge */
+		VALIDATE(chunk_used(h, c));
+		VALIDATE(chunk_used(h, left_chunk(h, c)));
+		VALIDATE(!chunk_cached(h, left_chunk(h, c)));
+		VALIDATE(chunk_used(h, right_chunk(h, c)));
+		VALIDATE(!chunk_cached(h, right_chunk(h, c)));
+	}
 	if (chunk_used(h, c)) {
 		VALIDATE(!solo_free_header(h, c));
 	} else {
@@ -85,6 +93,24 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Size class list entries are cached chunks of exactly their size */
+	for (chunksz_t sz = 0; sz < Z_HEAP_SIZE_CLASS_COUNT; sz++) {
+		chunkid_t prev = 0;
+		uint32_t n = 0;
+
+		for (c = heap->size_classes[sz]; c != 0; c = next_free_chunk(h, c)) {
+			if (!in_bounds(h, c) || !valid_chunk(h, c) ||
+			    !chunk_cached(h, c) || (chunk_size(h, c) != sz) ||
+			    (prev_free_chunk(h, c) != prev) ||
+			    (++n > h->end_chunk)) {
+				return false;
+			}
+			prev = c;
+		}
+	}
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	/*
 	 * Validate sys_heap_runtime_stats_get API.
@@ -95,7 +121,7 @@ bool sys_heap_validate(struct sys_heap *heap)
 	size_t allocated_bytes, free_bytes;
 	struct sys_memory_stats stat;
 
-	get_alloc_info(h, &allocated_bytes, &free_bytes);
+	get_alloc_info(heap, &allocated_bytes, &free_bytes);
 	sys_heap_runtime_stats_get(heap, &stat);
 	if ((stat.allocated_bytes != allocated_bytes) ||
 	    (stat.free_bytes != free_bytes)) {
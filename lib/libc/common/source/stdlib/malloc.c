@@ -137,13 +137,255 @@ malloc_unlock(void)
 #define malloc_unlock()
 #endif
 
+#ifdef CONFIG_COMMON_LIBC_MALLOC_THREAD_CACHE
+
+/*
+ * Small blocks freed by a thread are kept on exact-size lists owned by
+ * that thread, linked through their first word, and returned by its
+ * later malloc() calls without taking the heap mutex. Only the owner
+ * ever touches its cache. Caches are also registered on a list, under
+ * the heap mutex, so that those of threads that exited can be found and
+ * returned to the heap by another thread.
+ */
+#define CACHE_UNIT	8U
+#define CACHE_BINS	(CONFIG_COMMON_LIBC_MALLOC_THREAD_CACHE_MAX / CACHE_UNIT + 1U)
+
+struct malloc_cache {
+	sys_snode_t node;
+	k_tid_t owner;
+	void *bins[CACHE_BINS];
+	size_t bytes;
+};
+
+static Z_THREAD_LOCAL struct malloc_cache *thread_cache;
+
+/* Registered caches, protected by the heap mutex */
+static sys_slist_t caches = SYS_SLIST_STATIC_INIT(&caches);
+
+static void free_chain(void *mem)
+{
+	while (mem != NULL) {
+		void *next = *(void **)mem;
+
+		sys_heap_free(&z_malloc_heap, mem);
+		mem = next;
+	}
+}
+
+/* Called with the heap mutex held */
+static void cache_flush(struct malloc_cache *cache)
+{
+	for (size_t i = 0; i < CACHE_BINS; i++) {
+		free_chain(cache->bins[i]);
+		cache->bins[i] = NULL;
+	}
+	cache->bytes = 0;
+}
+
+struct owner_search {
+	k_tid_t owner;
+	bool found;
+};
+
+static void owner_search_cb(const struct k_thread *thread, void *user_data)
+{
+	struct owner_search *search = user_data;
+
+	if (thread == search->owner) {
+		search->found = true;
+	}
+}
+
+/*
+ * Called with the heap mutex held, returns true if anything was freed.
+ *
+ * Frees the caches of the threads that are no longer running. The
+ * thread list is searched rather than the owner dereferenced, as its
+ * struct k_thread may have been freed or reused since. A reused struct
+ * keeps a stale cache alive until its current thread also exits, or
+ * creates its own cache.
+ */
+static bool cache_sweep(void)
+{
+	struct malloc_cache *cache, *tmp, *prev = NULL;
+	bool freed = false;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&caches, cache, tmp, node) {
+		struct owner_search search = { .owner = cache->owner };
+
+		if (cache == thread_cache) {
+			prev = cache;
+			continue;
+		}
+
+		if (search.owner != k_current_get()) {
+			k_thread_foreach(owner_search_cb, &search);
+		}
+
+		if (search.found) {
+			prev = cache;
+			continue;
+		}
+
+		sys_slist_remove(&caches, prev != NULL ? &prev->node : NULL, &cache->node);
+		cache_flush(cache);
+		sys_heap_free(&z_malloc_heap, cache);
+		freed = true;
+	}
+
+	return freed;
+}
+
+/* Called with the heap mutex held */
+static struct malloc_cache *cache_create(void)
+{
+	struct malloc_cache *cache;
+
+	(void)cache_sweep();
+
+	cache = sys_heap_alloc(&z_malloc_heap, sizeof(*cache));
+	if (cache != NULL) {
+		(void)memset(cache, 0, sizeof(*cache));
+		cache->owner = k_current_get();
+		sys_slist_append(&caches, &cache->node);
+		thread_cache = cache;
+	}
+
+	return cache;
+}
+
+/* Called with the heap mutex held, returns true if anything was freed */
+static bool cache_reclaim(void)
+{
+	struct malloc_cache *cache = k_is_in_isr() ? NULL : thread_cache;
+	bool freed = false;
+
+	if (cache != NULL && cache->bytes != 0U) {
+		cache_flush(cache);
+		freed = true;
+	}
+
+	if (cache_sweep()) {
+		freed = true;
+	}
+
+	return freed;
+}
+
+static inline void *cache_alloc(size_t size)
+{
+	size_t bin = DIV_ROUND_UP(size, CACHE_UNIT);
+	struct malloc_cache *cache;
+	void *mem;
+
+	if (size == 0U || bin >= CACHE_BINS || k_is_in_isr()) {
+		return NULL;
+	}
+
+	cache = thread_cache;
+	if (cache == NULL) {
+		return NULL;
+	}
+
+	mem = cache->bins[bin];
+	if (mem != NULL) {
+		cache->bins[bin] = *(void **)mem;
+		cache->bytes -= (bin + 1U) * CACHE_UNIT;
+	}
+
+	return mem;
+}
+
+/*
+ * Takes the heap mutex only to create the cache of the thread, or to
+ * return the cached blocks to the heap when the cache is full.
+ */
+static inline bool cache_free(void *ptr)
+{
+	struct malloc_cache *cache;
+	size_t bin;
+
+	if (ptr == NULL || k_is_in_isr()) {
+		return false;
+	}
+
+	/*
+	 * The size in the chunk header of an allocated block only changes
+	 * when the block itself is freed or reallocated, which only the
+	 * caller may do: it can be read without the heap mutex.
+	 *
+	 * The blocks of a size class may be larger than the class by up
+	 * to CACHE_UNIT - 1 bytes: count each one at its upper bound so
+	 * the budget is never exceeded.
+	 */
+	bin = sys_heap_usable_size(&z_malloc_heap, ptr) / CACHE_UNIT;
+	if (bin >= CACHE_BINS) {
+		return false;
+	}
+
+	cache = thread_cache;
+	if (cache == NULL) {
+		malloc_lock();
+		cache = cache_create();
+		malloc_unlock();
+		if (cache == NULL) {
+			return false;
+		}
+	} else if (cache->bytes + (bin + 1U) * CACHE_UNIT >
+		   CONFIG_COMMON_LIBC_MALLOC_THREAD_CACHE_SIZE) {
+		malloc_lock();
+		cache_flush(cache);
+		malloc_unlock();
+	}
+
+	*(void **)ptr = cache->bins[bin];
+	cache->bins[bin] = ptr;
+	cache->bytes += (bin + 1U) * CACHE_UNIT;
+
+	return true;
+}
+
+#else
+
+static inline bool cache_reclaim(void)
+{
+	return false;
+}
+
+static inline void *cache_alloc(size_t size)
+{
+	ARG_UNUSED(size);
+
+	return NULL;
+}
+
+static inline bool cache_free(void *ptr)
+{
+	ARG_UNUSED(ptr);
+
+	return false;
+}
+
+#endif /* CONFIG_COMMON_LIBC_MALLOC_THREAD_CACHE */
+
 void *malloc(size_t size)
 {
+	void *ret = cache_alloc(size);
+
+	if (ret != NULL) {
+		return ret;
+	}
+
 	malloc_lock();
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   __alignof__(z_max_align_t),
-					   size);
+	ret = sys_heap_aligned_alloc(&z_malloc_heap,
+				     __alignof__(z_max_align_t),
+				     size);
+	if (ret == NULL && size != 0 && cache_reclaim()) {
+		ret = sys_heap_aligned_alloc(&z_malloc_heap,
+					     __alignof__(z_max_align_t),
+					     size);
+	}
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
@@ -155,11 +397,26 @@ void *malloc(size_t size)
 
 void *aligned_alloc(size_t alignment, size_t size)
 {
+	void *ret = NULL;
+
+	/* Every block in a thread cache is aligned for any type */
+	if (alignment <= __alignof__(z_max_align_t)) {
+		ret = cache_alloc(size);
+		if (ret != NULL) {
+			return ret;
+		}
+	}
+
 	malloc_lock();
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   alignment,
-					   size);
+	ret = sys_heap_aligned_alloc(&z_malloc_heap,
+				     alignment,
+				     size);
+	if (ret == NULL && size != 0 && cache_reclaim()) {
+		ret = sys_heap_aligned_alloc(&z_malloc_heap,
+					     alignment,
+					     size);
+	}
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
@@ -246,6 +503,12 @@ void *realloc(void *ptr, size_t requested_size)
 					     __alignof__(z_max_align_t),
 					     requested_size);
 
+	if (ret == NULL && requested_size != 0 && cache_reclaim()) {
+		ret = sys_heap_aligned_realloc(&z_malloc_heap, ptr,
+					       __alignof__(z_max_align_t),
+					       requested_size);
+	}
+
 	if (ret == NULL && requested_size != 0) {
 		errno = ENOMEM;
 	}
@@ -257,6 +520,10 @@ void *realloc(void *ptr, size_t requested_size)
 
 void free(void *ptr)
 {
+	if (cache_free(ptr)) {
+		return;
+	}
+
 	malloc_lock();
 	sys_heap_free(&z_malloc_heap, ptr);
 	malloc_unlock();
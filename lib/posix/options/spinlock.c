@@ -15,10 +15,12 @@ union _spinlock_storage {
 	struct k_spinlock lock;
 	uint8_t byte;
 };
-#if !defined(CONFIG_CPP) && !defined(CONFIG_SMP) && !defined(CONFIG_SPIN_VALIDATE)
+#if !defined(CONFIG_CPP) && !defined(CONFIG_SMP) && !defined(CONFIG_SPIN_VALIDATE) &&            \
+	!defined(CONFIG_LOCK_STATS)
 BUILD_ASSERT(sizeof(struct k_spinlock) == 0,
 	     "please remove the _spinlock_storage workaround if, at some point, k_spinlock is no "
-	     "longer zero bytes when CONFIG_SMP=n && CONFIG_SPIN_VALIDATE=n");
+	     "longer zero bytes when CONFIG_SMP=n && CONFIG_SPIN_VALIDATE=n && "
+	     "CONFIG_LOCK_STATS=n");
 #endif
 
 static union _spinlock_storage posix_spinlock_pool[CONFIG_MAX_PTHREAD_SPINLOCK_COUNT];
@@ -12,8 +12,12 @@ This translate stack samples captured by perf subsystem into format
 used by flamegraph.pl. Translation uses .elf file to get function names
 from addresses
 
+The output of "perf folded" is accepted as well, its addresses are translated
+to function names and the names of functions already resolved on target are
+kept as they are.
+
 Usage:
-    ./script/perf/stackcollapse.py <file with perf printbuf output> <ELF file>
+    ./script/perf/stackcollapse.py <file with perf printbuf or folded output> <ELF file>
 """
 
 import re
@@ -54,12 +58,29 @@ def collapse(buf, elf):
         buf = buf[8 + 8 * count:]
 
 
+def collapse_folded(lines, elf):
+    for line in lines:
+        stack, count = line.rsplit(" ", 1)
+        funcs = []
+        for frame in stack.split(";"):
+            func = addr_to_sym(int(frame, 16), elf) if frame.startswith("0x") else frame
+            # merge dublicate functions
+            if not funcs or funcs[-1] != func:
+                funcs.append(func)
+
+        print(";".join(funcs), count)
+
+
 if __name__ == "__main__":
     elf = ELFFile(open(sys.argv[2], "rb"))
     with open(sys.argv[1], "r") as f:
         inp = f.read()
 
     lines = inp.splitlines()
+    if not lines[0].startswith("Perf buf length"):
+        collapse_folded(lines, elf)
+        sys.exit(0)
+
     assert int(re.match(r"Perf buf length (\d+)", lines[0]).group(1)) == len(lines) - 1
     buf = binascii.unhexlify("".join(lines[1:]))
     collapse(buf, elf)
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to rebuild a standard CTF trace from the output of
+CONFIG_TRACING_CTF_COMPACT, merging the streams of the CPUs by timestamp when
+CONFIG_TRACING_BUFFER_PER_CPU is enabled as well.
+
+Capture the tracing output to a file as usual, for example with
+trace_capture_uart.py, then:
+
+    ./scripts/tracing/merge_compact_ctf.py -i channel0_0 -o ctf
+    ./scripts/tracing/parse_ctf.py -t ctf
+
+Use --per-cpu for the output of CONFIG_TRACING_BUFFER_PER_CPU.
+"""
+
+import argparse
+import heapq
+import os
+import shutil
+import struct
+import sys
+
+# Record giving the id and the name of a thread reference
+THREAD_INTERN = 0xFF
+# Record giving the absolute timestamp the next deltas are relative to
+TIMESTAMP = 0xFE
+
+# Events whose thread id and name are replaced with a thread reference
+THREAD_EVENTS = {
+    0x10,  # thread_switched_out
+    0x11,  # thread_switched_in
+    0x12,  # thread_priority_set
+    0x13,  # thread_create
+    0x14,  # thread_abort
+    0x15,  # thread_suspend
+    0x16,  # thread_resume
+    0x17,  # thread_ready
+    0x18,  # thread_pending
+    0x19,  # thread_info
+    0x1A,  # thread_name_set
+    0x34,  # thread_user_mode_enter
+    0x35,  # thread_wakeup
+}
+
+THREAD_LEN = 4 + 20
+
+# Header of the chunks of CONFIG_TRACING_BUFFER_PER_CPU: magic, CPU, length
+CHUNK_MAGIC = 0xC7
+CHUNK_HEADER = struct.Struct("<BBH")
+
+METADATA = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)), "..", "..", "subsys", "tracing", "ctf", "tsdl",
+    "metadata")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter,
+        allow_abbrev=False)
+    parser.add_argument("-i", "--input", required=True, help="compact tracing output")
+    parser.add_argument("-o", "--output", required=True,
+                        help="CTF trace directory to create, with metadata and channel0_0")
+    parser.add_argument("--per-cpu", action="store_true",
+                        help="input comes from a buffer per CPU")
+    parser.add_argument("-m", "--metadata", default=METADATA, help="CTF metadata file")
+    return parser.parse_args()
+
+
+def split_chunks(data):
+    """Return the concatenated chunks of every CPU."""
+    streams = {}
+    offset = 0
+
+    while offset + CHUNK_HEADER.size <= len(data):
+        magic, cpu, length = CHUNK_HEADER.unpack_from(data, offset)
+        if magic != CHUNK_MAGIC:
+            sys.exit(f"Bad chunk header at offset {offset}")
+        offset += CHUNK_HEADER.size
+        streams.setdefault(cpu, bytearray()).extend(data[offset:offset + length])
+        offset += length
+
+    return streams
+
+
+def read_varint(data, offset):
+    value = 0
+    shift = 0
+
+    while True:
+        if offset >= len(data):
+            raise IndexError
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte < 0x80:
+            return value, offset
+
+
+def decode(data):
+    """Yield (timestamp, id, fields) for the events of one stream."""
+    threads = {}
+    timestamp = 0
+    offset = 0
+
+    while offset < len(data):
+        try:
+            event_id = data[offset]
+            length, offset_fields = read_varint(data, offset + 1)
+            delta, offset_fields = read_varint(data, offset_fields)
+        except IndexError:
+            break
+
+        fields = bytes(data[offset_fields:offset_fields + length])
+        if len(fields) < length:
+            # Truncated capture
+            break
+
+        offset = offset_fields + length
+        timestamp += delta
+
+        if event_id == TIMESTAMP:
+            timestamp = struct.unpack("<Q", fields)[0]
+            continue
+
+        if event_id == THREAD_INTERN:
+            threads[fields[0]] = fields[1:1 + THREAD_LEN]
+            continue
+
+        if event_id in THREAD_EVENTS:
+            thread = threads.get(fields[0])
+            if thread is None:
+                sys.exit(f"Unknown thread reference {fields[0]} at {timestamp} ns")
+            fields = thread + fields[1:]
+
+        yield timestamp, event_id, fields
+
+
+def main():
+    args = parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    if args.per_cpu:
+        streams = split_chunks(data)
+    else:
+        streams = {0: data}
+
+    events = heapq.merge(*(decode(stream) for _, stream in sorted(streams.items())),
+                         key=lambda event: event[0])
+
+    os.makedirs(args.output, exist_ok=True)
+    shutil.copy(args.metadata, os.path.join(args.output, "metadata"))
+
+    count = 0
+    with open(os.path.join(args.output, "channel0_0"), "wb") as f:
+        for timestamp, event_id, fields in events:
+            f.write(struct.pack("<IB", timestamp & 0xFFFFFFFF, event_id))
+            f.write(fields)
+            count += 1
+
+    print(f"{count} events from {len(streams)} stream(s) written to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
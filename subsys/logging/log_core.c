@@ -12,6 +12,7 @@
 #include <zephyr/sys/mpsc_pbuf.h>
 #include <zephyr/logging/log_link.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/kernel_structs.h>
 #include <zephyr/sys_clock.h>
 #include <zephyr/sys/clock.h>
 #include <zephyr/init.h>
@@ -56,6 +57,12 @@ LOG_MODULE_REGISTER(log);
 #define CONFIG_LOG_BUFFER_SIZE 4
 #endif
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+#define LOG_CPU_COUNT CONFIG_MP_MAX_NUM_CPUS
+#else
+#define LOG_CPU_COUNT 1
+#endif
+
 #ifdef CONFIG_LOG_PROCESS_THREAD_CUSTOM_PRIORITY
 #define LOG_PROCESS_THREAD_PRIORITY CONFIG_LOG_PROCESS_THREAD_PRIORITY
 #else
@@ -125,7 +132,7 @@ static struct mpsc_pbuf_buffer *curr_log_buffer;
 
 #ifdef CONFIG_MPSC_PBUF
 static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
-	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int) / LOG_CPU_COUNT];
 
 static void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
 			      const union mpsc_pbuf_generic *item);
@@ -142,6 +149,34 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 };
 #endif
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* CPU 0 uses log_buffer, the other CPUs have a buffer of the same size each. */
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	cpu_buf32[LOG_CPU_COUNT - 1][ARRAY_SIZE(buf32)];
+static struct mpsc_pbuf_buffer cpu_log_buffer[LOG_CPU_COUNT - 1];
+
+/* Message claimed from each CPU buffer and not processed yet. */
+static union log_msg_generic *cpu_log_msg[LOG_CPU_COUNT];
+
+static struct mpsc_pbuf_buffer *cpu_buffer(unsigned int cpu)
+{
+	return cpu == 0 ? &log_buffer : &cpu_log_buffer[cpu - 1];
+}
+
+/* Buffer a message was allocated from. */
+static struct mpsc_pbuf_buffer *msg_buffer(const void *msg)
+{
+	for (unsigned int i = 0; i < LOG_CPU_COUNT - 1; i++) {
+		if ((const uint32_t *)msg >= cpu_buf32[i] &&
+		    (const uint32_t *)msg < cpu_buf32[i] + ARRAY_SIZE(buf32)) {
+			return &cpu_log_buffer[i];
+		}
+	}
+
+	return &log_buffer;
+}
+#endif
+
 /* Check that default tag can fit in tag buffer. */
 COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, (),
 	(BUILD_ASSERT(sizeof(CONFIG_LOG_TAG_DEFAULT) <= CONFIG_LOG_TAG_MAX_LEN + 1,
@@ -652,6 +687,18 @@ void z_log_msg_init(void)
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (unsigned int i = 0; i < LOG_CPU_COUNT - 1; i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = cpu_buf32[i];
+		mpsc_pbuf_init(&cpu_log_buffer[i], &config);
+	}
+
+	for (unsigned int i = 0; i < LOG_CPU_COUNT; i++) {
+		cpu_log_msg[i] = NULL;
+	}
+#endif
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -669,7 +716,14 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	/* Being migrated after reading the CPU id only costs some locality,
+	 * the message is committed to the buffer it was allocated from.
+	 */
+	return msg_alloc(cpu_buffer(arch_curr_cpu()->id), wlen);
+#else
 	return msg_alloc(&log_buffer, wlen);
+#endif
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -701,7 +755,11 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	msg_commit(msg_buffer(msg), msg);
+#else
 	msg_commit(&log_buffer, msg);
+#endif
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -781,8 +839,50 @@ union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 	return msg;
 }
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* Claim the oldest of the messages at the head of the CPU buffers. Messages
+ * of one CPU are in order already, so this merges them in timestamp order.
+ */
+static union log_msg_generic *msg_claim_per_cpu(void)
+{
+	union log_msg_generic *msg = NULL;
+	log_timestamp_t t_min = 0;
+	unsigned int chosen = 0;
+
+	for (unsigned int i = 0; i < LOG_CPU_COUNT; i++) {
+		log_timestamp_t t;
+
+		if (cpu_log_msg[i] == NULL) {
+			cpu_log_msg[i] = (union log_msg_generic *)mpsc_pbuf_claim(cpu_buffer(i));
+			if (cpu_log_msg[i] == NULL) {
+				continue;
+			}
+		}
+
+		t = log_msg_get_timestamp(&cpu_log_msg[i]->log);
+		if (msg == NULL || t < t_min) {
+			msg = cpu_log_msg[i];
+			t_min = t;
+			chosen = i;
+		}
+	}
+
+	if (msg != NULL) {
+		cpu_log_msg[chosen] = NULL;
+		curr_log_buffer = cpu_buffer(chosen);
+	}
+
+	return msg;
+}
+#endif
+
 union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	ARG_UNUSED(backoff);
+
+	return msg_claim_per_cpu();
+#else
 	size_t len;
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
@@ -793,6 +893,7 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	}
 
 	return z_log_msg_local_claim();
+#endif
 }
 
 static void msg_free(struct mpsc_pbuf_buffer *buffer, const union log_msg_generic *msg)
@@ -818,6 +919,15 @@ static bool msg_pending(struct mpsc_pbuf_buffer *buffer)
 
 bool z_log_msg_pending(void)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (unsigned int cpu = 0; cpu < LOG_CPU_COUNT; cpu++) {
+		if (cpu_log_msg[cpu] != NULL || msg_pending(cpu_buffer(cpu))) {
+			return true;
+		}
+	}
+
+	return false;
+#else
 	size_t len;
 	int i = 0;
 
@@ -844,6 +954,7 @@ bool z_log_msg_pending(void)
 	}
 
 	return false;
+#endif
 }
 
 void z_log_msg_enqueue(const struct log_link *link, const void *data, size_t len)
@@ -905,6 +1016,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (unsigned int i = 0; i < LOG_CPU_COUNT - 1; i++) {
+		uint32_t size, used;
+
+		mpsc_pbuf_get_utilization(&cpu_log_buffer[i], &size, &used);
+		*buf_size += size;
+		*usage += used;
+	}
+#endif
+
 	return 0;
 }
 
@@ -916,7 +1037,27 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	/* Sum of the peaks of each buffer, they need not happen together */
+	uint32_t total = 0;
+
+	for (unsigned int i = 0; i < LOG_CPU_COUNT; i++) {
+		uint32_t cpu_max;
+		int err = mpsc_pbuf_get_max_utilization(cpu_buffer(i), &cpu_max);
+
+		if (err != 0) {
+			return err;
+		}
+
+		total += cpu_max;
+	}
+
+	*max = total;
+
+	return 0;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Architecture specific inner loops of the Internet checksum calculation.
+ *
+ * chksum_arch_add() adds as many of the 32-bit words at src to the 64-bit
+ * sum as it can handle in whole vectors, copying them to dst as well unless
+ * it is NULL, and returns the number of words it consumed. The caller sums
+ * the rest. The words are added as they are in memory, like the generic loop
+ * does, and any carry is kept modulo 0xffff, so the folded result does not
+ * depend on the variant.
+ */
+
+#ifndef __NET_CHKSUM_ARCH_H
+#define __NET_CHKSUM_ARCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+
+#if defined(CONFIG_NET_CHKSUM_ARCH) && defined(__AVX2__) && defined(CONFIG_ARCH_POSIX)
+
+#include <immintrin.h>
+
+#define CHKSUM_ARCH_NAME "avx2"
+
+static ALWAYS_INLINE size_t chksum_arch_add(uint64_t *sum, uint8_t *dst, const uint32_t *src,
+					    size_t words)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i acc_a = zero;
+	__m256i acc_b = zero;
+	uint64_t lanes[4];
+	size_t i;
+
+	for (i = 0; i + 8 <= words; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)&src[i]);
+
+		if (dst != NULL) {
+			_mm256_storeu_si256((__m256i *)&dst[i * sizeof(uint32_t)], v);
+		}
+
+		/* Zero extend the words to 64 bits so no carry is lost */
+		acc_a = _mm256_add_epi64(acc_a, _mm256_unpacklo_epi32(v, zero));
+		acc_b = _mm256_add_epi64(acc_b, _mm256_unpackhi_epi32(v, zero));
+	}
+
+	_mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(acc_a, acc_b));
+	*sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+	return i;
+}
+
+#elif defined(CONFIG_NET_CHKSUM_ARCH) && defined(__SSE2__) &&                                     \
+	(defined(CONFIG_X86_64) || defined(CONFIG_ARCH_POSIX))
+
+#include <emmintrin.h>
+
+#define CHKSUM_ARCH_NAME "sse2"
+
+static ALWAYS_INLINE size_t chksum_arch_add(uint64_t *sum, uint8_t *dst, const uint32_t *src,
+					    size_t words)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc_a = zero;
+	__m128i acc_b = zero;
+	uint64_t lanes[2];
+	size_t i;
+
+	for (i = 0; i + 8 <= words; i += 8) {
+		__m128i a = _mm_loadu_si128((const __m128i *)&src[i]);
+		__m128i b = _mm_loadu_si128((const __m128i *)&src[i + 4]);
+
+		if (dst != NULL) {
+			_mm_storeu_si128((__m128i *)&dst[i * sizeof(uint32_t)], a);
+			_mm_storeu_si128((__m128i *)&dst[(i + 4) * sizeof(uint32_t)], b);
+		}
+
+		/* Zero extend the words to 64 bits so no carry is lost */
+		acc_a = _mm_add_epi64(acc_a, _mm_unpacklo_epi32(a, zero));
+		acc_b = _mm_add_epi64(acc_b, _mm_unpackhi_epi32(a, zero));
+		acc_a = _mm_add_epi64(acc_a, _mm_unpacklo_epi32(b, zero));
+		acc_b = _mm_add_epi64(acc_b, _mm_unpackhi_epi32(b, zero));
+	}
+
+	_mm_storeu_si128((__m128i *)lanes, _mm_add_epi64(acc_a, acc_b));
+	*sum += lanes[0] + lanes[1];
+
+	return i;
+}
+
+#elif defined(CONFIG_NET_CHKSUM_ARCH) && defined(__ARM_NEON) && defined(CONFIG_FPU_SHARING)
+
+#include <arm_neon.h>
+
+#define CHKSUM_ARCH_NAME "neon"
+
+static ALWAYS_INLINE size_t chksum_arch_add(uint64_t *sum, uint8_t *dst, const uint32_t *src,
+					    size_t words)
+{
+	uint64x2_t acc_a = vdupq_n_u64(0);
+	uint64x2_t acc_b = vdupq_n_u64(0);
+	size_t i;
+
+	for (i = 0; i + 8 <= words; i += 8) {
+		uint32x4_t a = vld1q_u32(&src[i]);
+		uint32x4_t b = vld1q_u32(&src[i + 4]);
+
+		if (dst != NULL) {
+			vst1q_u8(&dst[i * sizeof(uint32_t)], vreinterpretq_u8_u32(a));
+			vst1q_u8(&dst[(i + 4) * sizeof(uint32_t)], vreinterpretq_u8_u32(b));
+		}
+
+		/* Pairwise add of the words into 64-bit lanes */
+		acc_a = vpadalq_u32(acc_a, a);
+		acc_b = vpadalq_u32(acc_b, b);
+	}
+
+	acc_a = vaddq_u64(acc_a, acc_b);
+	*sum += vgetq_lane_u64(acc_a, 0) + vgetq_lane_u64(acc_a, 1);
+
+	return i;
+}
+
+#elif defined(CONFIG_NET_CHKSUM_ARCH) && defined(__ARM_FEATURE_MVE) &&                            \
+	(__ARM_FEATURE_MVE & 1) && defined(CONFIG_FPU_SHARING)
+
+#include <arm_mve.h>
+
+#define CHKSUM_ARCH_NAME "mve"
+
+static ALWAYS_INLINE size_t chksum_arch_add(uint64_t *sum, uint8_t *dst, const uint32_t *src,
+					    size_t words)
+{
+	uint64_t acc = 0;
+	size_t i;
+
+	for (i = 0; i + 4 <= words; i += 4) {
+		uint32x4_t v = vld1q_u32(&src[i]);
+
+		if (dst != NULL) {
+			vst1q_u8(&dst[i * sizeof(uint32_t)], vreinterpretq_u8_u32(v));
+		}
+
+		/* Widening add across the vector into the 64-bit accumulator */
+		acc = vaddlvaq_u32(acc, v);
+	}
+
+	*sum += acc;
+
+	return i;
+}
+
+#elif defined(CONFIG_NET_CHKSUM_ARCH) && defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+
+#include <string.h>
+
+#define CHKSUM_ARCH_NAME "adc"
+
+/* The DSP extension has no 32-bit add that keeps the carry, chaining it
+ * through the flags is what makes a difference on these cores.
+ */
+static ALWAYS_INLINE size_t chksum_arch_add(uint64_t *sum, uint8_t *dst, const uint32_t *src,
+					    size_t words)
+{
+	const uint32_t *p = src;
+	const uint32_t *end = src + (words & ~(size_t)3);
+	uint32_t lo = 0;
+	uint32_t hi = 0;
+	uint32_t a, b, c, d;
+
+	if (p == end) {
+		return 0;
+	}
+
+	__asm__ volatile("1:	ldrd	%[a], %[b], [%[p]], #8\n"
+			 "	ldrd	%[c], %[d], [%[p]], #8\n"
+			 "	adds	%[lo], %[lo], %[a]\n"
+			 "	adcs	%[lo], %[lo], %[b]\n"
+			 "	adcs	%[lo], %[lo], %[c]\n"
+			 "	adcs	%[lo], %[lo], %[d]\n"
+			 "	adc	%[hi], %[hi], #0\n"
+			 "	cmp	%[p], %[end]\n"
+			 "	bne	1b\n"
+			 : [p] "+r"(p), [lo] "+r"(lo), [hi] "+r"(hi), [a] "=&r"(a), [b] "=&r"(b),
+			   [c] "=&r"(c), [d] "=&r"(d)
+			 : [end] "r"(end)
+			 : "cc", "memory");
+
+	if (dst != NULL) {
+		memcpy(dst, src, (end - src) * sizeof(uint32_t));
+	}
+
+	*sum += ((uint64_t)hi << 32) + lo;
+
+	return end - src;
+}
+
+#else
+
+static ALWAYS_INLINE size_t chksum_arch_add(uint64_t *sum, uint8_t *dst, const uint32_t *src,
+					    size_t words)
+{
+	ARG_UNUSED(sum);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(src);
+	ARG_UNUSED(words);
+
+	return 0;
+}
+
+#endif
+
+#endif /* __NET_CHKSUM_ARCH_H */
@@ -61,6 +61,15 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* Lookup tables for net_conn_input(). Handlers with a local port are
+ * hashed by protocol and local port, or by protocol, both ports and the
+ * remote address when all of these are specified. Handlers accepting
+ * any local port are kept in a separate list, checked for every packet.
+ */
+static sys_slist_t conn_port_hash[CONFIG_NET_CONN_HASH_SIZE];
+static sys_slist_t conn_tuple_hash[CONFIG_NET_CONN_HASH_SIZE];
+static sys_slist_t conn_wildcard;
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -113,6 +122,125 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+static inline uint32_t conn_hash_mix(uint32_t hash, uint32_t val)
+{
+	/* Multiplicative hashing by the 32-bit golden ratio */
+	return (hash ^ val) * 0x9e3779b1U;
+}
+
+static inline uint32_t conn_hash_bucket(uint32_t hash)
+{
+	return (hash ^ (hash >> 16)) % CONFIG_NET_CONN_HASH_SIZE;
+}
+
+/* Ports are in network byte order */
+static sys_slist_t *conn_port_chain(uint16_t proto, uint16_t local_port)
+{
+	uint32_t hash = conn_hash_mix(proto, local_port);
+
+	return &conn_port_hash[conn_hash_bucket(hash)];
+}
+
+static sys_slist_t *conn_tuple_chain(uint16_t proto, uint16_t local_port,
+				     uint16_t remote_port, uint8_t family,
+				     const uint8_t *remote_addr)
+{
+	size_t len = family == AF_INET6 ? sizeof(struct in6_addr) : sizeof(struct in_addr);
+	uint32_t hash = conn_hash_mix(proto, local_port);
+
+	hash = conn_hash_mix(hash, remote_port);
+
+	for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+		hash = conn_hash_mix(hash, UNALIGNED_GET((const uint32_t *)&remote_addr[i]));
+	}
+
+	return &conn_tuple_hash[conn_hash_bucket(hash)];
+}
+
+/* Returns the raw remote address of the handler, or NULL if unspecified */
+static const uint8_t *conn_remote_addr_raw(struct net_conn *conn)
+{
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) == 0U) {
+		return NULL;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && conn->remote_addr.sa_family == AF_INET6 &&
+	    !net_ipv6_is_addr_unspecified(&net_sin6(&conn->remote_addr)->sin6_addr)) {
+		return net_sin6(&conn->remote_addr)->sin6_addr.s6_addr;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && conn->remote_addr.sa_family == AF_INET &&
+	    net_sin(&conn->remote_addr)->sin_addr.s_addr != 0U) {
+		return net_sin(&conn->remote_addr)->sin_addr.s4_addr;
+	}
+
+	return NULL;
+}
+
+/* Where net_conn_input() looks the handler up, NULL if it never does */
+static sys_slist_t *conn_hash_chain(struct net_conn *conn)
+{
+	uint16_t local_port = net_sin(&conn->local_addr)->sin_port;
+	uint16_t remote_port = net_sin(&conn->remote_addr)->sin_port;
+	const uint8_t *remote_addr;
+
+	if (conn->family != AF_INET && conn->family != AF_INET6 &&
+	    conn->family != AF_UNSPEC) {
+		return NULL;
+	}
+
+	if (local_port == 0U) {
+		return &conn_wildcard;
+	}
+
+	remote_addr = conn_remote_addr_raw(conn);
+	if (remote_port != 0U && remote_addr != NULL) {
+		return conn_tuple_chain(conn->proto, local_port, remote_port,
+					conn->remote_addr.sa_family, remote_addr);
+	}
+
+	return conn_port_chain(conn->proto, local_port);
+}
+
+/* must be called with conn_lock held */
+static void conn_hash_add(struct net_conn *conn)
+{
+	sys_slist_t *chain = conn_hash_chain(conn);
+
+	if (chain != NULL) {
+		sys_slist_prepend(chain, &conn->hash_node);
+	}
+}
+
+/* Iterate over the handlers in a NULL terminated array of lookup chains.
+ * Must be called with conn_lock held.
+ */
+static struct net_conn *conn_hash_next(sys_slist_t **chains, size_t *chain,
+				       struct net_conn *conn)
+{
+	sys_snode_t *node = NULL;
+
+	if (conn != NULL) {
+		node = sys_slist_peek_next(&conn->hash_node);
+	}
+
+	while (node == NULL && chains[*chain] != NULL) {
+		node = sys_slist_peek_head(chains[(*chain)++]);
+	}
+
+	return node != NULL ? CONTAINER_OF(node, struct net_conn, hash_node) : NULL;
+}
+
+/* must be called with conn_lock held */
+static void conn_hash_remove(struct net_conn *conn)
+{
+	sys_slist_t *chain = conn_hash_chain(conn);
+
+	if (chain != NULL) {
+		(void)sys_slist_find_and_remove(chain, &conn->hash_node);
+	}
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -138,6 +266,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -463,6 +592,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -491,12 +621,17 @@ int net_conn_update(struct net_conn_handle *handle,
 
 	net_conn_change_callback(conn, cb, user_data);
 
+	/* The handler may move to another lookup chain */
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	conn_hash_remove(conn);
+
 	ret = net_conn_change_local(conn, local_addr, local_port);
-	if (ret < 0) {
-		return ret;
+	if (ret == 0) {
+		ret = net_conn_change_remote(conn, remote_addr, remote_port);
 	}
 
-	ret = net_conn_change_remote(conn, remote_addr, remote_port);
+	conn_hash_add(conn);
+	k_mutex_unlock(&conn_lock);
 
 	return ret;
 }
@@ -919,6 +1054,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	struct net_conn *conn;
 	net_conn_cb_t cb = NULL;
 	void *user_data = NULL;
+	const uint8_t *src_addr;
+	sys_slist_t *chains[4];
+	size_t chain = 0;
 
 	/* If we receive a packet with multicast destination address, we might
 	 * need to deliver the packet to multiple recipients.
@@ -934,9 +1072,22 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		is_mcast_pkt = net_ipv6_is_addr_mcast_raw(ip_hdr->ipv6->dst);
 	}
 
+	if (IS_ENABLED(CONFIG_NET_IPV4) && pkt_family == AF_INET) {
+		src_addr = ip_hdr->ipv4->src;
+	} else {
+		src_addr = ip_hdr->ipv6->src;
+	}
+
+	/* Only these can hold handlers matching the packet's ports */
+	chains[0] = conn_tuple_chain(proto, dst_port, src_port, pkt_family, src_addr);
+	chains[1] = conn_port_chain(proto, dst_port);
+	chains[2] = &conn_wildcard;
+	chains[3] = NULL;
+
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	for (conn = conn_hash_next(chains, &chain, NULL); conn != NULL;
+	     conn = conn_hash_next(chains, &chain, conn)) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (!is_iface_matching(conn, pkt)) {
 			continue; /* wrong interface */
@@ -1117,6 +1268,12 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wildcard);
+
+	ARRAY_FOR_EACH(conn_port_hash, j) {
+		sys_slist_init(&conn_port_hash[j]);
+		sys_slist_init(&conn_tuple_hash[j]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
@@ -54,6 +54,9 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Internal slist node in the lookup tables */
+	sys_snode_t hash_node;
+
 	/** Remote socket address */
 	struct sockaddr remote_addr;
 
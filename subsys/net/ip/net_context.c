@@ -2116,6 +2116,7 @@ static int context_setup_udp_packet(struct net_context *context,
 				    const void *buf,
 				    size_t len,
 				    const struct msghdr *msg,
+				    struct net_buf *frags,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
 {
@@ -2155,9 +2156,16 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
-	if (ret) {
-		return ret;
+	if (frags != NULL) {
+		/* Link the data after the headers, the packet takes its own
+		 * reference and the caller keeps its one.
+		 */
+		net_pkt_append_buffer(pkt, net_buf_ref(frags));
+	} else {
+		ret = context_write_data(pkt, buf, len, msg);
+		if (ret) {
+			return ret;
+		}
 	}
 
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMPING)
@@ -2298,6 +2306,7 @@ static void set_pkt_txtime(struct net_pkt *pkt, const struct msghdr *msghdr)
 static int context_sendto(struct net_context *context,
 			  const void *buf,
 			  size_t len,
+			  struct net_buf *frags,
 			  const struct sockaddr *dst_addr,
 			  socklen_t addrlen,
 			  net_context_send_cb_t cb,
@@ -2561,6 +2570,17 @@ static int context_sendto(struct net_context *context,
 		}
 	}
 
+	if (frags != NULL) {
+		/* Only UDP and TCP can link the buffers to their packets */
+		if (net_if_is_ip_offloaded(net_context_get_iface(context)) ||
+		    (net_context_get_proto(context) != IPPROTO_UDP &&
+		     net_context_get_proto(context) != IPPROTO_TCP)) {
+			return -EOPNOTSUPP;
+		}
+
+		len = net_buf_frags_len(frags);
+	}
+
 	iface = net_context_get_iface(context);
 	if (iface && !net_if_is_up(iface)) {
 		return -ENETDOWN;
@@ -2575,7 +2595,7 @@ static int context_sendto(struct net_context *context,
 		goto skip_alloc;
 	}
 
-	pkt = context_alloc_pkt(context, family, len, PKT_WAIT_TIME);
+	pkt = context_alloc_pkt(context, family, frags != NULL ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
 		return -ENOBUFS;
@@ -2583,7 +2603,7 @@ static int context_sendto(struct net_context *context,
 
 	tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_proto(context));
-	if (tmp_len < len) {
+	if (frags == NULL && tmp_len < len) {
 		if (net_context_get_type(context) == SOCK_DGRAM ||
 		    net_context_get_type(context) == SOCK_RAW) {
 			NET_ERR("Available payload buffer (%zu) is not enough for requested DGRAM (%zu)",
@@ -2646,7 +2666,7 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, family, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       frags, dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2657,7 +2677,11 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_proto(context) == IPPROTO_TCP) {
 
-		ret = net_tcp_queue(context, buf, len, msghdr);
+		if (frags != NULL) {
+			ret = net_tcp_queue_buf(context, frags);
+		} else {
+			ret = net_tcp_queue(context, buf, len, msghdr);
+		}
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2838,13 +2862,47 @@ int net_context_send(struct net_context *context,
 		}
 	}
 
-	ret = context_sendto(context, buf, len, &context->remote,
+	ret = context_sendto(context, buf, len, NULL, &context->remote,
+			     addrlen, cb, timeout, user_data, false);
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *frags,
+			 net_context_send_cb_t cb,
+			 k_timeout_t timeout,
+			 void *user_data)
+{
+	socklen_t addrlen;
+	int ret;
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
+	    net_sin(&context->remote)->sin_port == 0) {
+		ret = -EDESTADDRREQ;
+		goto unlock;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) &&
+	    net_context_get_family(context) == AF_INET6) {
+		addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		addrlen = sizeof(struct sockaddr_in);
+	}
+
+	ret = context_sendto(context, NULL, 0, frags, &context->remote,
 			     addrlen, cb, timeout, user_data, false);
 unlock:
 	k_mutex_unlock(&context->lock);
 
 	return ret;
 }
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
 
 int net_context_sendmsg(struct net_context *context,
 			const struct msghdr *msghdr,
@@ -2857,7 +2915,7 @@ int net_context_sendmsg(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, msghdr, 0, NULL, 0,
+	ret = context_sendto(context, msghdr, 0, NULL, NULL, 0,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -2878,7 +2936,7 @@ int net_context_sendto(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, buf, len, dst_addr, addrlen,
+	ret = context_sendto(context, buf, len, NULL, dst_addr, addrlen,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -127,6 +127,13 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 
 	if (IS_ENABLED(CONFIG_NET_IP) && (family == AF_INET || family == AF_INET6 ||
 					  family == AF_UNSPEC || family == AF_PACKET)) {
+#if defined(CONFIG_NET_TCP_GRO)
+		ret = net_tcp_gro_receive(pkt, is_loopback);
+		if (ret != NET_CONTINUE) {
+			return ret;
+		}
+#endif
+
 		/* IP version and header length. */
 		uint8_t vtc_vhl = NET_IPV6_HDR(pkt)->vtc & 0xf0;
 
@@ -421,6 +428,15 @@ int net_try_send_data(struct net_pkt *pkt, k_timeout_t timeout)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
+
+#if defined(CONFIG_NET_TCP_GSO)
+		/* Delivered as is, so the checksum left for the segments is needed */
+		if (net_pkt_gso_size(pkt) > 0U && net_tcp_gso_finalize(pkt) < 0) {
+			ret = -ENOBUFS;
+			goto err;
+		}
+#endif
+
 		processing_data(pkt, true);
 		ret = 0;
 		goto err;
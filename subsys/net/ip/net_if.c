@@ -35,6 +35,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv4.h"
 #include "ipv6.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -453,6 +454,26 @@ static inline void init_iface(struct net_if *iface)
 }
 
 #if defined(CONFIG_NET_NATIVE)
+#if defined(CONFIG_NET_TCP_GSO)
+/* The hardware can only segment packets whose TCP checksum it computes */
+static bool tcp_seg_offloaded(struct net_if *iface, struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	enum net_if_checksum_type type = net_pkt_family(pkt) == AF_INET6 ?
+		NET_IF_CHECKSUM_IPV6_TCP : NET_IF_CHECKSUM_IPV4_TCP;
+
+	return net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	       (net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TCP_SEG_OFFLOAD) &&
+	       !net_if_need_calc_tx_checksum(iface, type);
+#else
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return false;
+#endif
+}
+#endif
+
 enum net_verdict net_if_try_send_data(struct net_if *iface, struct net_pkt *pkt,
 				      k_timeout_t timeout)
 {
@@ -504,6 +525,25 @@ enum net_verdict net_if_try_send_data(struct net_if *iface, struct net_pkt *pkt,
 				       net_pkt_lladdr_if(pkt)->len);
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	if (net_pkt_gso_size(pkt) > 0U && !tcp_seg_offloaded(iface, pkt)) {
+		int ret;
+
+		ret = net_tcp_gso_send(pkt);
+		if (ret < 0) {
+			NET_DBG("Cannot segment pkt %p (%d)", pkt, ret);
+			verdict = NET_DROP;
+			status = ret;
+			goto done;
+		}
+
+		/* The segments were sent, the original packet is not needed */
+		net_pkt_unref(pkt);
+		verdict = NET_CONTINUE;
+		goto done;
+	}
+#endif
+
 #if defined(CONFIG_NET_LOOPBACK)
 	/* If the packet is destined back to us, then there is no need to do
 	 * additional checks, so let the packet through.
@@ -1831,13 +1831,22 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 	}
 }
 
+/* Add the ones' complement sums of two parts of the data */
+static uint16_t chksum_add(uint16_t sum, uint16_t part)
+{
+	uint32_t total = (uint32_t)sum + part;
+
+	return (uint16_t)((total & 0xffff) + (total >> 16));
+}
+
 /* Internal function that does all operation (skip/read/write/memset) */
 static int net_pkt_cursor_operate(struct net_pkt *pkt,
 				  void *data, size_t length,
-				  bool copy, bool write)
+				  bool copy, bool write, uint16_t *sum)
 {
 	/* We use such variable to avoid lengthy lines */
 	struct net_pkt_cursor *c_op = &pkt->cursor;
+	size_t done = 0;
 
 	while (c_op->buf && length) {
 		size_t d_len, len;
@@ -1865,7 +1874,15 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 			len = d_len;
 		}
 
-		if (copy && data) {
+		if (copy && data && sum) {
+			uint16_t part;
+
+			part = calc_chksum_copy(0, write ? c_op->pos : data,
+						write ? data : c_op->pos, len);
+
+			/* A part starting at an odd offset has its bytes swapped */
+			*sum = chksum_add(*sum, (done % 2) ? BSWAP_16(part) : part);
+		} else if (copy && data) {
 			memcpy(write ? c_op->pos : data,
 			       write ? data : c_op->pos,
 			       len);
@@ -1884,6 +1901,7 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 		}
 
 		length -= len;
+		done += len;
 	}
 
 	if (length) {
@@ -1898,21 +1916,28 @@ int net_pkt_skip(struct net_pkt *pkt, size_t skip)
 {
 	NET_DBG("pkt %p skip %zu", pkt, skip);
 
-	return net_pkt_cursor_operate(pkt, NULL, skip, false, true);
+	return net_pkt_cursor_operate(pkt, NULL, skip, false, true, NULL);
 }
 
 int net_pkt_memset(struct net_pkt *pkt, int byte, size_t amount)
 {
 	NET_DBG("pkt %p byte %d amount %zu", pkt, byte, amount);
 
-	return net_pkt_cursor_operate(pkt, &byte, amount, false, true);
+	return net_pkt_cursor_operate(pkt, &byte, amount, false, true, NULL);
 }
 
 int net_pkt_read(struct net_pkt *pkt, void *data, size_t length)
 {
 	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
 
-	return net_pkt_cursor_operate(pkt, data, length, true, false);
+	return net_pkt_cursor_operate(pkt, data, length, true, false, NULL);
+}
+
+int net_pkt_read_chksum(struct net_pkt *pkt, void *data, size_t length, uint16_t *sum)
+{
+	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
+
+	return net_pkt_cursor_operate(pkt, data, length, true, false, sum);
 }
 
 int net_pkt_read_be16(struct net_pkt *pkt, uint16_t *data)
@@ -1960,7 +1985,14 @@ int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length)
 		return net_pkt_skip(pkt, length);
 	}
 
-	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true);
+	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true, NULL);
+}
+
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length, uint16_t *sum)
+{
+	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
+
+	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true, sum);
 }
 
 int net_pkt_copy(struct net_pkt *pkt_dst,
@@ -2053,6 +2085,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_ip_reassembled(pkt, net_pkt_is_ip_reassembled(pkt));
 	net_pkt_set_cooked_mode(clone_pkt, net_pkt_is_cooked_mode(pkt));
 	net_pkt_set_ipv4_pmtu(clone_pkt, net_pkt_ipv4_pmtu(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
 	net_pkt_set_l2_processed(clone_pkt, net_pkt_is_l2_processed(pkt));
 	net_pkt_set_ll_proto_type(clone_pkt, net_pkt_ll_proto_type(pkt));
@@ -2236,13 +2269,22 @@ int net_pkt_pull(struct net_pkt *pkt, size_t length)
 			rem = length;
 		}
 
-		c_op->buf->len -= rem;
 		left -= rem;
-		if (left) {
+		if (left && c_op->pos == c_op->buf->data &&
+		    (c_op->buf->flags & NET_BUF_EXTERNAL_DATA)) {
+			/* External data may be read-only, pull it from the
+			 * front instead of moving the rest.
+			 */
+			net_buf_pull(c_op->buf, rem);
+			c_op->pos = c_op->buf->data;
+		} else if (left) {
+			c_op->buf->len -= rem;
 			memmove(c_op->pos, c_op->pos+rem, left);
 		} else {
 			struct net_buf *buf = pkt->buffer;
 
+			c_op->buf->len -= rem;
+
 			if (buf) {
 				pkt->buffer = buf->frags;
 				buf->frags = NULL;
@@ -13,20 +13,30 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/sys/byteorder.h>
 
 #include "net_private.h"
+#include "ipv4.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "tcp_internal.h"
 
 #define TC_RX_PSEUDO_QUEUE (COND_CODE_1(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO, (1), (0)))
-#define NET_TC_RX_EFFECTIVE_COUNT (NET_TC_RX_COUNT + TC_RX_PSEUDO_QUEUE)
+#define NET_TC_RX_EFFECTIVE_COUNT (NET_TC_RX_QUEUE_COUNT + TC_RX_PSEUDO_QUEUE)
 
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
 #define NET_TC_RX_SLOTS (CONFIG_NET_PKT_RX_COUNT / NET_TC_RX_EFFECTIVE_COUNT)
 BUILD_ASSERT(NET_TC_RX_SLOTS > 0,
 		"Misconfiguration: There are more traffic classes then packets, "
 		"either increase CONFIG_NET_PKT_RX_COUNT or decrease "
-		"CONFIG_NET_TC_RX_COUNT or disable CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO");
+		"CONFIG_NET_TC_RX_COUNT or CONFIG_NET_TC_RX_RSS_QUEUES or disable "
+		"CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO");
+#endif
+
+#if NET_TC_RX_QUEUE_COUNT > NET_TC_RX_COUNT
+/* Number of queues of the best effort traffic class, its own one included */
+#define NET_TC_RX_RSS_COUNT (NET_TC_RX_QUEUE_COUNT - NET_TC_RX_COUNT + 1)
 #endif
 
 #define TC_TX_PSEUDO_QUEUE (COND_CODE_1(CONFIG_NET_TC_TX_SKIP_FOR_HIGH_PRIO, (1), (0)))
@@ -45,16 +55,17 @@ BUILD_ASSERT(NET_TC_TX_SLOTS > 0,
 #endif
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
- * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * where y indicates the traffic class id. The value of y can be from 0 to 7,
+ * the extra RX queues of the best effort traffic class follow up to 14.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[yy]")
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_QUEUE_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -62,7 +73,144 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_TC_RX_QUEUE_COUNT];
+#endif
+
+#if defined(NET_TC_RX_RSS_COUNT)
+/* Traffic class the best effort priority maps to */
+static uint8_t rx_rss_tc;
+
+/* The key most RSS capable network controllers use by default */
+static const uint8_t rss_key[40] = {
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2, 0x41, 0x67,
+	0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0, 0xd0, 0xca, 0x2b, 0xcb,
+	0xae, 0x7b, 0x30, 0xb4, 0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30,
+	0xf2, 0x0c, 0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+};
+
+static uint32_t rss_toeplitz(const uint8_t *data, size_t len)
+{
+	uint32_t window = sys_get_be32(rss_key);
+	uint32_t hash = 0U;
+
+	/* Each set bit of the input adds the 32 key bits starting at it */
+	for (size_t i = 0; i < len; i++) {
+		for (int bit = 7; bit >= 0; bit--) {
+			if (data[i] & BIT(bit)) {
+				hash ^= window;
+			}
+
+			window = (window << 1) | ((rss_key[i + 4] >> bit) & 1U);
+		}
+	}
+
+	return hash;
+}
+
+uint32_t net_tc_rx_flow_hash(struct net_pkt *pkt)
+{
+	/* Source and destination addresses followed by the ports */
+	uint8_t tuple[2 * NET_IPV6_ADDR_SIZE + 2 * sizeof(uint16_t)];
+	struct net_buf *buf = pkt->buffer;
+	size_t addr_len, hdr_len, len;
+	bool use_ports = false;
+	uint8_t *data;
+
+	if (buf == NULL) {
+		return 0U;
+	}
+
+	data = buf->data;
+	len = buf->len;
+
+	if (IS_ENABLED(CONFIG_NET_L2_ETHERNET) &&
+	    net_if_l2(net_pkt_iface(pkt)) == &NET_L2_GET_NAME(ETHERNET)) {
+		struct net_eth_hdr *hdr = (struct net_eth_hdr *)data;
+		uint16_t type;
+
+		if (len < sizeof(struct net_eth_hdr)) {
+			return 0U;
+		}
+
+		type = ntohs(hdr->type);
+		hdr_len = sizeof(struct net_eth_hdr);
+
+		if (type == NET_ETH_PTYPE_VLAN && len >= sizeof(struct net_eth_vlan_hdr)) {
+			type = ntohs(((struct net_eth_vlan_hdr *)data)->type);
+			hdr_len = sizeof(struct net_eth_vlan_hdr);
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			return 0U;
+		}
+
+		data += hdr_len;
+		len -= hdr_len;
+	} else if (!IS_ENABLED(CONFIG_NET_L2_DUMMY) ||
+		   net_if_l2(net_pkt_iface(pkt)) != &NET_L2_GET_NAME(DUMMY)) {
+		/* Other link layers carry anything but IP, leave them alone */
+		return 0U;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && len >= NET_IPV4H_LEN && (data[0] & 0xf0) == 0x40) {
+		struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)data;
+
+		addr_len = NET_IPV4_ADDR_SIZE;
+		hdr_len = (data[0] & 0x0f) * 4U;
+		memcpy(tuple, hdr->src, 2 * addr_len);
+
+		/* Only the first fragment has the ports */
+		if (!(sys_get_be16(hdr->offset) &
+		      (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK))) {
+			use_ports = hdr->proto == IPPROTO_TCP ||
+				    (IS_ENABLED(CONFIG_NET_TC_RX_RSS_UDP_PORTS) &&
+				     hdr->proto == IPPROTO_UDP);
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && len >= NET_IPV6H_LEN &&
+		   (data[0] & 0xf0) == 0x60) {
+		struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)data;
+
+		addr_len = NET_IPV6_ADDR_SIZE;
+		hdr_len = NET_IPV6H_LEN;
+		memcpy(tuple, hdr->src, 2 * addr_len);
+
+		/* Extension headers, fragments included, hide the ports */
+		use_ports = hdr->nexthdr == IPPROTO_TCP ||
+			    (IS_ENABLED(CONFIG_NET_TC_RX_RSS_UDP_PORTS) &&
+			     hdr->nexthdr == IPPROTO_UDP);
+	} else {
+		return 0U;
+	}
+
+	if (use_ports && len >= hdr_len + 2 * sizeof(uint16_t)) {
+		memcpy(&tuple[2 * addr_len], data + hdr_len, 2 * sizeof(uint16_t));
+
+		return rss_toeplitz(tuple, 2 * addr_len + 2 * sizeof(uint16_t));
+	}
+
+	return rss_toeplitz(tuple, 2 * addr_len);
+}
+
+/* Pick the queue of the flow if the packet is best effort traffic */
+static uint8_t rx_queue_select(uint8_t tc, struct net_pkt *pkt)
+{
+	uint32_t idx;
+
+	if (tc != rx_rss_tc) {
+		return tc;
+	}
+
+	idx = net_tc_rx_flow_hash(pkt) % NET_TC_RX_RSS_COUNT;
+
+	return idx == 0U ? tc : NET_TC_RX_COUNT + idx - 1U;
+}
+#else
+static inline uint8_t rx_queue_select(uint8_t tc, struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return tc;
+}
 #endif
 
 enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
@@ -92,10 +240,12 @@ enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
 	uint8_t retry_cnt = NET_TC_RETRY_CNT;
 #endif
+	uint8_t queue = rx_queue_select(tc, pkt);
+
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
-	while (k_sem_take(&rx_classes[tc].fifo_slot, K_NO_WAIT) != 0) {
+	while (k_sem_take(&rx_classes[queue].fifo_slot, K_NO_WAIT) != 0) {
 		if (k_is_in_isr() || retry_cnt == 0) {
 			return NET_DROP;
 		}
@@ -108,7 +258,7 @@ enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 	}
 #endif
 
-	k_fifo_put(&rx_classes[tc].fifo, pkt);
+	k_fifo_put(&rx_classes[queue].fifo, pkt);
 	return NET_OK;
 #else
 	ARG_UNUSED(tc);
@@ -117,6 +267,20 @@ enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 #endif
 }
 
+int net_tc_rx_current_queue(void)
+{
+#if NET_TC_RX_COUNT > 0
+	k_tid_t current = k_current_get();
+
+	for (int i = 0; i < NET_TC_RX_QUEUE_COUNT; i++) {
+		if (current == &rx_classes[i].handler) {
+			return i;
+		}
+	}
+#endif
+	return -1;
+}
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 #if NET_TC_TX_COUNT > 0
@@ -287,7 +451,11 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #if NET_TC_RX_COUNT > 0
 static void tc_rx_handler(void *p1, void *p2, void *p3)
 {
+#if defined(CONFIG_NET_TCP_GRO)
+	uint8_t queue = POINTER_TO_UINT(p3);
+#else
 	ARG_UNUSED(p3);
+#endif
 
 	struct k_fifo *fifo = p1;
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
@@ -308,6 +476,13 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 #endif
 
 		net_process_rx_packet(pkt);
+
+#if defined(CONFIG_NET_TCP_GRO)
+		/* Nothing more to coalesce, pass on what was held back */
+		if (k_fifo_is_empty(fifo)) {
+			net_tcp_gro_flush(queue);
+		}
+#endif
 	}
 }
 #endif
@@ -425,12 +600,21 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+#if defined(NET_TC_RX_RSS_COUNT)
+	rx_rss_tc = net_rx_priority2tc(NET_PRIORITY_BE);
+#endif
+
+	for (i = 0; i < NET_TC_RX_QUEUE_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
+#if defined(NET_TC_RX_RSS_COUNT)
+		/* The extra queues run at the priority of their traffic class */
+		thread_priority = rx_tc2thread(i < NET_TC_RX_COUNT ? i : rx_rss_tc);
+#else
 		thread_priority = rx_tc2thread(i);
+#endif
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -460,7 +644,7 @@ void net_tc_rx_init(void)
 #else
 				      NULL,
 #endif
-				      NULL,
+				      UINT_TO_POINTER(i),
 				      priority, 0, K_FOREVER);
 		if (!tid) {
 			NET_ERR("Cannot create TC handler thread %d", i);
@@ -474,6 +658,15 @@ void net_tc_rx_init(void)
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(NET_TC_RX_RSS_COUNT) && defined(CONFIG_SMP) && defined(CONFIG_SCHED_CPU_MASK)
+		/* Spread the queues of the best effort traffic over the CPUs */
+		if (i == rx_rss_tc) {
+			(void)k_thread_cpu_pin(tid, 0);
+		} else if (i >= NET_TC_RX_COUNT) {
+			(void)k_thread_cpu_pin(tid, (i - NET_TC_RX_COUNT + 1) % arch_num_cpus());
+		}
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
@@ -65,10 +65,6 @@ static int tcp_tx_window =
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
-
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
@@ -443,103 +439,110 @@ static void tcp_derive_rto(struct tcp *conn)
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-/* Implementation according to RFC6582 */
-
-static void tcp_new_reno_log(struct tcp *conn, char *step)
+/* One segment at a time is timed to feed the RTT to the algorithm */
+static void tcp_rtt_start(struct tcp *conn, uint32_t seq_end, bool resend)
 {
-	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
-		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
-		conn->ca.pending_fast_retransmit_bytes);
+	if (resend) {
+		/* Karn's algorithm, retransmitted data gives no RTT sample */
+		conn->rtt_pending = false;
+	} else if (!conn->rtt_pending) {
+		conn->rtt_seq = seq_end;
+		conn->rtt_start = k_cycle_get_32();
+		conn->rtt_pending = true;
+	}
 }
 
-static void tcp_new_reno_init(struct tcp *conn)
+/* Accepted connections use the algorithm chosen for the listener */
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from)
 {
-	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
-	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
-	conn->ca.pending_fast_retransmit_bytes = 0;
-	tcp_new_reno_log(conn, "init");
+	to->ca_ops = from->ca_ops;
 }
 
-static void tcp_new_reno_fast_retransmit(struct tcp *conn)
+static void tcp_ca_init(struct tcp *conn)
 {
-	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
-		/* Account for the lost segments */
-		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
-		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
-		tcp_new_reno_log(conn, "fast_retransmit");
-	}
+	conn->rtt_pending = false;
+	conn->ca_ops->init(conn);
 }
 
-static void tcp_new_reno_timeout(struct tcp *conn)
+static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
-	conn->ca.cwnd = conn_mss(conn);
-	tcp_new_reno_log(conn, "timeout");
+	conn->rtt_pending = false;
+	conn->ca_ops->fast_retransmit(conn);
 }
 
-/* For every duplicate ack increment the cwnd by mss */
-static void tcp_new_reno_dup_ack(struct tcp *conn)
+static void tcp_ca_timeout(struct tcp *conn)
 {
-	int32_t new_win = conn->ca.cwnd;
+	conn->rtt_pending = false;
+	conn->ca_ops->timeout(conn);
+}
 
-	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	tcp_new_reno_log(conn, "dup_ack");
+static void tcp_ca_dup_ack(struct tcp *conn)
+{
+	conn->ca_ops->dup_ack(conn);
 }
 
-static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
+static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	int32_t new_win = conn->ca.cwnd;
-	int32_t win_inc = MIN(acked_len, conn_mss(conn));
+	uint32_t rtt_us = 0;
 
-	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		if (conn->ca.cwnd < conn->ca.ssthresh) {
-			new_win += win_inc;
-		} else {
-			/* Implement a div_ceil	to avoid rounding to 0 */
-			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
-		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	} else {
-		/* Check if it is still in fast recovery mode */
-		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
-			conn->ca.pending_fast_retransmit_bytes = 0;
-			conn->ca.cwnd = conn->ca.ssthresh;
-		} else {
-			conn->ca.pending_fast_retransmit_bytes -= acked_len;
-			conn->ca.cwnd -= acked_len;
-		}
+	if (conn->rtt_pending &&
+	    net_tcp_seq_cmp(conn->seq + acked_len, conn->rtt_seq) >= 0) {
+		rtt_us = MAX(k_cyc_to_us_floor32(k_cycle_get_32() - conn->rtt_start), 1);
+		conn->rtt_pending = false;
 	}
-	tcp_new_reno_log(conn, "pkts_acked");
-}
 
-static void tcp_ca_init(struct tcp *conn)
-{
-	tcp_new_reno_init(conn);
+	conn->ca_ops->pkts_acked(conn, acked_len, rtt_us);
 }
 
-static void tcp_ca_fast_retransmit(struct tcp *conn)
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
 {
-	tcp_new_reno_fast_retransmit(conn);
-}
+	char name[NET_TCP_CA_NAME_MAX];
+	const struct tcp_ca_ops *ops;
 
-static void tcp_ca_timeout(struct tcp *conn)
-{
-	tcp_new_reno_timeout(conn);
-}
+	if (conn == NULL || value == NULL || len == 0) {
+		return -EINVAL;
+	}
 
-static void tcp_ca_dup_ack(struct tcp *conn)
-{
-	tcp_new_reno_dup_ack(conn);
+	len = MIN(len, sizeof(name) - 1);
+	memcpy(name, value, len);
+	name[len] = '\0';
+
+	ops = tcp_ca_find(name);
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops != conn->ca_ops) {
+		conn->ca_ops = ops;
+
+		/* A connection switching algorithm restarts from the
+		 * initial window, others are set up once established.
+		 */
+		if (conn->state == TCP_ESTABLISHED) {
+			tcp_ca_init(conn);
+		}
+	}
+
+	return 0;
 }
 
-static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	if (conn == NULL || value == NULL || len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	*len = MIN(*len, strlen(conn->ca_ops->name) + 1);
+	memcpy(value, conn->ca_ops->name, *len);
+
+	return 0;
 }
 #else
 
+static void tcp_rtt_start(struct tcp *conn, uint32_t seq_end, bool resend) { }
+
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from) { }
+
 static void tcp_ca_init(struct tcp *conn) { }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn) { }
@@ -550,6 +553,9 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -998,10 +1004,24 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
+/* Forget the options of the previous segment. The MSS is only sent in
+ * SYN segments, remember it for the rest of the connection.
+ */
+static void tcp_options_reset(struct tcp_options *recv_options)
+{
+	recv_options->wnd_found = false;
+	recv_options->sack_perm_found = false;
+	recv_options->ts_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_count = 0;
+#endif
+}
+
 static bool tcp_options_check(struct tcp_options *recv_options,
 			      struct net_pkt *pkt, ssize_t len)
 {
-	uint8_t options_buf[40]; /* TCP header max options size is 40 */
+	/* Sized for what the peer may send, not for what we support */
+	uint8_t options_buf[NET_TCP_MAX_RECV_OPT_SIZE];
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
 					   sizeof(options_buf));
@@ -1009,8 +1029,8 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* Never parse more than what was copied */
+	len = MIN(len, (ssize_t)sizeof(options_buf));
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1056,9 +1076,48 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = options[2];
 			recv_options->wnd_found = true;
+			NET_DBG("WS=%hu", recv_options->window);
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT:
+			if (((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_count < NET_TCP_MAX_SACK_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_count++];
+
+				block->start = sys_get_be32(options + i);
+				block->end = sys_get_be32(options + i + 4);
+			}
+			break;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval = sys_get_be32(options + 2);
+			recv_options->tsecr = sys_get_be32(options + 6);
+			recv_options->ts_found = true;
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1249,8 +1308,20 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+static uint16_t tcp_window_field(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+	/* The window in SYN segments is never scaled */
+	if (conn->wscale_ok && !(flags & SYN)) {
+		win >>= conn->rcv_wscale;
+	}
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1264,14 +1335,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_sport));
 	UNALIGNED_PUT(conn->dst.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_dport));
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + options_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), UNALIGNED_MEMBER_ADDR(th, th_win));
+	UNALIGNED_PUT(htons(tcp_window_field(conn, flags)), UNALIGNED_MEMBER_ADDR(th, th_win));
 	UNALIGNED_PUT(htonl(seq), UNALIGNED_MEMBER_ADDR(th, th_seq));
 
 	if (ACK & flags) {
@@ -1329,23 +1396,116 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+static uint8_t tcp_window_scale_for(uint32_t win)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	uint8_t shift = 0;
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	while (shift < NET_TCP_MAX_WINDOW_SCALE && (win >> shift) > UINT16_MAX) {
+		shift++;
+	}
+
+	return shift;
+}
+
+static size_t tcp_sack_options_fill(struct tcp *conn, uint8_t *options)
+{
+#if defined(CONFIG_NET_TCP_SACK)
+	/* The out-of-order queue holds a single contiguous range of data,
+	 * so this is the only block there is to report.
+	 */
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT && conn->sack_ok &&
+	    !net_pkt_is_empty(conn->queue_recv_data)) {
+		uint32_t start = tcp_get_seq(conn->queue_recv_data->buffer);
+
+		options[0] = NET_TCP_NOP_OPT;
+		options[1] = NET_TCP_NOP_OPT;
+		options[2] = NET_TCP_SACK_OPT;
+		options[3] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		sys_put_be32(start, options + 4);
+		sys_put_be32(start + net_pkt_get_len(conn->queue_recv_data), options + 8);
+
+		return 4 + NET_TCP_SACK_BLOCK_SIZE;
+	}
+#endif
+	ARG_UNUSED(conn);
+	ARG_UNUSED(options);
+
+	return 0;
+}
+
+/* Build the TCP options of an outgoing segment, padded to 32-bit words */
+static size_t tcp_options_fill(struct tcp *conn, uint8_t flags, bool has_data,
+			       uint8_t *options)
+{
+	bool syn = (flags & SYN) != 0;
+	bool sack_perm = false;
+	bool ts = false;
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		sys_put_be32((NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16) |
+			     net_tcp_get_supported_mss(conn), options);
+		len += NET_TCP_MSS_SIZE;
+	}
+
+	/* A SYN offers the options, a SYN-ACK only agrees to what the
+	 * peer has offered.
+	 */
+	if (syn) {
+		sack_perm = IS_ENABLED(CONFIG_NET_TCP_SACK) && (!(flags & ACK) || conn->sack_ok);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS)) {
+		ts = syn ? (!(flags & ACK) || conn->ts_ok) : conn->ts_ok;
+	}
+
+	if (ts) {
+		uint32_t tsecr = 0;
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		if (flags & ACK) {
+			tsecr = conn->ts_recent;
+		}
+#endif
+		if (sack_perm) {
+			options[len++] = NET_TCP_SACK_PERM_OPT;
+			options[len++] = NET_TCP_SACK_PERM_SIZE;
+			sack_perm = false;
+		} else {
+			options[len++] = NET_TCP_NOP_OPT;
+			options[len++] = NET_TCP_NOP_OPT;
+		}
+
+		options[len++] = NET_TCP_TIMESTAMP_OPT;
+		options[len++] = NET_TCP_TIMESTAMP_SIZE;
+		sys_put_be32(k_uptime_get_32(), options + len);
+		sys_put_be32(tsecr, options + len + 4);
+		len += 8;
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	if (sack_perm) {
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_SACK_PERM_OPT;
+		options[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) && syn &&
+	    (!(flags & ACK) || conn->wscale_ok)) {
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_WINDOW_SCALE_OPT;
+		options[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+		options[len++] = conn->rcv_wscale;
+	}
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	/* SACK blocks are only sent in pure ACKs, data segments are sized
+	 * to leave room for the timestamp option only.
+	 */
+	if (!syn && !has_data && !(flags & RST)) {
+		len += tcp_sack_options_fill(conn, options + len);
+	}
+
+	return len;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1457,14 +1617,12 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t options[NET_TCP_MAX_OPT_SIZE];
+	size_t options_len = tcp_options_fill(conn, flags, data != NULL, options);
+	size_t alloc_len = sizeof(struct tcphdr) + options_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1472,6 +1630,12 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
+#if defined(CONFIG_NET_TCP_GSO)
+		/* Data that does not fit in one segment is split after routing */
+		if (net_pkt_get_len(data) > conn_mss(conn)) {
+			net_pkt_set_gso_size(pkt, conn_mss(conn));
+		}
+#endif
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -1483,20 +1647,26 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (options_len > 0) {
+		ret = net_pkt_write(pkt, options, options_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
 		}
 	}
 
+	/* The headers may not need all the buffers allocated for them, drop
+	 * the empty ones so that they do not sit in front of the data.
+	 */
+	net_pkt_trim_buffer(pkt);
+	net_pkt_cursor_init(pkt);
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1510,6 +1680,9 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 
 	if (flags & ACK) {
 		conn->recv_win_sent = conn->recv_win;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		conn->last_ack_sent = conn->ack;
+#endif
 	}
 
 	if (is_destination_local(pkt)) {
@@ -1714,48 +1887,35 @@ static void tcp_setup_retransmission(struct tcp *conn)
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer, K_MSEC(TCP_RTO_MS));
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Send len bytes of the send_data queue, starting at offset */
+static int tcp_send_segment(struct tcp *conn, int offset, int len, bool resend)
 {
-	int ret = 0;
-	int len;
 	struct net_pkt *pkt;
-
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
-	if (len < 0) {
-		ret = len;
-		goto out;
-	}
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
-	}
+	int ret;
 
 	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
 	if (ret == 0) {
-		conn->unacked_len += len;
-
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (resend) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
 			net_stats_update_tcp_seg_sent(conn->iface);
 		}
+
+		tcp_rtt_start(conn, conn->seq + offset + len, resend);
 	}
 
 	/* The data we want to send, has been moved to the send queue so we
@@ -1764,6 +1924,50 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
+	return ret;
+}
+
+/* Amount of data that can be given to the IP layer in one packet */
+static int tcp_send_len_max(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_GSO)
+	/* After a timeout the data is sent again one segment at a time */
+	if (conn->data_mode != TCP_DATA_MODE_RESEND) {
+		return MIN(conn_mss(conn) * CONFIG_NET_TCP_GSO_MAX_SEGS,
+			   NET_TCP_GSO_MAX_LEN);
+	}
+#endif
+	return conn_mss(conn);
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len;
+
+	len = MIN(tcp_unsent_len(conn), tcp_send_len_max(conn));
+	if (len < 0) {
+		ret = len;
+		goto out;
+	}
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == -ENOBUFS && len > conn_mss(conn)) {
+		/* Not enough buffers for a large packet, try a single segment */
+		len = conn_mss(conn);
+		ret = tcp_send_segment(conn, conn->unacked_len, len,
+				       conn->data_mode == TCP_DATA_MODE_RESEND);
+	}
+	if (ret == 0) {
+		conn->unacked_len += len;
+	}
+
 	conn_send_data_dump(conn);
 
  out:
@@ -1816,6 +2020,210 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+
+static bool tcp_sack_block_used(const struct tcp_sack_block *block)
+{
+	return block->start != block->end;
+}
+
+static void tcp_sack_add(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block *free_block = NULL;
+	bool merged;
+
+	/* Merge with any overlapping or adjacent range */
+	do {
+		merged = false;
+
+		ARRAY_FOR_EACH_PTR(conn->sack_scoreboard, block) {
+			if (!tcp_sack_block_used(block) ||
+			    net_tcp_seq_cmp(block->start, end) > 0 ||
+			    net_tcp_seq_cmp(start, block->end) > 0) {
+				continue;
+			}
+
+			if (net_tcp_seq_cmp(block->start, start) < 0) {
+				start = block->start;
+			}
+
+			if (net_tcp_seq_cmp(block->end, end) > 0) {
+				end = block->end;
+			}
+
+			block->start = block->end;
+			merged = true;
+		}
+	} while (merged);
+
+	ARRAY_FOR_EACH_PTR(conn->sack_scoreboard, block) {
+		if (!tcp_sack_block_used(block)) {
+			free_block = block;
+			break;
+		}
+	}
+
+	/* If the scoreboard is full, the range is just not known to be
+	 * SACKed and might get retransmitted needlessly.
+	 */
+	if (free_block != NULL) {
+		free_block->start = start;
+		free_block->end = end;
+	}
+}
+
+/* Update the scoreboard with the cumulative ACK and SACK blocks received */
+static void tcp_sack_update(struct tcp *conn, uint32_t ack)
+{
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+
+	ARRAY_FOR_EACH_PTR(conn->sack_scoreboard, block) {
+		if (!tcp_sack_block_used(block)) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block->end, ack) <= 0) {
+			block->start = block->end;
+		} else if (net_tcp_seq_cmp(block->start, ack) < 0) {
+			block->start = ack;
+		}
+	}
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	for (int i = 0; i < conn->recv_options.sack_count; i++) {
+		struct tcp_sack_block *block = &conn->recv_options.sack[i];
+
+		/* Ignore blocks not covering data in flight, like D-SACK */
+		if (net_tcp_seq_cmp(block->start, ack) < 0 ||
+		    net_tcp_seq_cmp(block->end, snd_nxt) > 0 ||
+		    net_tcp_seq_cmp(block->start, block->end) >= 0) {
+			continue;
+		}
+
+		tcp_sack_add(conn, block->start, block->end);
+	}
+}
+
+/* Retransmit the next segment the peer is missing, as NextSeg() of RFC 6675.
+ * Besides the first unacknowledged segment, only holes below the highest
+ * SACKed sequence number are considered lost.
+ */
+static void tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+	uint32_t high_sacked = conn->seq;
+	uint32_t start = conn->sack_high_rxt;
+	uint32_t end = snd_nxt;
+	bool moved;
+	int len;
+
+	if (net_tcp_seq_cmp(start, conn->seq) < 0) {
+		start = conn->seq;
+	}
+
+	do {
+		moved = false;
+
+		ARRAY_FOR_EACH_PTR(conn->sack_scoreboard, block) {
+			if (tcp_sack_block_used(block) &&
+			    net_tcp_seq_cmp(block->start, start) <= 0 &&
+			    net_tcp_seq_cmp(block->end, start) > 0) {
+				start = block->end;
+				moved = true;
+			}
+		}
+	} while (moved);
+
+	ARRAY_FOR_EACH_PTR(conn->sack_scoreboard, block) {
+		if (!tcp_sack_block_used(block)) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block->end, high_sacked) > 0) {
+			high_sacked = block->end;
+		}
+
+		if (net_tcp_seq_cmp(block->start, start) > 0 &&
+		    net_tcp_seq_cmp(block->start, end) < 0) {
+			end = block->start;
+		}
+	}
+
+	if (net_tcp_seq_cmp(start, snd_nxt) >= 0 ||
+	    (start != conn->seq && net_tcp_seq_cmp(start, high_sacked) >= 0)) {
+		return;
+	}
+
+	len = MIN(end - start, conn_mss(conn));
+
+	NET_DBG("conn: %p SACK retransmit seq %u len %d", conn, start, len);
+
+	if (tcp_send_segment(conn, start - conn->seq, len, true) == 0) {
+		conn->sack_high_rxt = start + len;
+	}
+}
+
+static bool tcp_sack_fast_retransmit(struct tcp *conn)
+{
+	if (!conn->sack_ok) {
+		return false;
+	}
+
+	if (!conn->sack_recovery) {
+		conn->sack_recovery = true;
+		conn->sack_recovery_point = conn->seq + conn->unacked_len;
+		conn->sack_high_rxt = conn->seq;
+	}
+
+	tcp_sack_retransmit(conn);
+
+	return true;
+}
+
+static void tcp_sack_dup_ack(struct tcp *conn)
+{
+	if (conn->sack_recovery) {
+		tcp_sack_retransmit(conn);
+	}
+}
+
+static void tcp_sack_pkts_acked(struct tcp *conn)
+{
+	if (!conn->sack_recovery) {
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, conn->sack_recovery_point) >= 0) {
+		conn->sack_recovery = false;
+	} else {
+		/* Partial ACK, keep on filling the holes */
+		tcp_sack_retransmit(conn);
+	}
+}
+
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sack_recovery = false;
+	memset(conn->sack_scoreboard, 0, sizeof(conn->sack_scoreboard));
+}
+
+#else
+
+static void tcp_sack_update(struct tcp *conn, uint32_t ack) { }
+
+static bool tcp_sack_fast_retransmit(struct tcp *conn) { return false; }
+
+static void tcp_sack_dup_ack(struct tcp *conn) { }
+
+static void tcp_sack_pkts_acked(struct tcp *conn) { }
+
+static void tcp_sack_reset(struct tcp *conn) { }
+
+#endif /* CONFIG_NET_TCP_SACK */
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1868,6 +2276,8 @@ static void tcp_resend_data(struct k_work *work)
 			}
 		}
 
+		tcp_sack_reset(conn);
+
 		conn->data_mode = TCP_DATA_MODE_RESEND;
 		conn->unacked_len = 0;
 
@@ -2098,10 +2508,10 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
-	conn->recv_win_max = tcp_rx_window;
+	conn->recv_win_max = MIN(tcp_rx_window, NET_TCP_MAX_WIN);
 	conn->recv_win = conn->recv_win_max;
 	conn->recv_win_sent = conn->recv_win_max;
-	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
+	conn->send_win_max = MIN(MAX(tcp_tx_window, NET_IPV6_MTU), NET_TCP_MAX_WIN);
 	conn->send_win = conn->send_win_max;
 	conn->tcp_nodelay = false;
 	conn->addr_ref_done = false;
@@ -2112,7 +2522,8 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = NET_TCP_MAX_WIN;
+	conn->ca_ops = tcp_ca_default();
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2759,6 +3170,87 @@ static void tcp_out_of_order_data(struct tcp *conn, struct net_pkt *pkt,
 	tcp_queue_recv_data(conn, pkt, data_len, seq);
 }
 
+/* Windows above 64 KiB need the window scale option, which is agreed on
+ * in the handshake.
+ */
+static uint32_t tcp_max_recv_win(struct tcp *conn)
+{
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    (conn->wscale_ok || conn->state == TCP_LISTEN)) {
+		return NET_TCP_MAX_WIN;
+	}
+
+	return UINT16_MAX;
+}
+
+/* Agree on the options offered in the peer's SYN or SYN-ACK */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) && conn->recv_options.wnd_found) {
+		conn->wscale_ok = true;
+		conn->snd_wscale = MIN(conn->recv_options.window, NET_TCP_MAX_WINDOW_SCALE);
+
+		if (conn->state == TCP_LISTEN) {
+			conn->rcv_wscale = tcp_window_scale_for(conn->recv_win_max);
+		}
+	} else {
+		conn->wscale_ok = false;
+		conn->snd_wscale = 0U;
+		conn->rcv_wscale = 0U;
+		conn->recv_win_max = MIN(conn->recv_win_max, UINT16_MAX);
+		conn->recv_win = MIN(conn->recv_win, conn->recv_win_max);
+	}
+
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK) && conn->recv_options.sack_perm_found;
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	conn->ts_ok = conn->recv_options.ts_found;
+	if (conn->ts_ok) {
+		conn->ts_recent = conn->recv_options.tsval;
+		conn->ts_recent_age = k_uptime_get_32();
+	}
+#endif
+
+	NET_DBG("conn: %p wscale %d/%d sack %d ts %d", conn,
+		conn->wscale_ok ? conn->snd_wscale : -1,
+		conn->wscale_ok ? conn->rcv_wscale : -1,
+		conn->sack_ok, conn->ts_ok);
+}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* TS.Recent is not compared against anymore after 24 days of idle time */
+#define TCP_PAWS_IDLE_MS (24U * 24U * 60U * 60U * MSEC_PER_SEC)
+
+/* Check the timestamp of a segment as per RFC 7323 ch 5.3, returns false
+ * if the segment is an old duplicate. RST segments are not checked (R1).
+ */
+static bool tcp_timestamps_check(struct tcp *conn, struct tcphdr *th)
+{
+	uint32_t now = k_uptime_get_32();
+
+	if (!conn->ts_ok || !conn->recv_options.ts_found || (th_flags(th) & RST)) {
+		return true;
+	}
+
+	if ((int32_t)(conn->recv_options.tsval - conn->ts_recent) < 0 &&
+	    (now - conn->ts_recent_age) < TCP_PAWS_IDLE_MS) {
+		return false;
+	}
+
+	if (net_tcp_seq_cmp(th_seq(th), conn->last_ack_sent) <= 0) {
+		conn->ts_recent = conn->recv_options.tsval;
+		conn->ts_recent_age = now;
+	}
+
+	return true;
+}
+#else
+static bool tcp_timestamps_check(struct tcp *conn, struct tcphdr *th)
+{
+	return true;
+}
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
 static void tcp_check_sock_options(struct tcp *conn)
 {
 	int sndbuf_opt = 0;
@@ -2774,6 +3266,14 @@ static void tcp_check_sock_options(struct tcp *conn)
 					     &rcvbuf_opt, NULL);
 	}
 
+	if (sndbuf_opt > 0) {
+		sndbuf_opt = MIN((uint32_t)sndbuf_opt, NET_TCP_MAX_WIN);
+	}
+
+	if (rcvbuf_opt > 0) {
+		rcvbuf_opt = MIN((uint32_t)rcvbuf_opt, tcp_max_recv_win(conn));
+	}
+
 	if (sndbuf_opt > 0 && sndbuf_opt != conn->send_win_max) {
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
@@ -2897,6 +3397,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	tcp_options_reset(&conn->recv_options);
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2920,6 +3422,14 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (!tcp_timestamps_check(conn, th)) {
+		NET_DBG("conn: %p, PAWS check failed, dropping segment", conn);
+		net_stats_update_tcp_seg_drop(conn->iface);
+		tcp_out(conn, ACK);
+		k_mutex_unlock(&conn->lock);
+		return NET_DROP;
+	}
+
 	/* Now validate the ACK flag and ACKnum */
 	if ((conn->state != TCP_LISTEN) && (conn->state != TCP_SYN_SENT)) {
 		uint32_t snduna = conn->seq;
@@ -2957,6 +3467,10 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	/* Both the seqnum and the acknum are valid, then do processing. */
 	conn->send_win = ntohs(th_win(th));
+	if (conn->wscale_ok && !(th_flags(th) & SYN)) {
+		conn->send_win <<= conn->snd_wscale;
+	}
+
 	if (conn->send_win > conn->send_win_max) {
 		NET_DBG("Lowering send window from %u to %u", conn->send_win, conn->send_win_max);
 		conn->send_win = conn->send_win_max;
@@ -2984,6 +3498,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
+			tcp_options_negotiate(conn);
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
 			conn_seq(conn, + 1);
@@ -3011,6 +3526,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_param_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3098,6 +3614,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			k_work_cancel_delayable(&conn->send_data_timer);
+			tcp_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3171,6 +3688,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		keep_alive_timer_restart(conn);
 
+		tcp_sack_update(conn, th_ack(th));
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3192,19 +3711,27 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
 				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				if (!tcp_sack_fast_retransmit(conn)) {
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
+			} else if ((conn->data_mode == TCP_DATA_MODE_SEND) && (len == 0) &&
+				   (conn->dup_ack_cnt > DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
+				/* Every further duplicate ACK reports a segment
+				 * that has left the network, send another one.
+				 */
+				tcp_sack_dup_ack(conn);
 			}
 		}
 #endif
@@ -3268,6 +3795,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				tcp_setup_retransmission(conn);
 			}
 
+			tcp_sack_pkts_acked(conn);
+
 			/* We are closing the connection, send a FIN to peer */
 			if (conn->in_close && conn->send_data_total == 0) {
 				next = TCP_FIN_WAIT_1;
@@ -3762,6 +4291,94 @@ out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+static void tcp_zc_buf_destroy(struct net_buf *buf);
+
+/* Views into the buffers given to net_tcp_queue_buf(), each one holds a
+ * reference to the buffer it points into.
+ */
+NET_BUF_POOL_FIXED_DEFINE(tcp_zc_pool, CONFIG_NET_SOCKETS_ZEROCOPY_TCP_BUFS, 0,
+			  sizeof(struct net_buf *), tcp_zc_buf_destroy);
+
+static void tcp_zc_buf_destroy(struct net_buf *buf)
+{
+	struct net_buf *parent = *(struct net_buf **)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+	net_buf_unref(parent);
+}
+
+int net_tcp_queue_buf(struct net_context *context, struct net_buf *frags)
+{
+	struct tcp *conn = context->tcp;
+	size_t queued_len = 0;
+	size_t len;
+	int ret;
+
+	if (!conn || conn->state != TCP_ESTABLISHED) {
+		return -ENOTCONN;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (tcp_window_full(conn)) {
+		ret = -EAGAIN;
+		goto out;
+	}
+
+	/* Queue no more than TX window permits, as net_tcp_queue() does.
+	 * The caller's buffers cannot be linked into the queue as they
+	 * are, as only a part of the chain may fit, so views pointing into
+	 * them are queued instead.
+	 */
+	len = MIN(conn->send_win - conn->send_data_total, net_buf_frags_len(frags));
+
+	for (struct net_buf *buf = frags; buf != NULL && queued_len < len; buf = buf->frags) {
+		size_t frag_len = MIN(buf->len, len - queued_len);
+		struct net_buf *view;
+
+		if (frag_len == 0) {
+			continue;
+		}
+
+		view = net_buf_alloc_with_data(&tcp_zc_pool, buf->data, frag_len, K_NO_WAIT);
+		if (view == NULL) {
+			break;
+		}
+
+		*(struct net_buf **)net_buf_user_data(view) = net_buf_ref(buf);
+		net_pkt_append_buffer(conn->send_data, view);
+		queued_len += frag_len;
+	}
+
+	if (queued_len == 0) {
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	conn->send_data_total += queued_len;
+
+	/* The connection only holds its own references to the data, so it
+	 * can drop them on failure while the caller keeps the chain.
+	 */
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		tcp_conn_close(conn, ret);
+		goto out;
+	}
+
+	if (tcp_window_full(conn)) {
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	}
+
+	ret = queued_len;
+out:
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 /* net context is about to send out queued data - inform caller only */
 int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 		      void *user_data)
@@ -3781,6 +4398,10 @@ static int tcp_start_handshake(struct tcp *conn)
 	k_mutex_lock(&conn->lock, K_FOREVER);
 	tcp_check_sock_options(conn);
 	conn->send_options.mss_found = true;
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE)) {
+		conn->rcv_wscale = tcp_window_scale_for(conn->recv_win_max);
+	}
+
 	ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 	if (ret < 0) {
 		k_mutex_unlock(&conn->lock);
@@ -4082,7 +4703,9 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
+	/* Packets to be segmented get their checksums per segment */
+	if ((net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) &&
+	     net_pkt_gso_size(pkt) == 0U) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -4100,6 +4723,7 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
 	    (net_if_need_calc_rx_checksum(net_pkt_iface(pkt), type) ||
 	     net_pkt_is_ip_reassembled(pkt)) &&
+	    !net_pkt_is_tcp_gro(pkt) &&
 	    net_calc_chksum_tcp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
@@ -4548,6 +5172,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4585,6 +5212,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
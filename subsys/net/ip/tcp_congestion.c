@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP congestion control registry and the New Reno algorithm */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_context.h>
+
+#include "tcp_internal.h"
+
+/* Define the number of MSS sections the congestion window is initialized at */
+#define TCP_CONGESTION_INITIAL_WIN 1
+#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+
+static const struct tcp_ca_ops *const tcp_ca_algorithms[] = {
+	&tcp_ca_new_reno_ops,
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	&tcp_ca_cubic_ops,
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_VEGAS)
+	&tcp_ca_vegas_ops,
+#endif
+};
+
+const struct tcp_ca_ops *tcp_ca_find(const char *name)
+{
+	ARRAY_FOR_EACH(tcp_ca_algorithms, i) {
+		if (strcmp(tcp_ca_algorithms[i]->name, name) == 0) {
+			return tcp_ca_algorithms[i];
+		}
+	}
+
+	return NULL;
+}
+
+const struct tcp_ca_ops *tcp_ca_default(void)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+	return &tcp_ca_cubic_ops;
+#elif defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_VEGAS)
+	return &tcp_ca_vegas_ops;
+#else
+	return &tcp_ca_new_reno_ops;
+#endif
+}
+
+void tcp_ca_log(struct tcp *conn, const char *step)
+{
+	NET_DBG("conn: %p, %s %s, cwnd=%u, ssthres=%u, fast_pend=%u",
+		conn, conn->ca_ops->name, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.pending_fast_retransmit_bytes);
+}
+
+/* Implementation according to RFC6582 */
+
+void tcp_ca_reno_init(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+}
+
+void tcp_ca_reno_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_ca_log(conn, "fast_retransmit");
+	}
+}
+
+void tcp_ca_reno_timeout(struct tcp *conn)
+{
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_ca_log(conn, "timeout");
+}
+
+/* For every duplicate ack increment the cwnd by mss */
+void tcp_ca_reno_dup_ack(struct tcp *conn)
+{
+	uint32_t new_win = conn->ca.cwnd + conn_mss(conn);
+
+	conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
+	tcp_ca_log(conn, "dup_ack");
+}
+
+/* Deflate the window while in fast recovery, returns false outside of it */
+bool tcp_ca_reno_recovery(struct tcp *conn, uint32_t acked_len)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		return false;
+	}
+
+	/* Check if it is still in fast recovery mode */
+	if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+		conn->ca.pending_fast_retransmit_bytes = 0;
+		conn->ca.cwnd = conn->ca.ssthresh;
+	} else {
+		conn->ca.pending_fast_retransmit_bytes -= acked_len;
+		conn->ca.cwnd = MAX(conn->ca.cwnd - MIN(conn->ca.cwnd, acked_len),
+				    conn_mss(conn));
+	}
+
+	return true;
+}
+
+void tcp_ca_reno_slow_start(struct tcp *conn, uint32_t acked_len)
+{
+	uint32_t new_win = conn->ca.cwnd + MIN(acked_len, conn_mss(conn));
+
+	conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
+}
+
+void tcp_ca_reno_congestion_avoidance(struct tcp *conn, uint32_t acked_len)
+{
+	uint64_t win_inc = MIN(acked_len, conn_mss(conn));
+	uint32_t new_win = conn->ca.cwnd;
+
+	/* Implement a div_ceil to avoid rounding to 0 */
+	new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
+	conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
+}
+
+static void tcp_new_reno_init(struct tcp *conn)
+{
+	tcp_ca_reno_init(conn);
+	tcp_ca_log(conn, "init");
+}
+
+static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt_us)
+{
+	ARG_UNUSED(rtt_us);
+
+	if (!tcp_ca_reno_recovery(conn, acked_len)) {
+		if (conn->ca.cwnd < conn->ca.ssthresh) {
+			tcp_ca_reno_slow_start(conn, acked_len);
+		} else {
+			tcp_ca_reno_congestion_avoidance(conn, acked_len);
+		}
+	}
+
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+const struct tcp_ca_ops tcp_ca_new_reno_ops = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_ca_reno_fast_retransmit,
+	.timeout = tcp_ca_reno_timeout,
+	.dup_ack = tcp_ca_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, RFC 9438. Fixed point, times in milliseconds. */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_context.h>
+
+#include "tcp_internal.h"
+
+/* Multiplicative decrease factor, 0.7 scaled by 1024 */
+#define CUBIC_BETA 717
+/* Cubic scaling constant, 0.4 scaled by 1024 */
+#define CUBIC_C 410
+/* Reno-friendly additive increase, 3 * (1 - beta) / (1 + beta) scaled by 1024 */
+#define CUBIC_ALPHA 542
+/* K^3 in ms^3 is (w_max - cwnd) / mss / C * 10^9 */
+#define CUBIC_K_SCALE 2500000000ULL
+/* Keep the cube of the time offset within 64 bits */
+#define CUBIC_MAX_OFFSET_MS 100000ULL
+
+static uint32_t cubic_cbrt(uint64_t value)
+{
+	uint64_t root = 0;
+
+	for (int bit = 21; bit >= 0; bit--) {
+		uint64_t next = root | BIT64(bit);
+
+		if (next * next * next <= value) {
+			root = next;
+		}
+	}
+
+	return (uint32_t)root;
+}
+
+/* Congestion event, remember where it happened and shrink the window */
+static void cubic_reduce(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+
+	/* Fast convergence, release bandwidth to newer flows */
+	if (cwnd < cubic->w_max) {
+		cubic->w_max = (uint32_t)(((uint64_t)cwnd * (1024 + CUBIC_BETA)) / 2048);
+	} else {
+		cubic->w_max = cwnd;
+	}
+
+	conn->ca.ssthresh = MAX((uint32_t)(((uint64_t)conn->unacked_len * CUBIC_BETA) >> 10),
+				conn_mss(conn) * 2);
+	cubic->epoch_start = 0;
+}
+
+static void cubic_update(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = MAX(k_uptime_get_32(), 1);
+	uint32_t target;
+	uint32_t new_win;
+	uint64_t offs;
+	uint64_t delta;
+	uint32_t t;
+
+	if (cubic->epoch_start == 0) {
+		/* First increase after a congestion event */
+		cubic->epoch_start = now;
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			cubic->k = cubic_cbrt((uint64_t)(cubic->w_max - cwnd) * CUBIC_K_SCALE /
+					      mss);
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0;
+			cubic->origin = cwnd;
+		}
+	}
+
+	/* Window the cubic function gives one round trip from now */
+	t = now - cubic->epoch_start + cubic->min_rtt / USEC_PER_MSEC;
+	offs = (t > cubic->k) ? t - cubic->k : cubic->k - t;
+	offs = MIN(offs, CUBIC_MAX_OFFSET_MS);
+	delta = (((offs * offs * offs * CUBIC_C) / 1000000000ULL) * mss) >> 10;
+
+	if (t > cubic->k) {
+		target = (uint32_t)MIN(cubic->origin + delta, NET_TCP_MAX_WIN);
+	} else {
+		target = (cubic->origin > delta) ? cubic->origin - (uint32_t)delta : mss;
+	}
+
+	/* Grow by at most half a window per round trip */
+	target = MIN(target, cwnd + cwnd / 2);
+
+	new_win = cwnd;
+	if (target > cwnd) {
+		new_win += (uint32_t)(((uint64_t)(target - cwnd) * acked_len) / cwnd);
+	}
+
+	/* Never be slower than Reno would be on the same path */
+	cubic->w_est += (uint32_t)((((uint64_t)acked_len * mss * CUBIC_ALPHA) >> 10) / cwnd);
+	new_win = MAX(new_win, cubic->w_est);
+
+	conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	tcp_ca_reno_init(conn);
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+	tcp_ca_log(conn, "init");
+}
+
+static void cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes != 0) {
+		return;
+	}
+
+	cubic_reduce(conn);
+	/* Account for the lost segments */
+	conn->ca.cwnd = conn->ca.ssthresh + conn_mss(conn) * 3;
+	conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+	tcp_ca_log(conn, "fast_retransmit");
+}
+
+static void cubic_timeout(struct tcp *conn)
+{
+	cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_ca_log(conn, "timeout");
+}
+
+static void cubic_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt_us)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+
+	if (rtt_us != 0 && (cubic->min_rtt == 0 || rtt_us < cubic->min_rtt)) {
+		cubic->min_rtt = rtt_us;
+	}
+
+	if (!tcp_ca_reno_recovery(conn, acked_len)) {
+		if (conn->ca.cwnd < conn->ca.ssthresh) {
+			tcp_ca_reno_slow_start(conn, acked_len);
+		} else {
+			cubic_update(conn, acked_len);
+		}
+	}
+
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+const struct tcp_ca_ops tcp_ca_cubic_ops = {
+	.name = "cubic",
+	.init = cubic_init,
+	.fast_retransmit = cubic_fast_retransmit,
+	.timeout = cubic_timeout,
+	.dup_ack = tcp_ca_reno_dup_ack,
+	.pkts_acked = cubic_pkts_acked,
+};
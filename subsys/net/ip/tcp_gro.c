@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP generic receive offload. Each RX queue thread holds back at
+ * most one received TCP segment and appends the following in-order segments
+ * of the same connection to it, so that TCP handles them as one packet. The
+ * held packet is passed on as soon as something else arrives or the RX
+ * queue runs empty.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "tcp_internal.h"
+
+/* Headers of a segment that can be coalesced */
+struct gro_hdrs {
+	uint8_t *ip;
+	struct net_tcp_hdr *tcp;
+	uint16_t ip_len;
+	uint16_t hdrs_len;
+	/* Offset of the timestamp option in the TCP options plus one, 0 if none */
+	uint8_t ts_opt;
+};
+
+struct gro_flow {
+	struct net_pkt *pkt;
+	struct gro_hdrs hdrs;
+	uint32_t next_seq;
+	uint8_t segs;
+	bool is_loopback;
+};
+
+static struct gro_flow gro_flows[NET_TC_RX_QUEUE_COUNT];
+
+static uint8_t gro_find_ts(uint8_t *opts, uint16_t len)
+{
+	uint16_t i = 0U;
+
+	while (i < len && opts[i] != NET_TCP_END_OPT) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (i + 1 >= len || opts[i + 1] < 2U || opts[i + 1] > len - i) {
+			break;
+		}
+
+		if (opts[i] == NET_TCP_TIMESTAMP_OPT &&
+		    opts[i + 1] == NET_TCP_TIMESTAMP_SIZE) {
+			return i + 1;
+		}
+
+		i += opts[i + 1];
+	}
+
+	return 0U;
+}
+
+static bool gro_parse(struct net_pkt *pkt, struct gro_hdrs *hdrs)
+{
+	uint8_t *ip = net_pkt_ip_data(pkt);
+	size_t pkt_len = net_pkt_get_len(pkt);
+	uint16_t ip_hdr_len;
+	uint16_t ip_len;
+
+	if (pkt_len < NET_IPV4TCPH_LEN ||
+	    !net_pkt_is_contiguous(pkt, MIN(pkt_len, NET_IPV6TCPH_LEN + NET_TCP_MAX_OPT_SIZE))) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && ip[0] == 0x45) {
+		struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)ip;
+
+		/* No options and no fragments */
+		if (hdr->proto != IPPROTO_TCP ||
+		    (sys_get_be16(hdr->offset) & (NET_IPV4_MORE_FRAG_MASK |
+						  NET_IPV4_FRAGH_OFFSET_MASK))) {
+			return false;
+		}
+
+		ip_hdr_len = NET_IPV4H_LEN;
+		ip_len = ntohs(hdr->len);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && (ip[0] & 0xf0) == 0x60) {
+		struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)ip;
+
+		/* No extension headers */
+		if (hdr->nexthdr != IPPROTO_TCP) {
+			return false;
+		}
+
+		ip_hdr_len = NET_IPV6H_LEN;
+		ip_len = NET_IPV6H_LEN + ntohs(hdr->len);
+	} else {
+		return false;
+	}
+
+	if (ip_len > pkt_len || ip_len < ip_hdr_len + NET_TCPH_LEN) {
+		return false;
+	}
+
+	hdrs->ip = ip;
+	hdrs->tcp = (struct net_tcp_hdr *)(ip + ip_hdr_len);
+	hdrs->ip_len = ip_len;
+	hdrs->hdrs_len = ip_hdr_len + (hdrs->tcp->offset >> 4) * 4;
+
+	/* Only plain data segments, anything else ends the run */
+	if ((hdrs->tcp->flags & ~PSH) != ACK || hdrs->hdrs_len >= ip_len ||
+	    !net_pkt_is_contiguous(pkt, hdrs->hdrs_len)) {
+		return false;
+	}
+
+	/* Drop the link layer padding of short frames */
+	if (pkt_len > ip_len && net_pkt_update_length(pkt, ip_len) < 0) {
+		return false;
+	}
+
+	hdrs->ts_opt = gro_find_ts(hdrs->tcp->optdata, hdrs->hdrs_len - ip_hdr_len - NET_TCPH_LEN);
+
+	net_pkt_set_family(pkt, ip_hdr_len == NET_IPV4H_LEN ? AF_INET : AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, ip_hdr_len);
+	net_pkt_set_ipv4_opts_len(pkt, 0);
+	net_pkt_set_ipv6_ext_len(pkt, 0);
+
+	return true;
+}
+
+/* The options must match, except for the timestamp values which may only
+ * move forward. Every segment of a burst carries its own TSval, requiring
+ * identical bytes would stop coalescing whenever timestamps are in use.
+ */
+static bool gro_same_options(struct gro_hdrs *held, struct gro_hdrs *hdrs, uint16_t len)
+{
+	uint8_t *a = held->tcp->optdata;
+	uint8_t *b = hdrs->tcp->optdata;
+	uint16_t ts;
+
+	if (held->ts_opt != hdrs->ts_opt) {
+		return false;
+	}
+
+	if (held->ts_opt == 0U) {
+		return memcmp(a, b, len) == 0;
+	}
+
+	/* Compare up to and including the length byte, then after the values */
+	ts = held->ts_opt + 1U;
+
+	return memcmp(a, b, ts) == 0 &&
+	       memcmp(a + ts + 8U, b + ts + 8U, len - ts - 8U) == 0 &&
+	       (int32_t)(sys_get_be32(b + ts) - sys_get_be32(a + ts)) >= 0 &&
+	       (int32_t)(sys_get_be32(b + ts + 4U) - sys_get_be32(a + ts + 4U)) >= 0;
+}
+
+static bool gro_same_flow(struct gro_hdrs *held, struct gro_hdrs *hdrs)
+{
+	uint16_t ip_hdr_len = (uint8_t *)held->tcp - held->ip;
+
+	if (hdrs->ip[0] != held->ip[0] || hdrs->hdrs_len != held->hdrs_len) {
+		return false;
+	}
+
+	if (ip_hdr_len == NET_IPV4H_LEN) {
+		struct net_ipv4_hdr *a = (struct net_ipv4_hdr *)held->ip;
+		struct net_ipv4_hdr *b = (struct net_ipv4_hdr *)hdrs->ip;
+
+		if (a->tos != b->tos || a->ttl != b->ttl ||
+		    memcmp(a->offset, b->offset, sizeof(a->offset)) != 0 ||
+		    memcmp(a->src, b->src, 2 * NET_IPV4_ADDR_SIZE) != 0) {
+			return false;
+		}
+	} else {
+		struct net_ipv6_hdr *a = (struct net_ipv6_hdr *)held->ip;
+		struct net_ipv6_hdr *b = (struct net_ipv6_hdr *)hdrs->ip;
+
+		if (memcmp(a, b, offsetof(struct net_ipv6_hdr, len)) != 0 ||
+		    a->hop_limit != b->hop_limit ||
+		    memcmp(a->src, b->src, 2 * NET_IPV6_ADDR_SIZE) != 0) {
+			return false;
+		}
+	}
+
+	/* Ports, ack, window and options must all match */
+	return held->tcp->src_port == hdrs->tcp->src_port &&
+	       held->tcp->dst_port == hdrs->tcp->dst_port &&
+	       memcmp(held->tcp->ack, hdrs->tcp->ack, sizeof(held->tcp->ack)) == 0 &&
+	       memcmp(held->tcp->wnd, hdrs->tcp->wnd, sizeof(held->tcp->wnd)) == 0 &&
+	       gro_same_options(held, hdrs, held->hdrs_len - ip_hdr_len - NET_TCPH_LEN);
+}
+
+static bool gro_chksum_ok(struct net_pkt *pkt)
+{
+	enum net_if_checksum_type type = net_pkt_family(pkt) == AF_INET6 ?
+		NET_IF_CHECKSUM_IPV6_TCP : NET_IF_CHECKSUM_IPV4_TCP;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) ||
+	    !net_if_need_calc_rx_checksum(net_pkt_iface(pkt), type)) {
+		return true;
+	}
+
+	return net_calc_chksum_tcp(pkt) == 0U;
+}
+
+static uint32_t gro_payload_len(struct gro_hdrs *hdrs)
+{
+	return hdrs->ip_len - hdrs->hdrs_len;
+}
+
+static void gro_deliver(struct net_pkt *pkt, bool is_loopback)
+{
+	enum net_verdict verdict = NET_DROP;
+
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		verdict = net_ipv4_input(pkt, is_loopback);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		verdict = net_ipv6_input(pkt, is_loopback);
+	}
+
+	if (verdict != NET_OK) {
+		NET_DBG("Dropping pkt %p", pkt);
+		net_pkt_unref(pkt);
+	}
+}
+
+static void gro_flow_flush(struct gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+
+	if (pkt == NULL) {
+		return;
+	}
+
+	flow->pkt = NULL;
+
+	if (flow->segs > 1) {
+		if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+			struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)flow->hdrs.ip;
+
+			hdr->len = htons(flow->hdrs.ip_len);
+			hdr->chksum = 0U;
+			hdr->chksum = net_calc_chksum_ipv4(pkt);
+		} else {
+			struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)flow->hdrs.ip;
+
+			hdr->len = htons(flow->hdrs.ip_len - NET_IPV6H_LEN);
+		}
+
+		/* The checksum of every segment was verified when it was merged */
+		net_pkt_set_tcp_gro(pkt, true);
+
+		NET_DBG("pkt %p, %u segments coalesced into %u bytes", pkt, flow->segs,
+			flow->hdrs.ip_len);
+	}
+
+	gro_deliver(pkt, flow->is_loopback);
+}
+
+/* Append the payload of pkt to the held packet */
+static bool gro_merge(struct gro_flow *flow, struct net_pkt *pkt, struct gro_hdrs *hdrs)
+{
+	struct net_buf *buf = pkt->buffer;
+
+	if (flow->segs == 1 && !gro_chksum_ok(flow->pkt)) {
+		return false;
+	}
+
+	if (!gro_chksum_ok(pkt)) {
+		return false;
+	}
+
+	flow->hdrs.tcp->flags |= hdrs->tcp->flags;
+
+	/* Keep the TSval of the first segment, it is the one to echo as per
+	 * RFC 7323 ch 4.3, but take the most recent TSecr for RTT measurement.
+	 */
+	if (flow->hdrs.ts_opt != 0U) {
+		memcpy(flow->hdrs.tcp->optdata + flow->hdrs.ts_opt + 5U,
+		       hdrs->tcp->optdata + hdrs->ts_opt + 5U, sizeof(uint32_t));
+	}
+	flow->hdrs.ip_len += gro_payload_len(hdrs);
+	flow->next_seq += gro_payload_len(hdrs);
+	flow->segs++;
+
+	/* The headers are contiguous in the first buffer */
+	net_buf_pull(buf, hdrs->hdrs_len);
+	if (buf->len == 0U) {
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	net_pkt_append_buffer(flow->pkt, buf);
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	return true;
+}
+
+enum net_verdict net_tcp_gro_receive(struct net_pkt *pkt, bool is_loopback)
+{
+	int queue = net_tc_rx_current_queue();
+	struct gro_flow *flow;
+	struct gro_hdrs hdrs;
+
+	/* Only the RX queue threads flush held packets */
+	if (queue < 0) {
+		return NET_CONTINUE;
+	}
+
+	flow = &gro_flows[queue];
+
+	if (!gro_parse(pkt, &hdrs)) {
+		gro_flow_flush(flow);
+		return NET_CONTINUE;
+	}
+
+	if (flow->pkt != NULL && net_pkt_iface(flow->pkt) == net_pkt_iface(pkt) &&
+	    sys_get_be32(hdrs.tcp->seq) == flow->next_seq &&
+	    flow->segs < CONFIG_NET_TCP_GRO_MAX_SEGS &&
+	    flow->hdrs.ip_len + gro_payload_len(&hdrs) <= UINT16_MAX &&
+	    gro_same_flow(&flow->hdrs, &hdrs) && gro_merge(flow, pkt, &hdrs)) {
+		/* The sender pushes at the end of a write, do not wait for more */
+		if (flow->hdrs.tcp->flags & PSH) {
+			gro_flow_flush(flow);
+		}
+
+		return NET_OK;
+	}
+
+	gro_flow_flush(flow);
+
+	if (hdrs.tcp->flags & PSH) {
+		return NET_CONTINUE;
+	}
+
+	flow->pkt = pkt;
+	flow->hdrs = hdrs;
+	flow->next_seq = sys_get_be32(hdrs.tcp->seq) + gro_payload_len(&hdrs);
+	flow->segs = 1U;
+	flow->is_loopback = is_loopback;
+
+	return NET_OK;
+}
+
+void net_tcp_gro_flush(uint8_t queue)
+{
+	gro_flow_flush(&gro_flows[queue]);
+}
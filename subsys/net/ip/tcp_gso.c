@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP generic segmentation offload. TCP hands packets of several segments
+ * to the IP layer, and they are split into MSS sized segments here just
+ * before being queued to an interface that cannot segment them itself.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+#define GSO_BUF_TIMEOUT K_MSEC(100)
+
+/* Length of the IP and TCP headers in front of the payload */
+static int gso_hdrs_len(struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	int ret = -ENOBUFS;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len) == 0) {
+		tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+		if (tcp_hdr) {
+			ret = ip_len + (tcp_hdr->offset >> 4) * 4;
+		}
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return ret;
+}
+
+static int gso_fix_hdrs(struct net_pkt *seg, uint32_t offset, bool last)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+
+	net_pkt_set_overwrite(seg, true);
+	net_pkt_cursor_init(seg);
+
+	/* The header checksum is computed over the field as well */
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		NET_IPV4_HDR(seg)->chksum = 0U;
+	}
+
+	if (net_pkt_skip(seg, net_pkt_ip_hdr_len(seg) + net_pkt_ip_opts_len(seg))) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	sys_put_be32(sys_get_be32(tcp_hdr->seq) + offset, tcp_hdr->seq);
+
+	/* Only the end of the data is pushed */
+	if (!last) {
+		tcp_hdr->flags &= ~(PSH | FIN);
+	}
+
+	if (net_pkt_set_data(seg, &tcp_access)) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		return net_ipv4_finalize(seg, IPPROTO_TCP);
+	}
+
+	return net_ipv6_finalize(seg, IPPROTO_TCP);
+}
+
+static int gso_make_segment(struct net_pkt *pkt, size_t hdrs_len, uint32_t offset,
+			    size_t len, bool last, struct net_pkt **segment)
+{
+	struct net_pkt *seg;
+	int ret = -ENOBUFS;
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdrs_len + len,
+					net_pkt_family(pkt), IPPROTO_TCP, GSO_BUF_TIMEOUT);
+	if (!seg) {
+		return -ENOMEM;
+	}
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(seg, pkt, hdrs_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+	net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+
+	ret = gso_fix_hdrs(seg, offset, last);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	net_pkt_set_overwrite(seg, false);
+	net_pkt_cursor_init(seg);
+
+	/* The send callback of the context is called once, for the last one */
+	if (last) {
+		net_pkt_set_context(seg, net_pkt_context(pkt));
+	}
+
+	*segment = seg;
+
+	return 0;
+
+fail:
+	net_pkt_unref(seg);
+	return ret;
+}
+
+static void gso_drop_segments(sys_slist_t *segs)
+{
+	sys_snode_t *node;
+
+	while ((node = sys_slist_get(segs)) != NULL) {
+		net_pkt_unref(CONTAINER_OF(node, struct net_pkt, next));
+	}
+}
+
+int net_tcp_gso_send(struct net_pkt *pkt)
+{
+	size_t gso_size = net_pkt_gso_size(pkt);
+	uint16_t index = 0U;
+	struct net_pkt *seg;
+	sys_slist_t segs;
+	sys_snode_t *node;
+	size_t payload_len;
+	int hdrs_len;
+	int ret;
+
+	hdrs_len = gso_hdrs_len(pkt);
+	if (hdrs_len < 0) {
+		return hdrs_len;
+	}
+
+	payload_len = net_pkt_get_len(pkt) - hdrs_len;
+	sys_slist_init(&segs);
+
+	/* Build all the segments first, so that nothing of the packet is
+	 * sent when running out of buffers. The driver can still fail to send
+	 * a segment after the ones before it went out.
+	 */
+	for (size_t offset = 0; offset < payload_len; offset += gso_size) {
+		size_t len = MIN(gso_size, payload_len - offset);
+
+		ret = gso_make_segment(pkt, hdrs_len, offset, len,
+				       offset + len == payload_len, &seg);
+		if (ret < 0) {
+			NET_DBG("Cannot build segment %u of pkt %p (%d)", index, pkt, ret);
+			goto drop;
+		}
+
+		sys_slist_append(&segs, &seg->next);
+		index++;
+	}
+
+	index = 0U;
+
+	while ((node = sys_slist_get(&segs)) != NULL) {
+		seg = CONTAINER_OF(node, struct net_pkt, next);
+
+		ret = net_send_data(seg);
+		if (ret < 0) {
+			NET_DBG("Cannot send segment %u of pkt %p (%d)", index, pkt, ret);
+			net_pkt_unref(seg);
+			goto drop;
+		}
+
+		index++;
+	}
+
+	return 0;
+
+drop:
+	/* The segments before a failing one may have been sent. TCP keeps
+	 * the whole packet in its send queue until it is acknowledged, so the
+	 * rest is retransmitted as for segments lost on the way.
+	 */
+	gso_drop_segments(&segs);
+	return ret;
+}
+
+int net_tcp_gso_finalize(struct net_pkt *pkt)
+{
+	int ret;
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt));
+	if (ret == 0) {
+		ret = net_tcp_finalize(pkt, true);
+	}
+
+	net_pkt_set_gso_size(pkt, 0U);
+	net_pkt_set_overwrite(pkt, false);
+	net_pkt_cursor_init(pkt);
+
+	return ret;
+}
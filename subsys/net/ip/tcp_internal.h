@@ -36,6 +36,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
 };
 
 /**
@@ -312,6 +313,27 @@ static inline int net_tcp_queue(struct net_context *context, const void *data,
 }
 #endif
 
+/**
+ * @brief Enqueue a buffer chain for transmission without copying it
+ *
+ * @param context	Network context
+ * @param frags		Data to send, the caller keeps its reference
+ *
+ * @return Number of bytes queued if ok, < 0 if error
+ */
+#if defined(CONFIG_NET_NATIVE_TCP) && defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+int net_tcp_queue_buf(struct net_context *context, struct net_buf *frags);
+#else
+static inline int net_tcp_queue_buf(struct net_context *context,
+				    struct net_buf *frags)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(frags);
+
+	return -EPROTONOSUPPORT;
+}
+#endif
+
 /**
  * @brief Update TCP receive window
  *
@@ -356,7 +378,12 @@ static inline int net_tcp_put(struct net_context *context)
 }
 #endif
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) || defined(CONFIG_NET_TCP_TIMESTAMPS) || \
+	defined(CONFIG_NET_TCP_SACK)
+#define NET_TCP_MAX_OPT_SIZE  40
+#else
 #define NET_TCP_MAX_OPT_SIZE  8
+#endif
 
 #if defined(CONFIG_NET_NATIVE_TCP)
 void net_tcp_init(void);
@@ -463,6 +490,48 @@ int net_tcp_endpoint_copy(struct net_context *ctx,
 			  struct sockaddr *peer,
 			  socklen_t *addrlen);
 
+/**
+ * @brief Split a TCP packet carrying more than one segment worth of data
+ * and send the segments.
+ *
+ * All the segments are built before any is sent, so an allocation failure
+ * sends nothing. A send failure stops at the failing segment, the segments
+ * before it having been sent already.
+ *
+ * @param pkt Packet with a GSO size set. It is not consumed.
+ *
+ * @return 0 if all the segments were sent, <0 if some or none of them were
+ */
+int net_tcp_gso_send(struct net_pkt *pkt);
+
+/**
+ * @brief Compute the TCP checksum of a packet that will not be segmented
+ * after all, and clear its GSO size.
+ *
+ * @param pkt Packet with a GSO size set
+ *
+ * @return 0 on success, <0 otherwise
+ */
+int net_tcp_gso_finalize(struct net_pkt *pkt);
+
+/**
+ * @brief Pass a received packet to TCP receive coalescing.
+ *
+ * @param pkt Received packet, with the cursor at the IP header
+ * @param is_loopback True if the packet was looped back
+ *
+ * @return NET_OK if the packet was held back or merged, NET_CONTINUE if
+ *         it should be processed normally
+ */
+enum net_verdict net_tcp_gro_receive(struct net_pkt *pkt, bool is_loopback);
+
+/**
+ * @brief Pass on the packet held back for coalescing by a RX queue.
+ *
+ * @param queue RX queue, as returned by net_tc_rx_current_queue()
+ */
+void net_tcp_gro_flush(uint8_t queue);
+
 #ifdef __cplusplus
 }
 #endif
@@ -132,10 +132,12 @@
 
 #define NET_TCP_DEFAULT_MSS 536
 
+/* The timestamp option, padded to 32 bits, is carried in every segment */
 #define conn_mss(_conn)							\
-	MIN((_conn)->recv_options.mss_found ? (_conn)->recv_options.mss	\
-					    : NET_TCP_DEFAULT_MSS,	\
-	    net_tcp_get_supported_mss(_conn))
+	(MIN((_conn)->recv_options.mss_found ? (_conn)->recv_options.mss	\
+					     : NET_TCP_DEFAULT_MSS,	\
+	     net_tcp_get_supported_mss(_conn)) -			\
+	 ((_conn)->ts_ok ? NET_TCP_TIMESTAMP_SIZE + 2 : 0))
 
 #define conn_state(_conn, _s)						\
 ({									\
@@ -148,7 +150,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -194,10 +196,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_UNUSED = 0,
 	TCP_CLOSED,
@@ -229,31 +227,147 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* Largest option list a peer can send, (15 - 5) 32-bit words */
+#define NET_TCP_MAX_RECV_OPT_SIZE 40
+
+/* Largest window scale shift, RFC 7323 ch 2.3 */
+#define NET_TCP_MAX_WINDOW_SCALE  14
+
+/* Max number of SACK blocks a segment can carry */
+#define NET_TCP_MAX_SACK_BLOCKS   4
+
+/* Number of SACKed ranges remembered by the sender */
+#define NET_TCP_SACK_SCOREBOARD_SIZE 4
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define NET_TCP_MAX_WIN ((uint32_t)UINT16_MAX << NET_TCP_MAX_WINDOW_SCALE)
+#else
+#define NET_TCP_MAX_WIN UINT16_MAX
+#endif
+
+/* Largest payload that fits in one IP packet with full headers */
+#define NET_TCP_GSO_MAX_LEN (UINT16_MAX - NET_IPV6H_LEN - NET_TCPH_LEN - NET_TCP_MAX_OPT_SIZE)
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
+	uint8_t sack_count;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool ts_found : 1;
 };
 
+struct tcp;
+typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+/* Max length of a congestion control algorithm name, including the NUL */
+#define NET_TCP_CA_NAME_MAX 16
+
+/* Congestion control algorithm, selected per connection */
+struct tcp_ca_ops {
+	/* Name used with the TCP_CONGESTION socket option */
+	const char *name;
+	/* Connection established, set up the initial window */
+	void (*init)(struct tcp *conn);
+	/* Third duplicate ACK received, fast recovery starts */
+	void (*fast_retransmit)(struct tcp *conn);
+	/* Retransmission timer expired */
+	void (*timeout)(struct tcp *conn);
+	/* Duplicate ACK received */
+	void (*dup_ack)(struct tcp *conn);
+	/* New data acknowledged. rtt_us is the round-trip time measured
+	 * with this ACK, or 0 if none was taken.
+	 */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len, uint32_t rtt_us);
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+struct tcp_ca_cubic {
+	uint32_t w_max;
+	uint32_t w_est;
+	uint32_t origin;
+	uint32_t epoch_start;
+	uint32_t k;
+	uint32_t min_rtt;
 };
 #endif
 
-struct tcp;
-typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
+#if defined(CONFIG_NET_TCP_CONGESTION_VEGAS)
+struct tcp_ca_vegas {
+	uint32_t base_rtt;
+	uint32_t min_rtt;
+	uint32_t round_left;
+};
+#endif
+
+struct tcp_collision_avoidance {
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC) || defined(CONFIG_NET_TCP_CONGESTION_VEGAS)
+	union {
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+		struct tcp_ca_cubic cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_VEGAS)
+		struct tcp_ca_vegas vegas;
+#endif
+	};
+#endif
+};
+
+/* Look up an algorithm by name, returns NULL if it is not available */
+const struct tcp_ca_ops *tcp_ca_find(const char *name);
+
+/* Algorithm used by new connections */
+const struct tcp_ca_ops *tcp_ca_default(void);
+
+/* New Reno building blocks for the other algorithms */
+void tcp_ca_reno_init(struct tcp *conn);
+void tcp_ca_reno_fast_retransmit(struct tcp *conn);
+void tcp_ca_reno_timeout(struct tcp *conn);
+void tcp_ca_reno_dup_ack(struct tcp *conn);
+bool tcp_ca_reno_recovery(struct tcp *conn, uint32_t acked_len);
+void tcp_ca_reno_slow_start(struct tcp *conn, uint32_t acked_len);
+void tcp_ca_reno_congestion_avoidance(struct tcp *conn, uint32_t acked_len);
+void tcp_ca_log(struct tcp *conn, const char *step);
+
+extern const struct tcp_ca_ops tcp_ca_new_reno_ops;
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+extern const struct tcp_ca_ops tcp_ca_cubic_ops;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_VEGAS)
+extern const struct tcp_ca_ops tcp_ca_vegas_ops;
+#endif
+#endif
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
@@ -315,22 +429,41 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_sent;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack_scoreboard[NET_TCP_SACK_SCOREBOARD_SIZE];
+	uint32_t sack_recovery_point;
+	uint32_t sack_high_rxt;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t ts_recent;
+	uint32_t ts_recent_age;
+	uint32_t last_ack_sent;
+#endif
+	uint32_t recv_win_sent;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	const struct tcp_ca_ops *ca_ops;
+	struct tcp_collision_avoidance ca;
+	uint32_t rtt_seq;
+	uint32_t rtt_start;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
 #endif
 	uint8_t zwp_retries;
+	uint8_t snd_wscale;
+	uint8_t rcv_wscale;
+	bool wscale_ok : 1;
+	bool sack_ok : 1;
+	bool sack_recovery : 1;
+	bool ts_ok : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -339,6 +472,9 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	bool rtt_pending : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Vegas style delay-based congestion avoidance. Once per round trip the
+ * number of segments queued in the network is estimated from the increase
+ * of the RTT over the lowest one seen, and the window is adjusted to keep
+ * that number between alpha and beta. Loss recovery is the New Reno one.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_context.h>
+
+#include "tcp_internal.h"
+
+/* Thresholds of queued segments */
+#define VEGAS_ALPHA 2
+#define VEGAS_BETA 4
+#define VEGAS_GAMMA 1
+
+static void vegas_new_round(struct tcp *conn)
+{
+	conn->ca.vegas.round_left = conn->ca.cwnd;
+	conn->ca.vegas.min_rtt = UINT32_MAX;
+}
+
+static void vegas_adjust(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_vegas *vegas = &conn->ca.vegas;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t queued;
+
+	if (vegas->min_rtt == UINT32_MAX) {
+		/* No RTT sample in this round, behave like Reno */
+		if (cwnd < conn->ca.ssthresh) {
+			tcp_ca_reno_slow_start(conn, acked_len);
+		} else {
+			tcp_ca_reno_congestion_avoidance(conn, acked_len);
+		}
+		return;
+	}
+
+	queued = (uint32_t)(((uint64_t)cwnd * (vegas->min_rtt - vegas->base_rtt)) /
+			    vegas->min_rtt / mss);
+
+	if (cwnd < conn->ca.ssthresh) {
+		if (queued <= VEGAS_GAMMA) {
+			tcp_ca_reno_slow_start(conn, acked_len);
+			return;
+		}
+
+		/* Queues are building up, leave slow start with the window
+		 * the path can carry without them.
+		 */
+		cwnd = MIN(cwnd, (uint32_t)(((uint64_t)cwnd * vegas->base_rtt) /
+					    vegas->min_rtt) + mss);
+		conn->ca.ssthresh = MAX(cwnd, mss * 2);
+	} else if (queued > VEGAS_BETA) {
+		cwnd -= mss;
+		conn->ca.ssthresh = MIN(conn->ca.ssthresh, MAX(cwnd, mss * 2));
+	} else if (queued < VEGAS_ALPHA) {
+		cwnd += mss;
+	}
+
+	conn->ca.cwnd = CLAMP(cwnd, mss * 2, NET_TCP_MAX_WIN);
+}
+
+static void vegas_init(struct tcp *conn)
+{
+	tcp_ca_reno_init(conn);
+	conn->ca.vegas.base_rtt = UINT32_MAX;
+	vegas_new_round(conn);
+	tcp_ca_log(conn, "init");
+}
+
+static void vegas_fast_retransmit(struct tcp *conn)
+{
+	tcp_ca_reno_fast_retransmit(conn);
+	vegas_new_round(conn);
+}
+
+static void vegas_timeout(struct tcp *conn)
+{
+	tcp_ca_reno_timeout(conn);
+	vegas_new_round(conn);
+}
+
+static void vegas_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt_us)
+{
+	struct tcp_ca_vegas *vegas = &conn->ca.vegas;
+
+	if (rtt_us != 0) {
+		vegas->base_rtt = MIN(vegas->base_rtt, rtt_us);
+		vegas->min_rtt = MIN(vegas->min_rtt, rtt_us);
+	}
+
+	if (tcp_ca_reno_recovery(conn, acked_len)) {
+		vegas_new_round(conn);
+	} else if (vegas->round_left > acked_len) {
+		vegas->round_left -= acked_len;
+		if (conn->ca.cwnd < conn->ca.ssthresh) {
+			tcp_ca_reno_slow_start(conn, acked_len);
+		}
+	} else {
+		/* One round trip is over */
+		vegas_adjust(conn, acked_len);
+		vegas_new_round(conn);
+	}
+
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+const struct tcp_ca_ops tcp_ca_vegas_ops = {
+	.name = "vegas",
+	.init = vegas_init,
+	.fast_retransmit = vegas_fast_retransmit,
+	.timeout = vegas_timeout,
+	.dup_ack = tcp_ca_reno_dup_ack,
+	.pkts_acked = vegas_pkts_acked,
+};
@@ -27,6 +27,8 @@ LOG_MODULE_REGISTER(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/socketcan.h>
 
+#include "chksum_arch.h"
+
 char *net_sprint_addr(sa_family_t af, const void *addr)
 {
 #define NBUFS 3
@@ -565,11 +567,15 @@ static uint16_t offset_based_swap8(const uint8_t *data)
  * it is possible to do parallel addition using larger word sizes such as 32-bit or 64-bit words.
  * In those cases the variable that stores the accumulative sum has to be bigger too.
  * Once the sum is computed a final step folds the sum to a 16-bit word (adding carry if any).
+ *
+ * The data is copied to dst on the way unless it is NULL, the check is resolved at compile
+ * time as the function is inlined in both users.
  */
-uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
+static ALWAYS_INLINE uint16_t chksum_copy(uint16_t sum_in, uint8_t *dst, const uint8_t *data,
+					  size_t len)
 {
 	uint64_t sum;
-	uint32_t *p;
+	const uint32_t *p;
 	size_t i = 0;
 	size_t pending = len;
 	int odd_start = ((uintptr_t)data & 0x01);
@@ -586,15 +592,29 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	/* Process up to 3 data elements up front, so the data is aligned further down the line */
 	if ((((uintptr_t)data & 0x01) != 0) && (pending >= 1)) {
 		sum += offset_based_swap8(data);
+		if (dst != NULL) {
+			*dst++ = *data;
+		}
 		data++;
 		pending--;
 	}
 	if ((((uintptr_t)data & 0x02) != 0) && (pending >= sizeof(uint16_t))) {
 		pending -= sizeof(uint16_t);
 		sum = sum + *((uint16_t *)data);
+		if (dst != NULL) {
+			memcpy(dst, data, sizeof(uint16_t));
+			dst += sizeof(uint16_t);
+		}
 		data += sizeof(uint16_t);
 	}
-	p = (uint32_t *)data;
+	p = (const uint32_t *)data;
+
+	/* Let the vector unit have the bulk of the data if there is one */
+	i = chksum_arch_add(&sum, dst, p, pending / sizeof(uint32_t));
+	pending -= i * sizeof(uint32_t);
+	if (dst != NULL) {
+		dst += i * sizeof(uint32_t);
+	}
 
 	/* Do loop unrolling for the very large data sets */
 	while (pending >= sizeof(uint32_t) * 4) {
@@ -604,21 +624,36 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		pending -= sizeof(uint32_t) * 4;
 		sum_a += p[i + 2];
 		sum_b += p[i + 3];
+		if (dst != NULL) {
+			memcpy(dst, &p[i], sizeof(uint32_t) * 4);
+			dst += sizeof(uint32_t) * 4;
+		}
 		i += 4;
 		sum += sum_a + sum_b;
 	}
 	while (pending >= sizeof(uint32_t)) {
 		pending -= sizeof(uint32_t);
+		if (dst != NULL) {
+			memcpy(dst, &p[i], sizeof(uint32_t));
+			dst += sizeof(uint32_t);
+		}
 		sum = sum + p[i++];
 	}
-	data = (uint8_t *)(p + i);
+	data = (const uint8_t *)(p + i);
 	if (pending >= 2) {
 		pending -= sizeof(uint16_t);
 		sum = sum + *((uint16_t *)data);
+		if (dst != NULL) {
+			memcpy(dst, data, sizeof(uint16_t));
+			dst += sizeof(uint16_t);
+		}
 		data += sizeof(uint16_t);
 	}
 	if (pending == 1) {
 		sum += offset_based_swap8(data);
+		if (dst != NULL) {
+			*dst = *data;
+		}
 	}
 
 	/* Fold sum into 16-bit word. */
@@ -636,6 +671,16 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 }
 
+uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
+{
+	return chksum_copy(sum_in, NULL, data, len);
+}
+
+uint16_t calc_chksum_copy(uint16_t sum_in, uint8_t *dst, const uint8_t *src, size_t len)
+{
+	return chksum_copy(sum_in, dst, src, len);
+}
+
 #if defined(CONFIG_NET_NATIVE_IP)
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
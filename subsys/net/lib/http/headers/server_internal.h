@@ -10,6 +10,8 @@
 
 #include <stdbool.h>
 
+#include <zephyr/fs/fs.h>
+#include <zephyr/net_buf.h>
 #include <zephyr/net/http/server.h>
 #include <zephyr/net/http/service.h>
 #include <zephyr/net/http/status.h>
@@ -48,6 +50,19 @@ bool compression_value_is_valid(enum http_compression compression);
 struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
 						 const char *path, int *len, bool is_ws);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
+
+/* Called for each buffer of a file before it is sent, to add a frame header
+ * in the headroom.
+ */
+typedef void (*http_server_sendfile_cb_t)(struct net_buf *buf, bool last, void *user_data);
+
+/* Send len bytes of the file without copying them to the stack, available
+ * with CONFIG_HTTP_SERVER_SENDFILE.
+ */
+int http_server_sendfile(struct http_client_ctx *client, struct fs_file_t *file, size_t len,
+			 size_t headroom, http_server_sendfile_cb_t frame_cb, void *user_data);
+bool http_server_claim_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				struct http_client_ctx *client);
 void http_server_get_content_type_from_extension(char *url, char *content_type,
 						 size_t content_type_size);
 int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
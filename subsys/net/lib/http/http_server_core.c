@@ -14,8 +14,10 @@
 
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/fs_interface.h>
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/net_buf.h>
 #include <zephyr/net/http/service.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket.h>
@@ -41,7 +43,14 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
+#define HTTP_SERVER_WORKERS      CONFIG_HTTP_SERVER_WORKER_THREADS
+
+#if HTTP_SERVER_WORKERS > 0
+/* The workers poll the accepted sockets */
+#define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES)
+#else
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
+#endif
 
 struct http_server_ctx {
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
@@ -57,12 +66,47 @@ struct http_server_ctx {
 static struct http_server_ctx server_ctx;
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
+static atomic_t server_stop_requested;
+
+/* Protects the client counts of the services, which the workers decrement
+ * when releasing a client. Only the server thread touches its pollfds.
+ */
+static K_MUTEX_DEFINE(server_lock);
+
+#if HTTP_SERVER_WORKERS > 0
+/* Client i is served by worker i % HTTP_SERVER_WORKERS */
+#define HTTP_SERVER_WORKER_CLIENTS DIV_ROUND_UP(HTTP_SERVER_MAX_CLIENTS, HTTP_SERVER_WORKERS)
+
+struct http_server_worker {
+	struct k_thread thread;
+
+	/* Indexes of the clients the server thread has handed over */
+	struct k_msgq new_clients;
+	int new_clients_buf[HTTP_SERVER_WORKER_CLIENTS];
+
+	/* First pollfd is an eventfd that wakes up the worker, then we have
+	 * the sockets of its clients.
+	 */
+	struct zsock_pollfd fds[1 + HTTP_SERVER_WORKER_CLIENTS];
+
+	atomic_t num_clients;
+	atomic_t stop;
+};
+
+static struct http_server_worker workers[HTTP_SERVER_WORKERS];
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, HTTP_SERVER_WORKERS,
+				   CONFIG_HTTP_SERVER_STACK_SIZE);
+static ATOMIC_DEFINE(worker_slots, HTTP_SERVER_MAX_CLIENTS);
+static K_SEM_DEFINE(workers_stopped, 0, HTTP_SERVER_WORKERS);
+static bool workers_started;
+#endif
 
 #if defined(CONFIG_HTTP_SERVER_TLS_USE_ALPN)
 static const char *const alpn_list[] = {"h2", "http/1.1"};
 #endif
 
 static void close_client_connection(struct http_client_ctx *client);
+static int workers_init(void);
 
 HTTP_SERVER_CONTENT_TYPE(html, "text/html")
 HTTP_SERVER_CONTENT_TYPE(css, "text/css")
@@ -73,7 +117,7 @@ HTTP_SERVER_CONTENT_TYPE(svg, "image/svg+xml")
 
 int http_server_init(struct http_server_ctx *ctx)
 {
-	int proto;
+	int proto, ret;
 	int failed = 0, count = 0;
 	int svc_count;
 	socklen_t len;
@@ -89,6 +133,13 @@ int http_server_init(struct http_server_ctx *ctx)
 
 	HTTP_SERVICE_COUNT(&svc_count);
 
+	ret = workers_init();
+	if (ret < 0) {
+		return ret;
+	}
+
+	atomic_clear(&server_stop_requested);
+
 	/* Initialize fds */
 	memset(ctx->fds, 0, sizeof(ctx->fds));
 	memset(ctx->clients, 0, sizeof(ctx->clients));
@@ -285,6 +336,18 @@ static int accept_new_client(int server_fd)
 
 static void close_all_sockets(struct http_server_ctx *ctx)
 {
+#if HTTP_SERVER_WORKERS > 0
+	/* The workers close their own clients */
+	ARRAY_FOR_EACH_PTR(workers, worker) {
+		atomic_set(&worker->stop, 1);
+		eventfd_write(worker->fds[0].fd, 1);
+	}
+
+	for (int i = 0; i < HTTP_SERVER_WORKERS; i++) {
+		k_sem_take(&workers_stopped, K_FOREVER);
+	}
+#endif
+
 	zsock_close(ctx->fds[0].fd); /* close eventfd */
 	ctx->fds[0].fd = -1;
 
@@ -349,9 +412,22 @@ static void client_release_resources(struct http_client_ctx *client)
 	}
 }
 
+/* Return the pollfd entry of the client socket */
+static struct zsock_pollfd *client_pollfd(struct http_client_ctx *client)
+{
+	int idx = ARRAY_INDEX(server_ctx.clients, client);
+
+#if HTTP_SERVER_WORKERS > 0
+	return &workers[idx % HTTP_SERVER_WORKERS].fds[1 + idx / HTTP_SERVER_WORKERS];
+#else
+	return &server_ctx.fds[server_ctx.listen_fds + idx];
+#endif
+}
+
 void http_server_release_client(struct http_client_ctx *client)
 {
-	int i;
+	int idx;
+	bool was_full;
 	struct k_work_sync sync;
 
 	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
@@ -359,23 +435,31 @@ void http_server_release_client(struct http_client_ctx *client)
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
 
-	client->service->data->num_clients--;
+	/* The server thread re-enables the listen socket of a full service
+	 * the next time it wakes up.
+	 */
+	k_mutex_lock(&server_lock, K_FOREVER);
+	was_full = client->service->data->num_clients-- >= client->service->concurrent;
+	k_mutex_unlock(&server_lock);
 
-	for (i = 0; i < server_ctx.listen_fds; i++) {
-		if (server_ctx.fds[i].fd == *client->service->fd) {
-			server_ctx.fds[i].events = ZSOCK_POLLIN;
-			break;
-		}
-	}
-	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
-		if (server_ctx.fds[i].fd == client->fd) {
-			server_ctx.fds[i].fd = INVALID_SOCK;
-			break;
-		}
-	}
+	client_pollfd(client)->fd = INVALID_SOCK;
 
+	idx = ARRAY_INDEX(server_ctx.clients, client);
 	memset(client, 0, sizeof(struct http_client_ctx));
 	client->fd = INVALID_SOCK;
+
+#if HTTP_SERVER_WORKERS > 0
+	atomic_dec(&workers[idx % HTTP_SERVER_WORKERS].num_clients);
+	atomic_clear_bit(worker_slots, idx);
+
+	/* The server thread may be polling without the listen socket */
+	if (was_full) {
+		eventfd_write(server_ctx.fds[0].fd, 1);
+	}
+#else
+	ARG_UNUSED(idx);
+	ARG_UNUSED(was_full);
+#endif
 }
 
 static void close_client_connection(struct http_client_ctx *client)
@@ -548,20 +632,319 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
+static void client_poll_event(struct zsock_pollfd *pfd, struct http_client_ctx *client)
+{
+	int idx = ARRAY_INDEX(server_ctx.clients, client);
+	int sock_error;
+	socklen_t optlen = sizeof(int);
+	int ret;
+
+	if (pfd->revents & ZSOCK_POLLHUP) {
+		LOG_DBG("Client #%d has disconnected", idx);
+		close_client_connection(client);
+		return;
+	}
+
+	if (pfd->revents & ZSOCK_POLLERR) {
+		(void)zsock_getsockopt(pfd->fd, SOL_SOCKET, SO_ERROR, &sock_error, &optlen);
+		LOG_DBG("Error on fd %d %d", pfd->fd, sock_error);
+		close_client_connection(client);
+		return;
+	}
+
+	if (!(pfd->revents & ZSOCK_POLLIN)) {
+		return;
+	}
+
+	ret = zsock_recv(client->fd, client->buffer + client->data_len,
+			 sizeof(client->buffer) - client->data_len, 0);
+	if (ret <= 0) {
+		if (ret == 0) {
+			LOG_DBG("Connection closed by peer for client #%d", idx);
+		} else {
+			ret = -errno;
+			LOG_DBG("ERROR reading from socket (%d)", ret);
+		}
+
+		close_client_connection(client);
+		return;
+	}
+
+	client->data_len += ret;
+
+	http_client_timer_restart(client);
+
+	ret = handle_http_request(client);
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
+		}
+		close_client_connection(client);
+	} else if (client->data_len == sizeof(client->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		close_client_connection(client);
+	}
+}
+
+#if HTTP_SERVER_WORKERS > 0
+/* Move the clients handed over by the server thread to the poll set */
+static void worker_add_new_clients(struct http_server_worker *worker)
+{
+	struct zsock_pollfd *pfd;
+	int idx;
+
+	while (k_msgq_get(&worker->new_clients, &idx, K_NO_WAIT) == 0) {
+		pfd = client_pollfd(&server_ctx.clients[idx]);
+		pfd->fd = server_ctx.clients[idx].fd;
+		pfd->events = ZSOCK_POLLIN;
+		pfd->revents = 0;
+	}
+}
+
+static void worker_close_clients(struct http_server_worker *worker)
+{
+	int w = ARRAY_INDEX(workers, worker);
+
+	worker_add_new_clients(worker);
+
+	for (int i = 1; i < ARRAY_SIZE(worker->fds); i++) {
+		if (worker->fds[i].fd < 0) {
+			continue;
+		}
+
+		close_client_connection(&server_ctx.clients[w + (i - 1) * HTTP_SERVER_WORKERS]);
+	}
+}
+
+static void http_server_worker_thread(void *p1, void *p2, void *p3)
+{
+	struct http_server_worker *worker = p1;
+	int w = ARRAY_INDEX(workers, worker);
+	eventfd_t value;
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		ret = zsock_poll(worker->fds, ARRAY_SIZE(worker->fds), -1);
+		if (ret < 0) {
+			LOG_ERR("Worker %d poll failed (%d)", w, -errno);
+			worker_close_clients(worker);
+			k_sleep(K_MSEC(CONFIG_HTTP_SERVER_RESTART_DELAY));
+			continue;
+		}
+
+		if (worker->fds[0].revents & ZSOCK_POLLIN) {
+			eventfd_read(worker->fds[0].fd, &value);
+
+			if (atomic_clear(&worker->stop)) {
+				worker_close_clients(worker);
+				k_sem_give(&workers_stopped);
+				continue;
+			}
+
+			worker_add_new_clients(worker);
+		}
+
+		for (int i = 1; i < ARRAY_SIZE(worker->fds); i++) {
+			if (worker->fds[i].fd < 0) {
+				continue;
+			}
+
+			client_poll_event(&worker->fds[i],
+					  &server_ctx.clients[w + (i - 1) * HTTP_SERVER_WORKERS]);
+		}
+	}
+}
+
+static int workers_init(void)
+{
+	struct http_server_worker *worker;
+	char name[16];
+	int fd;
+
+	if (workers_started) {
+		return 0;
+	}
+
+	for (int i = 0; i < HTTP_SERVER_WORKERS; i++) {
+		worker = &workers[i];
+
+		fd = eventfd(0, 0);
+		if (fd < 0) {
+			fd = -errno;
+			LOG_ERR("eventfd failed (%d)", fd);
+			return fd;
+		}
+
+		for (int j = 0; j < ARRAY_SIZE(worker->fds); j++) {
+			worker->fds[j].fd = INVALID_SOCK;
+		}
+
+		worker->fds[0].fd = fd;
+		worker->fds[0].events = ZSOCK_POLLIN;
+
+		k_msgq_init(&worker->new_clients, (char *)worker->new_clients_buf,
+			    sizeof(int), ARRAY_SIZE(worker->new_clients_buf));
+
+		k_thread_create(&worker->thread, worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				http_server_worker_thread, worker, NULL, NULL,
+				THREAD_PRIORITY, 0, K_FOREVER);
+
+#if defined(CONFIG_SCHED_CPU_MASK) && defined(CONFIG_SMP)
+		/* Spread the workers over the CPUs */
+		(void)k_thread_cpu_pin(&worker->thread, i % arch_num_cpus());
+#endif
+
+		snprintk(name, sizeof(name), "http_worker%d", i);
+		k_thread_name_set(&worker->thread, name);
+		k_thread_start(&worker->thread);
+	}
+
+	workers_started = true;
+
+	return 0;
+}
+
+/* Take a free client slot of the worker, its slots are those with an index
+ * equal to the worker index modulo the number of workers.
+ */
+static int worker_take_slot(int w)
+{
+	for (int idx = w; idx < HTTP_SERVER_MAX_CLIENTS; idx += HTTP_SERVER_WORKERS) {
+		if (!atomic_test_and_set_bit(worker_slots, idx)) {
+			return idx;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/* Hand the new client to the least loaded worker */
+static bool server_add_client(struct http_server_ctx *ctx,
+			      const struct http_service_desc *service, int new_socket)
+{
+	int w = 0;
+	int idx;
+
+	for (int i = 1; i < HTTP_SERVER_WORKERS; i++) {
+		if (atomic_get(&workers[i].num_clients) < atomic_get(&workers[w].num_clients)) {
+			w = i;
+		}
+	}
+
+	idx = worker_take_slot(w);
+
+	/* The slots of that worker may all be taken while the others still
+	 * have free ones.
+	 */
+	for (int i = 0; idx < 0 && i < HTTP_SERVER_WORKERS; i++) {
+		if (i == w) {
+			continue;
+		}
+
+		idx = worker_take_slot(i);
+		if (idx >= 0) {
+			w = i;
+		}
+	}
+
+	if (idx < 0) {
+		return false;
+	}
+
+	k_mutex_lock(&server_lock, K_FOREVER);
+	service->data->num_clients++;
+	k_mutex_unlock(&server_lock);
+
+	atomic_inc(&workers[w].num_clients);
+
+	LOG_DBG("Init client #%d on worker %d", idx, w);
+
+	init_client_ctx(&ctx->clients[idx], service, new_socket);
+
+	(void)k_msgq_put(&workers[w].new_clients, &idx, K_NO_WAIT);
+	eventfd_write(workers[w].fds[0].fd, 1);
+
+	return true;
+}
+#else
+static int workers_init(void)
+{
+	return 0;
+}
+
+static bool server_add_client(struct http_server_ctx *ctx,
+			      const struct http_service_desc *service, int new_socket)
+{
+	for (int j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
+		if (ctx->fds[j].fd != INVALID_SOCK) {
+			continue;
+		}
+
+		ctx->fds[j].fd = new_socket;
+		ctx->fds[j].events = ZSOCK_POLLIN;
+		ctx->fds[j].revents = 0;
+
+		k_mutex_lock(&server_lock, K_FOREVER);
+		service->data->num_clients++;
+		k_mutex_unlock(&server_lock);
+
+		LOG_DBG("Init client #%d", j - ctx->listen_fds);
+
+		init_client_ctx(&ctx->clients[j - ctx->listen_fds], service, new_socket);
+
+		return true;
+	}
+
+	return false;
+}
+#endif /* HTTP_SERVER_WORKERS > 0 */
+
+/* Poll again the listen sockets of the services that can take new clients */
+static void server_enable_listen_fds(struct http_server_ctx *ctx)
+{
+	const struct http_service_desc *service;
+
+	for (int i = 1; i < ctx->listen_fds; i++) {
+		if (ctx->fds[i].fd < 0 || ctx->fds[i].events != 0) {
+			continue;
+		}
+
+		service = lookup_service(ctx->fds[i].fd);
+		__ASSERT(NULL != service, "fd not associated with a service");
+
+		k_mutex_lock(&server_lock, K_FOREVER);
+		if (service->data->num_clients < service->concurrent) {
+			ctx->fds[i].events = ZSOCK_POLLIN;
+		}
+		k_mutex_unlock(&server_lock);
+	}
+}
+
 static int http_server_run(struct http_server_ctx *ctx)
 {
-	struct http_client_ctx *client;
 	const struct http_service_desc *service;
 	eventfd_t value;
-	bool found_slot;
+	bool full;
 	int new_socket;
-	int ret, i, j;
+	int ret, i;
 	int sock_error;
 	socklen_t optlen = sizeof(int);
 
 	value = 0;
 
 	while (1) {
+		server_enable_listen_fds(ctx);
+
 		ret = zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
 		if (ret < 0) {
 			ret = -errno;
@@ -574,11 +957,17 @@ static int http_server_run(struct http_server_ctx *ctx)
 			break;
 		}
 
-		if (ret == 1 && ctx->fds[0].revents) {
+		if (ctx->fds[0].revents & ZSOCK_POLLIN) {
 			eventfd_read(ctx->fds[0].fd, &value);
-			LOG_DBG("Received stop event. exiting ..");
-			ret = 0;
-			goto closing;
+
+			/* Otherwise a worker released a client and the listen
+			 * sockets are enabled again before the next poll.
+			 */
+			if (atomic_clear(&server_stop_requested)) {
+				LOG_DBG("Received stop event. exiting ..");
+				ret = 0;
+				goto closing;
+			}
 		}
 
 		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
@@ -586,15 +975,12 @@ static int http_server_run(struct http_server_ctx *ctx)
 				continue;
 			}
 
-			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
-				if (i >= ctx->listen_fds) {
-					LOG_DBG("Client #%d has disconnected",
-						i - ctx->listen_fds);
-
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-				}
+			if (i >= ctx->listen_fds) {
+				client_poll_event(&ctx->fds[i], &ctx->clients[i - ctx->listen_fds]);
+				continue;
+			}
 
+			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
 				continue;
 			}
 
@@ -603,106 +989,40 @@ static int http_server_run(struct http_server_ctx *ctx)
 						       SO_ERROR, &sock_error, &optlen);
 				LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
 
-				if (i >= ctx->listen_fds) {
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-					continue;
-				}
-
 				/* Listening socket error, abort. */
 				LOG_ERR("Listening socket error, aborting.");
 				ret = -sock_error;
 				goto closing;
-
 			}
 
 			if (!(ctx->fds[i].revents & ZSOCK_POLLIN)) {
 				continue;
 			}
 
-			/* First check if we have something to accept */
-			if (i < ctx->listen_fds) {
-				service = lookup_service(ctx->fds[i].fd);
-				__ASSERT(NULL != service, "fd not associated with a service");
-
-				if (service->data->num_clients >= service->concurrent) {
-					ctx->fds[i].events = 0;
-					continue;
-				}
-
-				new_socket = accept_new_client(ctx->fds[i].fd);
-				if (new_socket < 0) {
-					ret = -errno;
-					LOG_DBG("accept: %d", ret);
-					continue;
-				}
+			service = lookup_service(ctx->fds[i].fd);
+			__ASSERT(NULL != service, "fd not associated with a service");
 
-				found_slot = false;
-
-				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
-						continue;
-					}
-
-					ctx->fds[j].fd = new_socket;
-					ctx->fds[j].events = ZSOCK_POLLIN;
-					ctx->fds[j].revents = 0;
-
-					service->data->num_clients++;
-
-					LOG_DBG("Init client #%d", j - ctx->listen_fds);
-
-					init_client_ctx(&ctx->clients[j - ctx->listen_fds], service,
-							new_socket);
-					found_slot = true;
-					break;
-				}
-
-				if (!found_slot) {
-					LOG_DBG("No free slot found.");
-					zsock_close(new_socket);
-				}
+			k_mutex_lock(&server_lock, K_FOREVER);
+			full = service->data->num_clients >= service->concurrent;
+			if (full) {
+				ctx->fds[i].events = 0;
+			}
+			k_mutex_unlock(&server_lock);
 
+			if (full) {
 				continue;
 			}
 
-			/* Client sock */
-			client = &ctx->clients[i - ctx->listen_fds];
-
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
-
-				close_client_connection(client);
+			new_socket = accept_new_client(ctx->fds[i].fd);
+			if (new_socket < 0) {
+				ret = -errno;
+				LOG_DBG("accept: %d", ret);
 				continue;
 			}
 
-			client->data_len += ret;
-
-			http_client_timer_restart(client);
-
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
-				close_client_connection(client);
+			if (!server_add_client(ctx, service, new_socket)) {
+				LOG_DBG("No free slot found.");
+				zsock_close(new_socket);
 			}
 		}
 	}
@@ -764,30 +1084,247 @@ static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
 	return false;
 }
 
-struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
-						 const char *path, int *path_len, bool is_websocket)
+static bool resource_match(struct http_resource_desc *resource, const char *path, int *path_len)
+{
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) &&
+	    fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR)) == 0) {
+		*path_len = path_len_without_query(path);
+		return true;
+	}
+
+	if (compare_strings(path, resource->resource) == 0) {
+		NET_DBG("Got match for %s", resource->resource);
+
+		*path_len = strlen(resource->resource);
+		return true;
+	}
+
+	return false;
+}
+
+static struct http_resource_desc *scan_resources(const struct http_service_desc *service,
+						 const char *path, int *path_len,
+						 bool is_websocket)
 {
 	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
 		if (skip_this(resource, is_websocket)) {
 			continue;
 		}
 
-		if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
-			int ret;
+		if (resource_match(resource, path, path_len)) {
+			return resource;
+		}
+	}
 
-			ret = fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR));
-			if (ret == 0) {
-				*path_len = path_len_without_query(path);
-				return resource->detail;
+	return NULL;
+}
+
+#if CONFIG_HTTP_SERVER_RESOURCE_TRIE_NODES > 0
+/* Radix trie of the literal resource prefixes, i.e. the resource strings up
+ * to the first wildcard character. A path can only match the resources along
+ * its own walk down the trie, so only those are tried. The siblings never
+ * start with the same character, except for the nodes with an empty label,
+ * which hold the other resources having the same prefix as their parent.
+ */
+struct resource_trie_node {
+	const char *label;
+	struct http_resource_desc *res;
+	uint16_t label_len;
+	uint16_t child;
+	uint16_t sibling;
+};
+
+/* Node 0 is not used so that 0 means no node */
+static struct resource_trie_node trie_nodes[1 + CONFIG_HTTP_SERVER_RESOURCE_TRIE_NODES];
+static uint16_t trie_nodes_used = 1;
+
+static uint16_t trie_node_alloc(const char *label, size_t label_len,
+				struct http_resource_desc *res)
+{
+	struct resource_trie_node *node;
+
+	if (trie_nodes_used >= ARRAY_SIZE(trie_nodes) || label_len > UINT16_MAX) {
+		return 0;
+	}
+
+	node = &trie_nodes[trie_nodes_used];
+	node->label = label;
+	node->label_len = label_len;
+	node->res = res;
+	node->child = 0;
+	node->sibling = 0;
+
+	return trie_nodes_used++;
+}
+
+static bool trie_insert(uint16_t root, struct http_resource_desc *res)
+{
+	struct resource_trie_node *node = &trie_nodes[root];
+	const char *key = res->resource;
+	size_t key_len;
+	uint16_t *link;
+	uint16_t idx;
+	size_t common;
+
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+		key_len = strcspn(key, "*?[\\");
+	} else {
+		key_len = strlen(key);
+	}
+
+	while (key_len > 0) {
+		link = &node->child;
+		while (*link != 0 && (trie_nodes[*link].label_len == 0 ||
+				      trie_nodes[*link].label[0] != key[0])) {
+			link = &trie_nodes[*link].sibling;
+		}
+
+		if (*link == 0) {
+			idx = trie_node_alloc(key, key_len, res);
+			*link = idx;
+			return idx != 0;
+		}
+
+		node = &trie_nodes[*link];
+		for (common = 1; common < node->label_len && common < key_len; common++) {
+			if (node->label[common] != key[common]) {
+				break;
+			}
+		}
+
+		if (common < node->label_len) {
+			/* Split the edge after the common part */
+			idx = trie_node_alloc(node->label, common, NULL);
+			if (idx == 0) {
+				return false;
+			}
+
+			trie_nodes[idx].child = *link;
+			trie_nodes[idx].sibling = node->sibling;
+			node->sibling = 0;
+			node->label += common;
+			node->label_len -= common;
+			*link = idx;
+			node = &trie_nodes[idx];
+		}
+
+		key += common;
+		key_len -= common;
+	}
+
+	if (node->res == NULL) {
+		node->res = res;
+		return true;
+	}
+
+	/* Another resource with the same prefix */
+	idx = trie_node_alloc(key, 0, res);
+	if (idx == 0) {
+		return false;
+	}
+
+	trie_nodes[idx].sibling = node->child;
+	node->child = idx;
+
+	return true;
+}
+
+static void trie_try(struct http_resource_desc *res, const char *path, bool is_websocket,
+		     struct http_resource_desc **found, int *path_len)
+{
+	/* The resource defined first wins, like when scanning them */
+	if (res == NULL || (*found != NULL && res > *found) || skip_this(res, is_websocket)) {
+		return;
+	}
+
+	if (resource_match(res, path, path_len)) {
+		*found = res;
+	}
+}
+
+static struct http_resource_desc *trie_lookup(uint16_t root, const char *path, int *path_len,
+					      bool is_websocket)
+{
+	struct http_resource_desc *found = NULL;
+	const char *pos = path;
+	uint16_t idx = root;
+	uint16_t next;
+
+	while (idx != 0) {
+		trie_try(trie_nodes[idx].res, path, is_websocket, &found, path_len);
+
+		next = 0;
+		for (idx = trie_nodes[idx].child; idx != 0; idx = trie_nodes[idx].sibling) {
+			if (trie_nodes[idx].label_len == 0) {
+				trie_try(trie_nodes[idx].res, path, is_websocket, &found, path_len);
+			} else if (next == 0 && strncmp(trie_nodes[idx].label, pos,
+							trie_nodes[idx].label_len) == 0) {
+				next = idx;
 			}
 		}
 
-		if (compare_strings(path, resource->resource) == 0) {
-			NET_DBG("Got match for %s", resource->resource);
+		if (next != 0) {
+			pos += trie_nodes[next].label_len;
+		}
+
+		idx = next;
+	}
 
-			*path_len = strlen(resource->resource);
-			return resource->detail;
+	return found;
+}
+
+static int resource_trie_init(void)
+{
+	uint16_t first;
+	uint16_t root;
+
+	HTTP_SERVICE_FOREACH(svc) {
+		first = trie_nodes_used;
+
+		root = trie_node_alloc("", 0, NULL);
+		if (root == 0) {
+			goto full;
 		}
+
+		HTTP_SERVICE_FOREACH_RESOURCE(svc, resource) {
+			if (!trie_insert(root, resource)) {
+				goto full;
+			}
+		}
+
+		svc->data->res_trie = root;
+		continue;
+
+full:
+		/* Leave the nodes to the other services and scan the resources */
+		trie_nodes_used = first;
+		LOG_WRN("Resource trie full, scanning the resources of %s",
+			svc->host ? svc->host : "<any>");
+	}
+
+	return 0;
+}
+
+SYS_INIT(resource_trie_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif /* CONFIG_HTTP_SERVER_RESOURCE_TRIE_NODES > 0 */
+
+struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
+						 const char *path, int *path_len, bool is_websocket)
+{
+	struct http_resource_desc *resource;
+
+#if CONFIG_HTTP_SERVER_RESOURCE_TRIE_NODES > 0
+	if (service->data->res_trie != 0) {
+		resource = trie_lookup(service->data->res_trie, path, path_len, is_websocket);
+	} else {
+		resource = scan_resources(service, path, path_len, is_websocket);
+	}
+#else
+	resource = scan_resources(service, path, path_len, is_websocket);
+#endif
+
+	if (resource != NULL) {
+		return resource->detail;
 	}
 
 	if (service->res_fallback != NULL) {
@@ -901,6 +1438,116 @@ int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t
 	return 0;
 }
 
+#if defined(CONFIG_HTTP_SERVER_SENDFILE)
+NET_BUF_POOL_FIXED_DEFINE(http_sendfile_pool, CONFIG_HTTP_SERVER_SENDFILE_BUF_COUNT,
+			  CONFIG_HTTP_SERVER_SENDFILE_BUF_SIZE, 0, NULL);
+
+static int sendfile_send(struct http_client_ctx *client, struct net_buf *frags)
+{
+	ssize_t sent;
+	int ret;
+
+	/* The socket may take only a part of the chain, drop what it took */
+	while ((sent = zsock_send_buf(client->fd, frags, 0)) >= 0) {
+		http_client_timer_restart(client);
+
+		while (frags != NULL && sent >= frags->len) {
+			sent -= frags->len;
+			frags = net_buf_frag_del(NULL, frags);
+		}
+
+		if (frags == NULL) {
+			return 0;
+		}
+
+		net_buf_pull(frags, sent);
+	}
+
+	ret = -errno;
+	if (ret == -EOPNOTSUPP) {
+		/* TLS and offloaded sockets need a copy of the data */
+		for (struct net_buf *buf = frags; buf != NULL; buf = buf->frags) {
+			ret = http_server_sendall(client, buf->data, buf->len);
+			if (ret < 0) {
+				break;
+			}
+		}
+	}
+
+	net_buf_unref(frags);
+
+	return ret;
+}
+
+int http_server_sendfile(struct http_client_ctx *client, struct fs_file_t *file, size_t len,
+			 size_t headroom, http_server_sendfile_cb_t frame_cb, void *user_data)
+{
+	struct net_buf *frags;
+	struct net_buf *buf;
+	k_timeout_t timeout;
+	ssize_t read;
+	int ret;
+
+	while (len > 0) {
+		frags = NULL;
+		timeout = INACTIVITY_TIMEOUT;
+
+		/* Read into as many buffers as are free, the socket releases
+		 * them once the data is sent.
+		 */
+		while (len > 0) {
+			buf = net_buf_alloc(&http_sendfile_pool, timeout);
+			if (buf == NULL) {
+				break;
+			}
+
+			timeout = K_NO_WAIT;
+			net_buf_reserve(buf, headroom);
+
+			read = fs_read(file, buf->data, MIN(len, net_buf_tailroom(buf)));
+			if (read <= 0) {
+				ret = read < 0 ? (int)read : -EIO;
+				LOG_ERR("Filesystem read error (%d)", ret);
+				net_buf_unref(buf);
+				goto error;
+			}
+
+			net_buf_add(buf, read);
+			len -= read;
+
+			if (frame_cb != NULL) {
+				frame_cb(buf, len == 0, user_data);
+			}
+
+			if (frags == NULL) {
+				frags = buf;
+			} else {
+				net_buf_frag_add(frags, buf);
+			}
+		}
+
+		if (frags == NULL) {
+			LOG_DBG("No buffer to send the file");
+			return -ENOBUFS;
+		}
+
+		ret = sendfile_send(client, frags);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+
+error:
+	if (frags != NULL) {
+		net_buf_unref(frags);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_HTTP_SERVER_SENDFILE */
+
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status)
 {
 	if (status != HTTP_SERVER_DATA_FINAL) {
@@ -924,6 +1571,14 @@ bool http_response_is_provided(struct http_response_ctx *rsp)
 	return false;
 }
 
+bool http_server_claim_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				struct http_client_ctx *client)
+{
+	/* The clients may be served by several workers */
+	return atomic_ptr_cas((atomic_ptr_t *)&dynamic_detail->holder, NULL, client) ||
+	       dynamic_detail->holder == client;
+}
+
 void populate_request_ctx(struct http_request_ctx *req_ctx, uint8_t *data, size_t len,
 			  struct http_header_capture_ctx *header_ctx)
 {
@@ -965,6 +1620,7 @@ int http_server_stop(void)
 
 	server_running = false;
 	k_sem_reset(&server_start);
+	atomic_set(&server_stop_requested, 1);
 	eventfd_write(server_ctx.fds[0].fd, 1);
 
 	LOG_DBG("Stopping HTTP server");
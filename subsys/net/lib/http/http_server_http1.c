@@ -563,6 +563,15 @@ BUILD_ASSERT(CONFIG_HTTP_SERVER_STATIC_FS_RESPONSE_SIZE >= STATIC_FS_RESPONSE_SI
 
 	/* read and send file */
 	remaining = file_size;
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_SENDFILE)) {
+		ret = http_server_sendfile(client, &file, file_size, 0, NULL, NULL);
+		if (ret < 0) {
+			goto close;
+		}
+
+		remaining = 0;
+	}
+
 	while (remaining > 0) {
 		len = fs_read(&file, http_response, sizeof(http_response));
 		if (len < 0) {
@@ -603,7 +612,7 @@ static int handle_http1_dynamic_resource(
 		return send_http1_405(client);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_claim_resource(dynamic_detail, client)) {
 		ret = send_http1_409(client);
 		if (ret < 0) {
 			return ret;
@@ -612,8 +621,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
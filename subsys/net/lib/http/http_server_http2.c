@@ -451,6 +451,14 @@ out:
 }
 
 #if defined(CONFIG_FILE_SYSTEM)
+static void add_data_frame_header(struct net_buf *buf, bool last, void *user_data)
+{
+	size_t len = buf->len;
+
+	encode_frame_header(net_buf_push(buf, HTTP2_FRAME_HEADER_SIZE), len, HTTP2_DATA_FRAME,
+			    last ? HTTP2_FLAG_END_STREAM : 0, POINTER_TO_UINT(user_data));
+}
+
 static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs *static_fs_detail,
 					   struct http2_frame *frame,
 					   struct http_client_ctx *client)
@@ -530,6 +538,18 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 
 	/* read and send file */
 	remaining = client->data_len;
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_SENDFILE)) {
+		ret = http_server_sendfile(client, &file, remaining, HTTP2_FRAME_HEADER_SIZE,
+					   add_data_frame_header,
+					   UINT_TO_POINTER(frame->stream_identifier));
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+			goto out;
+		}
+
+		remaining = 0;
+	}
+
 	while (remaining > 0) {
 		len = fs_read(&file, tmp, sizeof(tmp));
 		if (len < 0) {
@@ -782,7 +802,7 @@ static int handle_http2_dynamic_resource(
 		return send_http2_405(client, frame);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_claim_resource(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -791,8 +811,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 	case HTTP_DELETE:
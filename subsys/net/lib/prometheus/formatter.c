@@ -263,6 +263,7 @@ int prometheus_format_exposition(struct prometheus_collector *collector, char *b
 			if (ret < 0) {
 				if (ret == -EAGAIN) {
 					/* Skip this metric for now */
+					ret = 0;
 					continue;
 				}
 
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/net/prometheus/sched_latency.h>
+
+#include <zephyr/net/prometheus/histogram.h>
+
+#include <stdio.h>
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+
+#define NUM_LEVELS  (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO + 1)
+#define NUM_BUCKETS CONFIG_SCHED_LATENCY_STATS_BUCKETS
+
+enum {
+	LATENCY_WAKEUP,
+	LATENCY_ISR,
+	LATENCY_KINDS,
+};
+
+struct latency_metric {
+	struct prometheus_histogram histogram;
+	char name[sizeof("k_sched_wakeup_latency_seconds_prio_neg128")];
+};
+
+static struct latency_metric metrics[NUM_LEVELS][LATENCY_KINDS];
+
+/* The histograms are formatted right after being scraped, with the collector
+ * locked, so they can share their buckets.
+ */
+static struct prometheus_histogram_bucket buckets[NUM_BUCKETS];
+
+static int sched_latency_scrape(struct prometheus_collector *collector,
+				struct prometheus_metric *metric, void *user_data)
+{
+	struct prometheus_histogram *histogram =
+		CONTAINER_OF(metric, struct prometheus_histogram, base);
+	int index = POINTER_TO_INT(histogram->user_data);
+	const struct k_sched_latency_histogram *latency;
+	struct k_sched_latency_stats stats;
+	double freq = sys_clock_hw_cycles_per_sec();
+	unsigned long count = 0;
+
+	ARG_UNUSED(collector);
+	ARG_UNUSED(user_data);
+
+	(void)k_sched_latency_stats_get(K_HIGHEST_THREAD_PRIO + index / LATENCY_KINDS, &stats);
+	latency = (index % LATENCY_KINDS == LATENCY_ISR) ? &stats.isr : &stats.wakeup;
+
+	if (latency->count == 0U) {
+		/* Skip the priority levels without samples */
+		return -EAGAIN;
+	}
+
+	for (int i = 0; i < NUM_BUCKETS; i++) {
+		uint64_t upper = BIT64(i) - 1U;
+
+		/* The last bucket also counts the longer latencies */
+		if (i == NUM_BUCKETS - 1) {
+			upper = MAX(upper, latency->max);
+		}
+
+		count += latency->buckets[i];
+		buckets[i].upper_bound = (double)upper / freq;
+		buckets[i].count = count;
+	}
+
+	histogram->buckets = buckets;
+	histogram->num_buckets = NUM_BUCKETS;
+	histogram->sum = (double)latency->sum / freq;
+	histogram->count = latency->count;
+
+	return 0;
+}
+
+PROMETHEUS_COLLECTOR_DEFINE(prometheus_sched_latency, sched_latency_scrape);
+
+static void metric_init(struct latency_metric *metric, int index, const char *kind,
+			const char *description)
+{
+	int prio = K_HIGHEST_THREAD_PRIO + index / LATENCY_KINDS;
+
+	snprintf(metric->name, sizeof(metric->name), "k_sched_%s_latency_seconds_prio_%s%d",
+		 kind, prio < 0 ? "neg" : "", prio < 0 ? -prio : prio);
+
+	metric->histogram.base.name = metric->name;
+	metric->histogram.base.type = PROMETHEUS_HISTOGRAM;
+	metric->histogram.base.description = description;
+	metric->histogram.base.collector = &prometheus_sched_latency;
+	metric->histogram.user_data = INT_TO_POINTER(index);
+
+	(void)prometheus_collector_register_metric(&prometheus_sched_latency,
+						   &metric->histogram.base);
+}
+
+static int prometheus_sched_latency_init(void)
+{
+	/* Metrics are prepended to the collector, register the lowest priority first */
+	for (int i = NUM_LEVELS - 1; i >= 0; i--) {
+		metric_init(&metrics[i][LATENCY_ISR], i * LATENCY_KINDS + LATENCY_ISR, "isr",
+			    "Time from an ISR making a thread ready until it runs");
+		metric_init(&metrics[i][LATENCY_WAKEUP], i * LATENCY_KINDS + LATENCY_WAKEUP,
+			    "wakeup", "Time from a thread making a thread ready until it runs");
+	}
+
+	return 0;
+}
+
+SYS_INIT(prometheus_sched_latency_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
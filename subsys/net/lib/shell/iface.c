@@ -44,6 +44,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_HW_RX_CHKSUM_OFFLOAD, "RX checksum offload"),
 	EC(ETHERNET_HW_VLAN,              "Virtual LAN"),
 	EC(ETHERNET_HW_VLAN_TAG_STRIP,    "VLAN Tag stripping"),
+	EC(ETHERNET_HW_TCP_SEG_OFFLOAD,   "TCP segmentation offload"),
 	EC(ETHERNET_LINK_10BASE,          "10 Mbits"),
 	EC(ETHERNET_LINK_100BASE,         "100 Mbits"),
 	EC(ETHERNET_LINK_1000BASE,        "1 Gbits"),
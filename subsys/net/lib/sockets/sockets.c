@@ -11,12 +11,19 @@
 LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
+#include <zephyr/net_buf.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/timeutil.h>
 
 #include "sockets_internal.h"
 
+/* Like on Linux, this many messages at most are handled by one
+ * zsock_sendmmsg() or zsock_recvmmsg() call.
+ */
+#define MMSG_VLEN_MAX 1024
+
 #define VTABLE_CALL(fn, sock, ...)			     \
 	({						     \
 		const struct socket_op_vtable *vtable;	     \
@@ -386,92 +393,201 @@ ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
-static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
-					   const struct msghdr *msg,
-					   int flags)
+static void sendmsg_free_copy(struct msghdr *msg_copy)
 {
-	struct msghdr msg_copy;
 	size_t i;
-	int ret;
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	if (msg_copy->msg_name) {
+		k_free(msg_copy->msg_name);
+	}
+
+	if (msg_copy->msg_control) {
+		k_free(msg_copy->msg_control);
+	}
+
+	if (msg_copy->msg_iov) {
+		for (i = 0; i < msg_copy->msg_iovlen; i++) {
+			if (msg_copy->msg_iov[i].iov_base) {
+				k_free(msg_copy->msg_iov[i].iov_base);
+			}
+		}
+
+		k_free(msg_copy->msg_iov);
+	}
+}
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+static int sendmsg_copy_from_user(struct msghdr *msg_copy,
+				  const struct msghdr *msg)
+{
+	size_t i;
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
+	K_OOPS(k_usermode_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
+
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
+
+	msg_copy->msg_iov = k_usermode_alloc_from_copy(msg_copy->msg_iov,
+				       msg_copy->msg_iovlen * sizeof(struct iovec));
+	if (!msg_copy->msg_iov) {
 		errno = ENOMEM;
 		goto fail;
 	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		msg_copy.msg_iov[i].iov_base =
+	/* Clear the pointers in the copy so that if the allocation in the
+	 * next loop fails, we do not try to free non allocated memory
+	 * in fail branch.
+	 */
+	memset(msg_copy->msg_iov, 0, msg_copy->msg_iovlen * sizeof(struct iovec));
+
+	for (i = 0; i < msg_copy->msg_iovlen; i++) {
+		msg_copy->msg_iov[i].iov_base =
 			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
 					       msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+		if (!msg_copy->msg_iov[i].iov_base) {
 			errno = ENOMEM;
 			goto fail;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg_copy->msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
 	if (msg->msg_namelen > 0) {
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (!msg_copy.msg_name) {
+		msg_copy->msg_name = k_usermode_alloc_from_copy(msg->msg_name,
+							    msg->msg_namelen);
+		if (!msg_copy->msg_name) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
 	if (msg->msg_controllen > 0) {
-		msg_copy.msg_control = k_usermode_alloc_from_copy(msg->msg_control,
-							  msg->msg_controllen);
-		if (!msg_copy.msg_control) {
+		msg_copy->msg_control = k_usermode_alloc_from_copy(msg->msg_control,
+							   msg->msg_controllen);
+		if (!msg_copy->msg_control) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
+	return 0;
+
+fail:
+	sendmsg_free_copy(msg_copy);
+
+	return -1;
+}
+
+static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
+					   const struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	int ret;
+
+	if (sendmsg_copy_from_user(&msg_copy, msg) < 0) {
+		return -1;
+	}
+
 	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
 				   flags);
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+	sendmsg_free_copy(&msg_copy);
+
+	return ret;
+}
+#include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t bytes_sent;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0; count < vlen; count++) {
+		bytes_sent = vtable->sendmsg(obj, &msgvec[count].msg_hdr, flags);
+
+		sock_obj_core_update_send_stats(sock, bytes_sent);
+
+		if (bytes_sent < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = bytes_sent;
+	}
+
+	k_mutex_unlock(lock);
 
-	for (i = 0; i < msg_copy.msg_iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+	/* An error is only reported if it happened with the first message */
+	if (count == 0 && vlen > 0) {
+		return -1;
 	}
 
-	k_free(msg_copy.msg_iov);
+	return count;
+}
 
-	return ret;
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *msgvec_copy;
+	unsigned int copied;
+	unsigned int i;
+	int ret = -1;
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+	if (vlen == 0) {
+		return 0;
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	msgvec_copy = k_usermode_alloc_from_copy(msgvec, vlen * sizeof(*msgvec));
+	if (msgvec_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
+	for (copied = 0; copied < vlen; copied++) {
+		if (sendmsg_copy_from_user(&msgvec_copy[copied].msg_hdr,
+					   &msgvec[copied].msg_hdr) < 0) {
+			goto out;
 		}
+	}
 
-		k_free(msg_copy.msg_iov);
+	ret = z_impl_zsock_sendmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &msgvec_copy[i].msg_len,
+					  sizeof(msgvec[i].msg_len)));
 	}
 
-	return -1;
+out:
+	for (i = 0; i < copied; i++) {
+		sendmsg_free_copy(&msgvec_copy[i].msg_hdr);
+	}
+
+	k_free(msgvec_copy);
+
+	return ret;
 }
-#include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 ssize_t z_impl_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
@@ -541,33 +657,48 @@ ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
-ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+static void recvmsg_free_copy(struct msghdr *msg_copy, size_t iovlen)
+{
+	size_t i;
+
+	k_free(msg_copy->msg_name);
+	k_free(msg_copy->msg_control);
+
+	if (msg_copy->msg_iov) {
+		/* Note that we need to free according to original iovlen */
+		for (i = 0; i < iovlen; i++) {
+			k_free(msg_copy->msg_iov[i].iov_base);
+		}
+
+		k_free(msg_copy->msg_iov);
+	}
+}
+
+static int recvmsg_copy_from_user(struct msghdr *msg_copy, size_t *iovlen,
+				  struct msghdr *msg)
 {
-	struct msghdr msg_copy;
-	size_t iovlen;
 	size_t i;
-	int ret;
 
 	if (msg == NULL) {
 		errno = EINVAL;
 		return -1;
 	}
 
-	if (msg->msg_iov == NULL) {
+	K_OOPS(k_usermode_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
+
+	if (msg_copy->msg_iov == NULL) {
 		errno = ENOMEM;
 		return -1;
 	}
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
-
-	k_usermode_from_copy(&iovlen, &msg->msg_iovlen, sizeof(iovlen));
+	*iovlen = msg_copy->msg_iovlen;
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
+	msg_copy->msg_iov = k_usermode_alloc_from_copy(msg_copy->msg_iov,
+				       *iovlen * sizeof(struct iovec));
+	if (!msg_copy->msg_iov) {
 		errno = ENOMEM;
 		goto fail;
 	}
@@ -576,24 +707,24 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 	 * next loop fails, we do not try to free non allocated memory
 	 * in fail branch.
 	 */
-	memset(msg_copy.msg_iov, 0, msg->msg_iovlen * sizeof(struct iovec));
+	memset(msg_copy->msg_iov, 0, *iovlen * sizeof(struct iovec));
 
-	for (i = 0; i < iovlen; i++) {
+	for (i = 0; i < *iovlen; i++) {
 		/* TODO: In practice we do not need to copy the actual data
 		 * in msghdr when receiving data but currently there is no
 		 * ready made function to do just that (unless we want to call
 		 * relevant malloc function here ourselves). So just use
 		 * the copying variant for now.
 		 */
-		msg_copy.msg_iov[i].iov_base =
+		msg_copy->msg_iov[i].iov_base =
 			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
 						   msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+		if (!msg_copy->msg_iov[i].iov_base) {
 			errno = ENOMEM;
 			goto fail;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg_copy->msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
 	if (msg->msg_namelen > 0) {
@@ -602,9 +733,9 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 			goto fail;
 		}
 
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (msg_copy.msg_name == NULL) {
+		msg_copy->msg_name = k_usermode_alloc_from_copy(msg->msg_name,
+							    msg->msg_namelen);
+		if (msg_copy->msg_name == NULL) {
 			errno = ENOMEM;
 			goto fail;
 		}
@@ -616,100 +747,261 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 			goto fail;
 		}
 
-		msg_copy.msg_control =
+		msg_copy->msg_control =
 			k_usermode_alloc_from_copy(msg->msg_control,
 						   msg->msg_controllen);
-		if (msg_copy.msg_control == NULL) {
+		if (msg_copy->msg_control == NULL) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
+	return 0;
+
+fail:
+	recvmsg_free_copy(msg_copy, *iovlen);
+
+	return -1;
+}
+
+static void recvmsg_copy_to_user(struct msghdr *msg, struct msghdr *msg_copy,
+				 size_t iovlen)
+{
+	size_t i;
+
+	if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_name,
+					  msg_copy->msg_name,
+					  msg_copy->msg_namelen));
+	}
+
+	if (msg->msg_controllen > 0 &&
+	    msg->msg_control != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_control,
+					  msg_copy->msg_control,
+					  msg_copy->msg_controllen));
+
+		msg->msg_controllen = msg_copy->msg_controllen;
+	} else {
+		msg->msg_controllen = 0U;
+	}
+
+	k_usermode_to_copy(&msg->msg_iovlen,
+			   &msg_copy->msg_iovlen,
+			   sizeof(msg->msg_iovlen));
+
+	/* The new iovlen cannot be bigger than the original one */
+	NET_ASSERT(msg_copy->msg_iovlen <= iovlen);
+
+	for (i = 0; i < iovlen; i++) {
+		if (i < msg_copy->msg_iovlen) {
+			K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_len));
+			K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
+						  &msg_copy->msg_iov[i].iov_len,
+						  sizeof(msg->msg_iov[i].iov_len)));
+		} else {
+			/* Clear out those vectors that we could not populate */
+			msg->msg_iov[i].iov_len = 0;
+		}
+	}
+
+	k_usermode_to_copy(&msg->msg_flags,
+			   &msg_copy->msg_flags,
+			   sizeof(msg->msg_flags));
+}
+
+ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	struct msghdr msg_copy;
+	size_t iovlen;
+	int ret;
+
+	if (recvmsg_copy_from_user(&msg_copy, &iovlen, msg) < 0) {
+		return -1;
+	}
+
 	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
 
 	/* Do not copy anything back if there was an error or nothing was
 	 * received.
 	 */
 	if (ret > 0) {
-		if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_name,
-						  msg_copy.msg_name,
-						  msg_copy.msg_namelen));
-		}
+		recvmsg_copy_to_user(msg, &msg_copy, iovlen);
+	}
 
-		if (msg->msg_controllen > 0 &&
-		    msg->msg_control != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_control,
-						  msg_copy.msg_control,
-						  msg_copy.msg_controllen));
+	recvmsg_free_copy(&msg_copy, iovlen);
 
-			msg->msg_controllen = msg_copy.msg_controllen;
-		} else {
-			msg->msg_controllen = 0U;
+	return ret;
+}
+#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags, const struct timespec *timeout)
+{
+	const struct socket_op_vtable *vtable;
+	bool wait_for_one = (flags & ZSOCK_MSG_WAITFORONE) != 0;
+	k_timepoint_t end = sys_timepoint_calc(K_FOREVER);
+	ssize_t bytes_received;
+	struct k_mutex *lock;
+	unsigned int count;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (timeout != NULL) {
+		if (!timespec_is_valid(timeout) || timeout->tv_sec < 0) {
+			errno = EINVAL;
+			return -1;
 		}
 
-		k_usermode_to_copy(&msg->msg_iovlen,
-				   &msg_copy.msg_iovlen,
-				   sizeof(msg->msg_iovlen));
+		end = sys_timepoint_calc(timespec_to_timeout(timeout));
+	}
+
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+	flags &= ~ZSOCK_MSG_WAITFORONE;
 
-		/* The new iovlen cannot be bigger than the original one */
-		NET_ASSERT(msg_copy.msg_iovlen <= iovlen);
+	(void)k_mutex_lock(lock, K_FOREVER);
 
-		for (i = 0; i < iovlen; i++) {
-			if (i < msg_copy.msg_iovlen) {
-				K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_len));
-				K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
-							  &msg_copy.msg_iov[i].iov_len,
-							  sizeof(msg->msg_iov[i].iov_len)));
-			} else {
-				/* Clear out those vectors that we could not populate */
-				msg->msg_iov[i].iov_len = 0;
-			}
+	for (count = 0; count < vlen; count++) {
+		bytes_received = vtable->recvmsg(obj, &msgvec[count].msg_hdr, flags);
+
+		sock_obj_core_update_recv_stats(sock, bytes_received);
+
+		if (bytes_received < 0) {
+			break;
 		}
 
-		k_usermode_to_copy(&msg->msg_flags,
-				   &msg_copy.msg_flags,
-				   sizeof(msg->msg_flags));
+		msgvec[count].msg_len = bytes_received;
+
+		/* Whatever is already queued is still picked up */
+		if (wait_for_one || sys_timepoint_expired(end)) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
 	}
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+	k_mutex_unlock(lock);
 
-	/* Note that we need to free according to original iovlen */
-	for (i = 0; i < iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+	/* An error is only reported if it happened with the first message */
+	if (count == 0 && vlen > 0) {
+		return -1;
 	}
 
-	k_free(msg_copy.msg_iov);
+	return count;
+}
 
-	return ret;
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags,
+					const struct timespec *timeout)
+{
+	struct timespec timeout_copy;
+	struct mmsghdr *msgvec_copy;
+	unsigned int copied;
+	size_t *iovlens;
+	unsigned int i;
+	int ret = -1;
+
+	if (timeout != NULL) {
+		K_OOPS(k_usermode_from_copy(&timeout_copy, (void *)timeout,
+					    sizeof(timeout_copy)));
+	}
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+	if (vlen == 0) {
+		return 0;
+	}
+
+	/* The original iovlen of each message, which tells how many buffers
+	 * were copied whatever the socket implementation does with msg_iovlen.
+	 */
+	iovlens = k_malloc(vlen * sizeof(*iovlens));
+	if (iovlens == NULL) {
+		errno = ENOMEM;
+		return -1;
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	msgvec_copy = k_usermode_alloc_from_copy(msgvec, vlen * sizeof(*msgvec));
+	if (msgvec_copy == NULL) {
+		k_free(iovlens);
+		errno = ENOMEM;
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
+	for (copied = 0; copied < vlen; copied++) {
+		if (recvmsg_copy_from_user(&msgvec_copy[copied].msg_hdr, &iovlens[copied],
+					   &msgvec[copied].msg_hdr) < 0) {
+			goto out;
 		}
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags,
+				    timeout != NULL ? &timeout_copy : NULL);
 
-		k_free(msg_copy.msg_iov);
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		recvmsg_copy_to_user(&msgvec[i].msg_hdr, &msgvec_copy[i].msg_hdr,
+				     iovlens[i]);
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &msgvec_copy[i].msg_len,
+					  sizeof(msgvec[i].msg_len)));
 	}
 
-	return -1;
+out:
+	for (i = 0; i < copied; i++) {
+		recvmsg_free_copy(&msgvec_copy[i].msg_hdr, iovlens[i]);
+	}
+
+	k_free(msgvec_copy);
+	k_free(iovlens);
+
+	return ret;
 }
-#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+ssize_t zsock_recv_buf(int sock, struct net_buf **frags, int flags)
+{
+	ssize_t bytes_received;
+
+	*frags = NULL;
+
+	bytes_received = VTABLE_CALL(recv_buf, sock, frags, flags);
+
+	sock_obj_core_update_recv_stats(sock, bytes_received);
+
+	return bytes_received;
+}
+
+ssize_t zsock_send_buf(int sock, struct net_buf *frags, int flags)
+{
+	ssize_t bytes_sent;
+
+	bytes_sent = VTABLE_CALL(send_buf, sock, frags, flags);
+
+	sock_obj_core_update_send_stats(sock, bytes_sent);
+
+	return bytes_sent;
+}
+
+void zsock_buf_release(struct net_buf *frags)
+{
+	if (frags != NULL) {
+		net_buf_unref(frags);
+	}
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
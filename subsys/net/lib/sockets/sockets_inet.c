@@ -1530,6 +1530,202 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 	return -1;
 }
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+/* Hand the unread data of a received packet over to the caller and free
+ * the packet itself.
+ */
+static struct net_buf *sock_pkt_detach_data(struct net_pkt *pkt, size_t *len)
+{
+	size_t offset = net_pkt_get_len(pkt) - net_pkt_remaining_data(pkt);
+	struct net_buf *frags = pkt->buffer;
+
+	*len = net_pkt_remaining_data(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+	    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	/* Drop the protocol headers and whatever was read already */
+	while (frags != NULL && offset >= frags->len) {
+		offset -= frags->len;
+		frags = net_buf_frag_del(NULL, frags);
+	}
+
+	if (frags != NULL) {
+		net_buf_pull(frags, offset);
+	}
+
+	return frags;
+}
+
+static ssize_t zsock_recv_buf_dgram(struct net_context *ctx,
+				    struct net_buf **frags,
+				    k_timeout_t timeout)
+{
+	struct net_pkt *pkt;
+	size_t len;
+	int ret;
+
+	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (pkt == NULL) {
+		return -EAGAIN;
+	}
+
+	*frags = sock_pkt_detach_data(pkt, &len);
+
+	return len;
+}
+
+static ssize_t zsock_recv_buf_stream(struct net_context *ctx,
+				     struct net_buf **frags,
+				     k_timeout_t timeout)
+{
+	struct net_pkt *pkt;
+	k_timepoint_t end;
+	size_t len;
+	int ret;
+
+	if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	for (end = sys_timepoint_calc(timeout); ; timeout = sys_timepoint_timeout(end)) {
+		if (sock_is_error(ctx)) {
+			return -POINTER_TO_INT(ctx->user_data);
+		}
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = zsock_wait_data(ctx, &timeout);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (pkt == NULL) {
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				return -EAGAIN;
+			}
+
+			continue;
+		}
+
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		*frags = sock_pkt_detach_data(pkt, &len);
+		if (len == 0) {
+			/* Empty end of stream marker */
+			continue;
+		}
+
+		net_context_update_recv_wnd(ctx, len);
+
+		return len;
+	}
+}
+
+static ssize_t zsock_recv_buf_ctx(struct net_context *ctx,
+				  struct net_buf **frags, int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	ssize_t ret;
+
+	/* The data cannot be handed over and left in the queue at once */
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (!sock_is_eof(ctx) && !sock_is_error(ctx)) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	if (sock_type == SOCK_DGRAM || sock_type == SOCK_RAW) {
+		ret = zsock_recv_buf_dgram(ctx, frags, timeout);
+	} else if (sock_type == SOCK_STREAM) {
+		ret = zsock_recv_buf_stream(ctx, frags, timeout);
+	} else {
+		ret = -ENOTSUP;
+	}
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return ret;
+}
+
+static ssize_t zsock_send_buf_ctx(struct net_context *ctx,
+				  struct net_buf *frags, int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	int status;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	/* Register the callback before sending in order to receive the response
+	 * from the peer.
+	 */
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	while (1) {
+		status = net_context_send_buf(ctx, frags, NULL, timeout,
+					      ctx->user_data);
+		if (status < 0) {
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				return status;
+			}
+
+			/* Update the timeout value in case loop is repeated. */
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		break;
+	}
+
+	return status;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 static int zsock_poll_prepare_ctx(struct net_context *ctx,
 				  struct zsock_pollfd *pfd,
 				  struct k_poll_event **pev,
@@ -1630,6 +1826,8 @@ static enum tcp_conn_option get_tcp_option(int optname)
 		return TCP_OPT_KEEPINTVL;
 	case TCP_KEEPCNT:
 		return TCP_OPT_KEEPCNT;
+	case TCP_CONGESTION:
+		return TCP_OPT_CONGESTION;
 	}
 
 	return -EINVAL;
@@ -1914,6 +2112,21 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx,
+							 get_tcp_option(optname),
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2545,6 +2758,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx,
+							 get_tcp_option(optname),
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
@@ -3059,6 +3287,18 @@ static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				  src_addr, addrlen);
 }
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+static ssize_t sock_recv_buf_vmeth(void *obj, struct net_buf **frags, int flags)
+{
+	return zsock_recv_buf_ctx(obj, frags, flags);
+}
+
+static ssize_t sock_send_buf_vmeth(void *obj, struct net_buf *frags, int flags)
+{
+	return zsock_send_buf_ctx(obj, frags, flags);
+}
+#endif
+
 static int sock_getsockopt_vmeth(void *obj, int level, int optname,
 				 void *optval, socklen_t *optlen)
 {
@@ -3107,6 +3347,10 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.setsockopt = sock_setsockopt_vmeth,
 	.getpeername = sock_getpeername_vmeth,
 	.getsockname = sock_getsockname_vmeth,
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	.recv_buf = sock_recv_buf_vmeth,
+	.send_buf = sock_send_buf_vmeth,
+#endif
 };
 
 static bool inet_is_supported(int family, int type, int proto)
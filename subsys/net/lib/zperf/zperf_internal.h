@@ -129,7 +129,8 @@ extern void start_jobs(void);
 extern struct zperf_work *get_queue(enum session_proto proto, int session_id);
 
 int zperf_prepare_upload_sock(const struct sockaddr *peer_addr, uint8_t tos,
-			      int priority, int tcp_nodelay, int proto);
+			      int priority, int tcp_nodelay,
+			      const char *tcp_congestion, int proto);
 
 uint32_t zperf_packet_duration(uint32_t packet_size, uint32_t rate_in_kbps);
 
@@ -930,6 +930,30 @@ static int parse_arg(size_t *i, size_t argc, char *argv[])
 	return res;
 }
 
+static int parse_congestion_arg(const struct shell *sh, size_t *i, size_t argc,
+				char *argv[], bool is_udp,
+				struct zperf_upload_params *param)
+{
+	if (is_udp) {
+		shell_fprintf(sh, SHELL_WARNING,
+			      "UDP does not support -C option\n");
+		return -1;
+	}
+
+	*i += 1;
+	if (*i >= argc) {
+		shell_fprintf(sh, SHELL_WARNING, "-C <algorithm>\n");
+		return -1;
+	}
+
+	(void)memset(param->options.tcp_congestion, 0x0,
+		     sizeof(param->options.tcp_congestion));
+	strncpy(param->options.tcp_congestion, argv[*i],
+		sizeof(param->options.tcp_congestion) - 1);
+
+	return 0;
+}
+
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 static bool check_priority(const struct shell *sh, int priority)
 {
@@ -1003,6 +1027,14 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'C':
+			if (parse_congestion_arg(sh, &i, argc, argv, is_udp,
+						 &param) < 0) {
+				return -ENOEXEC;
+			}
+			opt_cnt += 2;
+			break;
+
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		case 't':
 			param.options.thread_priority = parse_arg(&i, argc, argv);
@@ -1256,6 +1288,14 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'C':
+			if (parse_congestion_arg(sh, &i, argc, argv, is_udp,
+						 &param) < 0) {
+				return -ENOEXEC;
+			}
+			opt_cnt += 2;
+			break;
+
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		case 't':
 			param.options.thread_priority = parse_arg(&i, argc, argv);
@@ -1907,6 +1947,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-C algorithm: TCP congestion control algorithm (reno, cubic, vegas)\n"
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
@@ -1931,6 +1972,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-C algorithm: TCP congestion control algorithm (reno, cubic, vegas)\n"
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
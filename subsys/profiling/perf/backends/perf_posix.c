@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+/* Provided by the host linker for the final executable */
+extern char __executable_start[];
+extern char etext[];
+
+static inline bool in_text_region(uintptr_t addr)
+{
+	return (addr >= (uintptr_t)__executable_start) && (addr < (uintptr_t)etext);
+}
+
+/*
+ * On the POSIX architecture, interrupts are handled on the host stack of the
+ * thread they interrupt, so the frame pointers are followed from here. The
+ * trace starts with the sampling timer and the interrupt handling path,
+ * followed by the interrupted code.
+ *
+ * Every frame of a caller is higher up the host stack than the frame of its
+ * callee, and the walk stops at the first one that is not, as well as at the
+ * first return address out of the executable, which is where the host thread
+ * started. Either way, frames the host C library may have built without a
+ * frame pointer are not followed.
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	void **fp = __builtin_frame_address(0);
+	size_t idx = 0;
+
+	while (fp != NULL && in_text_region((uintptr_t)fp[1])) {
+		if (idx >= size) {
+			return 0;
+		}
+
+		buf[idx++] = (uintptr_t)fp[1];
+
+		if ((void **)fp[0] <= fp) {
+			break;
+		}
+
+		fp = (void **)fp[0];
+	}
+
+	return idx;
+}
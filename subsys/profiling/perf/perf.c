@@ -8,12 +8,13 @@
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/arch/cpu.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/shell/shell.h>
 #include <zephyr/shell/shell_uart.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
+#include "perf_internal.h"
 
 struct perf_data_t {
 	struct k_timer timer;
@@ -22,9 +23,18 @@ struct perf_data_t {
 
 	struct k_work_delayable dwork;
 
+	/* Set by the shell commands, cleared by the work item */
+	atomic_t running;
+
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	uint64_t period_ns;
+	uint64_t duration_ns;
+	int64_t start;
+#else
 	size_t idx;
 	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
 	bool buf_full;
+#endif
 };
 
 static void perf_tracer(struct k_timer *timer);
@@ -34,6 +44,14 @@ static struct perf_data_t perf_data = {
 	.dwork = Z_WORK_DELAYABLE_INITIALIZER(perf_dwork_handler),
 };
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+static void perf_tracer(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	perf_aggregate_sample();
+}
+#else
 static void perf_tracer(struct k_timer *timer)
 {
 	struct perf_data_t *perf_data_ptr =
@@ -56,6 +74,7 @@ static void perf_tracer(struct k_timer *timer)
 		k_work_reschedule(&perf_data_ptr->dwork, K_NO_WAIT);
 	}
 }
+#endif /* CONFIG_PROFILING_PERF_AGGREGATE */
 
 static void perf_dwork_handler(struct k_work *work)
 {
@@ -63,71 +82,183 @@ static void perf_dwork_handler(struct k_work *work)
 	struct perf_data_t *perf_data_ptr = CONTAINER_OF(dwork, struct perf_data_t, dwork);
 
 	k_timer_stop(&perf_data_ptr->timer);
+	atomic_clear(&perf_data_ptr->running);
+
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	perf_data_ptr->duration_ns += k_ticks_to_ns_floor64(k_uptime_ticks() -
+							    perf_data_ptr->start);
+#else
 	if (perf_data_ptr->buf_full) {
 		shell_error(perf_data_ptr->sh, "Perf buf overflow!");
-	} else {
-		shell_print(perf_data_ptr->sh, "Perf done!");
+		return;
 	}
+#endif
+
+	shell_print(perf_data_ptr->sh, "Perf done!");
 }
 
 static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
-		shell_warn(sh, "Perf is running");
-		return -EINPROGRESS;
-	}
-
+#ifndef CONFIG_PROFILING_PERF_AGGREGATE
 	if (perf_data.buf_full) {
 		shell_warn(sh, "Perf buffer is full");
 		return -ENOBUFS;
 	}
+#endif
+
+	long long duration_ms = strtoll(argv[1], NULL, 10);
+	long long frequency = strtoll(argv[2], NULL, 10);
+
+	if (duration_ms < 0 || frequency <= 0 || frequency > NSEC_PER_SEC) {
+		shell_error(sh, "Invalid duration or frequency");
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&perf_data.running, 0, 1)) {
+		shell_warn(sh, "Perf is running");
+		return -EINPROGRESS;
+	}
 
-	k_timeout_t duration = K_MSEC(strtoll(argv[1], NULL, 10));
-	k_timeout_t period = K_NSEC(1000000000 / strtoll(argv[2], NULL, 10));
+	k_timeout_t period = K_NSEC(NSEC_PER_SEC / frequency);
 
 	perf_data.sh = sh;
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	perf_data.period_ns = NSEC_PER_SEC / frequency;
+	perf_data.start = k_uptime_ticks();
+#endif
+
 	k_timer_user_data_set(&perf_data.timer, &perf_data);
 	k_timer_start(&perf_data.timer, K_NO_WAIT, period);
 
-	k_work_schedule(&perf_data.dwork, duration);
+	/* A duration of 0 records until "perf stop" */
+	if (duration_ms != 0) {
+		k_work_schedule(&perf_data.dwork, K_MSEC(duration_ms));
+	}
 
 	shell_print(sh, "Enabled perf");
 
 	return 0;
 }
 
+static int cmd_perf_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	if (!atomic_get(&perf_data.running)) {
+		shell_warn(sh, "Perf is not running");
+		return -EALREADY;
+	}
+
+	perf_data.sh = sh;
+	k_work_reschedule(&perf_data.dwork, K_NO_WAIT);
+
+	return 0;
+}
+
 static int cmd_perf_clear(const struct shell *sh, size_t argc, char **argv)
 {
 	if (sh != NULL) {
-		if (k_work_delayable_is_pending(&perf_data.dwork)) {
+		if (atomic_get(&perf_data.running)) {
 			shell_warn(sh, "Perf is running");
 			return -EINPROGRESS;
 		}
 		shell_print(sh, "Perf buffer cleared");
 	}
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	perf_aggregate_clear();
+	perf_data.duration_ns = 0;
+#else
 	perf_data.idx = 0;
 	perf_data.buf_full = false;
+#endif
 
 	return 0;
 }
 
 static int cmd_perf_info(const struct shell *sh, size_t argc, char **argv)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+	if (atomic_get(&perf_data.running)) {
 		shell_print(sh, "Perf is running");
 	}
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		uint32_t used;
+		uint32_t lost;
+
+		perf_aggregate_stats(cpu, &used, &lost);
+		shell_print(sh, "CPU %u callchains: %u/%d, lost samples: %u", cpu, used,
+			    CONFIG_PROFILING_PERF_AGGREGATE_ENTRIES, lost);
+	}
+#else
 	shell_print(sh, "Perf buf: %zu/%d %s", perf_data.idx, CONFIG_PROFILING_PERF_BUFFER_SIZE,
 		    perf_data.buf_full ? "(full)" : "");
+#endif
 
 	return 0;
 }
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+static int cmd_perf_folded(const struct shell *sh, size_t argc, char **argv)
+{
+	if (atomic_get(&perf_data.running)) {
+		shell_warn(sh, "Perf is running");
+		return -EINPROGRESS;
+	}
+
+	perf_aggregate_print_folded(sh);
+
+	return 0;
+}
+
+#ifdef CONFIG_PROFILING_PERF_PPROF_FILE
+static int cmd_perf_pprof_file(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+
+	if (atomic_get(&perf_data.running)) {
+		shell_warn(sh, "Perf is running");
+		return -EINPROGRESS;
+	}
+
+	err = perf_pprof_to_file(argv[1], perf_data.period_ns, perf_data.duration_ns);
+	if (err != 0) {
+		shell_error(sh, "Failed to write %s (%d)", argv[1], err);
+		return err;
+	}
+
+	shell_print(sh, "Profile written to %s", argv[1]);
+
+	return 0;
+}
+#endif /* CONFIG_PROFILING_PERF_PPROF_FILE */
+
+#ifdef CONFIG_PROFILING_PERF_PPROF_TCP
+static int cmd_perf_pprof_tcp(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+
+	if (atomic_get(&perf_data.running)) {
+		shell_warn(sh, "Perf is running");
+		return -EINPROGRESS;
+	}
+
+	err = perf_pprof_to_tcp(argv[1], perf_data.period_ns, perf_data.duration_ns);
+	if (err != 0) {
+		shell_error(sh, "Failed to send to %s (%d)", argv[1], err);
+		return err;
+	}
+
+	shell_print(sh, "Profile sent to %s", argv[1]);
+
+	return 0;
+}
+#endif /* CONFIG_PROFILING_PERF_PPROF_TCP */
+
+#else
 static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+	if (atomic_get(&perf_data.running)) {
 		shell_warn(sh, "Perf is running");
 		return -EINPROGRESS;
 	}
@@ -141,14 +272,36 @@ static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 
 	return 0;
 }
+#endif /* CONFIG_PROFILING_PERF_AGGREGATE */
 
 #define CMD_HELP_RECORD                                                                            \
-	"Start recording for <duration> ms on <frequency> Hz\n"                                    \
+	"Start recording for <duration> ms on <frequency> Hz, until stopped if <duration> is 0\n"  \
 	"Usage: record <duration> <frequency>"
 
+#if defined(CONFIG_PROFILING_PERF_PPROF_FILE) || defined(CONFIG_PROFILING_PERF_PPROF_TCP)
+SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf_pprof,
+	IF_ENABLED(CONFIG_PROFILING_PERF_PPROF_FILE,
+		   (SHELL_CMD_ARG(file, NULL, "Write a pprof profile to <path>",
+				  cmd_perf_pprof_file, 2, 0),))
+	IF_ENABLED(CONFIG_PROFILING_PERF_PPROF_TCP,
+		   (SHELL_CMD_ARG(tcp, NULL, "Send a pprof profile to <address>:<port>",
+				  cmd_perf_pprof_tcp, 2, 0),))
+	SHELL_SUBCMD_SET_END
+);
+#endif
+
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf,
 	SHELL_CMD_ARG(record, NULL, CMD_HELP_RECORD, cmd_perf_record, 3, 0),
+	SHELL_CMD_ARG(stop, NULL, "Stop recording", cmd_perf_stop, 0, 0),
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	SHELL_CMD_ARG(folded, NULL, "Print the callchains as folded stacks", cmd_perf_folded,
+		      0, 0),
+#if defined(CONFIG_PROFILING_PERF_PPROF_FILE) || defined(CONFIG_PROFILING_PERF_PPROF_TCP)
+	SHELL_CMD(pprof, &m_sub_perf_pprof, "Export the callchains as a pprof profile", NULL),
+#endif
+#else
 	SHELL_CMD_ARG(printbuf, NULL, "Print the perf buffer", cmd_perf_print, 0, 0),
+#endif
 	SHELL_CMD_ARG(clear, NULL, "Clear the perf buffer", cmd_perf_clear, 0, 0),
 	SHELL_CMD_ARG(info, NULL, "Print the perf info", cmd_perf_info, 0, 0),
 	SHELL_SUBCMD_SET_END
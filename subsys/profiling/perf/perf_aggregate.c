@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/debug/symtab.h>
+#include <zephyr/shell/shell.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "perf_internal.h"
+
+#define ENTRIES CONFIG_PROFILING_PERF_AGGREGATE_ENTRIES
+#define DEPTH   CONFIG_PROFILING_PERF_AGGREGATE_DEPTH
+
+/* Bound of the linear probing, to keep the sampling time short on a full table */
+#define PROBE_MAX 32
+
+struct perf_table {
+	struct k_spinlock lock;
+	uint32_t used;
+	uint32_t lost;
+	struct perf_callchain entries[ENTRIES];
+};
+
+static struct perf_table perf_tables[CONFIG_MP_MAX_NUM_CPUS];
+
+static uint32_t callchain_hash(const uintptr_t *frames, size_t depth)
+{
+	/* FNV-1a over the frame addresses */
+	uint32_t hash = 2166136261U;
+
+	for (size_t i = 0; i < depth; i++) {
+		uintptr_t addr = frames[i];
+
+		for (size_t j = 0; j < sizeof(addr); j++) {
+			hash = (hash ^ (uint8_t)addr) * 16777619U;
+			addr >>= 8;
+		}
+	}
+
+	return hash;
+}
+
+/*
+ * Resolve every frame to the start of its function, so that the samples of a
+ * function are counted together wherever it was interrupted or called from.
+ * Return addresses are looked up one byte back, since a call ending a
+ * function returns to the next one.
+ */
+static void callchain_resolve(uintptr_t *frames, size_t depth)
+{
+#ifdef CONFIG_SYMTAB
+	for (size_t i = 0; i < depth; i++) {
+		uintptr_t addr = frames[i] - (i > 0 ? 1 : 0);
+		uint32_t offset;
+
+		if (strcmp(symtab_find_symbol_name(addr, &offset), "?") != 0) {
+			frames[i] = addr - offset;
+		}
+	}
+#else
+	ARG_UNUSED(frames);
+	ARG_UNUSED(depth);
+#endif
+}
+
+void perf_aggregate_sample(void)
+{
+	struct perf_table *table = &perf_tables[_current_cpu->id];
+	uintptr_t frames[DEPTH];
+	struct perf_callchain *entry;
+	k_spinlock_key_t key;
+	uint32_t hash;
+	size_t depth;
+
+	depth = arch_perf_current_stack_trace(frames, DEPTH);
+	if (depth == 0) {
+		key = k_spin_lock(&table->lock);
+		table->lost++;
+		k_spin_unlock(&table->lock, key);
+		return;
+	}
+
+	callchain_resolve(frames, depth);
+	hash = callchain_hash(frames, depth);
+
+	key = k_spin_lock(&table->lock);
+
+	for (size_t i = 0; i < MIN(PROBE_MAX, ENTRIES); i++) {
+		entry = &table->entries[(hash + i) % ENTRIES];
+
+		if (entry->depth == 0) {
+			entry->hash = hash;
+			entry->count = 1;
+			entry->depth = depth;
+			memcpy(entry->frames, frames, depth * sizeof(frames[0]));
+			table->used++;
+			k_spin_unlock(&table->lock, key);
+			return;
+		}
+
+		if (entry->hash == hash && entry->depth == depth &&
+		    memcmp(entry->frames, frames, depth * sizeof(frames[0])) == 0) {
+			entry->count++;
+			k_spin_unlock(&table->lock, key);
+			return;
+		}
+	}
+
+	table->lost++;
+	k_spin_unlock(&table->lock, key);
+}
+
+void perf_aggregate_clear(void)
+{
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct perf_table *table = &perf_tables[cpu];
+		k_spinlock_key_t key = k_spin_lock(&table->lock);
+
+		memset(table->entries, 0, sizeof(table->entries));
+		table->used = 0;
+		table->lost = 0;
+		k_spin_unlock(&table->lock, key);
+	}
+}
+
+bool perf_aggregate_get(unsigned int cpu, size_t index, struct perf_callchain *callchain)
+{
+	struct perf_table *table = &perf_tables[cpu];
+	k_spinlock_key_t key;
+
+	if (index >= ENTRIES) {
+		return false;
+	}
+
+	key = k_spin_lock(&table->lock);
+	*callchain = table->entries[index];
+	k_spin_unlock(&table->lock, key);
+
+	return true;
+}
+
+void perf_aggregate_stats(unsigned int cpu, uint32_t *used, uint32_t *lost)
+{
+	struct perf_table *table = &perf_tables[cpu];
+	k_spinlock_key_t key = k_spin_lock(&table->lock);
+
+	*used = table->used;
+	*lost = table->lost;
+	k_spin_unlock(&table->lock, key);
+}
+
+const char *perf_frame_name(uintptr_t addr, char *buf, size_t size)
+{
+#ifdef CONFIG_SYMTAB
+	const char *name = symtab_find_symbol_name(addr, NULL);
+
+	if (strcmp(name, "?") != 0) {
+		return name;
+	}
+#endif
+	snprintf(buf, size, "0x%lx", (unsigned long)addr);
+
+	return buf;
+}
+
+void perf_aggregate_print_folded(const struct shell *sh)
+{
+	struct perf_callchain callchain;
+	char buf[2 + 2 * sizeof(uintptr_t) + 1];
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		for (size_t i = 0; perf_aggregate_get(cpu, i, &callchain); i++) {
+			if (callchain.depth == 0) {
+				continue;
+			}
+
+			/*
+			 * Outermost frame first, merging consecutive frames of a
+			 * function, which have the same address once resolved
+			 */
+			for (size_t j = callchain.depth; j-- > 0;) {
+				if (j + 1 < callchain.depth &&
+				    callchain.frames[j] == callchain.frames[j + 1]) {
+					continue;
+				}
+
+				shell_fprintf(sh, SHELL_NORMAL, "%s%s",
+					      j + 1 < callchain.depth ? ";" : "",
+					      perf_frame_name(callchain.frames[j], buf, sizeof(buf)));
+			}
+
+			shell_fprintf(sh, SHELL_NORMAL, " %u\n", callchain.count);
+		}
+	}
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_PROFILING_PERF_PERF_INTERNAL_H_
+#define ZEPHYR_SUBSYS_PROFILING_PERF_PERF_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/shell/shell.h>
+
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
+
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+
+/** Distinct callchain and the number of samples it got. */
+struct perf_callchain {
+	uint32_t hash;
+	uint32_t count;
+	/** Number of frames, 0 for an unused entry */
+	uint16_t depth;
+	/** Frames, innermost first */
+	uintptr_t frames[CONFIG_PROFILING_PERF_AGGREGATE_DEPTH];
+};
+
+/** Count the stack trace of the current thread, called by the sampling timer. */
+void perf_aggregate_sample(void);
+
+/** Forget all the callchains. */
+void perf_aggregate_clear(void);
+
+/**
+ * Copy an entry of the callchain table of a CPU.
+ *
+ * @return false once @p index is past the end of the table.
+ */
+bool perf_aggregate_get(unsigned int cpu, size_t index, struct perf_callchain *callchain);
+
+/** Get the number of callchains and of lost samples of a CPU. */
+void perf_aggregate_stats(unsigned int cpu, uint32_t *used, uint32_t *lost);
+
+/**
+ * Get the name of a frame.
+ *
+ * @return Function name with CONFIG_SYMTAB, or the address printed in @p buf.
+ */
+const char *perf_frame_name(uintptr_t addr, char *buf, size_t size);
+
+/** Print the callchains in the folded format of FlameGraph. */
+void perf_aggregate_print_folded(const struct shell *sh);
+
+/** Sink of a pprof profile, returns a negative errno value on error. */
+typedef int (*perf_pprof_write_t)(void *ctx, const uint8_t *data, size_t len);
+
+/**
+ * Encode the callchains as an uncompressed pprof profile.
+ *
+ * @param write       Sink of the profile.
+ * @param ctx         Context of @p write.
+ * @param period_ns   Sampling period.
+ * @param duration_ns Time spent recording.
+ *
+ * @return 0 on success, or the error returned by @p write.
+ */
+int perf_pprof_export(perf_pprof_write_t write, void *ctx, uint64_t period_ns,
+		      uint64_t duration_ns);
+
+/**
+ * Write a pprof profile to a file, truncating it.
+ *
+ * @return 0 on success, or a negative errno value.
+ */
+int perf_pprof_to_file(const char *path, uint64_t period_ns, uint64_t duration_ns);
+
+/**
+ * Send a pprof profile to a TCP peer given as "<address>:<port>".
+ *
+ * @return 0 on success, or a negative errno value.
+ */
+int perf_pprof_to_tcp(const char *peer, uint64_t period_ns, uint64_t duration_ns);
+
+#endif /* CONFIG_PROFILING_PERF_AGGREGATE */
+
+#endif /* ZEPHYR_SUBSYS_PROFILING_PERF_PERF_INTERNAL_H_ */
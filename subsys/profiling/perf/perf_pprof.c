@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Encoder of the callchain tables as a pprof profile, see
+ * https://github.com/google/pprof/blob/main/proto/profile.proto
+ *
+ * The profile is not gzipped, which the pprof tools accept as well. With
+ * CONFIG_SYMTAB every location carries its function name, otherwise only its
+ * address, which pprof can symbolize with the ELF file.
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#ifdef CONFIG_PROFILING_PERF_PPROF_FILE
+#include <zephyr/fs/fs.h>
+#endif
+
+#ifdef CONFIG_PROFILING_PERF_PPROF_TCP
+#include <zephyr/net/socket.h>
+#endif
+
+#include "perf_internal.h"
+
+/* Fields of the Profile message */
+#define PROFILE_SAMPLE_TYPE    1
+#define PROFILE_SAMPLE         2
+#define PROFILE_MAPPING        3
+#define PROFILE_LOCATION       4
+#define PROFILE_FUNCTION       5
+#define PROFILE_STRING_TABLE   6
+#define PROFILE_DURATION_NANOS 10
+#define PROFILE_PERIOD_TYPE    11
+#define PROFILE_PERIOD         12
+
+/* Fields of the nested messages */
+#define VALUE_TYPE_TYPE       1
+#define VALUE_TYPE_UNIT       2
+#define SAMPLE_LOCATION_ID    1
+#define SAMPLE_VALUE          2
+#define SAMPLE_LABEL          3
+#define LABEL_KEY             1
+#define LABEL_NUM             3
+#define MAPPING_ID            1
+#define MAPPING_MEMORY_LIMIT  3
+#define MAPPING_HAS_FUNCTIONS 7
+#define LOCATION_ID           1
+#define LOCATION_MAPPING_ID   2
+#define LOCATION_ADDRESS      3
+#define LOCATION_LINE         4
+#define LINE_FUNCTION_ID      1
+#define FUNCTION_ID           1
+#define FUNCTION_NAME         2
+
+#define WIRE_VARINT 0
+#define WIRE_LEN    2
+
+/* The first strings of the string table, the function names follow */
+enum {
+	STR_EMPTY,
+	STR_SAMPLES,
+	STR_COUNT,
+	STR_CPU,
+	STR_NANOSECONDS,
+	STR_FIXED_COUNT,
+};
+
+static const char *const fixed_strings[STR_FIXED_COUNT] = {
+	[STR_EMPTY] = "",
+	[STR_SAMPLES] = "samples",
+	[STR_COUNT] = "count",
+	[STR_CPU] = "cpu",
+	[STR_NANOSECONDS] = "nanoseconds",
+};
+
+#define VARINT_MAX 10
+
+/* Largest nested message: a sample with all its location ids */
+#define MSG_MAX (64 + (VARINT_MAX + 1) * CONFIG_PROFILING_PERF_AGGREGATE_DEPTH)
+
+/* Number of locations collected by each pass over the callchain tables */
+#define LOCATION_BATCH 128
+
+struct pb_msg {
+	size_t len;
+	uint8_t buf[MSG_MAX];
+};
+
+struct pprof_out {
+	perf_pprof_write_t write;
+	void *ctx;
+	int err;
+	size_t len;
+	uint8_t buf[128];
+	/* Index of the next string of the string table */
+	uint32_t next_str;
+	struct pb_msg msg;
+	struct pb_msg inner;
+	/* Smallest distinct frame addresses above the last pass, sorted */
+	size_t batch_len;
+	uintptr_t batch[LOCATION_BATCH];
+};
+
+static size_t varint_encode(uint8_t *buf, uint64_t value)
+{
+	size_t len = 0;
+
+	while (value >= 0x80) {
+		buf[len++] = (uint8_t)value | 0x80;
+		value >>= 7;
+	}
+
+	buf[len++] = (uint8_t)value;
+
+	return len;
+}
+
+static void msg_varint(struct pb_msg *msg, uint64_t value)
+{
+	msg->len += varint_encode(&msg->buf[msg->len], value);
+}
+
+static void msg_uint(struct pb_msg *msg, uint32_t field, uint64_t value)
+{
+	msg_varint(msg, (field << 3) | WIRE_VARINT);
+	msg_varint(msg, value);
+}
+
+static void msg_msg(struct pb_msg *msg, uint32_t field, const struct pb_msg *inner)
+{
+	msg_varint(msg, (field << 3) | WIRE_LEN);
+	msg_varint(msg, inner->len);
+	memcpy(&msg->buf[msg->len], inner->buf, inner->len);
+	msg->len += inner->len;
+}
+
+static void out_flush(struct pprof_out *out)
+{
+	if (out->err == 0 && out->len != 0) {
+		out->err = out->write(out->ctx, out->buf, out->len);
+	}
+
+	out->len = 0;
+}
+
+static void out_put(struct pprof_out *out, const uint8_t *data, size_t len)
+{
+	while (len != 0 && out->err == 0) {
+		size_t chunk = MIN(len, sizeof(out->buf) - out->len);
+
+		memcpy(&out->buf[out->len], data, chunk);
+		out->len += chunk;
+		data += chunk;
+		len -= chunk;
+
+		if (out->len == sizeof(out->buf)) {
+			out_flush(out);
+		}
+	}
+}
+
+static void out_field(struct pprof_out *out, uint32_t field, const uint8_t *data, size_t len)
+{
+	uint8_t header[2 * VARINT_MAX];
+	size_t header_len;
+
+	header_len = varint_encode(header, (field << 3) | WIRE_LEN);
+	header_len += varint_encode(&header[header_len], len);
+
+	out_put(out, header, header_len);
+	out_put(out, data, len);
+}
+
+static void out_uint(struct pprof_out *out, uint32_t field, uint64_t value)
+{
+	uint8_t buf[2 * VARINT_MAX];
+	size_t len;
+
+	len = varint_encode(buf, (field << 3) | WIRE_VARINT);
+	len += varint_encode(&buf[len], value);
+
+	out_put(out, buf, len);
+}
+
+static uint32_t out_string(struct pprof_out *out, const char *str)
+{
+	out_field(out, PROFILE_STRING_TABLE, (const uint8_t *)str, strlen(str));
+
+	return out->next_str++;
+}
+
+static void out_value_type(struct pprof_out *out, uint32_t field, uint32_t type, uint32_t unit)
+{
+	out->msg.len = 0;
+	msg_uint(&out->msg, VALUE_TYPE_TYPE, type);
+	msg_uint(&out->msg, VALUE_TYPE_UNIT, unit);
+	out_field(out, field, out->msg.buf, out->msg.len);
+}
+
+/* Add a frame address to the batch, unless it is there or above a full batch */
+static void batch_add(struct pprof_out *out, uintptr_t addr)
+{
+	size_t low = 0;
+	size_t high = out->batch_len;
+
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+
+		if (out->batch[mid] < addr) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	if ((low < out->batch_len && out->batch[low] == addr) || low == LOCATION_BATCH) {
+		return;
+	}
+
+	if (out->batch_len == LOCATION_BATCH) {
+		out->batch_len--;
+	}
+
+	memmove(&out->batch[low + 1], &out->batch[low],
+		(out->batch_len - low) * sizeof(out->batch[0]));
+	out->batch[low] = addr;
+	out->batch_len++;
+}
+
+/*
+ * Collect the smallest distinct frame addresses above @p last, up to a batch.
+ *
+ * @return false if there is none.
+ */
+static bool batch_collect(struct pprof_out *out, uintptr_t last)
+{
+	struct perf_callchain callchain;
+
+	out->batch_len = 0;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		for (size_t i = 0; perf_aggregate_get(cpu, i, &callchain); i++) {
+			for (size_t j = 0; j < callchain.depth; j++) {
+				if (callchain.frames[j] > last) {
+					batch_add(out, callchain.frames[j]);
+				}
+			}
+		}
+	}
+
+	return out->batch_len != 0;
+}
+
+static void out_location(struct pprof_out *out, uintptr_t addr)
+{
+	bool symbolized = false;
+	char buf[2 + 2 * sizeof(uintptr_t) + 1];
+	const char *name = perf_frame_name(addr, buf, sizeof(buf));
+
+	if (name != buf) {
+		uint32_t str = out_string(out, name);
+
+		symbolized = true;
+		out->msg.len = 0;
+		msg_uint(&out->msg, FUNCTION_ID, addr);
+		msg_uint(&out->msg, FUNCTION_NAME, str);
+		out_field(out, PROFILE_FUNCTION, out->msg.buf, out->msg.len);
+	}
+
+	out->msg.len = 0;
+	msg_uint(&out->msg, LOCATION_ID, addr);
+	msg_uint(&out->msg, LOCATION_MAPPING_ID, 1);
+	msg_uint(&out->msg, LOCATION_ADDRESS, addr);
+	if (symbolized) {
+		out->inner.len = 0;
+		msg_uint(&out->inner, LINE_FUNCTION_ID, addr);
+		msg_msg(&out->msg, LOCATION_LINE, &out->inner);
+	}
+	out_field(out, PROFILE_LOCATION, out->msg.buf, out->msg.len);
+}
+
+static void out_sample(struct pprof_out *out, unsigned int cpu,
+		       const struct perf_callchain *callchain)
+{
+	/* Location ids, innermost first as pprof expects */
+	out->inner.len = 0;
+	for (size_t j = 0; j < callchain->depth; j++) {
+		msg_varint(&out->inner, callchain->frames[j]);
+	}
+
+	out->msg.len = 0;
+	msg_msg(&out->msg, SAMPLE_LOCATION_ID, &out->inner);
+
+	out->inner.len = 0;
+	msg_varint(&out->inner, callchain->count);
+	msg_msg(&out->msg, SAMPLE_VALUE, &out->inner);
+
+	out->inner.len = 0;
+	msg_uint(&out->inner, LABEL_KEY, STR_CPU);
+	msg_uint(&out->inner, LABEL_NUM, cpu);
+	msg_msg(&out->msg, SAMPLE_LABEL, &out->inner);
+
+	out_field(out, PROFILE_SAMPLE, out->msg.buf, out->msg.len);
+}
+
+int perf_pprof_export(perf_pprof_write_t write, void *ctx, uint64_t period_ns,
+		      uint64_t duration_ns)
+{
+	static struct pprof_out out;
+	static K_MUTEX_DEFINE(out_lock);
+	struct perf_callchain callchain;
+	uintptr_t last = 0;
+	int err;
+
+	k_mutex_lock(&out_lock, K_FOREVER);
+
+	out.write = write;
+	out.ctx = ctx;
+	out.err = 0;
+	out.len = 0;
+	out.next_str = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(fixed_strings); i++) {
+		(void)out_string(&out, fixed_strings[i]);
+	}
+
+	out_value_type(&out, PROFILE_SAMPLE_TYPE, STR_SAMPLES, STR_COUNT);
+	out_value_type(&out, PROFILE_PERIOD_TYPE, STR_CPU, STR_NANOSECONDS);
+	out_uint(&out, PROFILE_PERIOD, period_ns);
+	out_uint(&out, PROFILE_DURATION_NANOS, duration_ns);
+
+	/* A single mapping covering the whole address space */
+	out.msg.len = 0;
+	msg_uint(&out.msg, MAPPING_ID, 1);
+	msg_uint(&out.msg, MAPPING_MEMORY_LIMIT, UINTPTR_MAX);
+	msg_uint(&out.msg, MAPPING_HAS_FUNCTIONS, IS_ENABLED(CONFIG_SYMTAB));
+	out_field(&out, PROFILE_MAPPING, out.msg.buf, out.msg.len);
+
+	/*
+	 * The frame addresses are the location and function ids, each is
+	 * output once, in increasing order, by batches of the smallest ones
+	 * left
+	 */
+	while (batch_collect(&out, last)) {
+		for (size_t i = 0; i < out.batch_len; i++) {
+			out_location(&out, out.batch[i]);
+		}
+
+		last = out.batch[out.batch_len - 1];
+	}
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		for (size_t i = 0; perf_aggregate_get(cpu, i, &callchain); i++) {
+			if (callchain.depth != 0) {
+				out_sample(&out, cpu, &callchain);
+			}
+		}
+	}
+
+	out_flush(&out);
+	err = out.err;
+
+	k_mutex_unlock(&out_lock);
+
+	return err;
+}
+
+#ifdef CONFIG_PROFILING_PERF_PPROF_FILE
+static int file_write(void *ctx, const uint8_t *data, size_t len)
+{
+	ssize_t ret = fs_write(ctx, data, len);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	return ret == len ? 0 : -ENOSPC;
+}
+
+int perf_pprof_to_file(const char *path, uint64_t period_ns, uint64_t duration_ns)
+{
+	struct fs_file_t file;
+	int err;
+
+	fs_file_t_init(&file);
+
+	err = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE | FS_O_TRUNC);
+	if (err != 0) {
+		return err;
+	}
+
+	err = perf_pprof_export(file_write, &file, period_ns, duration_ns);
+
+	if (fs_close(&file) != 0 && err == 0) {
+		err = -EIO;
+	}
+
+	return err;
+}
+#endif /* CONFIG_PROFILING_PERF_PPROF_FILE */
+
+#ifdef CONFIG_PROFILING_PERF_PPROF_TCP
+static int tcp_write(void *ctx, const uint8_t *data, size_t len)
+{
+	int sock = POINTER_TO_INT(ctx);
+
+	while (len != 0) {
+		ssize_t ret = zsock_send(sock, data, len, 0);
+
+		if (ret < 0) {
+			return -errno;
+		}
+
+		data += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+int perf_pprof_to_tcp(const char *peer, uint64_t period_ns, uint64_t duration_ns)
+{
+	struct sockaddr addr;
+	int sock;
+	int err;
+
+	if (!net_ipaddr_parse(peer, strlen(peer), &addr) || net_sin(&addr)->sin_port == 0) {
+		return -EINVAL;
+	}
+
+	sock = zsock_socket(addr.sa_family, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	if (zsock_connect(sock, &addr, addr.sa_family == AF_INET6 ?
+					sizeof(struct sockaddr_in6) :
+					sizeof(struct sockaddr_in)) < 0) {
+		err = -errno;
+		zsock_close(sock);
+		return err;
+	}
+
+	err = perf_pprof_export(tcp_write, INT_TO_POINTER(sock), period_ns, duration_ns);
+
+	zsock_close(sock);
+
+	return err;
+}
+#endif /* CONFIG_PROFILING_PERF_PPROF_TCP */
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/debug/symtab.h>
+
+#define TOP_DEFAULT 10
+#define TOP_MAX     16
+
+/* Rank of a lock, its statistics summed over its call sites */
+struct lock_rank {
+	const void *lock;
+	uint32_t contended;
+	uint64_t wait_total;
+};
+
+static void stats_add(struct k_lock_stats *total, const struct k_lock_stats *stats)
+{
+	total->acquisitions += stats->acquisitions;
+	total->contended += stats->contended;
+	total->wait_total += stats->wait_total;
+	total->wait_max = MAX(total->wait_max, stats->wait_max);
+	total->hold_total += stats->hold_total;
+	total->hold_max = MAX(total->hold_max, stats->hold_max);
+}
+
+static void lock_total(const void *lock, size_t first, struct k_lock_stats *total)
+{
+	struct k_lock_stats stats;
+
+	memset(total, 0, sizeof(*total));
+
+	for (size_t i = first; k_lock_stats_get(i, &stats) == 0; i++) {
+		if (stats.lock == lock) {
+			total->type = stats.type;
+			stats_add(total, &stats);
+		}
+	}
+}
+
+static bool lock_seen_before(const void *lock, size_t index)
+{
+	struct k_lock_stats stats;
+
+	for (size_t i = 0; i < index; i++) {
+		if (k_lock_stats_get(i, &stats) == 0 && stats.lock == lock) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool rank_higher(const struct lock_rank *a, const struct lock_rank *b)
+{
+	if (a->contended != b->contended) {
+		return a->contended > b->contended;
+	}
+
+	return a->wait_total > b->wait_total;
+}
+
+static void print_stats(const struct shell *sh, const char *indent, const char *name,
+			const struct k_lock_stats *stats)
+{
+	uint32_t acquisitions = MAX(stats->acquisitions, 1U);
+
+	shell_print(sh, "%s%s: acquired %u, contended %u, wait avg %llu max %llu ns, "
+		    "hold avg %llu max %llu ns", indent, name, stats->acquisitions,
+		    stats->contended, k_cyc_to_ns_ceil64(stats->wait_total / acquisitions),
+		    k_cyc_to_ns_ceil64(stats->wait_max),
+		    k_cyc_to_ns_ceil64(stats->hold_total / acquisitions),
+		    k_cyc_to_ns_ceil64(stats->hold_max));
+}
+
+static const char *site_name(uintptr_t site, char *buf, size_t size)
+{
+#ifdef CONFIG_SYMTAB
+	uint32_t offset;
+	const char *name = symtab_find_symbol_name(site, &offset);
+
+	if (strcmp(name, "?") != 0) {
+		snprintf(buf, size, "%s+0x%x", name, offset);
+		return buf;
+	}
+#endif /* CONFIG_SYMTAB */
+	snprintf(buf, size, "0x%lx", (unsigned long)site);
+
+	return buf;
+}
+
+static void print_lock(const struct shell *sh, const void *lock)
+{
+	struct k_lock_stats stats;
+	char buf[64];
+
+	lock_total(lock, 0, &stats);
+	snprintf(buf, sizeof(buf), "%p (%s)", lock,
+		 stats.type == K_LOCK_STATS_MUTEX ? "mutex" : "spinlock");
+	print_stats(sh, "", buf, &stats);
+
+	for (size_t i = 0; k_lock_stats_get(i, &stats) == 0; i++) {
+		if (stats.lock == lock) {
+			print_stats(sh, "  ", site_name(stats.site, buf, sizeof(buf)), &stats);
+		}
+	}
+}
+
+static int cmd_kernel_lock_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	struct lock_rank top[TOP_MAX];
+	struct k_lock_stats stats;
+	struct k_lock_stats total;
+	size_t count = TOP_DEFAULT;
+	size_t used = 0;
+	int err = 0;
+
+	if (argc > 1) {
+		count = shell_strtoul(argv[1], 10, &err);
+		if (err != 0 || count == 0 || count > TOP_MAX) {
+			shell_error(sh, "Invalid count, expected 1 to %d", TOP_MAX);
+			return -EINVAL;
+		}
+	}
+
+	for (size_t i = 0; k_lock_stats_get(i, &stats) == 0; i++) {
+		struct lock_rank rank;
+		size_t pos;
+
+		if (stats.lock == NULL || lock_seen_before(stats.lock, i)) {
+			continue;
+		}
+
+		lock_total(stats.lock, i, &total);
+		rank = (struct lock_rank){
+			.lock = stats.lock,
+			.contended = total.contended,
+			.wait_total = total.wait_total,
+		};
+
+		/* Insertion in the ranks sorted by decreasing contention */
+		for (pos = used; pos > 0 && rank_higher(&rank, &top[pos - 1]); pos--) {
+			if (pos < count) {
+				top[pos] = top[pos - 1];
+			}
+		}
+
+		if (pos < count) {
+			top[pos] = rank;
+			used = MIN(used + 1, count);
+		}
+	}
+
+	for (size_t i = 0; i < used; i++) {
+		print_lock(sh, top[i].lock);
+	}
+
+	if (k_lock_stats_dropped() > 0U) {
+		shell_print(sh, "%u acquisitions not recorded, the table is full",
+			    k_lock_stats_dropped());
+	}
+
+	return 0;
+}
+
+static int cmd_kernel_lock_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_lock_stats_reset();
+	shell_print(sh, "Lock statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_lock_stats,
+	SHELL_CMD(reset, NULL, "Reset the lock statistics.", cmd_kernel_lock_stats_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+KERNEL_CMD_ARG_ADD(lock_stats, &sub_kernel_lock_stats,
+		   "[count] Most contended spinlocks and mutexes, with their call sites.",
+		   cmd_kernel_lock_stats, 1, 1);
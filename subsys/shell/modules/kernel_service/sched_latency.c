@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <zephyr/kernel.h>
+
+static void print_histogram(const struct shell *sh, const char *name,
+			    const struct k_sched_latency_histogram *histogram)
+{
+	uint64_t upper_ns;
+
+	if (histogram->count == 0U) {
+		return;
+	}
+
+	shell_print(sh, "  %s: count %u, avg %llu ns, max %llu ns", name, histogram->count,
+		    k_cyc_to_ns_ceil64(histogram->sum / histogram->count),
+		    k_cyc_to_ns_ceil64(histogram->max));
+
+	for (int i = 0; i < CONFIG_SCHED_LATENCY_STATS_BUCKETS; i++) {
+		if (histogram->buckets[i] == 0U) {
+			continue;
+		}
+
+		if (i == CONFIG_SCHED_LATENCY_STATS_BUCKETS - 1) {
+			upper_ns = k_cyc_to_ns_ceil64(histogram->max);
+		} else {
+			upper_ns = k_cyc_to_ns_ceil64(BIT64(i) - 1U);
+		}
+
+		shell_print(sh, "    <= %10llu ns: %u", upper_ns, histogram->buckets[i]);
+	}
+}
+
+static int cmd_kernel_sched_latency(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct k_sched_latency_stats stats;
+
+	for (int prio = K_HIGHEST_THREAD_PRIO; prio <= K_LOWEST_THREAD_PRIO; prio++) {
+		(void)k_sched_latency_stats_get(prio, &stats);
+
+		if (stats.wakeup.count == 0U && stats.isr.count == 0U) {
+			continue;
+		}
+
+		shell_print(sh, "prio %d:", prio);
+		print_histogram(sh, "wakeup", &stats.wakeup);
+		print_histogram(sh, "isr", &stats.isr);
+	}
+
+	return 0;
+}
+
+static int cmd_kernel_sched_latency_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_sched_latency_stats_reset();
+	shell_print(sh, "Scheduling latencies reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_sched_latency,
+	SHELL_CMD(reset, NULL, "Reset the scheduling latency histograms.",
+		  cmd_kernel_sched_latency_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+KERNEL_CMD_ADD(sched_latency, &sub_kernel_sched_latency,
+	       "Scheduling latency histograms per priority level.", cmd_kernel_sched_latency);
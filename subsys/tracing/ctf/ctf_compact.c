@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Compact encoding of the CTF events.
+ *
+ * Every event is emitted as a record made of its id, the length of its fields
+ * as an unsigned LEB128 integer, the time in nanoseconds since the previous
+ * record of the stream as an unsigned LEB128 integer, then its fields.
+ *
+ * Thread events start with the thread id and name, which are replaced with a
+ * one byte reference. The first time a thread is referenced, or when its name
+ * changes, a CTF_COMPACT_THREAD_INTERN record giving the reference, the thread
+ * id and the name precedes the event.
+ *
+ * The first record of a stream, and the first one after an idle event, are
+ * preceded by a CTF_COMPACT_TIMESTAMP record giving the absolute timestamp in
+ * nanoseconds as a little endian 64 bit integer, the following deltas being
+ * relative to it. This lets the decoder resynchronize on a stream caught in
+ * the middle and bounds the time a 32 bit cycle counter must be extended
+ * over to the busy periods of the CPU. Across idle periods, which can last
+ * longer than a wrap of the counter, the extension is corrected with the
+ * kernel tick count.
+ *
+ * There is one stream per CPU with CONFIG_TRACING_BUFFER_PER_CPU and a single
+ * one otherwise. scripts/tracing/merge_compact_ctf.py rebuilds a standard CTF
+ * stream from the records.
+ */
+
+#define DISABLE_SYSCALL_TRACING
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <tracing_core.h>
+#include <tracing_format_common.h>
+#include <ctf_top.h>
+
+/* Record id of the thread references, out of the range of the CTF events */
+#define CTF_COMPACT_THREAD_INTERN 0xFF
+/* Record id of the absolute timestamps */
+#define CTF_COMPACT_TIMESTAMP 0xFE
+
+/* Thread id and name, at the start of the fields of the thread events */
+#define CTF_COMPACT_THREAD_LEN (sizeof(uint32_t) + sizeof(ctf_bounded_string_t))
+
+/* Id, length and timestamp delta */
+#define CTF_COMPACT_HEADER_MAX (1 + 5 + 10)
+
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+#define CTF_COMPACT_STREAMS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define CTF_COMPACT_STREAMS 1
+#endif
+
+struct ctf_compact_thread {
+	uint32_t thread_id;
+	ctf_bounded_string_t name;
+};
+
+struct ctf_compact_stream {
+	/* Cycle count, extended to 64 bits when the counter has 32 */
+	uint64_t cycles;
+	/* Timestamp of the last record emitted */
+	uint64_t timestamp;
+#ifndef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	/* Tick count matching the cycle count while not synced */
+	int64_t ticks;
+#endif
+	/* A timestamp record was emitted since the last idle record */
+	bool synced;
+	uint8_t next_ref;
+	struct ctf_compact_thread threads[CONFIG_TRACING_CTF_COMPACT_THREADS];
+};
+
+static struct ctf_compact_stream streams[CTF_COMPACT_STREAMS];
+
+static inline struct ctf_compact_stream *current_stream(void)
+{
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+	return &streams[arch_curr_cpu()->id];
+#else
+	return &streams[0];
+#endif
+}
+
+static uint64_t stream_now(struct ctf_compact_stream *stream)
+{
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	stream->cycles = k_cycle_get_64();
+#else
+	uint64_t elapsed = (uint32_t)(k_cycle_get_32() - (uint32_t)stream->cycles);
+
+	if (!stream->synced) {
+		/* Add the wraps the tick count tells happened while idle */
+		int64_t ticks = sys_clock_tick_get();
+		uint64_t ticked = k_ticks_to_cyc_floor64(ticks - stream->ticks);
+
+		if (ticked > elapsed) {
+			elapsed += (ticked - elapsed + BIT64(31)) & ~(uint64_t)UINT32_MAX;
+		}
+
+		stream->ticks = ticks;
+	}
+
+	stream->cycles += elapsed;
+#endif
+
+	return k_cyc_to_ns_floor64(stream->cycles);
+}
+
+static bool is_thread_event(uint8_t id)
+{
+	switch (id) {
+	case CTF_EVENT_THREAD_SWITCHED_OUT:
+	case CTF_EVENT_THREAD_SWITCHED_IN:
+	case CTF_EVENT_THREAD_PRIORITY_SET:
+	case CTF_EVENT_THREAD_CREATE:
+	case CTF_EVENT_THREAD_ABORT:
+	case CTF_EVENT_THREAD_SUSPEND:
+	case CTF_EVENT_THREAD_RESUME:
+	case CTF_EVENT_THREAD_READY:
+	case CTF_EVENT_THREAD_PENDING:
+	case CTF_EVENT_THREAD_INFO:
+	case CTF_EVENT_THREAD_NAME_SET:
+	case CTF_EVENT_THREAD_USER_MODE_ENTER:
+	case CTF_EVENT_THREAD_WAKEUP:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* Returns the reference of a thread, or -1 if it is not interned yet */
+static int thread_ref_find(struct ctf_compact_stream *stream, const uint8_t *thread)
+{
+	for (int i = 0; i < ARRAY_SIZE(stream->threads); i++) {
+		if (memcmp(&stream->threads[i], thread, CTF_COMPACT_THREAD_LEN) == 0) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static uint8_t *varint_put(uint8_t *buf, uint64_t value)
+{
+	while (value >= 0x80) {
+		*buf++ = (uint8_t)value | 0x80;
+		value >>= 7;
+	}
+
+	*buf++ = (uint8_t)value;
+
+	return buf;
+}
+
+static uint32_t header_put(uint8_t *buf, uint8_t id, uint32_t length, uint64_t delta)
+{
+	uint8_t *cursor = buf;
+
+	*cursor++ = id;
+	cursor = varint_put(cursor, length);
+	cursor = varint_put(cursor, delta);
+
+	return cursor - buf;
+}
+
+void ctf_compact_event(uint8_t *event, uint32_t length)
+{
+	uint8_t timestamp_header[CTF_COMPACT_HEADER_MAX];
+	uint8_t timestamp_le[sizeof(uint64_t)];
+	uint8_t intern_header[CTF_COMPACT_HEADER_MAX];
+	uint8_t header[CTF_COMPACT_HEADER_MAX];
+	bool thread = is_thread_event(event[0]);
+	uint8_t *fields = event + 1;
+	uint32_t fields_length = length - 1;
+	struct ctf_compact_stream *stream;
+	tracing_data_t data[8];
+	uint32_t count = 0;
+	uint64_t timestamp;
+	uint64_t delta;
+	uint8_t ref = 0;
+	int found = 0;
+
+	if (!is_tracing_enabled() ||
+	    (IS_ENABLED(CONFIG_TRACING_ASYNC) && is_tracing_thread())) {
+		return;
+	}
+
+	TRACING_LOCK();
+	stream = current_stream();
+	timestamp = stream_now(stream);
+	delta = timestamp - stream->timestamp;
+
+	if (!stream->synced) {
+		sys_put_le64(timestamp, timestamp_le);
+		data[count++] = (tracing_data_t){
+			timestamp_header,
+			header_put(timestamp_header, CTF_COMPACT_TIMESTAMP, sizeof(timestamp_le), 0),
+		};
+		data[count++] = (tracing_data_t){timestamp_le, sizeof(timestamp_le)};
+		delta = 0;
+	}
+
+	if (thread) {
+		found = thread_ref_find(stream, fields);
+		if (found < 0) {
+			ref = stream->next_ref;
+			data[count++] = (tracing_data_t){
+				intern_header,
+				header_put(intern_header, CTF_COMPACT_THREAD_INTERN,
+					   1 + CTF_COMPACT_THREAD_LEN, delta),
+			};
+			data[count++] = (tracing_data_t){&ref, 1};
+			data[count++] = (tracing_data_t){fields, CTF_COMPACT_THREAD_LEN};
+			delta = 0;
+		} else {
+			ref = (uint8_t)found;
+		}
+
+		fields += CTF_COMPACT_THREAD_LEN;
+		fields_length -= CTF_COMPACT_THREAD_LEN;
+	}
+
+	data[count++] = (tracing_data_t){
+		header,
+		header_put(header, event[0], fields_length + (thread ? 1 : 0), delta),
+	};
+	if (thread) {
+		data[count++] = (tracing_data_t){&ref, 1};
+	}
+	data[count++] = (tracing_data_t){fields, fields_length};
+
+	/* The stream state only follows the records that got out */
+	if (tracing_format_data_locked(data, count)) {
+		stream->timestamp = timestamp;
+		stream->synced = event[0] != CTF_EVENT_IDLE;
+#ifndef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+		if (!stream->synced) {
+			stream->ticks = sys_clock_tick_get();
+		}
+#endif
+		if (found < 0) {
+			memcpy(&stream->threads[ref], event + 1, CTF_COMPACT_THREAD_LEN);
+			stream->next_ref = (ref + 1) % ARRAY_SIZE(stream->threads);
+		}
+	}
+	TRACING_UNLOCK();
+}
@@ -37,6 +37,20 @@
 		epacket_cursor += sizeof(x);                                   \
 	}
 
+#ifdef CONFIG_TRACING_CTF_COMPACT
+/**
+ * @brief Emit an event in the compact CTF encoding.
+ *
+ * @param event  Event id followed by the event fields, without timestamp.
+ * @param length Length of @a event.
+ */
+void ctf_compact_event(uint8_t *event, uint32_t length);
+
+#define CTF_INTERNAL_EMIT(epacket, length) ctf_compact_event(epacket, length)
+#else
+#define CTF_INTERNAL_EMIT(epacket, length) tracing_format_raw_data(epacket, length)
+#endif
+
 /*
  * Gather fields to a contiguous event-packet, then atomically emit.
  */
@@ -46,10 +60,11 @@
 		uint8_t *epacket_cursor = &epacket[0];                          \
 										\
 		MAP(CTF_INTERNAL_FIELD_APPEND, ##__VA_ARGS__)                   \
-		tracing_format_raw_data(epacket, sizeof(epacket));              \
+		CTF_INTERNAL_EMIT(epacket, sizeof(epacket));                    \
 	}
 
-#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+/* The compact encoding adds the timestamp itself */
+#if defined(CONFIG_TRACING_CTF_TIMESTAMP) && !defined(CONFIG_TRACING_CTF_COMPACT)
 #define CTF_EVENT(...)                                                         \
 	{                                                                      \
 		const uint32_t tstamp = k_cyc_to_ns_floor64(k_cycle_get_32()); \
@@ -22,7 +22,8 @@ void tracing_buffer_init(void);
 /**
  * @brief Tracing buffer is empty or not.
  *
- * @return true if the ring buffer is empty, or false if not.
+ * @return true if the ring buffer (all of them with
+ *         CONFIG_TRACING_BUFFER_PER_CPU) is empty, or false if not.
  */
 bool tracing_buffer_is_empty(void);
 
@@ -104,6 +105,36 @@ int tracing_buffer_get_finish(uint32_t size);
  */
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/**
+ * @brief Get address of the first valid data in the tracing buffer of a CPU.
+ *
+ * With CONFIG_TRACING_BUFFER_PER_CPU, the put functions work on the buffer
+ * of the current CPU, which the caller must not leave while putting. The
+ * tracing thread drains the buffers of all the CPUs with this function.
+ *
+ * @param cpu  CPU index.
+ * @param data Pointer to the address. It's set to a location pointing to
+ *             the first valid data within the tracing buffer of @a cpu.
+ * @param size Requested buffer size (in bytes).
+ *
+ * @return Size of valid buffer which can be smaller than requested
+ *         if there isn't enough valid data or buffer wraps.
+ */
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Indicate number of bytes read from the claimed buffer of a CPU.
+ *
+ * @param cpu  CPU index.
+ * @param size Number of bytes read from claimed buffer.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Given @a size exceeds available data of tracing buffer.
+ */
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size);
+#endif
+
 /**
  * @brief Get buffer from tracing command buffer.
  *
@@ -53,6 +53,19 @@ bool tracing_format_raw_data_put(uint8_t *data, uint32_t size);
  */
 bool tracing_format_data_put(tracing_data_t *tracing_data_array, uint32_t count);
 
+/**
+ * @brief Emit tracing_data format message as one packet.
+ *
+ * Same as tracing_format_data() but called with TRACING_LOCK() held, for
+ * formats that keep state which must follow the order of the packets.
+ *
+ * @param tracing_data_array Tracing_data format data array to be traced.
+ * @param count Tracing_data array data count.
+ *
+ * @return true if the message is emitted, false if it is dropped.
+ */
+bool tracing_format_data_locked(tracing_data_t *tracing_data_array, uint32_t count);
+
 #ifdef __cplusplus
 }
 #endif
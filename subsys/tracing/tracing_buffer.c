@@ -4,12 +4,35 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/ring_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+#define TRACING_BUFFER_COUNT CONFIG_MP_MAX_NUM_CPUS
+#else
+#define TRACING_BUFFER_COUNT 1
+#endif
+
+static struct ring_buf tracing_ring_buf[TRACING_BUFFER_COUNT];
+static uint8_t tracing_buffer[TRACING_BUFFER_COUNT][CONFIG_TRACING_BUFFER_SIZE + 1];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
+/*
+ * With a buffer per CPU, the current CPU is the only producer of its buffer
+ * and the tracing thread the only consumer, so the ring buffer indexes need
+ * no lock, only barriers ordering them with the data.
+ */
+static inline struct ring_buf *cpu_ring_buf(void)
+{
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+	return &tracing_ring_buf[arch_curr_cpu()->id];
+#else
+	return &tracing_ring_buf[0];
+#endif
+}
+
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 {
 	*data = &tracing_cmd_buffer[0];
@@ -19,51 +42,91 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+	return ring_buf_put_claim(cpu_ring_buf(), data, size);
 }
 
 int tracing_buffer_put_finish(uint32_t size)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+	if (IS_ENABLED(CONFIG_TRACING_BUFFER_PER_CPU)) {
+		barrier_dmem_fence_full();
+	}
+
+	return ring_buf_put_finish(cpu_ring_buf(), size);
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	uint8_t *buf;
+	uint32_t claimed, total = 0U;
+
+	do {
+		claimed = tracing_buffer_put_claim(&buf, size - total);
+		memcpy(buf, data + total, claimed);
+		total += claimed;
+	} while (claimed != 0U && total < size);
+
+	tracing_buffer_put_finish(total);
+
+	return total;
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+	return ring_buf_get_claim(cpu_ring_buf(), data, size);
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+	return ring_buf_get_finish(cpu_ring_buf(), size);
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	return ring_buf_get(cpu_ring_buf(), data, size);
 }
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data, uint32_t size)
+{
+	uint32_t claimed = ring_buf_get_claim(&tracing_ring_buf[cpu], data, size);
+
+	barrier_dmem_fence_full();
+
+	return claimed;
+}
+
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size)
+{
+	barrier_dmem_fence_full();
+
+	return ring_buf_get_finish(&tracing_ring_buf[cpu], size);
+}
+#endif
+
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	for (int i = 0; i < TRACING_BUFFER_COUNT; i++) {
+		ring_buf_init(&tracing_ring_buf[i], sizeof(tracing_buffer[i]), tracing_buffer[i]);
+	}
 }
 
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	for (int i = 0; i < TRACING_BUFFER_COUNT; i++) {
+		if (!ring_buf_is_empty(&tracing_ring_buf[i])) {
+			return false;
+		}
+	}
+
+	return true;
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return ring_buf_capacity_get(cpu_ring_buf());
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	return ring_buf_space_get(cpu_ring_buf());
 }
@@ -14,6 +14,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
 #include <tracing_core.h>
 #include <tracing_buffer.h>
 #include <tracing_backend.h>
@@ -40,10 +41,49 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
-static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/* Every chunk of a CPU buffer is output after a header telling the CPU */
+#define TRACING_CHUNK_MAGIC 0xC7
+
+static void tracing_thread_output(uint32_t max_length)
 {
 	uint8_t *transferring_buf;
-	uint32_t transferring_length, tracing_buffer_max_length;
+	uint32_t transferring_length;
+	uint8_t header[4];
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		transferring_length =
+			tracing_buffer_cpu_get_claim(cpu, &transferring_buf,
+						     MIN(max_length, UINT16_MAX));
+		if (transferring_length == 0U) {
+			continue;
+		}
+
+		header[0] = TRACING_CHUNK_MAGIC;
+		header[1] = (uint8_t)cpu;
+		sys_put_le16(transferring_length, &header[2]);
+
+		tracing_buffer_handle(header, sizeof(header));
+		tracing_buffer_handle(transferring_buf, transferring_length);
+		tracing_buffer_cpu_get_finish(cpu, transferring_length);
+	}
+}
+#else
+static void tracing_thread_output(uint32_t max_length)
+{
+	uint8_t *transferring_buf;
+	uint32_t transferring_length;
+
+	transferring_length =
+		tracing_buffer_get_claim(&transferring_buf, max_length);
+	tracing_buffer_handle(transferring_buf, transferring_length);
+	tracing_buffer_get_finish(transferring_length);
+}
+#endif
+
+static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
+{
+	uint32_t tracing_buffer_max_length;
 
 	tracing_thread_tid = k_current_get();
 
@@ -53,13 +93,7 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 		if (tracing_buffer_is_empty()) {
 			k_sem_take(&tracing_thread_sem, K_FOREVER);
 		} else {
-			transferring_length =
-				tracing_buffer_get_claim(
-						&transferring_buf,
-						tracing_buffer_max_length);
-			tracing_buffer_handle(transferring_buf,
-					      transferring_length);
-			tracing_buffer_get_finish(transferring_length);
+			tracing_thread_output(tracing_buffer_max_length);
 		}
 	}
 }
@@ -74,3 +74,16 @@ void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
 		tracing_packet_drop_handle();
 	}
 }
+
+bool tracing_format_data_locked(tracing_data_t *tracing_data_array, uint32_t count)
+{
+	bool before_put_is_empty = tracing_buffer_is_empty();
+
+	if (!tracing_format_data_put(tracing_data_array, count)) {
+		tracing_packet_drop_handle();
+		return false;
+	}
+
+	tracing_trigger_output(before_put_is_empty);
+	return true;
+}
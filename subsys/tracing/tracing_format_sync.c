@@ -51,25 +51,28 @@ void tracing_format_raw_data(uint8_t *data, uint32_t length)
 
 void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
 {
-	uint8_t *data;
-	bool put_success;
-	uint32_t length, tracing_buffer_size;
-
 	if (!is_tracing_enabled()) {
 		return;
 	}
 
-	tracing_buffer_size = tracing_buffer_capacity_get();
-
 	TRACING_LOCK();
-	put_success = tracing_format_data_put(tracing_data_array, count);
+	(void)tracing_format_data_locked(tracing_data_array, count);
+	TRACING_UNLOCK();
+}
 
-	if (put_success) {
-		length = tracing_buffer_get_claim(&data, tracing_buffer_size);
-		tracing_buffer_handle(data, length);
-		tracing_buffer_get_finish(length);
-	} else {
+bool tracing_format_data_locked(tracing_data_t *tracing_data_array, uint32_t count)
+{
+	uint8_t *data;
+	uint32_t length;
+
+	if (!tracing_format_data_put(tracing_data_array, count)) {
 		tracing_packet_drop_handle();
+		return false;
 	}
-	TRACING_UNLOCK();
+
+	length = tracing_buffer_get_claim(&data, tracing_buffer_capacity_get());
+	tracing_buffer_handle(data, length);
+	tracing_buffer_get_finish(length);
+
+	return true;
 }
@@ -51,9 +51,16 @@ K_THREAD_STACK_DEFINE(recv_stack, RECV_STACK_SIZE);
 K_APPMEM_PARTITION_DEFINE(bench_mem_partition);
 #endif
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+/* Lock-free message queues must have a power of 2 length */
+K_MSGQ_LOCKFREE_DEFINE(DEMOQX1, 1, 512, 4);
+K_MSGQ_LOCKFREE_DEFINE(DEMOQX4, 4, 512, 4);
+K_MSGQ_LOCKFREE_DEFINE(DEMOQX192, 192, 512, 4);
+#else
 K_MSGQ_DEFINE(DEMOQX1, 1, 500, 4);
 K_MSGQ_DEFINE(DEMOQX4, 4, 500, 4);
 K_MSGQ_DEFINE(DEMOQX192, 192, 500, 4);
+#endif /* CONFIG_MSGQ_LOCKFREE */
 K_MSGQ_DEFINE(MB_COMM, 12, 1, 4);
 K_MSGQ_DEFINE(CH_COMM, 12, 1, 4);
 
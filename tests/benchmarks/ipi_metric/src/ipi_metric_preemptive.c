@@ -92,6 +92,10 @@ void report(void)
 	unsigned long tmp_preempt[NUM_PREEMPTIVE_THREADS] = {};
 	unsigned int i;
 	unsigned int tmp_ipi_counter;
+#ifdef CONFIG_SCHED_WORK_STEALING
+	uint32_t last_steals = 0;
+	uint32_t tmp_steals;
+#endif
 
 	atomic_set(&ipi_counter, 0);
 
@@ -130,6 +134,15 @@ void report(void)
 
 		printf("  IPI Count: %u\n", tmp_ipi_counter);
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+		tmp_steals = 0;
+		for (i = 0; i < arch_num_cpus(); i++) {
+			tmp_steals += _kernel.cpus[i].steals;
+		}
+		printf("  Steal Count: %u\n", tmp_steals - last_steals);
+		last_steals = tmp_steals;
+#endif
+
 		printf("  Total Work: %lu\n", total_work);
 
 		for (i = 0; i < NUM_WORK_THREADS; i++) {
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures deferred logging throughput with one logging thread per CPU, for
+ * 1 up to all the CPUs of the target. Build it with CONFIG_LOG_PER_CPU_BUFFERS
+ * enabled and disabled to compare a buffer per CPU with the shared one.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+LOG_MODULE_REGISTER(log_bench, LOG_LEVEL_INF);
+
+#define MSGS_PER_THREAD 1000
+#define STACK_SIZE      2048
+#define PRODUCER_PRIO   K_PRIO_PREEMPT(5)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t thread_cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static atomic_t processed;
+static atomic_t dropped;
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(msg);
+
+	atomic_inc(&processed);
+}
+
+static void drop(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	atomic_add(&dropped, cnt);
+}
+
+static const struct log_backend_api bench_backend_api = {
+	.process = process,
+	.dropped = drop,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, bench_backend_api, true);
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	timing_t start;
+	timing_t end;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = timing_counter_get();
+	for (int i = 0; i < MSGS_PER_THREAD; i++) {
+		LOG_INF("thread %d message %d", id, i);
+	}
+	end = timing_counter_get();
+
+	thread_cycles[id] = timing_cycles_get(&start, &end);
+}
+
+static void bench_threads(int count)
+{
+	uint64_t total_cycles = 0;
+	uint32_t msgs = count * MSGS_PER_THREAD;
+	uint64_t wall_ns;
+	uint64_t ns;
+	timing_t start;
+	timing_t end;
+
+	atomic_clear(&processed);
+	atomic_clear(&dropped);
+
+	for (int i = 0; i < count; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, producer, INT_TO_POINTER(i),
+				NULL, NULL, PRODUCER_PRIO, 0, K_FOREVER);
+	}
+
+	start = timing_counter_get();
+	for (int i = 0; i < count; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (int i = 0; i < count; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total_cycles += thread_cycles[i];
+	}
+	end = timing_counter_get();
+
+	wall_ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	ns = timing_cycles_to_ns_avg(total_cycles, msgs);
+
+	log_flush();
+
+	printk("REC: log.throughput.%d_cpus - %d threads logging, %u msgs/s, %ld processed, "
+	       "%ld dropped : %7llu cycles , %7llu ns :\n",
+	       count, count, wall_ns ? (uint32_t)((uint64_t)msgs * NSEC_PER_SEC / wall_ns) : 0U,
+	       atomic_get(&processed), atomic_get(&dropped), total_cycles / msgs, ns);
+}
+
+int main(void)
+{
+	TC_START("Deferred logging throughput benchmark");
+
+	timing_init();
+	timing_start();
+
+	printk("%u CPUs, %s of %d bytes in total, timer frequency %u MHz\n", arch_num_cpus(),
+	       IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS) ? "a log buffer per CPU" : "one log buffer",
+	       CONFIG_LOG_BUFFER_SIZE, timing_freq_get_mhz());
+
+	for (int count = 1; count <= arch_num_cpus(); count++) {
+		bench_threads(count);
+	}
+
+	timing_stop();
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the allocation and free throughput of a memory slab shared by
+ * one thread per CPU.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_THREADS  CONFIG_MP_MAX_NUM_CPUS
+#define BURST        CONFIG_BENCHMARK_BURST
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define BLOCK_SIZE   64
+
+/* Leave room for every CPU cache to be full on top of what is in use */
+K_MEM_SLAB_DEFINE_STATIC(bench_slab, BLOCK_SIZE, NUM_THREADS * BURST * 4, sizeof(void *));
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static atomic_t errors;
+
+static void alloc_free_entry(void *p1, void *p2, void *p3)
+{
+	void *blocks[BURST];
+	unsigned int i;
+	unsigned int j;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		for (j = 0; j < BURST; j++) {
+			if (k_mem_slab_alloc(&bench_slab, &blocks[j], K_FOREVER) != 0) {
+				atomic_inc(&errors);
+				return;
+			}
+		}
+
+		for (j = 0; j < BURST; j++) {
+			k_mem_slab_free(&bench_slab, blocks[j]);
+		}
+	}
+}
+
+static void report(const char *tag, const char *str, uint64_t cycles, uint64_t ops)
+{
+	uint64_t avg = cycles / ops;
+	uint32_t avg_ns = (uint32_t)timing_cycles_to_ns_avg(cycles, ops);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7llu cycles , %7u ns :\n", tag, str, avg, avg_ns);
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-66s : %7llu cycles , %7u ns\n", str, avg, avg_ns);
+#endif
+}
+
+static void run(unsigned int num_threads, const char *tag, const char *str)
+{
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, alloc_free_entry,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		k_thread_cpu_pin(&threads[i], i);
+#endif
+	}
+
+	start = timing_counter_get();
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	finish = timing_counter_get();
+
+	/* Each operation is one allocation and one free */
+	report(tag, str, timing_cycles_get(&start, &finish),
+	       (uint64_t)num_threads * CONFIG_BENCHMARK_NUM_ITERATIONS * BURST);
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	TC_START("Memory slab benchmark");
+
+	printk("Slab of %u blocks, %u threads, bursts of %u blocks%s\n",
+	       bench_slab.info.num_blocks, arch_num_cpus(), BURST,
+	       IS_ENABLED(CONFIG_MEM_SLAB_CACHE) ? ", per-CPU caches" : "");
+
+	run(1, "mem_slab.alloc_free.single",
+	    "Allocate and free a block, one thread");
+	run(arch_num_cpus(), "mem_slab.alloc_free.all_cpus",
+	    "Allocate and free a block, one thread per CPU (aggregate)");
+
+	timing_stop();
+
+	if (k_mem_slab_num_used_get(&bench_slab) != 0U) {
+		printk("Blocks leaked: %u\n", k_mem_slab_num_used_get(&bench_slab));
+		atomic_inc(&errors);
+	}
+
+	TC_END_RESULT(atomic_get(&errors) == 0 ? TC_PASS : TC_FAIL);
+	TC_END_REPORT(atomic_get(&errors) == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
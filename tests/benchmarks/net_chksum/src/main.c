@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the Internet checksum calculation on its own, after a copy, and
+ * fused with the copy, for a few typical packet sizes. Build it with
+ * CONFIG_NET_CHKSUM_ARCH enabled and disabled to compare the architecture
+ * specific code with the generic one.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_chksum_bench, LOG_LEVEL_NONE);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#include "net_private.h"
+#include "chksum_arch.h"
+
+#ifndef CHKSUM_ARCH_NAME
+#define CHKSUM_ARCH_NAME "generic"
+#endif
+
+#define ITERATIONS 1000
+#define MAX_LEN    1500
+
+static uint8_t src_buf[MAX_LEN + 4] __aligned(4);
+static uint8_t dst_buf[MAX_LEN + 4] __aligned(4);
+
+static const size_t lengths[] = {64, 576, 1500};
+
+/* One byte at a time, as obvious as it gets */
+static uint16_t chksum_ref(const uint8_t *data, size_t len)
+{
+	uint32_t sum = 0;
+
+	for (size_t i = 0; i < len; i++) {
+		sum += (i % 2) ? data[i] : data[i] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+static void report(const char *op, size_t len, uint64_t cycles)
+{
+	uint64_t ns = timing_cycles_to_ns_avg(cycles, ITERATIONS);
+	uint32_t mbps = ns ? (uint32_t)((len * 1000U) / ns) : 0U;
+
+	printk("REC: net.chksum.%s.%s.%zu - %s of %zu bytes, %u MB/s : %7llu cycles , %7llu ns :\n",
+	       CHKSUM_ARCH_NAME, op, len, op, len, mbps, cycles / ITERATIONS, ns);
+}
+
+static bool bench_len(size_t len, size_t offset)
+{
+	const uint8_t *src = src_buf + offset;
+	uint16_t expected = chksum_ref(src, len);
+	volatile uint16_t sum = 0;
+	timing_t start;
+	timing_t end;
+
+	if (calc_chksum(0, src, len) != expected ||
+	    calc_chksum_copy(0, dst_buf, src, len) != expected ||
+	    memcmp(dst_buf, src, len) != 0) {
+		printk("Wrong checksum of %zu bytes at offset %zu\n", len, offset);
+		return false;
+	}
+
+	if (offset != 0) {
+		return true;
+	}
+
+	start = timing_counter_get();
+	for (int i = 0; i < ITERATIONS; i++) {
+		sum = calc_chksum(0, src, len);
+	}
+	end = timing_counter_get();
+	report("sum", len, timing_cycles_get(&start, &end));
+
+	start = timing_counter_get();
+	for (int i = 0; i < ITERATIONS; i++) {
+		memcpy(dst_buf, src, len);
+		sum = calc_chksum(0, dst_buf, len);
+	}
+	end = timing_counter_get();
+	report("copy_then_sum", len, timing_cycles_get(&start, &end));
+
+	start = timing_counter_get();
+	for (int i = 0; i < ITERATIONS; i++) {
+		sum = calc_chksum_copy(0, dst_buf, src, len);
+	}
+	end = timing_counter_get();
+	report("copy_and_sum", len, timing_cycles_get(&start, &end));
+
+	ARG_UNUSED(sum);
+
+	return true;
+}
+
+int main(void)
+{
+	bool ok = true;
+
+	TC_START("Internet checksum benchmark");
+
+	for (size_t i = 0; i < sizeof(src_buf); i++) {
+		src_buf[i] = (uint8_t)(i * 131 + 17);
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("Checksum variant: %s, timer frequency %u MHz\n", CHKSUM_ARCH_NAME,
+	       timing_freq_get_mhz());
+
+	for (size_t i = 0; i < ARRAY_SIZE(lengths); i++) {
+		for (size_t offset = 0; offset < 4; offset++) {
+			ok = bench_len(lengths[i] - offset, offset) && ok;
+		}
+	}
+
+	timing_stop();
+
+	TC_END_RESULT(ok ? TC_PASS : TC_FAIL);
+	TC_END_REPORT(ok ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
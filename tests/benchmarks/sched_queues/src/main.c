@@ -151,8 +151,8 @@ static uint64_t sqrt_u64(uint64_t square)
 	return square;
 }
 
-static void compute_and_report_stats(unsigned int num_threads, unsigned int num_iterations,
-				     uint64_t *cycles, const char *tag, const char *str)
+void compute_and_report_stats(unsigned int num_threads, unsigned int num_iterations,
+			      uint64_t *cycles, const char *tag, const char *str)
 {
 	uint64_t minimum = cycles[0];
 	uint64_t maximum = cycles[0];
@@ -329,6 +329,10 @@ int main(void)
 		k_thread_abort(&test_thread[i]);
 	}
 
+	if (IS_ENABLED(CONFIG_BENCHMARK_TIMEOUT_QUEUE)) {
+		timeout_queue_benchmark();
+	}
+
 	timing_stop();
 
 	TC_END_REPORT(0);
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the timeout queue measurements.
+ */
+
+#include <zephyr/kernel.h>
+#include "utils.h"
+#include <timeout_q.h>
+
+/*
+ * All timeouts are armed far enough in the future that none of them
+ * expires while the benchmark runs, so only the cost of the queue
+ * operations themselves is measured.
+ */
+#define TIMEOUT_BASE_TICKS 1000
+#define TIMEOUT_SPREAD     BIT(20)
+
+static struct _timeout timeouts[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+static k_ticks_t expiry[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+static unsigned int order[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+
+static uint64_t add_cycles[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+static uint64_t remove_cycles[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+
+static uint32_t rand_state = 0x2545f491;
+
+/* Deterministic xorshift so that every backend sees the same pattern */
+static uint32_t next_rand(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static void timeout_handler(struct _timeout *t)
+{
+	printk("Timeout %u unexpectedly expired\n",
+	       (unsigned int)(t - timeouts));
+}
+
+static void setup_increasing(unsigned int num_timeouts)
+{
+	unsigned int i;
+
+	for (i = 0; i < num_timeouts; i++) {
+		expiry[i] = TIMEOUT_BASE_TICKS + i;
+		order[i] = i;
+	}
+}
+
+static void setup_random(unsigned int num_timeouts)
+{
+	unsigned int i;
+	unsigned int j;
+	unsigned int tmp;
+
+	for (i = 0; i < num_timeouts; i++) {
+		expiry[i] = TIMEOUT_BASE_TICKS + (next_rand() % TIMEOUT_SPREAD);
+		order[i] = i;
+	}
+
+	/* Cancel in a different random order than the one used to arm */
+	for (i = num_timeouts - 1; i > 0; i--) {
+		j = next_rand() % (i + 1);
+		tmp = order[i];
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+}
+
+static void cycles_reset(unsigned int num_timeouts)
+{
+	unsigned int i;
+
+	for (i = 0; i < num_timeouts; i++) {
+		add_cycles[i] = 0ULL;
+		remove_cycles[i] = 0ULL;
+	}
+}
+
+static void test_add_abort(unsigned int num_timeouts)
+{
+	unsigned int i;
+	timing_t start;
+	timing_t finish;
+
+	for (i = 0; i < num_timeouts; i++) {
+		start = timing_counter_get();
+		z_add_timeout(&timeouts[i], timeout_handler, K_TICKS(expiry[i]));
+		finish = timing_counter_get();
+		add_cycles[i] += timing_cycles_get(&start, &finish);
+	}
+
+	for (i = 0; i < num_timeouts; i++) {
+		start = timing_counter_get();
+		z_abort_timeout(&timeouts[order[i]]);
+		finish = timing_counter_get();
+		remove_cycles[i] += timing_cycles_get(&start, &finish);
+	}
+}
+
+static void report_verbose(const char *what, uint64_t *cycles)
+{
+#ifdef CONFIG_BENCHMARK_VERBOSE
+	char description[120];
+	char tag[50];
+	unsigned int i;
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_TIMEOUTS; i++) {
+		snprintf(tag, sizeof(tag), "TimeoutQ.%s.%05u.armed", what, i);
+		snprintf(description, sizeof(description), "%-40s - %s timeout", tag, what);
+		PRINT_STATS_AVG(description, (uint32_t)cycles[i],
+				CONFIG_BENCHMARK_NUM_ITERATIONS);
+	}
+#else
+	ARG_UNUSED(what);
+	ARG_UNUSED(cycles);
+#endif
+}
+
+void timeout_queue_benchmark(void)
+{
+	unsigned int i;
+
+	printk("Time Measurements for %s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "timing wheel" : "dlist");
+
+	setup_increasing(CONFIG_BENCHMARK_NUM_TIMEOUTS);
+	cycles_reset(CONFIG_BENCHMARK_NUM_TIMEOUTS);
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		test_add_abort(CONFIG_BENCHMARK_NUM_TIMEOUTS);
+	}
+
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 add_cycles, "timeout.add.increasing",
+				 "Arm timeouts of increasing expiry");
+	report_verbose("add", add_cycles);
+
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 remove_cycles, "timeout.abort.first",
+				 "Cancel earliest armed timeout");
+	report_verbose("abort", remove_cycles);
+
+	setup_random(CONFIG_BENCHMARK_NUM_TIMEOUTS);
+	cycles_reset(CONFIG_BENCHMARK_NUM_TIMEOUTS);
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		test_add_abort(CONFIG_BENCHMARK_NUM_TIMEOUTS);
+	}
+
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 add_cycles, "timeout.add.random",
+				 "Arm timeouts of random expiry");
+	report_verbose("add", add_cycles);
+
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 remove_cycles, "timeout.abort.random",
+				 "Cancel timeouts in random order");
+	report_verbose("abort", remove_cycles);
+}
@@ -50,5 +50,9 @@
 	PRINT_F(summary, value / counter,                           \
 		(uint32_t)timing_cycles_to_ns_avg(value, counter))
 
+void compute_and_report_stats(unsigned int num_samples, unsigned int num_iterations,
+			      uint64_t *cycles, const char *tag, const char *str);
+
+void timeout_queue_benchmark(void);
 
 #endif
@@ -15,6 +15,9 @@
  * reduce the memory footprint as not only are thread stacks not required,
  * but we also do not need the full k_thread structure for each of these
  * dummy threads.
+ *
+ * It also measures how long it takes to wake a herd of real threads all
+ * pending on the same condition variable or event object.
  */
 
 #include <zephyr/kernel.h>
@@ -34,6 +37,24 @@ static _wait_q_t wait_q;
 uint64_t add_cycles[CONFIG_BENCHMARK_NUM_THREADS];
 uint64_t remove_cycles[CONFIG_BENCHMARK_NUM_THREADS];
 
+#define HERD_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(herd_stacks, CONFIG_BENCHMARK_NUM_HERD_THREADS,
+				   HERD_STACK_SIZE);
+static struct k_thread herd_threads[CONFIG_BENCHMARK_NUM_HERD_THREADS];
+
+static K_MUTEX_DEFINE(herd_mutex);
+static K_CONDVAR_DEFINE(herd_condvar);
+static K_EVENT_DEFINE(herd_event);
+
+uint64_t herd_cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+
+enum herd_wake {
+	HERD_CONDVAR_SIGNAL,
+	HERD_CONDVAR_BROADCAST,
+	HERD_EVENT_POST,
+};
+
 /**
  * Initialize each dummy thread.
  */
@@ -125,6 +146,79 @@ static void test_increasing_priority(_wait_q_t *q, unsigned int num_threads)
 	}
 }
 
+static void herd_condvar_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		k_mutex_lock(&herd_mutex, K_FOREVER);
+		k_condvar_wait(&herd_condvar, &herd_mutex, K_FOREVER);
+		k_mutex_unlock(&herd_mutex);
+	}
+}
+
+static void herd_event_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		(void)k_event_wait(&herd_event, BIT(0), true, K_FOREVER);
+	}
+}
+
+/**
+ * The herd threads share the priority of the main thread: waking them does
+ * not preempt it, and yielding lets every one of them run until it pends
+ * again before the main thread resumes.
+ */
+static void test_herd(enum herd_wake wake, unsigned int num_threads)
+{
+	k_thread_entry_t entry;
+	unsigned int i;
+	unsigned int j;
+	timing_t start;
+	timing_t finish;
+
+	entry = (wake == HERD_EVENT_POST) ? herd_event_entry : herd_condvar_entry;
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_create(&herd_threads[i], herd_stacks[i], HERD_STACK_SIZE,
+				entry, NULL, NULL, NULL,
+				k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+	}
+
+	k_yield();
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		switch (wake) {
+		case HERD_CONDVAR_SIGNAL:
+			for (j = 0; j < num_threads; j++) {
+				k_condvar_signal(&herd_condvar);
+			}
+			break;
+		case HERD_CONDVAR_BROADCAST:
+			k_condvar_broadcast(&herd_condvar);
+			break;
+		case HERD_EVENT_POST:
+			k_event_post(&herd_event, BIT(0));
+			break;
+		}
+		finish = timing_counter_get();
+
+		herd_cycles[i] = timing_cycles_get(&start, &finish);
+
+		k_yield();
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_abort(&herd_threads[i]);
+	}
+}
 
 static uint64_t sqrt_u64(uint64_t square)
 {
@@ -318,6 +412,23 @@ int main(void)
 	}
 #endif
 
+	/* Each iteration is a single sample for the thundering herd cases */
+
+	test_herd(HERD_CONDVAR_SIGNAL, CONFIG_BENCHMARK_NUM_HERD_THREADS);
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_ITERATIONS, 1, herd_cycles,
+				 "sched.wake.herd.condvar_signal",
+				 "Wake a herd of threads one by one");
+
+	test_herd(HERD_CONDVAR_BROADCAST, CONFIG_BENCHMARK_NUM_HERD_THREADS);
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_ITERATIONS, 1, herd_cycles,
+				 "sched.wake.herd.condvar_broadcast",
+				 "Wake a herd of threads with a broadcast");
+
+	test_herd(HERD_EVENT_POST, CONFIG_BENCHMARK_NUM_HERD_THREADS);
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_ITERATIONS, 1, herd_cycles,
+				 "sched.wake.herd.event_post",
+				 "Wake a herd of threads with an event");
+
 	timing_stop();
 
 	TC_END_REPORT(0);
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Pings the gateway of QEMU user networking through the VIRTIO network
+ * device, so that frames go through both the TX and the RX virtqueues.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/icmp.h>
+#include <zephyr/ztest.h>
+
+#define VIRTIO_NET_NODE DT_NODELABEL(virtio_net)
+
+#define PING_TIMEOUT K_SECONDS(2)
+#define PING_BURST   8
+
+/* Addresses of QEMU user networking */
+static struct in_addr local_addr = { { { 10, 0, 2, 15 } } };
+static struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+static struct in_addr gw_addr = { { { 10, 0, 2, 2 } } };
+
+static const struct device *const eth_dev = DEVICE_DT_GET(VIRTIO_NET_NODE);
+static struct net_if *iface;
+
+static K_SEM_DEFINE(reply_sem, 0, PING_BURST);
+static uint16_t reply_len;
+
+static uint8_t ping_data[1400];
+
+static int ping_handler(struct net_icmp_ctx *ctx, struct net_pkt *pkt,
+			struct net_icmp_ip_hdr *hdr, struct net_icmp_hdr *icmp_hdr,
+			void *user_data)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(icmp_hdr);
+	ARG_UNUSED(user_data);
+
+	if (hdr->family != AF_INET) {
+		return -ENOENT;
+	}
+
+	reply_len = ntohs(hdr->ipv4->len);
+	k_sem_give(&reply_sem);
+
+	return 0;
+}
+
+static void send_pings(size_t data_size, int count)
+{
+	struct sockaddr_in dst = {
+		.sin_family = AF_INET,
+		.sin_addr = gw_addr,
+	};
+	struct net_icmp_ping_params params = { 0 };
+	struct net_icmp_ctx ctx;
+	int ret;
+
+	k_sem_reset(&reply_sem);
+
+	ret = net_icmp_init_ctx(&ctx, NET_ICMPV4_ECHO_REPLY, 0, ping_handler);
+	zassert_equal(ret, 0, "Cannot init ICMP (%d)", ret);
+
+	params.identifier = 0x1234;
+	params.data = ping_data;
+	params.data_size = data_size;
+
+	for (int i = 0; i < count; i++) {
+		params.sequence = i;
+
+		ret = net_icmp_send_echo_request(&ctx, iface, (struct sockaddr *)&dst, &params,
+						 NULL);
+		zassert_equal(ret, 0, "Cannot send Echo-Request (%d)", ret);
+	}
+
+	for (int i = 0; i < count; i++) {
+		zassert_equal(k_sem_take(&reply_sem, PING_TIMEOUT), 0,
+			      "Echo-Reply %d of %d not received", i + 1, count);
+		/* Identifier and sequence number follow the ICMP header */
+		zassert_equal(reply_len, sizeof(struct net_ipv4_hdr) +
+				sizeof(struct net_icmp_hdr) + 4U + data_size,
+			      "Echo-Reply of wrong length %u", reply_len);
+	}
+
+	ret = net_icmp_cleanup_ctx(&ctx);
+	zassert_equal(ret, 0, "Cannot cleanup ICMP (%d)", ret);
+}
+
+ZTEST(virtio_net, test_ping)
+{
+	send_pings(56, 1);
+}
+
+/* The reply does not fit in one RX buffer */
+ZTEST(virtio_net, test_ping_large)
+{
+	send_pings(sizeof(ping_data), 1);
+}
+
+/* Several frames are received before the RX work item runs */
+ZTEST(virtio_net, test_ping_burst)
+{
+	send_pings(56, PING_BURST);
+	send_pings(sizeof(ping_data), PING_BURST);
+}
+
+static void *virtio_net_setup(void)
+{
+	zassert_true(device_is_ready(eth_dev), "VIRTIO network device not ready");
+
+	iface = net_if_lookup_by_dev(eth_dev);
+	zassert_not_null(iface, "No interface for the VIRTIO network device");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &local_addr, NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv4 address");
+	net_if_ipv4_set_netmask_by_addr(iface, &local_addr, &netmask);
+
+	for (int i = 0; i < 50 && !net_if_is_up(iface); i++) {
+		k_msleep(100);
+	}
+
+	zassert_true(net_if_is_up(iface), "Interface is not up");
+
+	for (size_t i = 0; i < sizeof(ping_data); i++) {
+		ping_data[i] = i;
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(virtio_net, NULL, virtio_net_setup, NULL, NULL, NULL);
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include "test_mslab.h"
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+
+/* Enough blocks for a cache to fill up and spill back to the slab */
+#define CACHE_BLK_NUM (3 * CONFIG_MEM_SLAB_CACHE_BATCH)
+
+K_MEM_SLAB_DEFINE_STATIC(cache_slab, BLK_SIZE, CACHE_BLK_NUM, BLK_ALIGN);
+
+static void *blocks[CACHE_BLK_NUM];
+
+static K_THREAD_STACK_DEFINE(cache_stack, STACKSIZE);
+static struct k_thread cache_thread;
+
+static void check_used(uint32_t used)
+{
+	struct sys_memory_stats stats;
+
+	zassert_equal(k_mem_slab_num_used_get(&cache_slab), used);
+	zassert_equal(k_mem_slab_num_free_get(&cache_slab), CACHE_BLK_NUM - used);
+
+	zassert_equal(k_mem_slab_runtime_stats_get(&cache_slab, &stats), 0);
+	zassert_equal(stats.allocated_bytes, used * BLK_SIZE);
+	zassert_equal(stats.free_bytes, (CACHE_BLK_NUM - used) * BLK_SIZE);
+}
+
+static void alloc_blocks(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_equal(k_mem_slab_alloc(&cache_slab, &blocks[i], K_NO_WAIT), 0);
+		zassert_not_null(blocks[i]);
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(blocks[i], blocks[j], "block handed out twice");
+		}
+	}
+}
+
+static void free_blocks(int count)
+{
+	for (int i = 0; i < count; i++) {
+		k_mem_slab_free(&cache_slab, blocks[i]);
+	}
+}
+
+/**
+ * @brief Test that cached blocks are accounted as free
+ * @see k_mem_slab_num_used_get(), k_mem_slab_runtime_stats_get()
+ */
+ZTEST(mslab_cache, test_mslab_cache_stats)
+{
+	check_used(0);
+
+	alloc_blocks(1);
+	check_used(1);
+	zassert_true(z_mem_slab_num_cached(&cache_slab) > 0, "no block cached");
+
+	free_blocks(1);
+	check_used(0);
+
+	/* Spill a full cache back to the slab */
+	alloc_blocks(2 * CONFIG_MEM_SLAB_CACHE_BATCH);
+	check_used(2 * CONFIG_MEM_SLAB_CACHE_BATCH);
+	free_blocks(2 * CONFIG_MEM_SLAB_CACHE_BATCH);
+	check_used(0);
+	zassert_true(z_mem_slab_num_cached(&cache_slab) < 2 * CONFIG_MEM_SLAB_CACHE_BATCH);
+}
+
+/**
+ * @brief Test that every block can be allocated while some are cached
+ */
+ZTEST(mslab_cache, test_mslab_cache_exhaust)
+{
+	void *block;
+
+	for (int round = 0; round < 3; round++) {
+		alloc_blocks(CACHE_BLK_NUM);
+		check_used(CACHE_BLK_NUM);
+		zassert_equal(k_mem_slab_alloc(&cache_slab, &block, K_NO_WAIT), -ENOMEM);
+		zassert_equal(k_mem_slab_alloc(&cache_slab, &block, K_MSEC(10)), -EAGAIN);
+
+		free_blocks(CACHE_BLK_NUM);
+		check_used(0);
+	}
+}
+
+static void cache_pend_entry(void *p1, void *p2, void *p3)
+{
+	void **block = p1;
+
+	zassert_equal(k_mem_slab_alloc(&cache_slab, block, K_FOREVER), 0);
+}
+
+/**
+ * @brief Test that a freed block is handed to a pending allocation
+ */
+ZTEST(mslab_cache, test_mslab_cache_pend)
+{
+	void *block = NULL;
+
+	alloc_blocks(CACHE_BLK_NUM);
+
+	k_thread_create(&cache_thread, cache_stack, STACKSIZE,
+			cache_pend_entry, &block, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+	zassert_is_null(block);
+
+	k_mem_slab_free(&cache_slab, blocks[0]);
+	k_thread_join(&cache_thread, K_FOREVER);
+	zassert_equal(block, blocks[0]);
+	check_used(CACHE_BLK_NUM);
+
+	/* Caching resumes once no allocation is starving */
+	blocks[0] = block;
+	free_blocks(CACHE_BLK_NUM);
+	check_used(0);
+	zassert_equal(atomic_get(&cache_slab.cache_bypass), 0);
+	zassert_true(z_mem_slab_num_cached(&cache_slab) > 0, "no block cached");
+}
+
+ZTEST_SUITE(mslab_cache, NULL, NULL, NULL, NULL, NULL);
+
+#endif /* CONFIG_MEM_SLAB_CACHE */
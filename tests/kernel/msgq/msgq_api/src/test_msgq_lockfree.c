@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#ifdef CONFIG_MSGQ_LOCKFREE
+
+#define LF_MSGQ_LEN     4
+#define LF_NUM_MSGS     1000
+#define LF_NUM_THREADS  2
+#define LF_STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/**TESTPOINT: init via K_MSGQ_LOCKFREE_DEFINE*/
+K_MSGQ_LOCKFREE_DEFINE(lf_kmsgq, sizeof(uint32_t), LF_MSGQ_LEN, 4);
+
+static struct k_msgq lf_msgq;
+static char __aligned(4) lf_buffer[sizeof(uint32_t) * LF_MSGQ_LEN];
+static atomic_t lf_seq[LF_MSGQ_LEN];
+
+static K_THREAD_STACK_ARRAY_DEFINE(lf_stacks, 2 * LF_NUM_THREADS, LF_STACK_SIZE);
+static struct k_thread lf_threads[2 * LF_NUM_THREADS];
+
+static atomic_t lf_sum;
+
+static void fill_and_drain(struct k_msgq *q)
+{
+	uint32_t data;
+	uint32_t i;
+
+	for (i = 0; i < LF_MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_put(q, &i, K_NO_WAIT), 0);
+		zassert_equal(k_msgq_num_used_get(q), i + 1);
+		zassert_equal(k_msgq_num_free_get(q), LF_MSGQ_LEN - i - 1);
+	}
+
+	/**TESTPOINT: a full queue rejects puts, and put_front altogether */
+	zassert_equal(k_msgq_put(q, &i, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_put_front(q, &i, K_NO_WAIT), -ENOTSUP);
+
+	zassert_equal(k_msgq_peek(q, &data), 0);
+	zassert_equal(data, 0);
+	zassert_equal(k_msgq_peek_at(q, &data, LF_MSGQ_LEN - 1), 0);
+	zassert_equal(data, LF_MSGQ_LEN - 1);
+	zassert_equal(k_msgq_peek_at(q, &data, LF_MSGQ_LEN), -ENOMSG);
+
+	for (i = 0; i < LF_MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_get(q, &data, K_NO_WAIT), 0);
+		zassert_equal(data, i, "messages out of order");
+	}
+
+	zassert_equal(k_msgq_get(q, &data, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_peek(q, &data), -ENOMSG);
+	zassert_equal(k_msgq_num_used_get(q), 0);
+}
+
+/**
+ * @brief Test FIFO order and full/empty handling of lock-free queues
+ * @see K_MSGQ_LOCKFREE_DEFINE(), k_msgq_lockfree_init()
+ */
+ZTEST(msgq_lockfree, test_msgq_lockfree_fifo)
+{
+	zassert_equal(k_msgq_lockfree_init(&lf_msgq, lf_buffer, lf_seq,
+					   sizeof(uint32_t), 3), -EINVAL);
+	zassert_equal(k_msgq_lockfree_init(&lf_msgq, lf_buffer, lf_seq,
+					   sizeof(uint32_t), LF_MSGQ_LEN), 0);
+
+	/* several laps so that sequence numbers wrap around the ring */
+	for (int lap = 0; lap < 3; lap++) {
+		fill_and_drain(&lf_kmsgq);
+		fill_and_drain(&lf_msgq);
+	}
+}
+
+static void lf_put_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t value = POINTER_TO_UINT(p2);
+
+	zassert_equal(k_msgq_put(p1, &value, K_FOREVER), 0);
+}
+
+/**
+ * @brief Test that a pending reader is woken up by a put
+ */
+ZTEST(msgq_lockfree, test_msgq_lockfree_pend_get)
+{
+	uint32_t data;
+
+	k_msgq_purge(&lf_kmsgq);
+
+	zassert_equal(k_msgq_get(&lf_kmsgq, &data, TIMEOUT), -EAGAIN);
+
+	k_thread_create(&lf_threads[0], lf_stacks[0], LF_STACK_SIZE,
+			lf_put_entry, &lf_kmsgq, UINT_TO_POINTER(MSG0), NULL,
+			K_PRIO_PREEMPT(0), 0, K_MSEC(10));
+
+	zassert_equal(k_msgq_get(&lf_kmsgq, &data, K_FOREVER), 0);
+	zassert_equal(data, MSG0);
+
+	k_thread_join(&lf_threads[0], K_FOREVER);
+}
+
+static void lf_get_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t data;
+
+	zassert_equal(k_msgq_get(p1, &data, K_FOREVER), 0);
+}
+
+/**
+ * @brief Test that a pending writer is woken up by a get
+ */
+ZTEST(msgq_lockfree, test_msgq_lockfree_pend_put)
+{
+	uint32_t data = MSG1;
+
+	k_msgq_purge(&lf_kmsgq);
+
+	for (int i = 0; i < LF_MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_put(&lf_kmsgq, &data, K_NO_WAIT), 0);
+	}
+	zassert_equal(k_msgq_put(&lf_kmsgq, &data, TIMEOUT), -EAGAIN);
+
+	k_thread_create(&lf_threads[0], lf_stacks[0], LF_STACK_SIZE,
+			lf_get_entry, &lf_kmsgq, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_MSEC(10));
+
+	zassert_equal(k_msgq_put(&lf_kmsgq, &data, K_FOREVER), 0);
+	zassert_equal(k_msgq_num_used_get(&lf_kmsgq), LF_MSGQ_LEN);
+
+	k_thread_join(&lf_threads[0], K_FOREVER);
+}
+
+static void lf_purged_put_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t data = MSG0;
+
+	zassert_equal(k_msgq_put(p1, &data, K_FOREVER), -ENOMSG);
+}
+
+/**
+ * @brief Test purging a lock-free queue with a pending writer
+ */
+ZTEST(msgq_lockfree, test_msgq_lockfree_purge)
+{
+	uint32_t data = MSG1;
+
+	k_msgq_purge(&lf_kmsgq);
+
+	for (int i = 0; i < LF_MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_put(&lf_kmsgq, &data, K_NO_WAIT), 0);
+	}
+
+	k_thread_create(&lf_threads[0], lf_stacks[0], LF_STACK_SIZE,
+			lf_purged_put_entry, &lf_kmsgq, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	k_msgq_purge(&lf_kmsgq);
+	zassert_equal(k_msgq_num_used_get(&lf_kmsgq), 0);
+
+	k_thread_join(&lf_threads[0], K_FOREVER);
+
+	zassert_equal(k_msgq_get(&lf_kmsgq, &data, K_NO_WAIT), -ENOMSG);
+}
+
+static void lf_isr_put(const void *param)
+{
+	uint32_t data = MSG1;
+
+	zassert_equal(k_msgq_put((struct k_msgq *)param, &data, K_NO_WAIT), 0);
+}
+
+/**
+ * @brief Test putting to a lock-free queue from an ISR
+ */
+ZTEST(msgq_lockfree, test_msgq_lockfree_isr)
+{
+	uint32_t data;
+
+	k_msgq_purge(&lf_kmsgq);
+
+	irq_offload(lf_isr_put, &lf_kmsgq);
+
+	zassert_equal(k_msgq_get(&lf_kmsgq, &data, K_NO_WAIT), 0);
+	zassert_equal(data, MSG1);
+}
+
+#ifdef CONFIG_POLL
+/**
+ * @brief Test polling a lock-free queue for data
+ */
+ZTEST(msgq_lockfree, test_msgq_lockfree_poll)
+{
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &lf_kmsgq);
+	uint32_t data;
+
+	k_msgq_purge(&lf_kmsgq);
+
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), -EAGAIN);
+
+	k_thread_create(&lf_threads[0], lf_stacks[0], LF_STACK_SIZE,
+			lf_put_entry, &lf_kmsgq, UINT_TO_POINTER(MSG1), NULL,
+			K_PRIO_PREEMPT(0), 0, K_MSEC(10));
+
+	event.state = K_POLL_STATE_NOT_READY;
+	zassert_equal(k_poll(&event, 1, K_FOREVER), 0);
+	zassert_equal(event.state, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+	zassert_equal(k_msgq_get(&lf_kmsgq, &data, K_NO_WAIT), 0);
+	zassert_equal(data, MSG1);
+
+	k_thread_join(&lf_threads[0], K_FOREVER);
+
+	/* With no poller left, the next put leaves the notification path */
+	zassert_equal(k_msgq_put(&lf_kmsgq, &data, K_NO_WAIT), 0);
+	zassert_equal(atomic_get(&lf_kmsgq.waiters), 0);
+	zassert_equal(k_msgq_get(&lf_kmsgq, &data, K_NO_WAIT), 0);
+}
+#endif /* CONFIG_POLL */
+
+static void lf_producer(void *p1, void *p2, void *p3)
+{
+	for (uint32_t i = 1; i <= LF_NUM_MSGS; i++) {
+		zassert_equal(k_msgq_put(p1, &i, K_FOREVER), 0);
+	}
+}
+
+static void lf_consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t data;
+
+	for (int i = 0; i < LF_NUM_MSGS; i++) {
+		zassert_equal(k_msgq_get(p1, &data, K_FOREVER), 0);
+		atomic_add(&lf_sum, data);
+	}
+}
+
+/**
+ * @brief Test several producers and consumers sharing a lock-free queue
+ */
+ZTEST(msgq_lockfree, test_msgq_lockfree_mpmc)
+{
+	int i;
+
+	k_msgq_purge(&lf_kmsgq);
+	atomic_clear(&lf_sum);
+
+	for (i = 0; i < LF_NUM_THREADS; i++) {
+		k_thread_create(&lf_threads[2 * i], lf_stacks[2 * i], LF_STACK_SIZE,
+				lf_producer, &lf_kmsgq, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+		k_thread_create(&lf_threads[2 * i + 1], lf_stacks[2 * i + 1], LF_STACK_SIZE,
+				lf_consumer, &lf_kmsgq, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(lf_threads); i++) {
+		k_thread_join(&lf_threads[i], K_FOREVER);
+	}
+
+	zassert_equal(atomic_get(&lf_sum),
+		      LF_NUM_THREADS * (LF_NUM_MSGS * (LF_NUM_MSGS + 1) / 2),
+		      "messages lost or duplicated");
+	zassert_equal(k_msgq_num_used_get(&lf_kmsgq), 0);
+}
+
+ZTEST_SUITE(msgq_lockfree, NULL, NULL, NULL, NULL, NULL);
+
+#endif /* CONFIG_MSGQ_LOCKFREE */
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#define NUM_SEMS 32
+
+struct fifo_msg {
+	void *private;
+	uint32_t msg;
+};
+
+static struct k_poll_set set;
+static struct k_sem set_sem;
+static struct k_fifo set_fifo;
+static struct k_poll_signal set_signal;
+static struct k_sem sems[NUM_SEMS];
+static struct k_poll_event sem_events[NUM_SEMS];
+
+static void give_sem(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	k_sem_give(&set_sem);
+}
+
+static K_TIMER_DEFINE(give_timer, give_sem, NULL);
+
+/**
+ * @brief Test waiting on a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_wait(),
+ * k_poll_set_remove()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	struct k_poll_event events[3];
+	struct k_poll_event *ready[3];
+	struct fifo_msg msg = { .msg = 0xdeadbeef };
+	int rc;
+
+	k_poll_set_init(&set);
+	k_sem_init(&set_sem, 0, 1);
+	k_fifo_init(&set_fifo);
+	k_poll_signal_init(&set_signal);
+
+	k_poll_event_init(&events[0], K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+			  &set_sem);
+	k_poll_event_init(&events[1], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+	k_poll_event_init(&events[2], K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &set_signal);
+
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		zassert_ok(k_poll_set_add(&set, &events[i]));
+	}
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT), -EAGAIN);
+
+	/* Wake up on an object signaled while waiting */
+	k_timer_start(&give_timer, K_MSEC(10), K_NO_WAIT);
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_MSEC(1000));
+	zassert_equal(rc, 1, "unexpected count %d", rc);
+	zassert_equal_ptr(ready[0], &events[0]);
+	zassert_equal(events[0].state, K_POLL_STATE_SEM_AVAILABLE);
+
+	/* Level-triggered: reported again until the semaphore is taken */
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, 1);
+	zassert_equal_ptr(ready[0], &events[0]);
+	zassert_ok(k_sem_take(&set_sem, K_NO_WAIT));
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT), -EAGAIN);
+
+	/* Several events ready at once */
+	k_fifo_put(&set_fifo, &msg);
+	k_poll_signal_raise(&set_signal, 0x1337);
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, 2, "unexpected count %d", rc);
+	zassert_equal_ptr(ready[0], &events[1]);
+	zassert_equal(events[1].state, K_POLL_STATE_FIFO_DATA_AVAILABLE);
+	zassert_equal_ptr(ready[1], &events[2]);
+	zassert_equal(events[2].state, K_POLL_STATE_SIGNALED);
+
+	zassert_equal_ptr(k_fifo_get(&set_fifo, K_NO_WAIT), &msg);
+	k_poll_signal_reset(&set_signal);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT), -EAGAIN);
+
+	/* A cancelled wait is reported once */
+	k_fifo_cancel_wait(&set_fifo);
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, 1);
+	zassert_equal_ptr(ready[0], &events[1]);
+	zassert_equal(events[1].state, K_POLL_STATE_CANCELLED);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT), -EAGAIN);
+
+	/* Removed events are no longer reported */
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		zassert_ok(k_poll_set_remove(&set, &events[i]));
+	}
+	k_sem_give(&set_sem);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_MSEC(10)), -EAGAIN);
+}
+
+/**
+ * @brief Test that a wait only returns the ready events of a large set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_many)
+{
+	struct k_poll_event *ready[4];
+	int rc;
+
+	k_poll_set_init(&set);
+
+	for (int i = 0; i < NUM_SEMS; i++) {
+		k_sem_init(&sems[i], 0, 1);
+		k_poll_event_init(&sem_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &sems[i]);
+		sem_events[i].tag = i;
+		zassert_ok(k_poll_set_add(&set, &sem_events[i]));
+	}
+
+	k_sem_give(&sems[20]);
+	k_sem_give(&sems[5]);
+
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, 2, "unexpected count %d", rc);
+	zassert_equal(ready[0]->tag, 20);
+	zassert_equal(ready[1]->tag, 5);
+
+	/* Only as many events as requested are returned, round robin */
+	rc = k_poll_set_wait(&set, ready, 1, K_NO_WAIT);
+	zassert_equal(rc, 1);
+	zassert_equal(ready[0]->tag, 20);
+	rc = k_poll_set_wait(&set, ready, 1, K_NO_WAIT);
+	zassert_equal(rc, 1);
+	zassert_equal(ready[0]->tag, 5);
+
+	for (int i = 0; i < NUM_SEMS; i++) {
+		zassert_ok(k_poll_set_remove(&set, &sem_events[i]));
+	}
+}
+
+/**
+ * @brief Test that events can only be in one set or k_poll() call
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_remove()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_busy)
+{
+	struct k_poll_set other;
+	struct k_poll_event event;
+
+	k_poll_set_init(&set);
+	k_poll_set_init(&other);
+	k_sem_init(&set_sem, 0, 1);
+	k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+			  &set_sem);
+
+	zassert_equal(k_poll_set_remove(&set, &event), -EINVAL);
+	zassert_ok(k_poll_set_add(&set, &event));
+	zassert_equal(k_poll_set_add(&other, &event), -EBUSY);
+	zassert_equal(k_poll_set_remove(&other, &event), -EINVAL);
+	zassert_ok(k_poll_set_remove(&set, &event));
+	zassert_ok(k_poll_set_add(&other, &event));
+	zassert_ok(k_poll_set_remove(&other, &event));
+}
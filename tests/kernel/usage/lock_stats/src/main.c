@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/ztest.h>
+
+#define HELPER_STACK_SIZE 1024
+/* Above the test thread, so that it runs as soon as it is started */
+#define HELPER_PRIO       (CONFIG_ZTEST_THREAD_PRIORITY - 1)
+#define ITERATIONS        10
+
+static struct k_thread helper_thread;
+static K_THREAD_STACK_DEFINE(helper_stack, HELPER_STACK_SIZE);
+
+static struct k_spinlock test_lock;
+static struct k_spinlock early_lock;
+static K_MUTEX_DEFINE(test_mutex);
+static K_SEM_DEFINE(held_sem, 0, 1);
+
+/* Number of entries of a lock, and their statistics summed up */
+static int lock_stats_sum(const void *lock, struct k_lock_stats *total)
+{
+	struct k_lock_stats stats;
+	int sites = 0;
+
+	memset(total, 0, sizeof(*total));
+
+	for (size_t i = 0; k_lock_stats_get(i, &stats) == 0; i++) {
+		if (stats.lock != lock) {
+			continue;
+		}
+
+		zassert_not_equal(stats.site, 0, "no call site");
+		total->type = stats.type;
+		total->acquisitions += stats.acquisitions;
+		total->contended += stats.contended;
+		total->wait_total += stats.wait_total;
+		total->wait_max = MAX(total->wait_max, stats.wait_max);
+		total->hold_total += stats.hold_total;
+		total->hold_max = MAX(total->hold_max, stats.hold_max);
+		sites++;
+	}
+
+	return sites;
+}
+
+static void lock_stats_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_lock_stats_reset();
+}
+
+ZTEST(lock_stats, test_spinlock)
+{
+	struct k_lock_stats total;
+	k_spinlock_key_t key;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		key = k_spin_lock(&test_lock);
+		k_spin_unlock(&test_lock, key);
+	}
+
+	zassert_equal(lock_stats_sum(&test_lock, &total), 1, "one call site expected");
+	zassert_equal(total.type, K_LOCK_STATS_SPINLOCK);
+	zassert_equal(total.acquisitions, ITERATIONS, "%u acquisitions", total.acquisitions);
+	zassert_true(total.hold_max <= total.hold_total);
+
+	/* Another call site */
+	zassert_ok(k_spin_trylock(&test_lock, &key));
+	k_spin_unlock(&test_lock, key);
+
+	zassert_equal(lock_stats_sum(&test_lock, &total), 2, "two call sites expected");
+	zassert_equal(total.acquisitions, ITERATIONS + 1);
+}
+
+static void mutex_helper(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&test_mutex, K_FOREVER);
+	k_mutex_unlock(&test_mutex);
+}
+
+ZTEST(lock_stats, test_mutex_contended)
+{
+	struct k_lock_stats total;
+
+	k_mutex_lock(&test_mutex, K_FOREVER);
+
+	/* Blocks on the mutex right away */
+	k_thread_create(&helper_thread, helper_stack, K_THREAD_STACK_SIZEOF(helper_stack),
+			mutex_helper, NULL, NULL, NULL, HELPER_PRIO, 0, K_NO_WAIT);
+
+	k_msleep(10);
+	k_mutex_unlock(&test_mutex);
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	zassert_equal(lock_stats_sum(&test_mutex, &total), 2, "two call sites expected");
+	zassert_equal(total.type, K_LOCK_STATS_MUTEX);
+	zassert_equal(total.acquisitions, 2, "%u acquisitions", total.acquisitions);
+	zassert_equal(total.contended, 1, "%u contended", total.contended);
+	zassert_true(total.wait_max > 0, "no wait");
+	zassert_true(total.hold_max >= k_ms_to_cyc_floor32(10), "held %u cycles",
+		     total.hold_max);
+}
+
+ZTEST(lock_stats, test_mutex_recursive)
+{
+	struct k_lock_stats total;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		k_mutex_lock(&test_mutex, K_FOREVER);
+	}
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		k_mutex_unlock(&test_mutex);
+	}
+
+	/* Failed attempts are not counted */
+	zassert_equal(k_mutex_unlock(&test_mutex), -EINVAL);
+
+	zassert_equal(lock_stats_sum(&test_mutex, &total), 1, "one call site expected");
+	zassert_equal(total.acquisitions, 1, "%u acquisitions", total.acquisitions);
+	zassert_equal(total.contended, 0);
+}
+
+static void spinlock_helper(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_spinlock_key_t key = k_spin_lock(&test_lock);
+
+	k_sem_give(&held_sem);
+	k_busy_wait(10000);
+	k_spin_unlock(&test_lock, key);
+}
+
+ZTEST(lock_stats, test_spinlock_contended)
+{
+	struct k_lock_stats total;
+	k_spinlock_key_t key;
+
+	if (!IS_ENABLED(CONFIG_SMP) || arch_num_cpus() < 2) {
+		ztest_test_skip();
+	}
+
+	/* Below the test thread, so that it runs on another CPU */
+	k_thread_create(&helper_thread, helper_stack, K_THREAD_STACK_SIZEOF(helper_stack),
+			spinlock_helper, NULL, NULL, NULL, CONFIG_ZTEST_THREAD_PRIORITY + 1, 0,
+			K_NO_WAIT);
+
+	/* Spins while the helper holds the spinlock */
+	k_sem_take(&held_sem, K_FOREVER);
+	key = k_spin_lock(&test_lock);
+	k_spin_unlock(&test_lock, key);
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	zassert_equal(lock_stats_sum(&test_lock, &total), 2, "two call sites expected");
+	zassert_equal(total.acquisitions, 2, "%u acquisitions", total.acquisitions);
+	zassert_equal(total.contended, 1, "%u contended", total.contended);
+	zassert_true(total.wait_max > 0, "no wait");
+}
+
+ZTEST(lock_stats, test_get_and_reset)
+{
+	struct k_lock_stats stats;
+	k_spinlock_key_t key;
+
+	zassert_equal(k_lock_stats_get(CONFIG_LOCK_STATS_ENTRIES, &stats), -ENOENT);
+
+	key = k_spin_lock(&test_lock);
+	k_spin_unlock(&test_lock, key);
+	zassert_equal(lock_stats_sum(&test_lock, &stats), 1);
+
+	k_lock_stats_reset();
+	zassert_equal(lock_stats_sum(&test_lock, &stats), 0);
+	zassert_equal(k_lock_stats_dropped(), 0);
+}
+
+/* Taken before the system timer is initialized, so not tracked */
+static int early_lock_take(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&early_lock);
+
+	k_spin_unlock(&early_lock, key);
+
+	return 0;
+}
+
+SYS_INIT(early_lock_take, PRE_KERNEL_1, 0);
+
+/* Entries of the early lock, counted before the first reset */
+static int early_lock_sites;
+
+static void *lock_stats_setup(void)
+{
+	struct k_lock_stats total;
+
+	early_lock_sites = lock_stats_sum(&early_lock, &total);
+
+	return NULL;
+}
+
+ZTEST(lock_stats, test_early_lock)
+{
+	zassert_equal(early_lock_sites, 0, "lock taken at PRE_KERNEL_1 tracked");
+}
+
+ZTEST_SUITE(lock_stats, NULL, lock_stats_setup, lock_stats_before, NULL, NULL);
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/irq_offload.h>
+
+#define HELPER_STACK_SIZE 1024
+/* Above the test thread, so that it blocks before each wakeup */
+#define HELPER_PRIO       (CONFIG_ZTEST_THREAD_PRIORITY - 1)
+#define ITERATIONS        10
+
+static struct k_thread helper_thread;
+static K_THREAD_STACK_DEFINE(helper_stack, HELPER_STACK_SIZE);
+static K_SEM_DEFINE(helper_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static void helper(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&helper_sem, K_FOREVER);
+		k_sem_give(&done_sem);
+	}
+}
+
+static void give_from_isr(const void *arg)
+{
+	ARG_UNUSED(arg);
+
+	k_sem_give(&helper_sem);
+}
+
+static uint32_t bucket_sum(const struct k_sched_latency_histogram *histogram)
+{
+	uint32_t sum = 0;
+
+	for (int i = 0; i < CONFIG_SCHED_LATENCY_STATS_BUCKETS; i++) {
+		sum += histogram->buckets[i];
+	}
+
+	return sum;
+}
+
+static void *sched_latency_setup(void)
+{
+	k_thread_create(&helper_thread, helper_stack, K_THREAD_STACK_SIZEOF(helper_stack),
+			helper, NULL, NULL, NULL, HELPER_PRIO, 0, K_NO_WAIT);
+
+	return NULL;
+}
+
+static void sched_latency_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Let the helper block on its semaphore */
+	k_sleep(K_MSEC(10));
+	k_sched_latency_stats_reset();
+}
+
+/**
+ * @brief Test the wakeups by a thread and by an ISR are counted apart
+ */
+ZTEST(sched_latency, test_wakeup_and_isr)
+{
+	struct k_sched_latency_stats stats;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		k_sem_give(&helper_sem);
+		zassert_ok(k_sem_take(&done_sem, K_MSEC(100)));
+	}
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		irq_offload(give_from_isr, NULL);
+		zassert_ok(k_sem_take(&done_sem, K_MSEC(100)));
+	}
+
+	zassert_ok(k_sched_latency_stats_get(HELPER_PRIO, &stats));
+	zassert_equal(stats.prio, HELPER_PRIO);
+	zassert_equal(stats.wakeup.count, ITERATIONS);
+	zassert_equal(stats.isr.count, ITERATIONS);
+	zassert_equal(bucket_sum(&stats.wakeup), ITERATIONS);
+	zassert_equal(bucket_sum(&stats.isr), ITERATIONS);
+	zassert_true(stats.wakeup.sum <= (uint64_t)stats.wakeup.max * ITERATIONS);
+
+	k_sched_latency_stats_reset();
+
+	zassert_ok(k_sched_latency_stats_get(HELPER_PRIO, &stats));
+	zassert_equal(stats.wakeup.count, 0);
+	zassert_equal(stats.isr.count, 0);
+	zassert_equal(bucket_sum(&stats.wakeup), 0);
+}
+
+/**
+ * @brief Test the invalid priority levels are rejected
+ */
+ZTEST(sched_latency, test_invalid_prio)
+{
+	struct k_sched_latency_stats stats;
+
+	zassert_equal(k_sched_latency_stats_get(K_HIGHEST_THREAD_PRIO - 1, &stats), -EINVAL);
+	zassert_equal(k_sched_latency_stats_get(K_LOWEST_THREAD_PRIO + 1, &stats), -EINVAL);
+	zassert_ok(k_sched_latency_stats_get(K_LOWEST_THREAD_PRIO, &stats));
+}
+
+static int find_level(struct k_obj_core *obj_core, void *data)
+{
+	struct k_sched_latency_stats stats;
+
+	zassert_ok(k_obj_core_stats_query(obj_core, &stats, sizeof(stats)));
+
+	if (stats.prio == HELPER_PRIO) {
+		*(struct k_obj_core **)data = obj_core;
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Test the histograms are available through the object core statistics
+ */
+ZTEST(sched_latency, test_obj_core_stats)
+{
+	struct k_sched_latency_stats stats;
+	struct k_obj_core *obj_core = NULL;
+	struct k_obj_type *type;
+
+	type = k_obj_type_find(K_OBJ_TYPE_SCHED_LATENCY_ID);
+	zassert_not_null(type);
+	zassert_equal(k_obj_type_walk_unlocked(type, find_level, &obj_core), 1);
+	zassert_not_null(obj_core);
+
+	k_sem_give(&helper_sem);
+	zassert_ok(k_sem_take(&done_sem, K_MSEC(100)));
+
+	zassert_ok(k_obj_core_stats_raw(obj_core, &stats, sizeof(stats)));
+	zassert_equal(stats.wakeup.count, 1);
+
+	zassert_ok(k_obj_core_stats_reset(obj_core));
+	zassert_ok(k_obj_core_stats_query(obj_core, &stats, sizeof(stats)));
+	zassert_equal(stats.wakeup.count, 0);
+}
+
+ZTEST_SUITE(sched_latency, NULL, sched_latency_setup, sched_latency_before, NULL, NULL);
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define NUM_WORKERS 3
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKER_PRIORITY K_PRIO_PREEMPT(1)
+#define NUM_ITEMS 16
+
+#define DELAY_MS 50
+#define DELAY_TIMEOUT K_MSEC(DELAY_MS)
+
+K_WORK_Q_POOL_DEFINE(work_pool, NUM_WORKERS, STACK_SIZE);
+
+static struct k_work_q *pool_q;
+
+static struct k_work items[NUM_ITEMS];
+static atomic_t item_runs[NUM_ITEMS];
+
+static struct k_work slow_work;
+static struct k_work fast_work;
+static struct k_work_delayable dwork;
+static struct k_work_sync work_sync;
+
+static struct k_sem sync_sem;
+static struct k_sem rel_sem;
+
+/* Number of concurrent executions of the reentrancy item */
+static atomic_t active;
+static atomic_t max_active;
+static atomic_t reentry_runs;
+
+static void count_handler(struct k_work *work)
+{
+	atomic_inc(&item_runs[work - items]);
+	k_sem_give(&sync_sem);
+}
+
+/* Blocks until released, so that it keeps its worker busy */
+static void slow_handler(struct k_work *work)
+{
+	k_sem_take(&rel_sem, K_FOREVER);
+	k_sem_give(&sync_sem);
+}
+
+static void fast_handler(struct k_work *work)
+{
+	k_sem_give(&sync_sem);
+}
+
+static void reentry_handler(struct k_work *work)
+{
+	atomic_val_t now = atomic_inc(&active) + 1;
+
+	if (now > atomic_get(&max_active)) {
+		atomic_set(&max_active, now);
+	}
+
+	/* Resubmit while running: must not be picked up by another worker */
+	if (atomic_inc(&reentry_runs) < 3) {
+		zassert_equal(k_work_submit_to_queue(pool_q, work), 2);
+	}
+
+	k_msleep(1);
+	atomic_dec(&active);
+	k_sem_give(&sync_sem);
+}
+
+/* Queues fast_work behind itself on the same worker and waits for it:
+ * this only completes if another worker steals fast_work.
+ */
+static void chain_handler(struct k_work *work)
+{
+	zassert_equal(k_work_submit_to_queue(pool_q, &fast_work), 1);
+	zassert_equal(k_sem_take(&sync_sem, K_MSEC(1000)), 0,
+		      "chained work not stolen");
+	k_sem_give(&rel_sem);
+}
+
+static void *work_pool_setup(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "work_pool",
+		.pin_workers = IS_ENABLED(CONFIG_SCHED_CPU_MASK),
+	};
+
+	pool_q = k_work_q_pool_queue(&work_pool);
+	k_work_q_pool_start(&work_pool, WORKER_PRIORITY, &cfg);
+
+	return NULL;
+}
+
+static void work_pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_init(&sync_sem, 0, K_SEM_MAX_LIMIT);
+	k_sem_init(&rel_sem, 0, K_SEM_MAX_LIMIT);
+}
+
+static void work_pool_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Release anything still blocked and let the pool settle */
+	k_sem_give(&rel_sem);
+	(void)k_work_queue_drain(pool_q, false);
+}
+
+/* Every submitted item runs exactly once */
+ZTEST(work_pool, test_submit)
+{
+	unsigned int i;
+
+	for (i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], count_handler);
+		atomic_clear(&item_runs[i]);
+		zassert_equal(k_work_submit_to_queue(pool_q, &items[i]), 1);
+	}
+
+	for (i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal(k_sem_take(&sync_sem, K_MSEC(1000)), 0);
+	}
+
+	/* Handlers may still be returning */
+	zassert_true(k_work_queue_drain(pool_q, false) >= 0);
+
+	for (i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal(atomic_get(&item_runs[i]), 1, "item %u", i);
+		zassert_equal(k_work_busy_get(&items[i]), 0);
+	}
+}
+
+/* A blocked item does not delay items submitted after it */
+ZTEST(work_pool, test_concurrency)
+{
+	k_work_init(&slow_work, slow_handler);
+	k_work_init(&fast_work, fast_handler);
+
+	zassert_equal(k_work_submit_to_queue(pool_q, &slow_work), 1);
+	zassert_equal(k_work_submit_to_queue(pool_q, &fast_work), 1);
+
+	zassert_equal(k_sem_take(&sync_sem, K_MSEC(1000)), 0);
+	zassert_equal(k_work_busy_get(&slow_work), K_WORK_RUNNING);
+
+	k_sem_give(&rel_sem);
+	zassert_equal(k_sem_take(&sync_sem, K_MSEC(1000)), 0);
+	(void)k_work_flush(&slow_work, &work_sync);
+	zassert_equal(k_work_busy_get(&slow_work), 0);
+}
+
+/* Idle workers steal work queued to a busy worker */
+ZTEST(work_pool, test_steal)
+{
+	static struct k_work chain_work;
+
+	k_work_init(&chain_work, chain_handler);
+	k_work_init(&fast_work, fast_handler);
+
+	zassert_equal(k_work_submit_to_queue(pool_q, &chain_work), 1);
+	zassert_equal(k_sem_take(&rel_sem, K_MSEC(2000)), 0);
+}
+
+/* A work item resubmitted while running never runs concurrently */
+ZTEST(work_pool, test_no_reentry)
+{
+	static struct k_work reentry_work;
+
+	k_work_init(&reentry_work, reentry_handler);
+	atomic_clear(&active);
+	atomic_clear(&max_active);
+	atomic_clear(&reentry_runs);
+
+	zassert_equal(k_work_submit_to_queue(pool_q, &reentry_work), 1);
+
+	for (int i = 0; i < 4; i++) {
+		zassert_equal(k_sem_take(&sync_sem, K_MSEC(1000)), 0);
+	}
+
+	(void)k_work_flush(&reentry_work, &work_sync);
+	zassert_equal(k_work_busy_get(&reentry_work), 0);
+	zassert_equal(atomic_get(&reentry_runs), 4);
+	zassert_equal(atomic_get(&max_active), 1);
+}
+
+/* Flushing waits for a running item to complete */
+ZTEST(work_pool, test_flush)
+{
+	k_work_init(&slow_work, slow_handler);
+
+	zassert_equal(k_work_submit_to_queue(pool_q, &slow_work), 1);
+	k_msleep(DELAY_MS);
+	zassert_equal(k_work_busy_get(&slow_work), K_WORK_RUNNING);
+
+	k_sem_give(&rel_sem);
+	(void)k_work_flush(&slow_work, &work_sync);
+	zassert_equal(k_work_busy_get(&slow_work), 0);
+	zassert_equal(k_sem_take(&sync_sem, K_NO_WAIT), 0, "flush did not wait");
+}
+
+/* Cancelling a queued item removes it from the worker holding it */
+ZTEST(work_pool, test_cancel)
+{
+	unsigned int i;
+
+	/* Keep every worker busy so that the item stays queued */
+	for (i = 0; i < NUM_WORKERS; i++) {
+		k_work_init(&items[i], slow_handler);
+		zassert_equal(k_work_submit_to_queue(pool_q, &items[i]), 1);
+	}
+	k_msleep(DELAY_MS);
+
+	k_work_init(&fast_work, fast_handler);
+	zassert_equal(k_work_submit_to_queue(pool_q, &fast_work), 1);
+	zassert_equal(k_work_busy_get(&fast_work), K_WORK_QUEUED);
+	zassert_equal(k_work_cancel(&fast_work), 0);
+
+	for (i = 0; i < NUM_WORKERS; i++) {
+		k_sem_give(&rel_sem);
+	}
+	for (i = 0; i < NUM_WORKERS; i++) {
+		zassert_equal(k_sem_take(&sync_sem, K_MSEC(1000)), 0);
+	}
+
+	zassert_true(k_work_queue_drain(pool_q, false) >= 0);
+	zassert_equal(k_sem_take(&sync_sem, K_NO_WAIT), -EBUSY,
+		      "cancelled work ran");
+}
+
+/* Delayable work scheduled to a pool runs on it */
+ZTEST(work_pool, test_delayable)
+{
+	k_work_init_delayable(&dwork, fast_handler);
+
+	zassert_equal(k_work_schedule_for_queue(pool_q, &dwork, DELAY_TIMEOUT), 1);
+	zassert_equal(k_sem_take(&sync_sem, K_MSEC(1000)), 0);
+	(void)k_work_flush_delayable(&dwork, &work_sync);
+	zassert_equal(k_work_delayable_busy_get(&dwork), 0);
+}
+
+/* Draining waits for every worker, plugging rejects new work */
+ZTEST(work_pool, test_drain_plug)
+{
+	k_work_init(&slow_work, slow_handler);
+	k_work_init(&fast_work, fast_handler);
+
+	zassert_equal(k_work_submit_to_queue(pool_q, &slow_work), 1);
+	k_msleep(DELAY_MS);
+
+	k_sem_give(&rel_sem);
+	zassert_true(k_work_queue_drain(pool_q, true) >= 0);
+	zassert_equal(k_work_busy_get(&slow_work), 0);
+
+	zassert_equal(k_work_submit_to_queue(pool_q, &fast_work), -EBUSY);
+	zassert_equal(k_work_queue_unplug(pool_q), 0);
+	zassert_equal(k_work_submit_to_queue(pool_q, &fast_work), 1);
+	zassert_equal(k_sem_take(&sync_sem, K_MSEC(1000)), 0);
+	zassert_equal(k_sem_take(&sync_sem, K_MSEC(1000)), 0);
+}
+
+/* Stopping a pool stops all its workers, it can then be restarted */
+ZTEST(work_pool, test_stop)
+{
+	k_work_init(&fast_work, fast_handler);
+
+	zassert_equal(k_work_queue_stop(pool_q, K_FOREVER), -EBUSY);
+	zassert_equal(k_work_queue_drain(pool_q, true), 1);
+	zassert_equal(k_work_queue_stop(pool_q, K_MSEC(1000)), 0);
+	zassert_equal(k_work_queue_stop(pool_q, K_FOREVER), -EALREADY);
+	zassert_equal(k_work_submit_to_queue(pool_q, &fast_work), -ENODEV);
+
+	(void)work_pool_setup();
+
+	zassert_equal(k_work_submit_to_queue(pool_q, &fast_work), 1);
+	zassert_equal(k_sem_take(&sync_sem, K_MSEC(1000)), 0);
+}
+
+ZTEST_SUITE(work_pool, NULL, work_pool_setup, work_pool_before, work_pool_after, NULL);
@@ -387,6 +387,77 @@ ZTEST(lib_heap, test_realloc)
 		     "Realloc should have moved %p", p2);
 }
 
+/* Freed small blocks are reused as is, and merged back into the heap
+ * once one of their neighbors is freed.
+ */
+ZTEST(lib_heap, test_size_classes)
+{
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	struct sys_heap heap;
+	void *blocks[SMALL_HEAP_SZ / 16];
+	uint32_t cached;
+	void *big;
+	int n;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	blocks[0] = sys_heap_alloc(&heap, 16);
+	blocks[1] = sys_heap_alloc(&heap, 16);
+	blocks[2] = sys_heap_alloc(&heap, 16);
+	zassert_not_null(blocks[2]);
+	sys_heap_free(&heap, blocks[1]);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	/* Same size class: the block is handed back */
+	zassert_equal(sys_heap_alloc(&heap, 12), blocks[1]);
+	for (n = 0; n < 3; n++) {
+		sys_heap_free(&heap, blocks[n]);
+	}
+
+	/* Fill the heap with small blocks, then free every other one */
+	for (n = 0; n < ARRAY_SIZE(blocks); n++) {
+		blocks[n] = sys_heap_alloc(&heap, 16);
+		if (blocks[n] == NULL) {
+			break;
+		}
+	}
+	zassert_true(n > 2);
+	for (int i = 1; i < n - 1; i += 2) {
+		sys_heap_free(&heap, blocks[i]);
+	}
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	cached = 0;
+	for (int i = 0; i < ARRAY_SIZE(heap.size_classes); i++) {
+		cached |= heap.size_classes[i];
+	}
+	zassert_not_equal(cached, 0, "no block cached");
+
+	/* Another size may need the cached blocks to be merged back */
+	big = sys_heap_alloc(&heap, 8);
+	zassert_not_null(big, "cached blocks not merged back");
+	sys_heap_free(&heap, big);
+
+	/* Freeing their neighbors merges the cached blocks back */
+	for (int i = 0; i < n; i += 2) {
+		sys_heap_free(&heap, blocks[i]);
+	}
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	for (int i = 0; i < ARRAY_SIZE(heap.size_classes); i++) {
+		zassert_equal(heap.size_classes[i], 0, "cached blocks left");
+	}
+	if (n % 2 == 0) {
+		sys_heap_free(&heap, blocks[n - 1]);
+	}
+
+	big = sys_heap_alloc(&heap, SMALL_HEAP_SZ / 2);
+	zassert_not_null(big, "cached blocks not merged back");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	sys_heap_free(&heap, big);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_SIZE_CLASSES */
+}
+
 #ifdef CONFIG_SYS_HEAP_LISTENER
 static struct sys_heap listener_heap;
 static uintptr_t listener_heap_id;
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <stdlib.h>
+
+#ifdef CONFIG_COMMON_LIBC_MALLOC_THREAD_CACHE
+
+#define BLOCK_SIZE  64
+#define MAX_BLOCKS  256
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(child_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(reclaim_stack, STACK_SIZE);
+static struct k_thread child_thread;
+static struct k_thread reclaim_thread;
+
+static void *blocks[MAX_BLOCKS];
+
+static void run_child(k_thread_entry_t entry, void *p1)
+{
+	k_thread_create(&child_thread, child_stack, STACK_SIZE, entry, p1, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_ok(k_thread_join(&child_thread, K_FOREVER));
+}
+
+/* Allocate as many blocks as possible, then free them all */
+static int count_blocks(size_t size)
+{
+	int count = 0;
+
+	while (count < MAX_BLOCKS) {
+		blocks[count] = malloc(size);
+		if (blocks[count] == NULL) {
+			break;
+		}
+		count++;
+	}
+
+	zassert_true(count < MAX_BLOCKS, "arena larger than expected");
+
+	for (int i = 0; i < count; i++) {
+		free(blocks[i]);
+	}
+
+	return count;
+}
+
+static void alloc_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	*(void **)p1 = malloc(BLOCK_SIZE);
+}
+
+static void alloc_free_entry(void *p1, void *p2, void *p3)
+{
+	void *mem[8];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < ARRAY_SIZE(mem); i++) {
+		mem[i] = malloc(BLOCK_SIZE);
+	}
+	for (int i = 0; i < ARRAY_SIZE(mem); i++) {
+		free(mem[i]);
+	}
+}
+
+/**
+ * @brief Test that a block freed by a thread is reused by its next malloc()
+ */
+ZTEST(c_lib_malloc_thread_cache, test_reuse)
+{
+	void *p = malloc(BLOCK_SIZE);
+	void *q;
+
+	zassert_not_null(p);
+	free(p);
+
+	q = malloc(BLOCK_SIZE);
+	zassert_equal(p, q, "freed block not reused");
+	free(q);
+}
+
+/**
+ * @brief Test that a block allocated by another thread is cached by the
+ * thread freeing it
+ */
+ZTEST(c_lib_malloc_thread_cache, test_remote_free)
+{
+	void *p = NULL;
+	void *q;
+
+	run_child(alloc_entry, &p);
+	zassert_not_null(p);
+	free(p);
+
+	q = malloc(BLOCK_SIZE);
+	zassert_equal(p, q, "remotely allocated block not reused");
+	free(q);
+}
+
+static void reclaim_entry(void *p1, void *p2, void *p3)
+{
+	int before;
+	int after;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Make sure this thread's own cache is allocated before counting */
+	free(malloc(BLOCK_SIZE));
+
+	before = count_blocks(BLOCK_SIZE);
+	zassert_true(before > 8, "arena too small");
+
+	run_child(alloc_free_entry, NULL);
+
+	after = count_blocks(BLOCK_SIZE);
+	zassert_equal(before, after, "%d blocks lost", before - after);
+
+	/* Small blocks exceed the cache budget and are freed in batches */
+	before = count_blocks(8);
+	after = count_blocks(8);
+	zassert_equal(before, after, "%d small blocks lost", before - after);
+}
+
+/**
+ * @brief Test that no memory is lost in the caches
+ *
+ * Blocks cached by a thread that exited, and blocks beyond the cache
+ * budget, must all be available to a thread exhausting the arena.
+ */
+ZTEST(c_lib_malloc_thread_cache, test_reclaim)
+{
+	/*
+	 * Exhaust the arena from a thread of its own: the blocks it leaves
+	 * in its cache are only returned to the heap once it exited.
+	 */
+	k_thread_create(&reclaim_thread, reclaim_stack, STACK_SIZE, reclaim_entry, NULL, NULL,
+			NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_ok(k_thread_join(&reclaim_thread, K_FOREVER));
+}
+
+ZTEST_SUITE(c_lib_malloc_thread_cache, NULL, NULL, NULL, NULL, NULL);
+
+#endif /* CONFIG_COMMON_LIBC_MALLOC_THREAD_CACHE */
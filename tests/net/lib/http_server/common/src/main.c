@@ -85,6 +85,15 @@ static uint16_t service_E_port = 8080;
 HTTP_SERVICE_DEFINE(service_E, "192.0.2.1", &service_E_port, 1, 1, NULL, DETAIL(0), NULL);
 HTTP_RESOURCE_DEFINE(resource_10, service_E, "/index.html", RES(4));
 
+/* Resources sharing literal prefixes, to exercise the resource lookup trie */
+static uint16_t service_F_port = 8081;
+HTTP_SERVICE_DEFINE(service_F, "192.0.2.2", &service_F_port, 1, 1, NULL, NULL, NULL);
+HTTP_RESOURCE_DEFINE(resource_13, service_F, "/api/v*/items", RES(5));
+HTTP_RESOURCE_DEFINE(resource_14, service_F, "/api/v1/status", RES(0));
+HTTP_RESOURCE_DEFINE(resource_15, service_F, "/api/v1/stat", RES(1));
+HTTP_RESOURCE_DEFINE(resource_16, service_F, "/api/v2", RES(3));
+HTTP_RESOURCE_DEFINE(resource_17, service_F, "/api", RES(4));
+
 ZTEST(http_service, test_HTTP_SERVICE_DEFINE)
 {
 	zassert_ok(strcmp(service_A.host, "a.service.com"));
@@ -117,7 +126,7 @@ ZTEST(http_service, test_HTTP_SERVICE_COUNT)
 
 	n_svc = 4273;
 	HTTP_SERVICE_COUNT(&n_svc);
-	zassert_equal(n_svc, 5);
+	zassert_equal(n_svc, 6);
 }
 
 ZTEST(http_service, test_HTTP_SERVICE_RESOURCE_COUNT)
@@ -135,6 +144,7 @@ ZTEST(http_service, test_HTTP_SERVICE_FOREACH)
 	size_t have_service_C = 0;
 	size_t have_service_D = 0;
 	size_t have_service_E = 0;
+	size_t have_service_F = 0;
 
 	HTTP_SERVICE_FOREACH(svc) {
 		if (svc == &service_A) {
@@ -147,6 +157,8 @@ ZTEST(http_service, test_HTTP_SERVICE_FOREACH)
 			have_service_D = 1;
 		} else if (svc == &service_E) {
 			have_service_E = 1;
+		} else if (svc == &service_F) {
+			have_service_F = 1;
 		} else {
 			zassert_unreachable("svc (%p) not equal to any defined service", svc);
 		}
@@ -154,12 +166,13 @@ ZTEST(http_service, test_HTTP_SERVICE_FOREACH)
 		n_svc++;
 	}
 
-	zassert_equal(n_svc, 5);
+	zassert_equal(n_svc, 6);
 	zassert_equal(have_service_A, 1);
 	zassert_equal(have_service_B, 1);
 	zassert_equal(have_service_C, 1);
 	zassert_equal(have_service_D, 1);
 	zassert_equal(have_service_E, 1);
+	zassert_equal(have_service_F, 1);
 }
 
 ZTEST(http_service, test_HTTP_RESOURCE_FOREACH)
@@ -396,6 +409,42 @@ ZTEST(http_service, test_HTTP_RESOURCE_WILDCARD)
 	zassert_equal(res, RES(3), "Resource mismatch");
 }
 
+ZTEST(http_service, test_HTTP_RESOURCE_PREFIX)
+{
+	struct http_resource_detail *res;
+	int len;
+
+	res = CHECK_PATH(service_F, "/api/v1/status", &len);
+	zassert_equal(res, RES(0), "Resource mismatch");
+	zassert_equal(len, strlen("/api/v1/status"), "Length incorrect");
+
+	res = CHECK_PATH(service_F, "/api/v1/stat?x=1", &len);
+	zassert_equal(res, RES(1), "Resource mismatch");
+	zassert_equal(len, strlen("/api/v1/stat"), "Length incorrect");
+
+	/* The resource defined first wins when several match */
+	res = CHECK_PATH(service_F, "/api/v1/items", &len);
+	zassert_equal(res, RES(5), "Resource mismatch");
+
+	res = CHECK_PATH(service_F, "/api/v2/items", &len);
+	zassert_equal(res, RES(5), "Resource mismatch");
+
+	res = CHECK_PATH(service_F, "/api/v2", &len);
+	zassert_equal(res, RES(3), "Resource mismatch");
+
+	res = CHECK_PATH(service_F, "/api?x=1", &len);
+	zassert_equal(res, RES(4), "Resource mismatch");
+	zassert_equal(len, strlen("/api"), "Length incorrect");
+
+	res = CHECK_PATH(service_F, "/apix", &len);
+	zassert_is_null(res, "Resource found");
+	zassert_equal(len, 0, "Length set");
+
+	res = CHECK_PATH(service_F, "/ap", &len);
+	zassert_is_null(res, "Resource found");
+	zassert_equal(len, 0, "Length set");
+}
+
 ZTEST(http_service, test_HTTP_RESOURCE_DEFAULT)
 {
 #define NON_EXISTING_PATH "/this_path_is_not_registered"
@@ -17,8 +17,23 @@ PROMETHEUS_COUNTER_DEFINE(test_counter, "Test counter",
 PROMETHEUS_COUNTER_DEFINE(test_counter2, "Test counter 2",
 			  ({ .key = "test", .value = "counter" }), NULL);
 
+PROMETHEUS_COUNTER_DEFINE(test_counter_kept, "Test counter kept",
+			  ({ .key = "test", .value = "counter" }), NULL);
+PROMETHEUS_COUNTER_DEFINE(test_counter_skipped, "Test counter skipped",
+			  ({ .key = "test", .value = "counter" }), NULL);
+
 PROMETHEUS_COLLECTOR_DEFINE(test_custom_collector);
 
+static int skip_metric_cb(struct prometheus_collector *collector,
+			  struct prometheus_metric *metric, void *user_data)
+{
+	ARG_UNUSED(collector);
+
+	return metric == user_data ? -EAGAIN : 0;
+}
+
+PROMETHEUS_COLLECTOR_DEFINE(test_skip_collector, skip_metric_cb, &test_counter_skipped.base);
+
 /**
  * @brief Test Prometheus formatter
  * @details The test shall increment the counter value by 1 and check if the
@@ -63,4 +78,29 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 		      exposed, formatted);
 }
 
+/**
+ * @brief Test Prometheus formatter with a skipped metric
+ * @details The collector callback skips the last metric of the collector.
+ * The formatter shall leave it out and still succeed.
+ */
+ZTEST(test_formatter, test_prometheus_formatter_skip_last)
+{
+	int ret;
+	char formatted[MAX_BUFFER_SIZE] = { 0 };
+	char exposed[] = "# HELP test_counter_kept Test counter kept\n"
+			 "# TYPE test_counter_kept counter\n"
+			 "test_counter_kept{test=\"counter\"} 0\n";
+
+	/* Metrics are prepended, so the skipped one comes last */
+	prometheus_collector_register_metric(&test_skip_collector, &test_counter_skipped.base);
+	prometheus_collector_register_metric(&test_skip_collector, &test_counter_kept.base);
+
+	ret = prometheus_format_exposition(&test_skip_collector, formatted, sizeof(formatted));
+	zassert_ok(ret, "Error formatting exposition data");
+
+	zassert_equal(strcmp(formatted, exposed), 0,
+		      "Exposition format is not as expected (expected\n\"%s\", got\n\"%s\")",
+		      exposed, formatted);
+}
+
 ZTEST_SUITE(test_formatter, NULL, NULL, NULL, NULL, NULL);
@@ -1291,4 +1291,65 @@ ZTEST(net_pkt_test_suite, test_net_pkt_shallow_clone_append_buf_2)
 	test_net_pkt_shallow_clone_append_buf(2);
 }
 
+/* Plain 16-bit big endian ones' complement sum */
+static uint16_t chksum_ref(uint16_t sum, const uint8_t *data, size_t len)
+{
+	uint32_t total = sum;
+
+	for (size_t i = 0; i < len; i++) {
+		total += (i % 2) ? data[i] : data[i] << 8;
+	}
+
+	while (total >> 16) {
+		total = (total & 0xffff) + (total >> 16);
+	}
+
+	return total;
+}
+
+#define CHKSUM_TEST_PKT_DATA_SIZE 600
+
+ZTEST(net_pkt_test_suite, test_net_pkt_rw_chksum)
+{
+	uint8_t data[CHKSUM_TEST_PKT_DATA_SIZE];
+	uint8_t read_data[CHKSUM_TEST_PKT_DATA_SIZE];
+	uint16_t expected;
+	struct net_pkt *pkt;
+	uint16_t sum;
+	int ret;
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	expected = chksum_ref(0x1234, data, sizeof(data));
+
+	pkt = net_pkt_alloc_with_buffer(eth_if, sizeof(data) + 1, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_true(pkt != NULL, "Pkt not allocated");
+	zassert_not_null(pkt->buffer->frags, "Test needs more than one buffer");
+
+	/* Start at an odd offset so that a buffer boundary splits a word */
+	ret = net_pkt_write_u8(pkt, 0xaa);
+	zassert_equal(ret, 0, "Write failed");
+
+	sum = 0x1234;
+	ret = net_pkt_write_chksum(pkt, data, 100, &sum);
+	zassert_equal(ret, 0, "Write failed");
+	ret = net_pkt_write_chksum(pkt, data + 100, sizeof(data) - 100, &sum);
+	zassert_equal(ret, 0, "Write failed");
+	zassert_equal(sum, expected, "Wrong checksum of written data");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_skip(pkt, 1);
+
+	sum = 0x1234;
+	ret = net_pkt_read_chksum(pkt, read_data, sizeof(read_data), &sum);
+	zassert_equal(ret, 0, "Read failed");
+	zassert_equal(sum, expected, "Wrong checksum of read data");
+	zassert_mem_equal(read_data, data, sizeof(data), "Data differs");
+
+	net_pkt_unref(pkt);
+}
+
 ZTEST_SUITE(net_pkt_test_suite, NULL, NULL, NULL, NULL, NULL);
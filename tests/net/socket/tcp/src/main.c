@@ -297,6 +297,92 @@ ZTEST_USER(net_socket_tcp, test_v6_send_recv)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+NET_BUF_POOL_FIXED_DEFINE(zerocopy_pool, 1, 0, 0, NULL);
+#endif
+
+ZTEST(net_socket_tcp, test_v4_send_buf_recv_buf)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	/* Test that the data of a buffer chain gets through without copying */
+	static const char payload[] = TEST_STR_LONG;
+	const size_t len = strlen(payload);
+	char data[sizeof(payload)];
+	size_t received = 0;
+	struct net_buf *frags;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	ssize_t ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	frags = net_buf_alloc_with_data(&zerocopy_pool, (void *)payload, len, K_NO_WAIT);
+	zassert_not_null(frags, "cannot allocate buffer");
+
+	ret = zsock_send_buf(c_sock, frags, 0);
+	zassert_equal(ret, -1, "send_buf should fail");
+	zassert_equal(errno, EDESTADDRREQ, "wrong errno (%d)", errno);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	ret = zsock_send_buf(c_sock, frags, 0);
+	zassert_true(ret > 0 && ret <= len, "send_buf failed (%d)", -errno);
+
+	/* The caller keeps its reference, and sends the rest the send
+	 * window did not take.
+	 */
+	for (size_t sent = ret; sent < len; sent += ret) {
+		net_buf_pull(frags, ret);
+
+		ret = zsock_send_buf(c_sock, frags, 0);
+		zassert_true(ret > 0 && sent + ret <= len, "send_buf failed (%d)", -errno);
+	}
+
+	net_buf_unref(frags);
+
+	while (received < len) {
+		ret = zsock_recv_buf(new_sock, &frags, 0);
+		zassert_true(ret > 0, "recv_buf failed (%d)", -errno);
+		zassert_equal(net_buf_frags_len(frags), ret, "wrong chain length");
+		zassert_true(received + ret <= len, "too much data");
+
+		net_buf_linearize(data + received, sizeof(data) - received, frags, 0, ret);
+		zsock_buf_release(frags);
+		received += ret;
+	}
+
+	zassert_mem_equal(data, payload, len, "wrong data");
+
+	test_close(c_sock);
+
+	ret = zsock_recv_buf(new_sock, &frags, 0);
+	zassert_equal(ret, 0, "no end of stream (%d)", -errno);
+	zassert_is_null(frags, "chain returned at end of stream");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+
+	/* The stack must have released the sent chain by now */
+	frags = net_buf_alloc_with_data(&zerocopy_pool, (void *)payload, len, K_NO_WAIT);
+	zassert_not_null(frags, "sent chain not released");
+	net_buf_unref(frags);
+#else
+	ztest_test_skip();
+#endif
+}
+
 /* Test the stack behavior with a resonable sized block data, be sure to have multiple packets */
 #define TEST_LARGE_TRANSFER_SIZE 60000
 #define TEST_PRIME 811
@@ -354,7 +440,7 @@ void tcp_server_block_thread(void *vps_sock, void *unused2, void *unused3)
 	test_close(new_sock);
 }
 
-void test_send_recv_large_common(int tcp_nodelay, int family)
+void test_send_recv_large_common(int tcp_nodelay, int family, const char *congestion)
 {
 	int rv;
 	int c_sock = 0;
@@ -387,6 +473,12 @@ void test_send_recv_large_common(int tcp_nodelay, int family)
 	test_bind(s_sock, s_saddr, addrlen);
 	test_listen(s_sock);
 
+	if (congestion != NULL) {
+		rv = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, congestion,
+				      strlen(congestion));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+	}
+
 	(void)k_thread_create(&tcp_server_thread_data, tcp_server_stack_area,
 		K_THREAD_STACK_SIZEOF(tcp_server_stack_area),
 		tcp_server_block_thread,
@@ -454,39 +546,57 @@ static void restore_packet_loss_ratio(void)
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_normal)
 {
-	test_send_recv_large_common(0, AF_INET);
+	test_send_recv_large_common(0, AF_INET, NULL);
 }
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_packet_loss)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(0, AF_INET);
+	test_send_recv_large_common(0, AF_INET, NULL);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_no_delay)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(1, AF_INET);
+	test_send_recv_large_common(1, AF_INET, NULL);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v6_send_recv_large_normal)
 {
-	test_send_recv_large_common(0, AF_INET6);
+	test_send_recv_large_common(0, AF_INET6, NULL);
 }
 
 ZTEST(net_socket_tcp, test_v6_send_recv_large_packet_loss)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(0, AF_INET6);
+	test_send_recv_large_common(0, AF_INET6, NULL);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v6_send_recv_large_no_delay)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(1, AF_INET6);
+	test_send_recv_large_common(1, AF_INET6, NULL);
+	restore_packet_loss_ratio();
+}
+
+ZTEST(net_socket_tcp, test_v4_send_recv_large_cubic)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_CUBIC);
+
+	set_packet_loss_ratio();
+	test_send_recv_large_common(0, AF_INET, "cubic");
+	restore_packet_loss_ratio();
+}
+
+ZTEST(net_socket_tcp, test_v4_send_recv_large_vegas)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_VEGAS);
+
+	set_packet_loss_ratio();
+	test_send_recv_large_common(0, AF_INET, "vegas");
 	restore_packet_loss_ratio();
 }
 
@@ -2430,6 +2540,54 @@ ZTEST(net_socket_tcp, test_so_keepalive_opt)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion_opt)
+{
+	struct sockaddr_in bind_addr4;
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int sock, ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_AVOIDANCE);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	/* New Reno is the default algorithm */
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optlen, sizeof("reno"), "getsockopt got invalid size");
+	zassert_str_equal(name, "reno", "getsockopt got invalid value");
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "bogus", strlen("bogus"));
+	zassert_equal(ret, -1, "setsockopt should fail");
+	zassert_equal(errno, ENOENT, "setsockopt set invalid errno (%d)", errno);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+		ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+				       strlen("cubic"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+		zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+		zassert_str_equal(name, "cubic", "getsockopt got invalid value");
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_VEGAS)) {
+		ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "vegas",
+				       strlen("vegas"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+		zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+		zassert_str_equal(name, "vegas", "getsockopt got invalid value");
+	}
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 static void test_prepare_keepalive_socks(int *c_sock, int *s_sock, int *new_sock)
 {
 	struct sockaddr_in c_saddr, s_saddr;
@@ -3112,6 +3112,180 @@ ZTEST(net_socket_udp, test_40_clamp_udp_tcp_port_range)
 #endif
 }
 
+ZTEST_USER(net_socket_udp, test_41_v4_sendmmsg_recvmmsg)
+{
+	static const char * const data[] = { "first", "second datagram", "3rd" };
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in src_addr[4];
+	struct mmsghdr msgvec[4];
+	struct iovec iov[4];
+	char bufs[4][32];
+	struct timespec timeout = { 0 };
+	socklen_t addrlen = sizeof(client_addr);
+	int client_sock;
+	int server_sock;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = zsock_bind(client_sock, (struct sockaddr *)&client_addr, sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	rv = zsock_getsockname(client_sock, (struct sockaddr *)&client_addr, &addrlen);
+	zassert_equal(rv, 0, "getsockname failed");
+
+	memset(msgvec, 0, sizeof(msgvec));
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		iov[i].iov_base = (void *)data[i];
+		iov[i].iov_len = strlen(data[i]);
+		msgvec[i].msg_hdr.msg_name = &server_addr;
+		msgvec[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		msgvec[i].msg_hdr.msg_iov = &iov[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgvec, ARRAY_SIZE(data), 0);
+	zassert_equal(rv, ARRAY_SIZE(data), "sendmmsg failed (%d)", -errno);
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		zassert_equal(msgvec[i].msg_len, strlen(data[i]), "wrong length sent");
+	}
+
+	memset(msgvec, 0, sizeof(msgvec));
+
+	for (int i = 0; i < ARRAY_SIZE(msgvec); i++) {
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = sizeof(bufs[i]);
+		msgvec[i].msg_hdr.msg_name = &src_addr[i];
+		msgvec[i].msg_hdr.msg_namelen = sizeof(src_addr[i]);
+		msgvec[i].msg_hdr.msg_iov = &iov[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Only the queued datagrams are returned after the first one */
+	rv = zsock_recvmmsg(server_sock, msgvec, ARRAY_SIZE(msgvec), ZSOCK_MSG_WAITFORONE,
+			    NULL);
+	zassert_equal(rv, ARRAY_SIZE(data), "recvmmsg failed (%d)", -errno);
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		zassert_equal(msgvec[i].msg_len, strlen(data[i]), "wrong length received");
+		zassert_mem_equal(bufs[i], data[i], strlen(data[i]), "wrong data");
+		zassert_equal(msgvec[i].msg_hdr.msg_namelen, sizeof(struct sockaddr_in),
+			      "wrong address length");
+		zassert_equal(src_addr[i].sin_port, client_addr.sin_port, "wrong source port");
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgvec, ARRAY_SIZE(msgvec), ZSOCK_MSG_DONTWAIT, NULL);
+	zassert_equal(rv, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "wrong errno (%d)", errno);
+
+	/* An expired timeout stops the waiting after the first datagram */
+	rv = zsock_sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			  (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	for (int i = 0; i < ARRAY_SIZE(msgvec); i++) {
+		msgvec[i].msg_hdr.msg_namelen = sizeof(src_addr[i]);
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgvec, ARRAY_SIZE(msgvec), 0, &timeout);
+	zassert_equal(rv, 1, "recvmmsg failed (%d)", -errno);
+	zassert_equal(msgvec[0].msg_len, STRLEN(TEST_STR_SMALL), "wrong length received");
+	zassert_mem_equal(bufs[0], BUF_AND_SIZE(TEST_STR_SMALL), "wrong data");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+NET_BUF_POOL_FIXED_DEFINE(zerocopy_pool, 2, 16, 0, NULL);
+#endif
+
+ZTEST(net_socket_udp, test_42_v4_send_buf_recv_buf)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	static const char hdr[] = "header:";
+	static const char payload[] = "sent without a copy";
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct net_buf *frags;
+	struct net_buf *buf;
+	char data[sizeof(hdr) + sizeof(payload)];
+	int client_sock;
+	int server_sock;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = zsock_bind(client_sock, (struct sockaddr *)&client_addr, sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	frags = net_buf_alloc(&zerocopy_pool, K_NO_WAIT);
+	zassert_not_null(frags, "cannot allocate buffer");
+	net_buf_add_mem(frags, hdr, STRLEN(hdr));
+
+	buf = net_buf_alloc_with_data(&zerocopy_pool, (void *)payload, STRLEN(payload),
+				      K_NO_WAIT);
+	zassert_not_null(buf, "cannot allocate buffer");
+	net_buf_frag_add(frags, buf);
+
+	/* The caller keeps the chain when sending fails */
+	rv = zsock_send_buf(client_sock, frags, 0);
+	zassert_equal(rv, -1, "send_buf should fail");
+	zassert_equal(errno, EDESTADDRREQ, "wrong errno (%d)", errno);
+	zassert_equal(frags->ref, 1, "chain not left to the caller");
+
+	rv = zsock_connect(client_sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	rv = zsock_send_buf(client_sock, frags, 0);
+	zassert_equal(rv, STRLEN(hdr) + STRLEN(payload), "send_buf failed (%d)", -errno);
+
+	/* The caller keeps its reference after sending too */
+	net_buf_unref(frags);
+
+	frags = NULL;
+	rv = zsock_recv_buf(server_sock, &frags, 0);
+	zassert_equal(rv, STRLEN(hdr) + STRLEN(payload), "recv_buf failed (%d)", -errno);
+	zassert_not_null(frags, "no data received");
+	zassert_equal(net_buf_frags_len(frags), rv, "wrong chain length");
+
+	net_buf_linearize(data, sizeof(data), frags, 0, rv);
+	zassert_mem_equal(data, hdr, STRLEN(hdr), "wrong data");
+	zassert_mem_equal(data + STRLEN(hdr), payload, STRLEN(payload), "wrong data");
+	zsock_buf_release(frags);
+
+	rv = zsock_recv_buf(server_sock, &frags, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recv_buf should fail");
+	zassert_equal(errno, EAGAIN, "wrong errno (%d)", errno);
+	zassert_is_null(frags, "chain returned on error");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+
+	/* The stack must have released the sent chain by now */
+	frags = net_buf_alloc(&zerocopy_pool, K_NO_WAIT);
+	zassert_not_null(frags, "sent chain not released");
+	net_buf_unref(frags);
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
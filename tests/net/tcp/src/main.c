@@ -116,6 +116,9 @@ static enum test_case_no {
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
 	TEST_CLIENT_SEQ_VALIDATION = 19,
 	TEST_SERVER_ACK_VALIDATION = 20,
+	TEST_SERVER_OPTIONS = 21,
+	TEST_SERVER_GSO = 22,
+	TEST_SERVER_SEND_BUF = 23,
 } test_case_no;
 
 static enum test_state t_state;
@@ -142,6 +145,8 @@ static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_seq_validation_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_ack_validation_test(struct net_pkt *pkt);
+static void handle_server_options_test(struct net_pkt *pkt);
+static void handle_server_gso_test(struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -239,6 +244,15 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options sent by the peer in TEST_SERVER_OPTIONS */
+static const uint8_t *peer_opts;
+static size_t peer_opts_len;
+
+/* Window announced in TEST_SERVER_OPTIONS, small enough to stay below our
+ * send buffer once scaled.
+ */
+#define OPTIONS_PEER_WIN 8U
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -249,11 +263,16 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
+	const uint8_t *opts = NULL;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if (test_case_no == TEST_SERVER_OPTIONS && peer_opts != NULL) {
+		opts = peer_opts;
+		opts_len = peer_opts_len;
 	}
 
 	/* Allocate buffer */
@@ -288,14 +307,10 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
-	th->th_win = htons(NET_IPV6_MTU);
+	th->th_win = htons(test_case_no == TEST_SERVER_OPTIONS ? OPTIONS_PEER_WIN : NET_IPV6_MTU);
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -307,9 +322,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len > 0) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -494,6 +509,15 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_SERVER_ACK_VALIDATION:
 		handle_server_ack_validation_test(pkt);
 		break;
+	case TEST_SERVER_OPTIONS:
+		handle_server_options_test(pkt);
+		break;
+	case TEST_SERVER_GSO:
+		handle_server_gso_test(pkt);
+		break;
+	case TEST_SERVER_SEND_BUF:
+		/* The data is not acknowledged */
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -3002,4 +3026,422 @@ ZTEST(net_tcp, test_server_ack_validation)
 	net_context_put(accepted_ctx);
 }
 
+/* A segment sent by the stack, with its options */
+struct tcp_seg_capture {
+	struct tcphdr th;
+	uint8_t opts[NET_TCP_MAX_RECV_OPT_SIZE];
+	uint8_t opts_len;
+};
+
+K_MSGQ_DEFINE(options_msgq, sizeof(struct tcp_seg_capture), 4, 4);
+
+static void handle_server_options_test(struct net_pkt *pkt)
+{
+	struct tcp_seg_capture seg = { 0 };
+	int ret;
+
+	ret = read_tcp_header(pkt, &seg.th);
+	zassert_ok(ret, "Cannot read TCP header");
+
+	seg.opts_len = (seg.th.th_off - 5U) * 4U;
+
+	net_pkt_set_overwrite(pkt, true);
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			   sizeof(struct tcphdr));
+	zassert_ok(ret, "Cannot skip TCP header");
+	ret = net_pkt_read(pkt, seg.opts, seg.opts_len);
+	zassert_ok(ret, "Cannot read TCP options");
+	net_pkt_cursor_init(pkt);
+
+	(void)k_msgq_put(&options_msgq, &seg, K_NO_WAIT);
+}
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) && defined(CONFIG_NET_TCP_TIMESTAMPS) && \
+	defined(CONFIG_NET_TCP_SACK)
+/* Return the option of the given kind in a captured segment, or NULL */
+static const uint8_t *find_tcp_option(const struct tcp_seg_capture *seg, uint8_t kind)
+{
+	for (int i = 0; i < seg->opts_len && seg->opts[i] != NET_TCP_END_OPT; ) {
+		if (seg->opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		zassert_true(i + 1 < seg->opts_len && seg->opts[i + 1] >= 2,
+			     "Malformed option list");
+
+		if (seg->opts[i] == kind) {
+			return &seg->opts[i];
+		}
+
+		i += seg->opts[i + 1];
+	}
+
+	return NULL;
+}
+
+static void expect_segment(struct tcp_seg_capture *seg, uint8_t flags)
+{
+	zassert_ok(k_msgq_get(&options_msgq, seg, K_MSEC(500)), "No segment received");
+	zassert_equal(seg->th.th_flags, flags, "Unexpected flags 0x%02x", seg->th.th_flags);
+}
+
+static uint32_t expect_ts_option(const struct tcp_seg_capture *seg, uint32_t tsecr)
+{
+	const uint8_t *opt = find_tcp_option(seg, NET_TCP_TIMESTAMP_OPT);
+
+	zassert_not_null(opt, "No timestamp option");
+	zassert_equal(opt[1], NET_TCP_TIMESTAMP_SIZE, "Wrong timestamp option size");
+	zassert_equal(sys_get_be32(opt + 6), tsecr, "Wrong TSecr %u, expected %u",
+		      sys_get_be32(opt + 6), tsecr);
+
+	return sys_get_be32(opt + 2);
+}
+
+static void set_peer_ts_option(uint8_t *opts, uint32_t tsval, uint32_t tsecr)
+{
+	opts[0] = NET_TCP_NOP_OPT;
+	opts[1] = NET_TCP_NOP_OPT;
+	opts[2] = NET_TCP_TIMESTAMP_OPT;
+	opts[3] = NET_TCP_TIMESTAMP_SIZE;
+	sys_put_be32(tsval, opts + 4);
+	sys_put_be32(tsecr, opts + 8);
+}
+
+#if defined(CONFIG_NET_TCP_GRO)
+static int options_recv_pkts;
+static size_t options_recv_len;
+
+static void options_recv_cb(struct net_context *context, struct net_pkt *pkt,
+			    union net_ip_header *ip_hdr,
+			    union net_proto_header *proto_hdr,
+			    int status, void *user_data)
+{
+	if (pkt) {
+		options_recv_pkts++;
+		options_recv_len += net_pkt_remaining_data(pkt);
+		net_pkt_unref(pkt);
+	}
+}
+#endif
+
+static void send_with_options(uint8_t flags, const uint8_t *data, size_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = tester_prepare_tcp_pkt(AF_INET, htons(PEER_PORT), htons(MY_PORT), flags,
+				     data, len);
+	zassert_not_null(pkt, "Cannot create pkt");
+	zassert_ok(net_recv_data(net_iface, pkt), "recv data failed");
+}
+#endif
+
+/* Test case scenario IPv4 with window scale, timestamps and SACK
+ *   send SYN offering all the options,
+ *   expect SYN ACK agreeing to them and echoing our timestamp,
+ *   send ACK, check the negotiated connection state,
+ *   send out of order data,
+ *   expect a duplicate ACK with a SACK block and the old timestamp echoed,
+ *   send the missing data,
+ *   expect an ACK covering everything without SACK block,
+ *   send RST with an old timestamp, expect no answer.
+ */
+ZTEST(net_tcp, test_server_options_negotiation)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) && defined(CONFIG_NET_TCP_TIMESTAMPS) && \
+	defined(CONFIG_NET_TCP_SACK)
+	uint8_t opts[NET_TCP_MAX_RECV_OPT_SIZE];
+	struct tcp_seg_capture seg;
+	struct net_context *ctx;
+	const uint8_t *opt;
+	struct tcp *conn;
+	uint32_t peer_tsval;
+	int ret;
+
+	test_case_no = TEST_SERVER_OPTIONS;
+	k_msgq_purge(&options_msgq);
+	k_sem_reset(&test_sem);
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_ok(ret, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_ok(ret, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_ok(ret, "Failed to listen on net_context");
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_ok(ret, "Failed to set accept on net_context");
+
+	/* MSS, SACK permitted, timestamp with TSval 0xc27bef0f and WS 7 */
+	peer_opts = tcp_options;
+	peer_opts_len = sizeof(tcp_options);
+	send_with_options(SYN, NULL, 0);
+
+	expect_segment(&seg, SYN | ACK);
+	zassert_not_null(find_tcp_option(&seg, NET_TCP_SACK_PERM_OPT), "SACK not permitted");
+	opt = find_tcp_option(&seg, NET_TCP_WINDOW_SCALE_OPT);
+	zassert_not_null(opt, "No window scale option");
+	peer_tsval = expect_ts_option(&seg, 0xc27bef0f);
+
+	seq++;
+	ack = ntohl(seg.th.th_seq) + 1;
+
+	peer_opts = opts;
+	peer_opts_len = 12;
+	set_peer_ts_option(opts, 0xc27bef10, peer_tsval);
+	send_with_options(ACK, NULL, 0);
+
+	/* test_tcp_accept_cb will release the semaphore */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = accepted_ctx->tcp;
+	zassert_true(conn->wscale_ok, "Window scaling not agreed");
+	zassert_equal(conn->snd_wscale, 7, "Wrong send window scale %u", conn->snd_wscale);
+	zassert_equal(conn->rcv_wscale, opt[2], "Announced and used scale differ");
+	zassert_equal(conn->send_win, OPTIONS_PEER_WIN << 7,
+		      "Peer window not scaled, got %u", conn->send_win);
+	zassert_true(conn->sack_ok, "SACK not agreed");
+	zassert_true(conn->ts_ok, "Timestamps not agreed");
+	zassert_equal(conn->ts_recent, 0xc27bef10, "TS.Recent not updated");
+
+	/* Leave a 100 byte hole, the stack must report the 10 bytes after it.
+	 * The segment is out of order, so TS.Recent stays at the last in
+	 * order one.
+	 */
+	seq = 101;
+	set_peer_ts_option(opts, 0xc27bef11, peer_tsval);
+	send_with_options(PSH | ACK, lorem_ipsum, 10);
+
+	expect_segment(&seg, ACK);
+	zassert_equal(ntohl(seg.th.th_ack), 1, "Hole not acknowledged");
+	zassert_equal(ntohs(seg.th.th_win), MIN(conn->recv_win >> conn->rcv_wscale, UINT16_MAX),
+		      "Wrong scaled window %u", ntohs(seg.th.th_win));
+	expect_ts_option(&seg, 0xc27bef10);
+	opt = find_tcp_option(&seg, NET_TCP_SACK_OPT);
+	zassert_not_null(opt, "No SACK option");
+	zassert_equal(opt[1], 2 + NET_TCP_SACK_BLOCK_SIZE, "Wrong SACK option size");
+	zassert_equal(sys_get_be32(opt + 2), 101, "Wrong SACK block start");
+	zassert_equal(sys_get_be32(opt + 6), 111, "Wrong SACK block end");
+
+	/* Fill the hole, everything is acknowledged and the timestamp of the
+	 * segment that advanced the window is echoed.
+	 */
+	seq = 1;
+	set_peer_ts_option(opts, 0xc27bef12, peer_tsval);
+	send_with_options(PSH | ACK, lorem_ipsum, 100);
+
+	expect_segment(&seg, ACK);
+	zassert_equal(ntohl(seg.th.th_ack), 111, "Data not acknowledged");
+	expect_ts_option(&seg, 0xc27bef12);
+	zassert_is_null(find_tcp_option(&seg, NET_TCP_SACK_OPT), "Stale SACK block");
+
+	seq = 111;
+
+#if defined(CONFIG_NET_TCP_GRO)
+	/* Back to back segments are coalesced although their TSval differ,
+	 * the data is received at once and the TSval of the first one is
+	 * echoed.
+	 */
+	options_recv_pkts = 0;
+	options_recv_len = 0;
+	ret = net_context_recv(accepted_ctx, options_recv_cb, K_NO_WAIT, NULL);
+	zassert_ok(ret, "Failed to set recv callback");
+
+	k_sched_lock();
+	for (int i = 0; i < 3; i++) {
+		set_peer_ts_option(opts, 0xc27bef13 + i, peer_tsval);
+		send_with_options(i < 2 ? ACK : PSH | ACK, lorem_ipsum, 100);
+		seq += 100;
+	}
+	k_sched_unlock();
+
+	expect_segment(&seg, ACK);
+	zassert_equal(ntohl(seg.th.th_ack), 411, "Data not acknowledged");
+	expect_ts_option(&seg, 0xc27bef13);
+	zassert_equal(options_recv_len, 300, "Data not received");
+	zassert_equal(options_recv_pkts, 1, "Segments were not coalesced");
+#endif
+
+	/* RST segments are exempt from PAWS, one carrying an older TSval
+	 * than TS.Recent aborts the connection rather than being answered
+	 * with an ACK.
+	 */
+	set_peer_ts_option(opts, 0xc27bef0f, peer_tsval);
+	send_with_options(RST, NULL, 0);
+	zassert_not_ok(k_msgq_get(&options_msgq, &seg, K_MSEC(100)), "RST was answered");
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+#else
+	ztest_test_skip();
+#endif
+}
+
+#define GSO_TEST_LEN 300
+
+static uint32_t gso_seg_seq[8];
+static uint16_t gso_seg_len[8];
+static uint8_t gso_seg_flags[8];
+static int gso_seg_count;
+static size_t gso_total;
+
+static void handle_server_gso_test(struct net_pkt *pkt)
+{
+	struct tcphdr th;
+	size_t len;
+
+	zassert_ok(read_tcp_header(pkt, &th), "Cannot read TCP header");
+
+	len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+	      net_pkt_ip_opts_len(pkt) - th.th_off * 4U;
+	if (len == 0 || gso_seg_count >= ARRAY_SIZE(gso_seg_len)) {
+		return;
+	}
+
+	gso_seg_seq[gso_seg_count] = ntohl(th.th_seq);
+	gso_seg_len[gso_seg_count] = len;
+	gso_seg_flags[gso_seg_count] = th.th_flags;
+	gso_seg_count++;
+
+	gso_total += len;
+	if (gso_total >= GSO_TEST_LEN) {
+		test_sem_give();
+	}
+}
+
+/* Test case scenario IPv6
+ *   send data larger than the MSS in one call,
+ *   expect it split in contiguous MSS sized segments, only the last one
+ *   being pushed.
+ */
+ZTEST(net_tcp, test_server_gso)
+{
+#if defined(CONFIG_NET_TCP_GSO) && !defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	uint16_t mss;
+	int ret;
+
+	k_sem_reset(&test_sem);
+
+	ctx = create_server_socket(0, 0);
+
+	test_case_no = TEST_SERVER_GSO;
+	gso_seg_count = 0;
+	gso_total = 0;
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, GSO_TEST_LEN, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, GSO_TEST_LEN, "Failed to send data to peer %d", ret);
+
+	test_sem_take(K_MSEC(500), __LINE__);
+
+	/* All but the last segment are full sized */
+	mss = gso_seg_len[0];
+	zassert_true(mss < GSO_TEST_LEN, "Data was not segmented");
+	zassert_equal(gso_seg_count, DIV_ROUND_UP(GSO_TEST_LEN, mss),
+		      "%d segments for %d bytes with MSS %u", gso_seg_count,
+		      GSO_TEST_LEN, mss);
+
+	for (int i = 0; i < gso_seg_count; i++) {
+		bool last = i == gso_seg_count - 1;
+
+		zassert_equal(gso_seg_len[i], last ? GSO_TEST_LEN - i * mss : mss,
+			      "Wrong length %u of segment %d", gso_seg_len[i], i);
+		zassert_equal(gso_seg_seq[i], gso_seg_seq[0] + i * mss,
+			      "Segment %d is not contiguous", i);
+		zassert_equal(gso_seg_flags[i], last ? (PSH | ACK) : ACK,
+			      "Wrong flags 0x%02x of segment %d", gso_seg_flags[i], i);
+	}
+
+	/* Just send a RST packet to abort the underlying connection */
+	rst = tester_prepare_tcp_pkt(AF_INET6, htons(MY_PORT), htons(PEER_PORT), RST, NULL, 0);
+	zassert_not_null(rst, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+#else
+	ztest_test_skip();
+#endif
+}
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+#define SEND_BUF_FRAG_LEN 700
+
+BUILD_ASSERT(sizeof(lorem_ipsum) > SEND_BUF_FRAG_LEN);
+BUILD_ASSERT(2 * SEND_BUF_FRAG_LEN > NET_IPV6_MTU);
+
+NET_BUF_POOL_FIXED_DEFINE(send_buf_pool, 2, 0, 0, NULL);
+#endif
+
+/* Test case scenario IPv6
+ *   queue a buffer chain larger than the send window without copying it,
+ *   expect only what the window permits to be taken, and the connection
+ *   to drop its references to the chain when it is aborted.
+ */
+ZTEST(net_tcp, test_server_send_buf_window)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	struct net_context *ctx;
+	struct net_buf *frags;
+	struct net_buf *buf;
+	struct net_pkt *rst;
+	int ret;
+
+	ctx = create_server_socket(0, 0);
+
+	test_case_no = TEST_SERVER_SEND_BUF;
+
+	frags = net_buf_alloc_with_data(&send_buf_pool, (void *)lorem_ipsum,
+					SEND_BUF_FRAG_LEN, K_NO_WAIT);
+	zassert_not_null(frags, "Cannot allocate buffer");
+	buf = net_buf_alloc_with_data(&send_buf_pool, (void *)lorem_ipsum,
+				      SEND_BUF_FRAG_LEN, K_NO_WAIT);
+	zassert_not_null(buf, "Cannot allocate buffer");
+	net_buf_frag_add(frags, buf);
+
+	/* The peer announced a window of NET_IPV6_MTU bytes */
+	ret = net_context_send_buf(accepted_ctx, frags, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, NET_IPV6_MTU, "Queued %d bytes", ret);
+	zassert_equal(frags->ref, 2, "No reference to the first buffer");
+	zassert_equal(buf->ref, 2, "No reference to the second buffer");
+
+	ret = net_context_send_buf(accepted_ctx, frags, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, -EAGAIN, "Queued past the window (%d)", ret);
+
+	/* Just send a RST packet to abort the underlying connection */
+	rst = tester_prepare_tcp_pkt(AF_INET6, htons(MY_PORT), htons(PEER_PORT), RST, NULL, 0);
+	zassert_not_null(rst, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+
+	/* Let the connection be released */
+	k_msleep(50);
+
+	zassert_equal(frags->ref, 1, "Connection kept the first buffer");
+	zassert_equal(buf->ref, 1, "Connection kept the second buffer");
+	net_buf_unref(frags);
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -1051,6 +1051,63 @@ ZTEST(net_traffic_class, test_mix_all_2)
 	test_traffic_class_recv_data_mix_all_2();
 }
 
+#if NET_TC_RX_QUEUE_COUNT > NET_TC_RX_COUNT
+static uint32_t rss_hash_udp6(const char *src, uint16_t src_port,
+			      const char *dst, uint16_t dst_port)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	struct net_ipv6_hdr ip = {
+		.vtc = 0x60,
+		.len = htons(sizeof(struct net_udp_hdr)),
+		.nexthdr = IPPROTO_UDP,
+		.hop_limit = 64,
+	};
+	struct net_udp_hdr udp = {
+		.src_port = htons(src_port),
+		.dst_port = htons(dst_port),
+		.len = htons(sizeof(struct net_udp_hdr)),
+	};
+	struct net_pkt *pkt;
+	uint32_t hash;
+
+	zassert_equal(net_addr_pton(AF_INET6, src, (struct in6_addr *)ip.src), 0);
+	zassert_equal(net_addr_pton(AF_INET6, dst, (struct in6_addr *)ip.dst), 0);
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(ip) + sizeof(udp), AF_UNSPEC, 0,
+					K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	zassert_equal(net_pkt_write(pkt, &ip, sizeof(ip)), 0);
+	zassert_equal(net_pkt_write(pkt, &udp, sizeof(udp)), 0);
+
+	hash = net_tc_rx_flow_hash(pkt);
+	net_pkt_unref(pkt);
+
+	return hash;
+}
+
+ZTEST(net_traffic_class, test_rss_flow_hash)
+{
+	/* Verification suite of the Microsoft RSS specification */
+	uint32_t hash = rss_hash_udp6("3ffe:2501:200:1fff::7", 2794,
+				      "3ffe:2501:200:3::1", 1766);
+
+	if (IS_ENABLED(CONFIG_NET_TC_RX_RSS_UDP_PORTS)) {
+		zassert_equal(hash, 0x40207d3d, "Wrong hash 0x%08x", hash);
+	} else {
+		zassert_equal(hash, 0x2cc18cd5, "Wrong hash 0x%08x", hash);
+	}
+
+	hash = rss_hash_udp6("3ffe:501:8::260:97ff:fe40:efab", 14230, "ff02::1", 4739);
+
+	if (IS_ENABLED(CONFIG_NET_TC_RX_RSS_UDP_PORTS)) {
+		zassert_equal(hash, 0xdde51bbf, "Wrong hash 0x%08x", hash);
+	} else {
+		zassert_equal(hash, 0x0f0c461c, "Wrong hash 0x%08x", hash);
+	}
+}
+#endif
+
 static void run_before(void *dummy)
 {
 	ARG_UNUSED(dummy);
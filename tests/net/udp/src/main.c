@@ -653,4 +653,73 @@ ZTEST(udp_fn_tests, test_udp)
 	zassert_false(test_failed, "udp tests failed");
 }
 
+#define DEMUX_PORTS 32
+#define DEMUX_BASE_PORT 5000
+
+/* Handlers on many ports must each get their own packets, and a connected
+ * handler must win over the listener bound to the same port.
+ */
+ZTEST(udp_fn_tests, test_udp_demux)
+{
+	static struct ud listeners[DEMUX_PORTS];
+	static struct ud connected;
+	struct net_conn_handle *handlers[DEMUX_PORTS];
+	struct net_conn_handle *conn_handler;
+	struct in_addr in4addr_my = { { { 192, 0, 2, 1 } } };
+	struct in_addr in4addr_peer = { { { 192, 0, 2, 9 } } };
+	struct sockaddr_in peer_addr4 = {
+		.sin_family = AF_INET,
+		.sin_port = htons(1234),
+		.sin_addr = in4addr_peer,
+	};
+	struct net_if *iface;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE)) {
+		k_thread_priority_set(k_current_get(),
+				K_PRIO_COOP(CONFIG_NUM_COOP_PRIORITIES - 1));
+	} else {
+		k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(9));
+	}
+
+	k_sem_init(&recv_lock, 0, UINT_MAX);
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(net_if_ipv4_addr_add(iface, &in4addr_my, NET_ADDR_MANUAL, 0));
+
+	for (int i = 0; i < DEMUX_PORTS; i++) {
+		listeners[i].test = "demux listener";
+		ret = net_udp_register(AF_INET, NULL, NULL, 0, DEMUX_BASE_PORT + i,
+				       NULL, test_ok, &listeners[i], &handlers[i]);
+		zassert_ok(ret, "Cannot register port %d (%d)", DEMUX_BASE_PORT + i, ret);
+	}
+
+	connected.test = "demux connected";
+	ret = net_udp_register(AF_INET, (struct sockaddr *)&peer_addr4, NULL,
+			       1234, DEMUX_BASE_PORT + 10, NULL, test_ok,
+			       &connected, &conn_handler);
+	zassert_ok(ret, "Cannot register connected handler (%d)", ret);
+
+	for (int i = 0; i < DEMUX_PORTS; i++) {
+		zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my, 999,
+					       DEMUX_BASE_PORT + i, &listeners[i], false));
+	}
+
+	zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my, 1234,
+				       DEMUX_BASE_PORT + 10, &connected, false));
+	zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my, 1235,
+				       DEMUX_BASE_PORT + 10, &listeners[10], false));
+
+	zassert_ok(net_udp_unregister(conn_handler));
+	zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my, 1234,
+				       DEMUX_BASE_PORT + 10, &listeners[10], false));
+
+	for (int i = 0; i < DEMUX_PORTS; i++) {
+		zassert_ok(net_udp_unregister(handlers[i]));
+	}
+
+	zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my, 999,
+				       DEMUX_BASE_PORT, NULL, true));
+}
+
 ZTEST_SUITE(udp_fn_tests, NULL, NULL, NULL, NULL, NULL);
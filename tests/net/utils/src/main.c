@@ -1365,6 +1365,35 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+ZTEST(test_utils_fn, test_ip_checksum_copy)
+{
+	static uint8_t copy[CHECKSUM_TEST_LENGTH + 8];
+	uint16_t sum_got;
+	uint16_t sum_exp;
+
+	for (int i = 0; i < CHECKSUM_TEST_LENGTH; i++) {
+		testdata[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	/* Source and destination alignments do not have to match */
+	for (int src_off = 0; src_off < 4; src_off++) {
+		for (int dst_off = 0; dst_off < 4; dst_off++) {
+			size_t len = CHECKSUM_TEST_LENGTH - 4 - dst_off * 97;
+
+			memset(copy, 0, sizeof(copy));
+
+			sum_exp = calc_chksum_ref(src_off ^ 0x3c5a, testdata + src_off, len);
+			sum_got = calc_chksum_copy(src_off ^ 0x3c5a, copy + dst_off,
+						   testdata + src_off, len);
+
+			zassert_equal(sum_got, sum_exp, "Mismatch in checksum of copy");
+			zassert_mem_equal(copy + dst_off, testdata + src_off, len,
+					  "Copied data differs");
+			zassert_equal(copy[dst_off + len], 0, "Copied past the end");
+		}
+	}
+}
+
 /* Verify that the net_pkt pointer to the received link layer address
  * is correct.
  */
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Takes samples from known call sites, exports them as a pprof profile and
+ * decodes it back.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include "perf_internal.h"
+
+/* More call sites than the pprof encoder collects locations in one pass */
+#define SITES 150
+
+#define PERIOD_NS   1000000
+#define DURATION_NS 150000000
+
+#define STRINGS_MAX   64
+#define LOCATIONS_MAX 512
+
+struct pb_field {
+	uint32_t field;
+	uint32_t wire;
+	uint64_t value;
+	const uint8_t *data;
+};
+
+struct profile {
+	const uint8_t *strings[STRINGS_MAX];
+	size_t string_lens[STRINGS_MAX];
+	size_t string_count;
+	uint64_t sample_type[2];
+	uint64_t period_type[2];
+	uint64_t period;
+	uint64_t duration;
+	size_t mapping_count;
+	uint64_t locations[LOCATIONS_MAX];
+	size_t location_count;
+	size_t function_count;
+	size_t sample_count;
+	uint64_t sample_total;
+};
+
+static uint8_t profile_buf[32768];
+static size_t profile_len;
+static struct profile profile;
+
+static int buf_write(void *ctx, const uint8_t *data, size_t len)
+{
+	ARG_UNUSED(ctx);
+
+	if (profile_len + len > sizeof(profile_buf)) {
+		return -ENOMEM;
+	}
+
+	memcpy(&profile_buf[profile_len], data, len);
+	profile_len += len;
+
+	return 0;
+}
+
+static int failing_write(void *ctx, const uint8_t *data, size_t len)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return -ENOSPC;
+}
+
+static __noinline void take_sample(void)
+{
+	perf_aggregate_sample();
+}
+
+#define SAMPLE_SITE(i, _) take_sample()
+
+static __noinline void take_samples(void)
+{
+	LISTIFY(SITES, SAMPLE_SITE, (;));
+}
+
+static uint64_t pb_varint(const uint8_t **cursor, const uint8_t *end)
+{
+	uint64_t value = 0;
+
+	for (int shift = 0; shift < 64; shift += 7) {
+		zassert_true(*cursor < end, "Truncated varint");
+
+		value |= (uint64_t)(**cursor & 0x7F) << shift;
+		if ((*(*cursor)++ & 0x80) == 0) {
+			return value;
+		}
+	}
+
+	zassert_unreachable("Varint too long");
+
+	return 0;
+}
+
+/* Read the next field of a message, returns false at its end */
+static bool pb_next(const uint8_t **cursor, const uint8_t *end, struct pb_field *field)
+{
+	uint64_t key;
+
+	if (*cursor == end) {
+		return false;
+	}
+
+	key = pb_varint(cursor, end);
+	field->field = key >> 3;
+	field->wire = key & 0x7;
+	field->value = pb_varint(cursor, end);
+	field->data = NULL;
+
+	zassert_true(field->wire == 0 || field->wire == 2, "Unexpected wire type %u",
+		     field->wire);
+
+	if (field->wire == 2) {
+		zassert_true(field->value <= end - *cursor, "Truncated field");
+		field->data = *cursor;
+		*cursor += field->value;
+	}
+
+	return true;
+}
+
+static void decode_value_type(const struct pb_field *msg, uint64_t value_type[2])
+{
+	const uint8_t *cursor = msg->data;
+	struct pb_field field;
+
+	while (pb_next(&cursor, msg->data + msg->value, &field)) {
+		if (field.field == 1 || field.field == 2) {
+			value_type[field.field - 1] = field.value;
+		}
+	}
+}
+
+static void decode_location(const struct pb_field *msg)
+{
+	const uint8_t *cursor = msg->data;
+	struct pb_field field;
+	uint64_t id = 0;
+
+	while (pb_next(&cursor, msg->data + msg->value, &field)) {
+		if (field.field == 1) {
+			id = field.value;
+		} else if (field.field == 2) {
+			zassert_equal(field.value, 1, "Location of unknown mapping");
+		}
+	}
+
+	zassert_true(profile.location_count < LOCATIONS_MAX, "Too many locations");
+	profile.locations[profile.location_count] = id;
+	profile.location_count++;
+}
+
+static bool location_find(uint64_t id)
+{
+	for (size_t i = 0; i < profile.location_count; i++) {
+		if (profile.locations[i] == id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void check_sample(const struct pb_field *msg)
+{
+	const uint8_t *cursor = msg->data;
+	struct pb_field field;
+	struct pb_field label;
+	size_t depth = 0;
+
+	while (pb_next(&cursor, msg->data + msg->value, &field)) {
+		const uint8_t *packed = field.data;
+		const uint8_t *end = field.data + field.value;
+
+		switch (field.field) {
+		case 1:
+			while (packed < end) {
+				zassert_true(location_find(pb_varint(&packed, end)),
+					     "Sample of unknown location");
+				depth++;
+			}
+			break;
+		case 2:
+			profile.sample_total += pb_varint(&packed, end);
+			zassert_equal(packed, end, "More than one sample value");
+			break;
+		case 3:
+			while (pb_next(&packed, end, &label)) {
+				zassert_equal(label.value, label.field == 1 ? 3 : 0,
+					      "Unexpected CPU label");
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	zassert_true(depth > 0, "Empty sample");
+	profile.sample_count++;
+}
+
+static void decode_profile(void)
+{
+	const uint8_t *end = profile_buf + profile_len;
+	const uint8_t *cursor;
+	struct pb_field field;
+
+	memset(&profile, 0, sizeof(profile));
+
+	/* The samples refer to the locations, which may come after them */
+	for (int pass = 0; pass < 2; pass++) {
+		cursor = profile_buf;
+
+		while (pb_next(&cursor, end, &field)) {
+			if (pass == 1) {
+				if (field.field == 2) {
+					check_sample(&field);
+				}
+				continue;
+			}
+
+			switch (field.field) {
+			case 1:
+				decode_value_type(&field, profile.sample_type);
+				break;
+			case 3:
+				profile.mapping_count++;
+				break;
+			case 4:
+				decode_location(&field);
+				break;
+			case 5:
+				profile.function_count++;
+				break;
+			case 6:
+				zassert_true(profile.string_count < STRINGS_MAX, "Too many strings");
+				profile.strings[profile.string_count] = field.data;
+				profile.string_lens[profile.string_count] = field.value;
+				profile.string_count++;
+				break;
+			case 10:
+				profile.duration = field.value;
+				break;
+			case 11:
+				decode_value_type(&field, profile.period_type);
+				break;
+			case 12:
+				profile.period = field.value;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+}
+
+static bool string_is(uint64_t index, const char *str)
+{
+	zassert_true(index < profile.string_count, "String %llu out of the table",
+		     (unsigned long long)index);
+
+	return profile.string_lens[index] == strlen(str) &&
+	       memcmp(profile.strings[index], str, strlen(str)) == 0;
+}
+
+ZTEST(perf_pprof, test_profile)
+{
+	int err;
+
+	take_samples();
+
+	err = perf_pprof_export(buf_write, NULL, PERIOD_NS, DURATION_NS);
+	zassert_equal(err, 0, "Export failed (%d)", err);
+
+	decode_profile();
+
+	zassert_true(string_is(0, ""), "First string is not empty");
+	zassert_true(string_is(profile.sample_type[0], "samples"), "Wrong sample type");
+	zassert_true(string_is(profile.sample_type[1], "count"), "Wrong sample unit");
+	zassert_true(string_is(profile.period_type[0], "cpu"), "Wrong period type");
+	zassert_true(string_is(profile.period_type[1], "nanoseconds"), "Wrong period unit");
+	zassert_equal(profile.period, PERIOD_NS);
+	zassert_equal(profile.duration, DURATION_NS);
+	zassert_equal(profile.mapping_count, 1);
+
+	/* Every frame address is a single location */
+	for (size_t i = 1; i < profile.location_count; i++) {
+		zassert_true(profile.locations[i] > profile.locations[i - 1],
+			     "Location %zu out of order or repeated", i);
+	}
+
+	zassert_equal(profile.sample_total, SITES, "Samples lost");
+
+	/* Without SYMTAB, the call sites are told apart by their address */
+	zassert_equal(profile.sample_count, SITES);
+	zassert_true(profile.location_count > SITES, "Call sites share a location");
+	zassert_equal(profile.function_count, 0);
+}
+
+ZTEST(perf_pprof, test_write_error)
+{
+	take_sample();
+
+	zassert_equal(perf_pprof_export(failing_write, NULL, PERIOD_NS, DURATION_NS), -ENOSPC);
+}
+
+static void perf_pprof_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	perf_aggregate_clear();
+	profile_len = 0;
+}
+
+ZTEST_SUITE(perf_pprof, NULL, NULL, perf_pprof_before, NULL, NULL);
@@ -0,0 +1,16 @@
+#
+# Copyright (c) 2026 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import pytest
+
+
+def pytest_addoption(parser):
+    parser.addoption('--per-cpu', action="store_true")
+
+
+@pytest.fixture()
+def is_per_cpu_build(request):
+    return request.config.getoption('--per-cpu')
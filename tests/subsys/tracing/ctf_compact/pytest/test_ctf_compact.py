@@ -0,0 +1,186 @@
+#
+# Copyright (c) 2026 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+'''
+Pytest harness to test the compact CTF stream: the stream dumped by the
+target is decoded with scripts/tracing/merge_compact_ctf.py and checked
+against the events the target traced.
+'''
+
+import heapq
+import importlib.util
+import logging
+import os
+import re
+import shlex
+import struct
+import subprocess
+import sys
+
+from twister_harness import DeviceAdapter
+
+ZEPHYR_BASE = os.getenv("ZEPHYR_BASE")
+MERGE_SCRIPT = os.path.join(ZEPHYR_BASE, "scripts", "tracing", "merge_compact_ctf.py")
+
+THREAD_SWITCHED_IN = 0x11
+THREAD_NAME_SET = 0x1A
+SEMAPHORE_GIVE_ENTER = 0x22
+
+# Slack on the time of the event following the idle period, above a tick
+RESYNC_SLACK_NS = 20000000
+
+logger = logging.getLogger(__name__)
+
+
+def load_merge_script():
+    assert os.path.isfile(MERGE_SCRIPT)
+    spec = importlib.util.spec_from_file_location("merge_compact_ctf", MERGE_SCRIPT)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def record_end(merge, data, offset):
+    '''
+    Return the offset following the record at offset, or None at the end of
+    the stream. No CTF event has id 0, which the unused RAM buffer is filled
+    with.
+    '''
+    if offset >= len(data) or data[offset] == 0:
+        return None
+
+    length, offset = merge.read_varint(data, offset + 1)
+    _, offset = merge.read_varint(data, offset)
+    return offset + length
+
+
+def record_ids(merge, data):
+    '''Return the ids of the records of a stream, including the internal ones.'''
+    ids = []
+    offset = 0
+
+    while (end := record_end(merge, data, offset)) is not None:
+        ids.append(data[offset])
+        offset = end
+
+    return ids, offset
+
+
+def chunks_length(merge, data):
+    '''Return the length of the CPU chunks at the start of data.'''
+    offset = 0
+
+    while offset + merge.CHUNK_HEADER.size <= len(data):
+        magic, _, length = merge.CHUNK_HEADER.unpack_from(data, offset)
+        if magic != merge.CHUNK_MAGIC:
+            break
+        offset += merge.CHUNK_HEADER.size + length
+
+    return offset
+
+
+def read_dump(dut: DeviceAdapter):
+    '''
+    Grab the tracing data dumped on the console, with the values the target
+    printed before it.
+    '''
+    lines = dut.readlines_until(regex='CTF_COMPACT_DUMP_END', timeout=120.0)
+    lines = [line.strip() for line in lines]
+
+    values = {}
+    for line in lines:
+        match = re.fullmatch(r'(resync|rounds)((?: [0-9]+)+)', line)
+        if match:
+            values[match.group(1)] = [int(value) for value in match.group(2).split()]
+
+    begin = lines.index('CTF_COMPACT_DUMP_BEGIN')
+    end = lines.index('CTF_COMPACT_DUMP_END')
+    data = bytes.fromhex(''.join(lines[begin + 1:end]))
+
+    return data, values
+
+
+def thread_name(fields):
+    return fields[4:24].split(b'\0')[0].decode()
+
+
+def test_ctf_compact(dut: DeviceAdapter, is_per_cpu_build):
+    build_dir = dut.device_config.app_build_dir
+    merge = load_merge_script()
+
+    data, values = read_dump(dut)
+    rounds = values['rounds'][0]
+    before, after = values['resync']
+
+    # Keep the part of the RAM buffer that was written
+    if is_per_cpu_build:
+        data = data[:chunks_length(merge, data)]
+        streams = merge.split_chunks(data)
+    else:
+        data = data[:record_ids(merge, data)[1]]
+        streams = {0: data}
+    assert data, "Nothing traced"
+
+    # Every stream starts with an absolute timestamp, and has another one
+    # after the idle period
+    timestamps = 0
+    for cpu, stream in streams.items():
+        ids, length = record_ids(merge, stream)
+        assert length == len(stream), f"Stream of CPU {cpu} does not end on a record"
+        assert ids[0] == merge.TIMESTAMP, f"Stream of CPU {cpu} starts with record {ids[0]}"
+        timestamps += ids.count(merge.TIMESTAMP)
+    assert timestamps > len(streams), "No timestamp record after the idle period"
+
+    # Decode the streams and check the events the target traced
+    decoded = {cpu: list(merge.decode(stream)) for cpu, stream in streams.items()}
+    events = []
+    for cpu, stream_events in decoded.items():
+        times = [timestamp for timestamp, _, _ in stream_events]
+        assert times == sorted(times), f"Timestamps of CPU {cpu} go backwards"
+        events.extend(stream_events)
+
+    names = [thread_name(fields) for _, event_id, fields in events
+             if event_id == THREAD_NAME_SET]
+    logger.info(f'Thread names set: {names}')
+    for name in ('ping', 'pong', 'resync'):
+        assert name in names, f"No name set event for {name}"
+
+    switched_in = [thread_name(fields) for _, event_id, fields in events
+                   if event_id == THREAD_SWITCHED_IN]
+    for name in ('ping', 'pong'):
+        assert switched_in.count(name) >= rounds, f"{name} switched in too few times"
+
+    gives = [event_id for _, event_id, _ in events if event_id == SEMAPHORE_GIVE_ENTER]
+    assert len(gives) >= 2 * rounds, "Too few semaphore give events"
+
+    # The time right after the idle period comes from the timestamp record
+    resync = [timestamp for timestamp, event_id, fields in events
+              if event_id == THREAD_NAME_SET and thread_name(fields) == 'resync']
+    logger.info(f'Resync event at {resync[0]} ns, uptime {before} to {after} ns')
+    assert before - RESYNC_SLACK_NS <= resync[0] <= after + RESYNC_SLACK_NS
+
+    # Round trip through the script, which must write the same events in
+    # timestamp order
+    input_file = os.path.join(build_dir, "ctf_compact.bin")
+    output_dir = os.path.join(build_dir, "ctf_compact")
+    with open(input_file, 'wb') as fp:
+        fp.write(data)
+
+    cmd = [sys.executable, MERGE_SCRIPT, '-i', input_file, '-o', output_dir]
+    if is_per_cpu_build:
+        cmd.append('--per-cpu')
+    logger.info(f'Running merge script: {shlex.join(cmd)}')
+    result = subprocess.run(cmd, capture_output=True, text=True, check=True)
+    logger.info(result.stdout)
+
+    merged = heapq.merge(*(decoded[cpu] for cpu in sorted(decoded)),
+                         key=lambda event: event[0])
+    expected = b''.join(struct.pack("<IB", timestamp & 0xFFFFFFFF, event_id) + fields
+                        for timestamp, event_id, fields in merged)
+
+    with open(os.path.join(output_dir, "channel0_0"), 'rb') as fp:
+        assert fp.read() == expected
+    assert os.path.isfile(os.path.join(output_dir, "metadata"))
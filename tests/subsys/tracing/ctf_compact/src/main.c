@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Traces two threads handing a semaphore back and forth, then an idle period,
+ * with the compact CTF stream to the RAM backend. The captured stream is
+ * dumped in hexadecimal to the console, for the pytest harness to decode it
+ * with scripts/tracing/merge_compact_ctf.py and check the events.
+ */
+
+#include <zephyr/kernel.h>
+#include <tracing_core.h>
+
+#define ROUNDS     16
+#define STACK_SIZE 1024
+#define PRIORITY   5
+#define IDLE_TIME  K_MSEC(200)
+
+/* Bytes per line of the dump */
+#define DUMP_LINE 32
+
+extern uint8_t ram_tracing[CONFIG_RAM_TRACING_BUFFER_SIZE];
+
+static K_THREAD_STACK_DEFINE(ping_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(pong_stack, STACK_SIZE);
+static struct k_thread ping_thread;
+static struct k_thread pong_thread;
+
+static K_SEM_DEFINE(ping_sem, 0, 1);
+static K_SEM_DEFINE(pong_sem, 0, 1);
+
+static void ping(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < ROUNDS; i++) {
+		k_sem_give(&pong_sem);
+		k_sem_take(&ping_sem, K_FOREVER);
+	}
+}
+
+static void pong(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < ROUNDS; i++) {
+		k_sem_take(&pong_sem, K_FOREVER);
+		k_sem_give(&ping_sem);
+	}
+}
+
+static uint64_t uptime_ns(void)
+{
+	return k_ticks_to_ns_floor64(k_uptime_ticks());
+}
+
+int main(void)
+{
+	uint64_t before, after;
+
+	k_thread_create(&pong_thread, pong_stack, K_THREAD_STACK_SIZEOF(pong_stack), pong,
+			NULL, NULL, NULL, PRIORITY, 0, K_FOREVER);
+	k_thread_name_set(&pong_thread, "pong");
+	k_thread_create(&ping_thread, ping_stack, K_THREAD_STACK_SIZEOF(ping_stack), ping,
+			NULL, NULL, NULL, PRIORITY, 0, K_FOREVER);
+	k_thread_name_set(&ping_thread, "ping");
+
+	k_thread_start(&pong_thread);
+	k_thread_start(&ping_thread);
+	k_thread_join(&ping_thread, K_FOREVER);
+	k_thread_join(&pong_thread, K_FOREVER);
+
+	/* The first event after the idle period carries the absolute time */
+	k_sleep(IDLE_TIME);
+	before = uptime_ns();
+	k_thread_name_set(k_current_get(), "resync");
+	after = uptime_ns();
+
+	/* Let the tracing thread output what is left in the tracing buffer */
+	tracing_cmd_handle((uint8_t *)"disable", sizeof("disable") - 1);
+	k_sleep(K_MSEC(100));
+
+	printk("resync %llu %llu\n", (unsigned long long)before, (unsigned long long)after);
+	printk("rounds %d\n", ROUNDS);
+	printk("CTF_COMPACT_DUMP_BEGIN\n");
+	for (size_t i = 0; i < sizeof(ram_tracing); i++) {
+		printk("%02x%s", ram_tracing[i], (i + 1) % DUMP_LINE == 0 ? "\n" : "");
+	}
+	printk("CTF_COMPACT_DUMP_END\n");
+
+	return 0;
+}